@@ -0,0 +1,359 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "AnnotationNode.h"
+#include "Util/StringHandler.h"
+
+QMutex AnnotationNode::mMutex;
+QCache<QString, AnnotationNode> AnnotationNode::mCache(ANNOTATION_NODE_CACHE_SIZE);
+
+AnnotationNode::AnnotationNode()
+  : mType(AnnotationNode::Atom), mStart(0), mLength(0), mArgumentsStart(0)
+{
+}
+
+/*!
+ * \brief AnnotationNode::parse
+ * Parses the comma separated annotation values and returns them as the children of an Array node.\n
+ * Returns the cached node if the same annotation is already parsed.
+ * \param annotation
+ * \return
+ */
+AnnotationNode AnnotationNode::parse(const QString &annotation)
+{
+  {
+    QMutexLocker locker(&mMutex);
+    if (AnnotationNode *pNode = mCache.object(annotation)) {
+      return *pNode;
+    }
+  }
+  AnnotationNode node;
+  node.mType = AnnotationNode::Array;
+  node.mSource = annotation;
+  node.mLength = annotation.length();
+  if (!annotation.trimmed().isEmpty()) {
+    parseList(annotation, 0, QChar(), &node);
+  }
+  insert(annotation, node);
+  return node;
+}
+
+/*!
+ * \brief AnnotationNode::at
+ * Returns the child node at index. Returns an empty Atom if the index is out of range.
+ * \param index
+ * \return
+ */
+const AnnotationNode& AnnotationNode::at(int index) const
+{
+  static const AnnotationNode emptyNode;
+  if (index < 0 || index >= mChildren.size()) {
+    return emptyNode;
+  }
+  return mChildren.at(index);
+}
+
+/*!
+ * \brief AnnotationNode::getName
+ * Returns the name of the Record node.
+ * \return
+ */
+QString AnnotationNode::getName() const
+{
+  if (mType != AnnotationNode::Record) {
+    return "";
+  }
+  return mSource.mid(mStart, mArgumentsStart - mStart - 1).trimmed();
+}
+
+/*!
+ * \brief AnnotationNode::getArguments
+ * Returns the arguments of the Record node as an Array node.
+ * \return
+ */
+AnnotationNode AnnotationNode::getArguments() const
+{
+  AnnotationNode node;
+  if (mType == AnnotationNode::Record) {
+    node.mType = AnnotationNode::Array;
+    node.mSource = mSource;
+    node.mStart = mArgumentsStart;
+    // the Record node ends with the closing parenthesis.
+    node.mLength = qMax(mStart + mLength - mArgumentsStart - 1, 0);
+    node.mChildren = mChildren;
+  }
+  return node;
+}
+
+/*!
+ * \brief AnnotationNode::internArguments
+ * Returns the text of the arguments of the Record node and caches the already parsed arguments by it.\n
+ * Used when the arguments text is passed to a shape constructor so the shape doesn't parse it again.
+ * \return
+ */
+QString AnnotationNode::internArguments() const
+{
+  AnnotationNode node = getArguments();
+  QString arguments = node.getSource();
+  insert(arguments, node);
+  return arguments;
+}
+
+/*!
+ * \brief AnnotationNode::toUnquotedString
+ * Returns the source text of the node without the surrounding double quotes.
+ * \return
+ */
+QString AnnotationNode::toUnquotedString() const
+{
+  return StringHandler::removeFirstLastQuotes(getSource());
+}
+
+/*!
+ * \brief AnnotationNode::toPoint
+ * Returns the point of a {x, y} node.
+ * \return
+ */
+QPointF AnnotationNode::toPoint() const
+{
+  if (mChildren.size() < 2) {
+    return QPointF();
+  }
+  return QPointF(mChildren.at(0).toReal(), mChildren.at(1).toReal());
+}
+
+/*!
+ * \brief AnnotationNode::toPoints
+ * Returns the points of a {{x1, y1}, {x2, y2}, ...} node. Children without two coordinates are skipped.
+ * \return
+ */
+QList<QPointF> AnnotationNode::toPoints() const
+{
+  QList<QPointF> points;
+  points.reserve(mChildren.size());
+  foreach (const AnnotationNode &node, mChildren) {
+    if (node.size() >= 2) {
+      points.append(node.toPoint());
+    }
+  }
+  return points;
+}
+
+/*!
+ * \brief AnnotationNode::toColor
+ * Returns the color of a {red, green, blue} node.
+ * \return an invalid color if the node doesn't have three components.
+ */
+QColor AnnotationNode::toColor() const
+{
+  if (mChildren.size() < 3) {
+    return QColor();
+  }
+  return QColor(mChildren.at(0).toInt(), mChildren.at(1).toInt(), mChildren.at(2).toInt());
+}
+
+/*!
+ * \brief AnnotationNode::insert
+ * Inserts the parsed annotation in the cache.
+ * \param annotation
+ * \param node
+ */
+void AnnotationNode::insert(const QString &annotation, const AnnotationNode &node)
+{
+  QMutexLocker locker(&mMutex);
+  mCache.insert(annotation, new AnnotationNode(node), qMax(annotation.length(), 1));
+}
+
+/*!
+ * \brief AnnotationNode::skipSpaces
+ * Returns the index of the first non space character starting from index.
+ * \param source
+ * \param index
+ * \return
+ */
+int AnnotationNode::skipSpaces(const QString &source, int index)
+{
+  while (index < source.length() && source.at(index).isSpace()) {
+    index++;
+  }
+  return index;
+}
+
+/*!
+ * \brief AnnotationNode::skipString
+ * Returns the index after the string starting at index. Handles the escaped quotes.
+ * \param source
+ * \param index - the index of the opening quote.
+ * \return
+ */
+int AnnotationNode::skipString(const QString &source, int index)
+{
+  QChar quote = source.at(index);
+  index++;
+  while (index < source.length()) {
+    if (source.at(index) == '\\') {
+      index += 2;
+      continue;
+    }
+    if (source.at(index) == quote) {
+      return index + 1;
+    }
+    index++;
+  }
+  return index;
+}
+
+/*!
+ * \brief AnnotationNode::skipExpression
+ * Returns the index of the comma or closing bracket ending the expression starting at index.
+ * \param source
+ * \param index
+ * \return
+ */
+int AnnotationNode::skipExpression(const QString &source, int index)
+{
+  int depth = 0;
+  while (index < source.length()) {
+    QChar c = source.at(index);
+    if (c == '"' || c == '\'') {
+      index = skipString(source, index);
+      continue;
+    } else if (c == '{' || c == '(') {
+      depth++;
+    } else if (c == '}' || c == ')') {
+      if (depth == 0) {
+        return index;
+      }
+      depth--;
+    } else if (c == ',' && depth == 0) {
+      return index;
+    }
+    index++;
+  }
+  return index;
+}
+
+/*!
+ * \brief AnnotationNode::parseValue
+ * Parses the value starting at index.
+ * \param source
+ * \param index
+ * \param pNode
+ * \return the index after the value.
+ */
+int AnnotationNode::parseValue(const QString &source, int index, AnnotationNode *pNode)
+{
+  index = skipSpaces(source, index);
+  pNode->mSource = source;
+  pNode->mStart = index;
+  if (index >= source.length()) {
+    return index;
+  }
+  QChar c = source.at(index);
+  if (c == '{') {
+    pNode->mType = AnnotationNode::Array;
+    index = parseList(source, index + 1, '}', pNode);
+  } else if (c == '"' || c == '\'') {
+    pNode->mType = AnnotationNode::String;
+    index = skipString(source, index);
+  } else {
+    while (index < source.length()) {
+      c = source.at(index);
+      if (c == ',' || c == '{' || c == '}' || c == '(' || c == ')' || c == '"' || c == '\'') {
+        break;
+      }
+      index++;
+    }
+    if (index < source.length() && source.at(index) == '(' && index > pNode->mStart) {
+      pNode->mType = AnnotationNode::Record;
+      pNode->mArgumentsStart = index + 1;
+      index = parseList(source, index + 1, ')', pNode);
+    } else {
+      pNode->mType = AnnotationNode::Atom;
+    }
+  }
+  // the value is followed by something else, e.g., "a" + "b", so take the whole expression as an Atom.
+  int next = skipSpaces(source, index);
+  if (next < source.length() && source.at(next) != ',' && source.at(next) != '}' && source.at(next) != ')') {
+    pNode->mType = AnnotationNode::Atom;
+    pNode->mChildren.clear();
+    index = skipExpression(source, next);
+  }
+  int end = index;
+  while (end > pNode->mStart && source.at(end - 1).isSpace()) {
+    end--;
+  }
+  pNode->mLength = end - pNode->mStart;
+  return index;
+}
+
+/*!
+ * \brief AnnotationNode::parseList
+ * Parses the comma separated values starting at index as the children of pNode.
+ * \param source
+ * \param index
+ * \param end - the closing bracket of the list or a null character for the top level list.
+ * \param pNode
+ * \return the index after the closing bracket.
+ */
+int AnnotationNode::parseList(const QString &source, int index, QChar end, AnnotationNode *pNode)
+{
+  index = skipSpaces(source, index);
+  if (index < source.length() && source.at(index) == end) {
+    return index + 1;
+  }
+  while (index < source.length()) {
+    AnnotationNode node;
+    index = parseValue(source, index, &node);
+    pNode->mChildren.append(node);
+    index = skipSpaces(source, index);
+    if (index >= source.length()) {
+      break;
+    }
+    if (source.at(index) == ',') {
+      index++;
+      // a trailing comma is followed by an empty value.
+      if (skipSpaces(source, index) >= source.length()) {
+        AnnotationNode node;
+        parseValue(source, index, &node);
+        pNode->mChildren.append(node);
+        break;
+      }
+      continue;
+    }
+    // the closing bracket of the list or an unbalanced bracket ends the list.
+    return index + 1;
+  }
+  return index;
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef ANNOTATIONNODE_H
+#define ANNOTATIONNODE_H
+
+#include <QString>
+#include <QVector>
+#include <QPointF>
+#include <QColor>
+#include <QCache>
+#include <QMutex>
+
+#define ANNOTATION_NODE_CACHE_SIZE 4194304 // maximum number of annotation characters kept in the parsed annotations cache.
+
+/*!
+ * \class AnnotationNode
+ * \brief A node of a parsed annotation as returned by OMC, e.g., {true, {0, 0}, 0, {{-100, -100}, {100, 100}}}.\n
+ * The annotation is tokenized in one pass. The nodes only store the positions in the implicitly shared annotation text,
+ * so parsing doesn't copy the text at every nesting level.
+ * The parsed annotations are cached by their text so undo/redo and reloading the same icons doesn't parse them again.
+ */
+class AnnotationNode
+{
+public:
+  enum Type {
+    Atom,     /* number, boolean, enumeration literal or expression */
+    String,   /* "string" */
+    Array,    /* {a, b} */
+    Record    /* Name(a, b) */
+  };
+  AnnotationNode();
+  static AnnotationNode parse(const QString &annotation);
+  Type getType() const {return mType;}
+  bool isArray() const {return mType == AnnotationNode::Array;}
+  bool isRecord() const {return mType == AnnotationNode::Record;}
+  int size() const {return mChildren.size();}
+  const AnnotationNode& at(int index) const;
+  QString getSource() const {return mSource.mid(mStart, mLength);}
+  QString getName() const;
+  AnnotationNode getArguments() const;
+  QString internArguments() const;
+  qreal toReal() const {return getSource().toFloat();}
+  int toInt() const {return getSource().toInt();}
+  bool toBool() const {return getSource().contains("true");}
+  QString toUnquotedString() const;
+  QPointF toPoint() const;
+  QList<QPointF> toPoints() const;
+  QColor toColor() const;
+private:
+  Type mType;
+  QString mSource;
+  int mStart;
+  int mLength;
+  int mArgumentsStart;
+  QVector<AnnotationNode> mChildren;
+
+  static QMutex mMutex;
+  static QCache<QString, AnnotationNode> mCache;
+
+  static void insert(const QString &annotation, const AnnotationNode &node);
+  static int skipSpaces(const QString &source, int index);
+  static int skipString(const QString &source, int index);
+  static int skipExpression(const QString &source, int index);
+  static int parseValue(const QString &source, int index, AnnotationNode *pNode);
+  static int parseList(const QString &source, int index, QChar end, AnnotationNode *pNode);
+};
+
+#endif // ANNOTATIONNODE_H
@@ -54,6 +54,7 @@ BitmapAnnotation::BitmapAnnotation(QString classFileName, QString annotation, Gr
 BitmapAnnotation::BitmapAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent), mpComponent(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   setPos(mOrigin);
@@ -111,24 +112,22 @@ BitmapAnnotation::BitmapAnnotation(QString classFileName, GraphicsView *pGraphic
 
 void BitmapAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Bitmap.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
   if (list.size() < 5) {
     return;
   }
   // 4th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2)
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  for (int i = 0 ; i < qMin(list.at(3).size(), 2) ; i++) {
+    if (list.at(3).at(i).size() >= 2)
+      mExtents.replace(i, list.at(3).at(i).toPoint());
   }
   // 5th item is the fileName
-  setFileName(StringHandler::removeFirstLastQuotes(list.at(4)));
+  setFileName(list.at(4).toUnquotedString());
   // 6th item is the imageSource
   if (list.size() >= 6) {
-    mImageSource = StringHandler::removeFirstLastQuotes(list.at(5));
+    mImageSource = list.at(5).toUnquotedString();
   }
   if (!mImageSource.isEmpty()) {
     mImage.loadFromData(QByteArray::fromBase64(mImageSource.toLatin1()));
@@ -161,7 +160,7 @@ void BitmapAnnotation::paint(QPainter *painter, const QStyleOptionGraphicsItem *
 
 void BitmapAnnotation::drawBitmapAnnotaion(QPainter *painter)
 {
-  painter->drawImage(getBoundingRect(), mImage.mirrored());
+  painter->drawImage(getBoundingRect(), getMirroredImage());
 }
 
 /*!
@@ -51,6 +51,7 @@ EllipseAnnotation::EllipseAnnotation(QString annotation, GraphicsView *pGraphics
 EllipseAnnotation::EllipseAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   setPos(mOrigin);
@@ -75,25 +76,23 @@ EllipseAnnotation::EllipseAnnotation(ShapeAnnotation *pShapeAnnotation, Graphics
 
 void EllipseAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Ellipse.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  for (int i = 0 ; i < qMin(list.at(8).size(), 2) ; i++) {
+    if (list.at(8).at(i).size() >= 2) {
+      mExtents.replace(i, list.at(8).at(i).toPoint());
     }
   }
   // 10th item of the list contains the start angle.
-  mStartAngle = list.at(9).toFloat();
+  mStartAngle = list.at(9).toReal();
   // 11th item of the list contains the end angle.
-  mEndAngle = list.at(10).toFloat();
+  mEndAngle = list.at(10).toReal();
 }
 
 QRectF EllipseAnnotation::boundingRect() const
@@ -71,6 +71,7 @@ LineAnnotation::LineAnnotation(QString annotation, GraphicsView *pGraphicsView)
 LineAnnotation::LineAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   setLineType(LineAnnotation::ComponentType);
@@ -384,47 +385,53 @@ LineAnnotation::LineAnnotation(GraphicsView *pGraphicsView)
 
 void LineAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Line.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
   mPoints.clear();
   // 4th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  foreach (QString point, pointsList) {
-    QStringList linePoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (linePoints.size() >= 2) {
-      addPoint(QPointF(linePoints.at(0).toFloat(), linePoints.at(1).toFloat()));
-    }
+  foreach (const QPointF &point, list.at(3).toPoints()) {
+    addPoint(point);
   }
   // 5th item of list contains the color.
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (colorList.size() >= 3) {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+  if (list.at(4).size() >= 3) {
+    mLineColor = list.at(4).toColor();
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(list.at(5).getSource());
   // 7th item of list contains the Line thickness.
-  mLineThickness = list.at(6).toFloat();
+  mLineThickness = list.at(6).toReal();
   // 8th item of list contains the Line Arrows.
-  QStringList arrowList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(7)));
-  if (arrowList.size() >= 2) {
-    mArrow.replace(0, StringHandler::getArrowType(arrowList.at(0)));
-    mArrow.replace(1, StringHandler::getArrowType(arrowList.at(1)));
+  if (list.at(7).size() >= 2) {
+    mArrow.replace(0, StringHandler::getArrowType(list.at(7).at(0).getSource()));
+    mArrow.replace(1, StringHandler::getArrowType(list.at(7).at(1).getSource()));
   }
   // 9th item of list contains the Line Arrow Size.
-  mArrowSize = list.at(8).toFloat();
+  mArrowSize = list.at(8).toReal();
   // 10th item of list contains the smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).getSource());
 }
 
+/*!
+ * \brief LineAnnotation::getShape
+ * Returns the path of the line. The path is cached and shared with the class icon shape.
+ * \return
+ * \sa ShapeAnnotation::getCachedShapePath()
+ */
 QPainterPath LineAnnotation::getShape() const
+{
+  return getCachedShapePath();
+}
+
+/*!
+ * \brief LineAnnotation::createShapePath
+ * Creates the path of the line from its points.
+ * \return
+ */
+QPainterPath LineAnnotation::createShapePath() const
 {
   QPainterPath path;
   if (mPoints.size() > 0) {
@@ -1050,9 +1057,15 @@ void LineAnnotation::updateShape(ShapeAnnotation *pShapeAnnotation)
   // set the default values
   GraphicItem::setDefaults(pShapeAnnotation);
   mPoints.clear();
-  QList<QPointF> points = pShapeAnnotation->getPoints();
-  for (int i = 0 ; i < points.size() ; i++) {
-    addPoint(points[i]);
+  if (mpReferenceShapeAnnotation) {
+    // shape inside a component is not edited so share the points and geometries of the class icon shape.
+    mPoints = pLineAnnotation->mPoints;
+    mGeometries = pLineAnnotation->mGeometries;
+  } else {
+    QList<QPointF> points = pShapeAnnotation->getPoints();
+    for (int i = 0 ; i < points.size() ; i++) {
+      addPoint(points[i]);
+    }
   }
   updateTransitionTextPosition();
   ShapeAnnotation::setDefaults(pShapeAnnotation);
@@ -137,6 +137,7 @@ public:
   void updateToolTip();
   void showOMSConnection();
 protected:
+  QPainterPath createShapePath() const;
   QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
   private:
@@ -51,6 +51,7 @@ PolygonAnnotation::PolygonAnnotation(QString annotation, GraphicsView *pGraphics
 PolygonAnnotation::PolygonAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   setPos(mOrigin);
@@ -86,22 +87,15 @@ PolygonAnnotation::PolygonAnnotation(Component *pParent)
 
 void PolygonAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Polygon.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 10) {
     return;
   }
-  mPoints.clear();
   // 9th item of list contains the points.
-  QStringList pointsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  foreach (QString point, pointsList) {
-    QStringList polygonPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(point));
-    if (polygonPoints.size() >= 2) {
-      mPoints.append(QPointF(polygonPoints.at(0).toFloat(), polygonPoints.at(1).toFloat()));
-    }
-  }
+  mPoints = list.at(8).toPoints();
   /* The polygon is automatically closed, if the first and the last points are not identical. */
   if (mPoints.size() == 1) {
     mPoints.append(mPoints.first());
@@ -115,10 +109,26 @@ void PolygonAnnotation::parseShapeAnnotation(QString annotation)
     }
   }
   // 10th item of the list is smooth.
-  mSmooth = StringHandler::getSmoothType(list.at(9));
+  mSmooth = StringHandler::getSmoothType(list.at(9).getSource());
 }
 
+/*!
+ * \brief PolygonAnnotation::getShape
+ * Returns the path of the polygon. The path is cached and shared with the class icon shape.
+ * \return
+ * \sa ShapeAnnotation::getCachedShapePath()
+ */
 QPainterPath PolygonAnnotation::getShape() const
+{
+  return getCachedShapePath();
+}
+
+/*!
+ * \brief PolygonAnnotation::createShapePath
+ * Creates the path of the polygon from its points.
+ * \return
+ */
+QPainterPath PolygonAnnotation::createShapePath() const
 {
   QPainterPath path;
   if (mPoints.size() > 0) {
@@ -65,6 +65,8 @@ public:
   void updateShape(ShapeAnnotation *pShapeAnnotation);
 public slots:
   void duplicate();
+protected:
+  QPainterPath createShapePath() const;
 };
 
 #endif // POLYGONANNOTATION_H
@@ -51,6 +51,7 @@ RectangleAnnotation::RectangleAnnotation(QString annotation, GraphicsView *pGrap
 RectangleAnnotation::RectangleAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   setPos(mOrigin);
@@ -118,25 +119,23 @@ RectangleAnnotation::RectangleAnnotation(GraphicsView *pGraphicsView)
 
 void RectangleAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Rectangle.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item of the list contains the border pattern.
-  mBorderPattern = StringHandler::getBorderPatternType(list.at(8));
+  mBorderPattern = StringHandler::getBorderPatternType(list.at(8).getSource());
   // 10th item is the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(9)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2) {
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  for (int i = 0 ; i < qMin(list.at(9).size(), 2) ; i++) {
+    if (list.at(9).at(i).size() >= 2) {
+      mExtents.replace(i, list.at(9).at(i).toPoint());
     }
   }
   // 11th item of the list contains the corner radius.
-  mRadius = list.at(10).toFloat();
+  mRadius = list.at(10).toReal();
 }
 
 QRectF RectangleAnnotation::boundingRect() const
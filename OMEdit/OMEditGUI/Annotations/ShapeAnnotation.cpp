@@ -68,35 +68,31 @@ void GraphicItem::setDefaults(ShapeAnnotation *pShapeAnnotation)
 
 /*!
   Parses the GraphicItem annotation values.
-  \param annotation - the annotation string.
+  \param annotation - the parsed annotation values.
   */
-void GraphicItem::parseShapeAnnotation(QString annotation)
+void GraphicItem::parseShapeAnnotation(const AnnotationNode &annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 3)
+  if (annotation.size() < 3)
     return;
   // if first item of list is true then the shape should be visible.
-  if (list.at(0).startsWith("{")) {
+  if (annotation.at(0).isArray()) {
     // DynamicSelect
-    QStringList args = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(0)));
-    if (args.count() > 0)
-      mVisible = args.at(0).contains("true");
-    if (args.count() > 1)
-      mDynamicVisible = args.at(1);  // variable name
+    const AnnotationNode &args = annotation.at(0);
+    if (args.size() > 0)
+      mVisible = args.at(0).toBool();
+    if (args.size() > 1)
+      mDynamicVisible = args.at(1).getSource();  // variable name
   }
   else {
-    mVisible = list.at(0).contains("true");
+    mVisible = annotation.at(0).toBool();
   }
   // 2nd item is the origin
-  QStringList originList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(1)));
-  if (originList.size() >= 2)
+  if (annotation.at(1).size() >= 2)
   {
-    mOrigin.setX(originList.at(0).toFloat());
-    mOrigin.setY(originList.at(1).toFloat());
+    mOrigin = annotation.at(1).toPoint();
   }
   // 3rd item is the rotation
-  mRotation = list.at(2).toFloat();
+  mRotation = annotation.at(2).toReal();
 }
 
 /*!
@@ -175,40 +171,28 @@ void FilledShape::setDefaults(ShapeAnnotation *pShapeAnnotation)
 
 /*!
   Parses the FilledShape annotation values.
-  \param annotation - the annotation string.
+  \param annotation - the parsed annotation values.
   */
-void FilledShape::parseShapeAnnotation(QString annotation)
+void FilledShape::parseShapeAnnotation(const AnnotationNode &annotation)
 {
-  // parse the shape to get the list of attributes
-  QStringList list = StringHandler::getStrings(annotation);
-  if (list.size() < 8)
+  if (annotation.size() < 8)
     return;
   // 4th item of the list is the line color
-  QStringList colorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(3)));
-  if (colorList.size() >= 3)
+  if (annotation.at(3).size() >= 3)
   {
-    int red, green, blue = 0;
-    red = colorList.at(0).toInt();
-    green = colorList.at(1).toInt();
-    blue = colorList.at(2).toInt();
-    mLineColor = QColor (red, green, blue);
+    mLineColor = annotation.at(3).toColor();
   }
   // 5th item of list contains the fill color.
-  QStringList fillColorList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(4)));
-  if (fillColorList.size() >= 3)
+  if (annotation.at(4).size() >= 3)
   {
-    int red, green, blue = 0;
-    red = fillColorList.at(0).toInt();
-    green = fillColorList.at(1).toInt();
-    blue = fillColorList.at(2).toInt();
-    mFillColor = QColor (red, green, blue);
+    mFillColor = annotation.at(4).toColor();
   }
   // 6th item of list contains the Line Pattern.
-  mLinePattern = StringHandler::getLinePatternType(list.at(5));
+  mLinePattern = StringHandler::getLinePatternType(annotation.at(5).getSource());
   // 7th item of list contains the Fill Pattern.
-  mFillPattern = StringHandler::getFillPatternType(list.at(6));
+  mFillPattern = StringHandler::getFillPatternType(annotation.at(6).getSource());
   // 8th item of list contains the thickness.
-  mLineThickness = list.at(7).toFloat();
+  mLineThickness = annotation.at(7).toReal();
 }
 
 /*!
@@ -300,6 +284,9 @@ ShapeAnnotation::ShapeAnnotation(QGraphicsItem *pParent)
 {
   mpGraphicsView = 0;
   mpParentComponent = dynamic_cast<Component*>(pParent);
+  mpReferenceShapeAnnotation = 0;
+  mShapePathSmooth = StringHandler::SmoothNone;
+  mMirroredImageCacheKey = 0;
   //mTransformation = 0;
   mIsCustomShape = false;
   mIsInheritedShape = false;
@@ -316,6 +303,9 @@ ShapeAnnotation::ShapeAnnotation(bool inheritedShape, GraphicsView *pGraphicsVie
 {
   mpGraphicsView = pGraphicsView;
   mpParentComponent = 0;
+  mpReferenceShapeAnnotation = 0;
+  mShapePathSmooth = StringHandler::SmoothNone;
+  mMirroredImageCacheKey = 0;
   mTransformation = Transformation(StringHandler::Diagram);
   mIsCustomShape = true;
   mIsInheritedShape = inheritedShape;
@@ -461,6 +451,29 @@ QPainterPath ShapeAnnotation::addPathStroker(QPainterPath &path) const
   return stroker.createStroke(path);
 }
 
+/*!
+ * \brief ShapeAnnotation::getCachedShapePath
+ * Returns the path of the shape created by createShapePath().\n
+ * The path is created again only when the points or the smooth of the shape are changed.
+ * The instances of a class share the path of the class icon shape they are created from.
+ * \return
+ */
+QPainterPath ShapeAnnotation::getCachedShapePath() const
+{
+  const ShapeAnnotation *pShapeAnnotation = this;
+  // the points of the instance share the data with the points of the reference shape so the comparison is cheap.
+  if (mpReferenceShapeAnnotation && mpReferenceShapeAnnotation->mSmooth == mSmooth && mpReferenceShapeAnnotation->mPoints == mPoints) {
+    pShapeAnnotation = mpReferenceShapeAnnotation.data();
+  }
+  if (pShapeAnnotation->mShapePath.isEmpty() || pShapeAnnotation->mShapePathSmooth != pShapeAnnotation->mSmooth
+      || pShapeAnnotation->mShapePathPoints != pShapeAnnotation->mPoints) {
+    pShapeAnnotation->mShapePath = pShapeAnnotation->createShapePath();
+    pShapeAnnotation->mShapePathPoints = pShapeAnnotation->mPoints;
+    pShapeAnnotation->mShapePathSmooth = pShapeAnnotation->mSmooth;
+  }
+  return pShapeAnnotation->mShapePath;
+}
+
 /*!
   Returns the bounding rectangle of the shape.
   \return the bounding rectangle.
@@ -788,6 +801,25 @@ QImage ShapeAnnotation::getImage()
   return mImage;
 }
 
+/*!
+ * \brief ShapeAnnotation::getMirroredImage
+ * Returns the mirrored image used for drawing.\n
+ * The mirrored image is cached and the instances of a class share the mirrored image of the class icon shape.
+ * \return
+ */
+QImage ShapeAnnotation::getMirroredImage() const
+{
+  const ShapeAnnotation *pShapeAnnotation = this;
+  if (mpReferenceShapeAnnotation && mpReferenceShapeAnnotation->mImage.cacheKey() == mImage.cacheKey()) {
+    pShapeAnnotation = mpReferenceShapeAnnotation.data();
+  }
+  if (pShapeAnnotation->mMirroredImage.isNull() || pShapeAnnotation->mMirroredImageCacheKey != pShapeAnnotation->mImage.cacheKey()) {
+    pShapeAnnotation->mMirroredImage = pShapeAnnotation->mImage.mirrored();
+    pShapeAnnotation->mMirroredImageCacheKey = pShapeAnnotation->mImage.cacheKey();
+  }
+  return pShapeAnnotation->mMirroredImage;
+}
+
 /*!
   Returns a dynamic value or null if no dynamic value exists
   */
@@ -37,8 +37,10 @@
 
 #include "Util/StringHandler.h"
 #include "Component/Transformation.h"
+#include "Annotations/AnnotationNode.h"
 
 #include <QGraphicsItem>
+#include <QPointer>
 #include <QSettings>
 #include <QGroupBox>
 #include <QDialog>
@@ -59,7 +61,7 @@ public:
   GraphicItem() {}
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
-  void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const AnnotationNode &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setOrigin(QPointF origin) {mOrigin = origin;}
@@ -79,7 +81,7 @@ public:
   FilledShape() {}
   void setDefaults();
   void setDefaults(ShapeAnnotation *pShapeAnnotation);
-  void parseShapeAnnotation(QString annotation);
+  void parseShapeAnnotation(const AnnotationNode &annotation);
   QStringList getOMCShapeAnnotation();
   QStringList getShapeAnnotation();
   void setLineColor(QColor color) {mLineColor = color;}
@@ -141,6 +143,8 @@ public:
   virtual void replaceExtent(int index, QPointF point);
   virtual void updateEndExtent(QPointF point);
   GraphicsView* getGraphicsView() {return mpGraphicsView;}
+  void setReferenceShapeAnnotation(ShapeAnnotation *pReferenceShapeAnnotation) {mpReferenceShapeAnnotation = pReferenceShapeAnnotation;}
+  ShapeAnnotation* getReferenceShapeAnnotation() {return mpReferenceShapeAnnotation;}
   void setPoints(QList<QPointF> points) {mPoints = points;}
   QList<QPointF> getPoints() {return mPoints;}
   void setStartArrow(StringHandler::Arrow startArrow) {mArrow.replace(0, startArrow);}
@@ -177,6 +181,7 @@ public:
   QString getImageSource();
   void setImage(QImage image);
   QImage getImage();
+  QImage getMirroredImage() const;
   QVariant getDynamicValue(QString name);
   void applyRotation(qreal angle);
   void adjustPointsWithOrigin();
@@ -236,6 +241,8 @@ public slots:
 protected:
   GraphicsView *mpGraphicsView;
   Component *mpParentComponent;
+  /* The class icon shape this shape is created from. The geometry of the reference shape is shared by all instances of the class. */
+  QPointer<ShapeAnnotation> mpReferenceShapeAnnotation;
   QList<QPointF> mPoints;
   QList<LineGeometryType> mGeometries;
   QList<StringHandler::Arrow> mArrow;
@@ -259,6 +266,13 @@ protected:
   QImage mImage;
   QList<CornerItem*> mCornerItemsList;
   QList<QVariant> mDynamicTextString; /* list of String() arguments */
+  mutable QPainterPath mShapePath; /* cached path created from mShapePathPoints and mShapePathSmooth. */
+  mutable QList<QPointF> mShapePathPoints;
+  mutable StringHandler::Smooth mShapePathSmooth;
+  mutable QImage mMirroredImage; /* cached mirrored image created from mImage. */
+  mutable qint64 mMirroredImageCacheKey;
+  QPainterPath getCachedShapePath() const;
+  virtual QPainterPath createShapePath() const {return QPainterPath();}
   void initUpdateVisible();
   virtual void contextMenuEvent(QGraphicsSceneContextMenuEvent *pEvent);
   virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value);
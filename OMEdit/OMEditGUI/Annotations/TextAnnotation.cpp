@@ -62,6 +62,7 @@ TextAnnotation::TextAnnotation(QString annotation, GraphicsView *pGraphicsView)
 TextAnnotation::TextAnnotation(ShapeAnnotation *pShapeAnnotation, Component *pParent)
   : ShapeAnnotation(pParent), mpComponent(pParent)
 {
+  setReferenceShapeAnnotation(pShapeAnnotation);
   updateShape(pShapeAnnotation);
   initUpdateVisible(); // DynamicSelect for visible attribute
   initUpdateTextString();
@@ -156,70 +157,66 @@ TextAnnotation::TextAnnotation(GraphicsView *pGraphicsView)
  */
 void TextAnnotation::parseShapeAnnotation(QString annotation)
 {
-  GraphicItem::parseShapeAnnotation(annotation);
-  FilledShape::parseShapeAnnotation(annotation);
   // parse the shape to get the list of attributes of Text.
-  QStringList list = StringHandler::getStrings(annotation);
+  AnnotationNode list = AnnotationNode::parse(annotation);
+  GraphicItem::parseShapeAnnotation(list);
+  FilledShape::parseShapeAnnotation(list);
   if (list.size() < 11) {
     return;
   }
   // 9th item of the list contains the extent points
-  QStringList extentsList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)));
-  for (int i = 0 ; i < qMin(extentsList.size(), 2) ; i++) {
-    QStringList extentPoints = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(extentsList[i]));
-    if (extentPoints.size() >= 2)
-      mExtents.replace(i, QPointF(extentPoints.at(0).toFloat(), extentPoints.at(1).toFloat()));
+  for (int i = 0 ; i < qMin(list.at(8).size(), 2) ; i++) {
+    if (list.at(8).at(i).size() >= 2)
+      mExtents.replace(i, list.at(8).at(i).toPoint());
   }
   // 10th item of the list contains the textString.
-  if (list.at(9).startsWith("{")) {
+  if (list.at(9).isArray()) {
     // DynamicSelect
-    QStringList args = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(9)));
-    if (args.count() > 0)
-      mOriginalTextString = StringHandler::removeFirstLastQuotes(args.at(0));
-    if (args.count() > 1)
-      mDynamicTextString << args.at(1);  // variable name
-    if (args.count() > 2)
-      mDynamicTextString << args.at(2);  // significantDigits
+    const AnnotationNode &args = list.at(9);
+    if (args.size() > 0)
+      mOriginalTextString = args.at(0).toUnquotedString();
+    if (args.size() > 1)
+      mDynamicTextString << args.at(1).getSource();  // variable name
+    if (args.size() > 2)
+      mDynamicTextString << args.at(2).getSource();  // significantDigits
   }
   else {
-    mOriginalTextString = StringHandler::removeFirstLastQuotes(list.at(9));
+    mOriginalTextString = list.at(9).toUnquotedString();
   }
   mTextString = mOriginalTextString;
   initUpdateTextString();
   // 11th item of the list contains the fontSize.
-  mFontSize = list.at(10).toFloat();
-  //Now comes the optional parameters; fontName and textStyle.
-  annotation = annotation.replace("{", "");
-  annotation = annotation.replace("}", "");
-  // parse the shape to get the list of attributes of Text Annotation.
-  list = StringHandler::getStrings(annotation);
-  int index = 19;
+  mFontSize = list.at(10).toReal();
+  //Now comes the optional parameters; fontName, textStyle and horizontalAlignment.
+  QList<AnnotationNode> optionalList;
+  for (int i = 11 ; i < list.size() ; i++) {
+    if (list.at(i).isArray()) {
+      for (int j = 0 ; j < list.at(i).size() ; j++) {
+        optionalList.append(list.at(i).at(j));
+      }
+    } else {
+      optionalList.append(list.at(i));
+    }
+  }
   mTextStyles.clear();
-  while(index < list.size()) {
-    QString annotationValue = StringHandler::removeFirstLastQuotes(list.at(index));
+  foreach (const AnnotationNode &node, optionalList) {
+    QString annotationValue = node.toUnquotedString();
     // check textStyles enumeration.
     if(annotationValue == "TextStyle.Bold") {
       mTextStyles.append(StringHandler::TextStyleBold);
-      index++;
     } else if(annotationValue == "TextStyle.Italic") {
       mTextStyles.append(StringHandler::TextStyleItalic);
-      index++;
     } else if(annotationValue == "TextStyle.UnderLine") {
       mTextStyles.append(StringHandler::TextStyleUnderLine);
-      index++;
     } else if(annotationValue == "TextAlignment.Left") {
       // check textAlignment enumeration.
       mHorizontalAlignment = StringHandler::TextAlignmentLeft;
-      index++;
     } else if(annotationValue == "TextAlignment.Center") {
       mHorizontalAlignment = StringHandler::TextAlignmentCenter;
-      index++;
     } else if(annotationValue == "TextAlignment.Right") {
       mHorizontalAlignment = StringHandler::TextAlignmentRight;
-      index++;
     } else {
       mFontName = annotationValue;
-      index++;
     }
   }
 }
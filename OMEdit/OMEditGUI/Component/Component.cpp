@@ -152,7 +152,16 @@ void ComponentInfo::parseComponentInfoString(QString value)
   if (value.isEmpty()) {
     return;
   }
-  QStringList list = StringHandler::unparseStrings(value);
+  parseComponentInfo(StringHandler::unparseStrings(value));
+}
+
+/*!
+ * \brief ComponentInfo::parseComponentInfo
+ * Parses the component info from the unparsed strings of the component info string.
+ * \param list
+ */
+void ComponentInfo::parseComponentInfo(const QStringList &list)
+{
   // read the class name
   if (list.size() > 0) {
     mClassName = list.at(0);
@@ -67,6 +67,7 @@ public:
   ComponentInfo(ComponentInfo *pComponentInfo, QObject *pParent = 0);
   void updateComponentInfo(const ComponentInfo *pComponentInfo);
   void parseComponentInfoString(QString value);
+  void parseComponentInfo(const QStringList &list);
   void fetchModifiers(OMCProxy *pOMCProxy, QString className, Component *pComponent);
   void fetchParameterValue(OMCProxy *pOMCProxy, QString className);
   void applyDefaultPrefixes(QString defaultPrefixes);
@@ -203,6 +203,7 @@ QStringList ModelicaEditor::getClassNames(QString *errorString)
     QString stringToParse = modelicaText;
     if (!modelicaText.startsWith("within")) {
       if (pLibraryTreeItem->isInPackageOneFile()) {
+        MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->updateOutOfDateClassText(pLibraryTreeItem);
         stringToParse = pLibraryTreeItem->getClassTextBefore() + modelicaText + pLibraryTreeItem->getClassTextAfter();
         // first we try to parse whole string so that we get correct line numbers for errors if any (see Ticket #3969).
         classNames = pOMCProxy->parseString(stringToParse, pLibraryTreeItem->getFileName());
@@ -76,6 +76,7 @@
 #include "omc_config.h"
 
 #include <QtSvg/QSvgGenerator>
+#include <QFutureWatcher>
 
 MainWindow::MainWindow(bool debug, QWidget *parent)
   : QMainWindow(parent), mDebug(debug), mExitApplicationStatus(false)
@@ -514,6 +515,8 @@ int MainWindow::askForExit()
  */
 void MainWindow::beforeClosingMainWindow()
 {
+  // save the class information of the libraries that are not completely fetched.
+  mpLibraryWidget->getLibraryTreeModel()->saveLibraryMetadataCache();
   mpOMCProxy->quitOMC();
   delete mpOMCProxy;
   // Unload the OMSimulator models
@@ -631,18 +634,18 @@ void MainWindow::openDroppedFile(QDropEvent *event)
 
 /*!
  * \brief MainWindow::openResultFiles
- * Opens the result file(s).
+ * Opens the result file(s).\n
+ * The result files are loaded in parallel in worker threads. The variables browser shows their progress.
  * \param fileNames
  */
 void MainWindow::openResultFiles(QStringList fileNames)
 {
+  if (fileNames.isEmpty()) {
+    return;
+  }
+  mpPerspectiveTabbar->setCurrentIndex(2);
   foreach (QString fileName, fileNames) {
-    QFileInfo fileInfo(fileName);
-    QStringList list = mpOMCProxy->readSimulationResultVars(fileInfo.absoluteFilePath());
-    if (list.size() > 0) {
-      mpPerspectiveTabbar->setCurrentIndex(2);
-      mpVariablesWidget->insertVariablesItemsToTree(fileInfo.fileName(), fileInfo.absoluteDir().absolutePath(), list, SimulationOptions());
-    }
+    mpVariablesWidget->loadResultFile(QFileInfo(fileName).absoluteFilePath());
   }
 }
 
@@ -786,12 +789,29 @@ void MainWindow::instantiateModel(LibraryTreeItem *pLibraryTreeItem)
   if (OptionsDialog::instance()->getMessagesPage()->getClearMessagesBrowserBeforeSimulationCheckBox()->isChecked()) {
     MessagesWidget::instance()->clearMessages();
   }
-  QString instantiateModelResult = mpOMCProxy->instantiateModel(pLibraryTreeItem->getNameStructure());
+  // instantiate the model in the background so the user can continue editing.
+  QFutureWatcher<QString> *pFutureWatcher = new QFutureWatcher<QString>(this);
+  pFutureWatcher->setProperty("className", pLibraryTreeItem->getNameStructure());
+  connect(pFutureWatcher, SIGNAL(finished()), SLOT(instantiateModelFinished()));
+  pFutureWatcher->setFuture(mpOMCProxy->instantiateModelAsync(pLibraryTreeItem->getNameStructure()));
+}
+
+/*!
+ * \brief MainWindow::instantiateModelFinished
+ * Shows the result of the model instantiation started by MainWindow::instantiateModel(LibraryTreeItem *pLibraryTreeItem).
+ */
+void MainWindow::instantiateModelFinished()
+{
+  QFutureWatcher<QString> *pFutureWatcher = static_cast<QFutureWatcher<QString>*>(sender());
+  QString className = pFutureWatcher->property("className").toString();
+  QString instantiateModelResult = pFutureWatcher->isCanceled() ? "" : StringHandler::unparse(pFutureWatcher->result());
+  pFutureWatcher->deleteLater();
+  mpOMCProxy->finishModelCheck();
   if (!instantiateModelResult.isEmpty()) {
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Instantiation of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
+                                                tr("Instantiation of %1 completed successfully.").arg(className),
                                                 Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
+    QString windowTitle = QString(Helper::instantiateModel).append(" - ").append(className);
     InformationDialog *pInformationDialog = new InformationDialog(windowTitle, instantiateModelResult, true, this);
     pInformationDialog->show();
   }
@@ -822,12 +842,29 @@ void MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem)
   if (OptionsDialog::instance()->getMessagesPage()->getClearMessagesBrowserBeforeSimulationCheckBox()->isChecked()) {
     MessagesWidget::instance()->clearMessages();
   }
-  QString checkModelResult = mpOMCProxy->checkModel(pLibraryTreeItem->getNameStructure());
+  // check the model in the background so the user can continue editing.
+  QFutureWatcher<QString> *pFutureWatcher = new QFutureWatcher<QString>(this);
+  pFutureWatcher->setProperty("className", pLibraryTreeItem->getNameStructure());
+  connect(pFutureWatcher, SIGNAL(finished()), SLOT(checkModelFinished()));
+  pFutureWatcher->setFuture(mpOMCProxy->checkModelAsync(pLibraryTreeItem->getNameStructure()));
+}
+
+/*!
+ * \brief MainWindow::checkModelFinished
+ * Shows the result of the model check started by MainWindow::checkModel(LibraryTreeItem *pLibraryTreeItem).
+ */
+void MainWindow::checkModelFinished()
+{
+  QFutureWatcher<QString> *pFutureWatcher = static_cast<QFutureWatcher<QString>*>(sender());
+  QString className = pFutureWatcher->property("className").toString();
+  QString checkModelResult = pFutureWatcher->isCanceled() ? "" : StringHandler::unparse(pFutureWatcher->result());
+  pFutureWatcher->deleteLater();
+  mpOMCProxy->finishModelCheck();
   if (!checkModelResult.isEmpty()) {
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                tr("Check of %1 completed successfully.").arg(pLibraryTreeItem->getNameStructure()),
+                                                tr("Check of %1 completed successfully.").arg(className),
                                                 Helper::scriptingKind, Helper::notificationLevel));
-    QString windowTitle = QString(Helper::checkModel).append(" - ").append(pLibraryTreeItem->getNameStructure());
+    QString windowTitle = QString(Helper::checkModel).append(" - ").append(className);
     InformationDialog *pInformationDialog = new InformationDialog(windowTitle, checkModelResult, false, this);
     pInformationDialog->show();
   }
@@ -850,7 +887,22 @@ void MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem)
   // show the progress bar
   mpProgressBar->setRange(0, 0);
   showProgressBar();
-  QString checkAllModelsResult = mpOMCProxy->checkAllModelsRecursive(pLibraryTreeItem->getNameStructure());
+  // check the models in the background so the user can continue editing.
+  QFutureWatcher<QString> *pFutureWatcher = new QFutureWatcher<QString>(this);
+  connect(pFutureWatcher, SIGNAL(finished()), SLOT(checkAllModelsFinished()));
+  pFutureWatcher->setFuture(mpOMCProxy->checkAllModelsRecursiveAsync(pLibraryTreeItem->getNameStructure()));
+}
+
+/*!
+ * \brief MainWindow::checkAllModelsFinished
+ * Shows the result of the models check started by MainWindow::checkAllModels(LibraryTreeItem *pLibraryTreeItem).
+ */
+void MainWindow::checkAllModelsFinished()
+{
+  QFutureWatcher<QString> *pFutureWatcher = static_cast<QFutureWatcher<QString>*>(sender());
+  QString checkAllModelsResult = pFutureWatcher->isCanceled() ? "" : StringHandler::unparse(pFutureWatcher->result());
+  pFutureWatcher->deleteLater();
+  mpOMCProxy->finishModelCheck();
   if (!checkAllModelsResult.isEmpty()) {
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, checkAllModelsResult, Helper::scriptingKind,
                                                 Helper::notificationLevel));
@@ -3457,6 +3509,10 @@ void MainWindow::createActions()
     mpShowOMCDiffWidgetAction = new QAction(QIcon(":/Resources/icons/console.svg"), tr("OpenModelica Compiler Diff"), this);
     mpShowOMCDiffWidgetAction->setStatusTip(tr("Shows OpenModelica Compiler Diff"));
     connect(mpShowOMCDiffWidgetAction, SIGNAL(triggered()), mpOMCProxy, SLOT(openOMCDiffWidget()));
+    // show OMC Profiler widget action
+    mpShowOMCProfilerWidgetAction = new QAction(QIcon(":/Resources/icons/console.svg"), tr("OpenModelica Compiler Profiler"), this);
+    mpShowOMCProfilerWidgetAction->setStatusTip(tr("Shows the OpenModelica Compiler calls statistics"));
+    connect(mpShowOMCProfilerWidgetAction, SIGNAL(triggered()), mpOMCProxy, SLOT(openOMCProfilerWidget()));
   }
   // open working directory action
   mpOpenWorkingDirectoryAction = new QAction(tr("Open Working Directory"), this);
@@ -3893,6 +3949,7 @@ void MainWindow::createMenus()
 #endif
   if (isDebug()) {
     pToolsMenu->addAction(mpShowOMCDiffWidgetAction);
+    pToolsMenu->addAction(mpShowOMCProfilerWidgetAction);
   }
   pToolsMenu->addSeparator();
   pToolsMenu->addAction(mpOpenWorkingDirectoryAction);
@@ -0,0 +1,235 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "LibraryIconCache.h"
+#include "LibraryTreeWidget.h"
+#include "Util/Utilities.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+
+/*!
+ * \class LibraryIconReader
+ * \brief Reads and decodes the cached icon images of a class on a worker thread.
+ */
+class LibraryIconReader : public QRunnable
+{
+public:
+  LibraryIconReader(LibraryIconCache *pLibraryIconCache, const QString &nameStructure, const QString &filePath)
+    : mpLibraryIconCache(pLibraryIconCache), mNameStructure(nameStructure), mFilePath(filePath) {}
+  void run()
+  {
+    bool found = false;
+    QImage libraryImage, dragImage;
+    if (QFile::exists(mFilePath + ".none")) {
+      found = true;
+    } else if (libraryImage.load(mFilePath + ".png", "PNG") && dragImage.load(mFilePath + "_drag.png", "PNG")) {
+      found = true;
+    }
+    QMetaObject::invokeMethod(mpLibraryIconCache, "iconLoaded", Qt::QueuedConnection, Q_ARG(QString, mNameStructure),
+                              Q_ARG(QString, mFilePath), Q_ARG(bool, found), Q_ARG(QImage, libraryImage), Q_ARG(QImage, dragImage));
+  }
+private:
+  LibraryIconCache *mpLibraryIconCache;
+  QString mNameStructure;
+  QString mFilePath;
+};
+
+/*!
+ * \class LibraryIconWriter
+ * \brief Encodes and writes the icon images of a class on a worker thread.
+ * A class without icon annotation is stored as an empty marker file.
+ */
+class LibraryIconWriter : public QRunnable
+{
+public:
+  LibraryIconWriter(const QString &filePath, const QImage &libraryImage, const QImage &dragImage)
+    : mFilePath(filePath), mLibraryImage(libraryImage), mDragImage(dragImage) {}
+  void run()
+  {
+    if (mLibraryImage.isNull() || mDragImage.isNull()) {
+      QFile file(mFilePath + ".none");
+      if (file.open(QIODevice::WriteOnly)) {
+        file.close();
+      }
+    } else {
+      // write the drag image first since the reader checks for the library image.
+      if (saveImage(mDragImage, mFilePath + "_drag.png")) {
+        saveImage(mLibraryImage, mFilePath + ".png");
+      }
+    }
+  }
+private:
+  /*!
+   * \brief saveImage
+   * Saves the image to a temporary file first so that a reader never sees a partial image.
+   * \param image
+   * \param fileName
+   * \return true on success.
+   */
+  static bool saveImage(const QImage &image, const QString &fileName)
+  {
+    QString temporaryFileName = fileName + ".tmp";
+    QFile::remove(temporaryFileName);
+    if (!image.save(temporaryFileName, "PNG")) {
+      QFile::remove(temporaryFileName);
+      return false;
+    }
+    QFile::remove(fileName);
+    return QFile::rename(temporaryFileName, fileName);
+  }
+
+  QString mFilePath;
+  QImage mLibraryImage;
+  QImage mDragImage;
+};
+
+/*!
+ * \brief LibraryIconCache::LibraryIconCache
+ * \param pLibraryTreeModel
+ */
+LibraryIconCache::LibraryIconCache(LibraryTreeModel *pLibraryTreeModel)
+  : QObject(pLibraryTreeModel)
+{
+  mpLibraryTreeModel = pLibraryTreeModel;
+  mThreadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+  QDir().mkpath(Utilities::cacheDirectory() + "icons");
+}
+
+/*!
+ * \brief LibraryIconCache::~LibraryIconCache
+ * Waits for the pending reads and writes.
+ */
+LibraryIconCache::~LibraryIconCache()
+{
+  mThreadPool.clear();
+  mThreadPool.waitForDone();
+}
+
+/*!
+ * \brief LibraryIconCache::loadIcon
+ * Starts reading the cached icon of the LibraryTreeItem in the background.
+ * The pixmaps of the LibraryTreeItem are set when the read is finished.
+ * \param pLibraryTreeItem
+ * \param libraryIconSize
+ * \return false if the icon is not cached and must be rendered.
+ */
+bool LibraryIconCache::loadIcon(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize)
+{
+  QString filePath = iconFilePath(pLibraryTreeItem, libraryIconSize);
+  if (filePath.isEmpty() || !(QFile::exists(filePath + ".png") || QFile::exists(filePath + ".none"))) {
+    return false;
+  }
+  if (!mPendingIcons.contains(pLibraryTreeItem->getNameStructure())) {
+    mPendingIcons.insert(pLibraryTreeItem->getNameStructure());
+    mThreadPool.start(new LibraryIconReader(this, pLibraryTreeItem->getNameStructure(), filePath));
+  }
+  return true;
+}
+
+/*!
+ * \brief LibraryIconCache::saveIcon
+ * Writes the rendered icon of the LibraryTreeItem in the background.
+ * \param pLibraryTreeItem
+ * \param libraryIconSize
+ * \param libraryImage
+ * \param dragImage
+ */
+void LibraryIconCache::saveIcon(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize, const QImage &libraryImage, const QImage &dragImage)
+{
+  QString filePath = iconFilePath(pLibraryTreeItem, libraryIconSize);
+  if (!filePath.isEmpty()) {
+    mThreadPool.start(new LibraryIconWriter(filePath, libraryImage, dragImage));
+  }
+}
+
+/*!
+ * \brief LibraryIconCache::iconFilePath
+ * Returns the cache file path of the icon without extension.\n
+ * Only the classes of the system libraries are cached since they are read-only.
+ * The key contains the class name, the library version, the icon size and the modification time and size of the class file.
+ * \param pLibraryTreeItem
+ * \param libraryIconSize
+ * \return an empty string if the icon can't be cached.
+ */
+QString LibraryIconCache::iconFilePath(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize) const
+{
+  if (pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica || !pLibraryTreeItem->isSystemLibrary()
+      || pLibraryTreeItem->isNonExisting() || pLibraryTreeItem->getFileName().isEmpty()) {
+    return "";
+  }
+  LibraryTreeItem *pTopLevelLibraryTreeItem = pLibraryTreeItem;
+  while (pTopLevelLibraryTreeItem->parent() && !pTopLevelLibraryTreeItem->parent()->isRootItem()) {
+    pTopLevelLibraryTreeItem = pTopLevelLibraryTreeItem->parent();
+  }
+  QFileInfo fileInfo(pLibraryTreeItem->getFileName());
+  QString key = QString("%1|%2|%3|%4|%5|%6").arg(pLibraryTreeItem->getNameStructure()).arg(pTopLevelLibraryTreeItem->getVersion())
+                .arg(libraryIconSize).arg(fileInfo.absoluteFilePath()).arg(fileInfo.lastModified().toMSecsSinceEpoch()).arg(fileInfo.size());
+  QString hash = QString(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+  return QString("%1icons/%2").arg(Utilities::cacheDirectory()).arg(hash);
+}
+
+/*!
+ * \brief LibraryIconCache::iconLoaded
+ * Slot activated when LibraryIconReader has finished.
+ * Sets the pixmaps of the LibraryTreeItem or renders the icon if the cache file is unreadable.
+ * \param nameStructure
+ * \param filePath
+ * \param found
+ * \param libraryImage
+ * \param dragImage
+ */
+void LibraryIconCache::iconLoaded(QString nameStructure, QString filePath, bool found, QImage libraryImage, QImage dragImage)
+{
+  mPendingIcons.remove(nameStructure);
+  // the class might be unloaded meanwhile.
+  LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(nameStructure);
+  if (!pLibraryTreeItem) {
+    return;
+  }
+  if (found) {
+    pLibraryTreeItem->setPixmap(libraryImage.isNull() ? QPixmap() : QPixmap::fromImage(libraryImage));
+    pLibraryTreeItem->setDragPixmap(dragImage.isNull() ? QPixmap() : QPixmap::fromImage(dragImage));
+    mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+  } else {
+    QFile::remove(filePath + ".png");
+    QFile::remove(filePath + "_drag.png");
+    mpLibraryTreeModel->loadLibraryTreeItemPixmap(pLibraryTreeItem);
+    mpLibraryTreeModel->updateLibraryTreeItem(pLibraryTreeItem);
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef LIBRARYICONCACHE_H
+#define LIBRARYICONCACHE_H
+
+#include <QObject>
+#include <QImage>
+#include <QSet>
+#include <QThreadPool>
+
+class LibraryTreeItem;
+class LibraryTreeModel;
+
+/*!
+ * \class LibraryIconCache
+ * \brief Stores the rasterized icons of the system library classes on disk.
+ * The icons are read, decoded and written by a pool of worker threads. Only the pixmap conversion happens on the GUI thread.
+ */
+class LibraryIconCache : public QObject
+{
+  Q_OBJECT
+public:
+  LibraryIconCache(LibraryTreeModel *pLibraryTreeModel);
+  ~LibraryIconCache();
+  bool loadIcon(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize);
+  void saveIcon(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize, const QImage &libraryImage, const QImage &dragImage);
+private:
+  LibraryTreeModel *mpLibraryTreeModel;
+  QThreadPool mThreadPool;
+  QSet<QString> mPendingIcons;
+
+  QString iconFilePath(LibraryTreeItem *pLibraryTreeItem, int libraryIconSize) const;
+private slots:
+  void iconLoaded(QString nameStructure, QString filePath, bool found, QImage libraryImage, QImage dragImage);
+};
+
+#endif // LIBRARYICONCACHE_H
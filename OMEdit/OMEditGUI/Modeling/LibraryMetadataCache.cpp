@@ -0,0 +1,313 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "LibraryMetadataCache.h"
+#include "Util/StringHandler.h"
+#include "Util/Utilities.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+
+#define LIBRARYMETADATACACHE_MAGIC 0x4F4D4C43
+#define LIBRARYMETADATACACHE_VERSION 1
+
+/*!
+ * \brief writeClassInformation
+ * Writes the class information to the stream.
+ * \param out
+ * \param classInformation
+ */
+static void writeClassInformation(QDataStream &out, const OMCInterface::getClassInformation_res &classInformation)
+{
+  out << classInformation.restriction << classInformation.comment << (bool)classInformation.partialPrefix
+      << classInformation.fileName << (bool)classInformation.fileReadOnly
+      << (qint64)classInformation.lineNumberStart << (qint64)classInformation.columnNumberStart
+      << (qint64)classInformation.lineNumberEnd << (qint64)classInformation.columnNumberEnd
+      << (bool)classInformation.isProtectedClass << (bool)classInformation.isDocumentationClass
+      << classInformation.version << classInformation.preferredView << classInformation.access;
+}
+
+/*!
+ * \brief readClassInformation
+ * Reads the class information from the stream.
+ * \param in
+ * \param pClassInformation
+ */
+static void readClassInformation(QDataStream &in, OMCInterface::getClassInformation_res *pClassInformation)
+{
+  bool partialPrefix, fileReadOnly, isProtectedClass, isDocumentationClass;
+  qint64 lineNumberStart, columnNumberStart, lineNumberEnd, columnNumberEnd;
+  in >> pClassInformation->restriction >> pClassInformation->comment >> partialPrefix
+     >> pClassInformation->fileName >> fileReadOnly
+     >> lineNumberStart >> columnNumberStart >> lineNumberEnd >> columnNumberEnd
+     >> isProtectedClass >> isDocumentationClass
+     >> pClassInformation->version >> pClassInformation->preferredView >> pClassInformation->access;
+  pClassInformation->partialPrefix = partialPrefix;
+  pClassInformation->fileReadOnly = fileReadOnly;
+  pClassInformation->lineNumberStart = lineNumberStart;
+  pClassInformation->columnNumberStart = columnNumberStart;
+  pClassInformation->lineNumberEnd = lineNumberEnd;
+  pClassInformation->columnNumberEnd = columnNumberEnd;
+  pClassInformation->isProtectedClass = isProtectedClass;
+  pClassInformation->isDocumentationClass = isDocumentationClass;
+}
+
+/*!
+ * \class LibraryMetadataCache
+ * \brief Stores the class information of the system libraries on disk.
+ */
+/*!
+ * \brief LibraryMetadataCache::LibraryMetadataCache
+ */
+LibraryMetadataCache::LibraryMetadataCache()
+{
+}
+
+/*!
+ * \brief LibraryMetadataCache::load
+ * Reads the cache file of the library.\n
+ * The class information is only kept for the classes whose file has the same modification time and size as when the cache was saved.
+ * Does nothing if the library is already loaded.
+ * \param library - the top level class name.
+ * \param omcVersion - the cache is discarded if it is created by a different OMC version.
+ */
+void LibraryMetadataCache::load(const QString &library, const QString &omcVersion)
+{
+  if (mLoadedLibraries.contains(library)) {
+    return;
+  }
+  mLoadedLibraries.insert(library, omcVersion);
+  QFile file(cacheFilePath(library));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return;
+  }
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_4_6);
+  quint32 magic, version;
+  in >> magic >> version;
+  if (magic != LIBRARYMETADATACACHE_MAGIC || version != LIBRARYMETADATACACHE_VERSION) {
+    return;
+  }
+  QString cachedOMCVersion, cachedLibrary;
+  in >> cachedOMCVersion >> cachedLibrary;
+  if (cachedOMCVersion.compare(omcVersion) != 0 || cachedLibrary.compare(library) != 0) {
+    return;
+  }
+  // validate the source files of the library.
+  QSet<QString> validFiles;
+  quint32 filesCount;
+  in >> filesCount;
+  for (quint32 i = 0 ; i < filesCount && in.status() == QDataStream::Ok ; i++) {
+    QString fileName;
+    qint64 modified, size;
+    in >> fileName >> modified >> size;
+    if (modified >= 0 && fileStamp(fileName) == qMakePair(modified, size)) {
+      validFiles.insert(fileName);
+    }
+  }
+  if (validFiles.size() < (int)filesCount) {
+    mModifiedLibraries.insert(library);
+  }
+  // read the class information of the classes defined in valid files.
+  QHash<QString, OMCInterface::getClassInformation_res> classInformations;
+  quint32 classesCount;
+  in >> classesCount;
+  for (quint32 i = 0 ; i < classesCount && in.status() == QDataStream::Ok ; i++) {
+    QString className;
+    OMCInterface::getClassInformation_res classInformation;
+    in >> className;
+    readClassInformation(in, &classInformation);
+    if (validFiles.contains(classInformation.fileName)) {
+      classInformations.insert(className, classInformation);
+    }
+  }
+  // a truncated file is ignored completely.
+  if (in.status() == QDataStream::Ok) {
+    mClassInformations.unite(classInformations);
+  }
+}
+
+/*!
+ * \brief LibraryMetadataCache::save
+ * Writes the cache file of the library if any class information is added or invalidated since it was loaded or saved.
+ * The class information stays in memory until LibraryMetadataCache::unload is called.
+ * \param library
+ */
+void LibraryMetadataCache::save(const QString &library)
+{
+  if (!mLoadedLibraries.contains(library) || !mModifiedLibraries.remove(library)) {
+    return;
+  }
+  QString omcVersion = mLoadedLibraries.value(library);
+  QString prefix = library + ".";
+  QHash<QString, OMCInterface::getClassInformation_res> classInformations;
+  QHash<QString, OMCInterface::getClassInformation_res>::const_iterator it;
+  for (it = mClassInformations.constBegin() ; it != mClassInformations.constEnd() ; ++it) {
+    if (it.key().compare(library) == 0 || it.key().startsWith(prefix)) {
+      classInformations.insert(it.key(), it.value());
+    }
+  }
+  if (classInformations.isEmpty()) {
+    return;
+  }
+  QSet<QString> fileNames;
+  foreach (OMCInterface::getClassInformation_res classInformation, classInformations) {
+    if (!classInformation.fileName.isEmpty()) {
+      fileNames.insert(classInformation.fileName);
+    }
+  }
+  // write to a temporary file first so that a crash never leaves a partial cache file behind.
+  QString fileName = cacheFilePath(library);
+  QFile file(fileName + ".tmp");
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return;
+  }
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << (quint32)LIBRARYMETADATACACHE_MAGIC << (quint32)LIBRARYMETADATACACHE_VERSION << omcVersion << library;
+  out << (quint32)fileNames.size();
+  foreach (QString sourceFileName, fileNames) {
+    QPair<qint64, qint64> stamp = fileStamp(sourceFileName);
+    out << sourceFileName << stamp.first << stamp.second;
+  }
+  out << (quint32)classInformations.size();
+  QHash<QString, OMCInterface::getClassInformation_res>::const_iterator classInformationsIterator;
+  for (classInformationsIterator = classInformations.constBegin() ; classInformationsIterator != classInformations.constEnd() ; ++classInformationsIterator) {
+    out << classInformationsIterator.key();
+    writeClassInformation(out, classInformationsIterator.value());
+  }
+  file.close();
+  if (out.status() == QDataStream::Ok) {
+    QFile::remove(fileName);
+    file.rename(fileName);
+  } else {
+    file.remove();
+  }
+}
+
+/*!
+ * \brief LibraryMetadataCache::unload
+ * Releases the class information of the library from memory. The unsaved class information is lost.
+ * \param library
+ */
+void LibraryMetadataCache::unload(const QString &library)
+{
+  QString prefix = library + ".";
+  QHash<QString, OMCInterface::getClassInformation_res>::iterator it = mClassInformations.begin();
+  while (it != mClassInformations.end()) {
+    if (it.key().compare(library) == 0 || it.key().startsWith(prefix)) {
+      it = mClassInformations.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  mLoadedLibraries.remove(library);
+  mModifiedLibraries.remove(library);
+}
+
+/*!
+ * \brief LibraryMetadataCache::getClassInformation
+ * Returns the cached class information.
+ * \param className
+ * \param pClassInformation
+ * \return true if the class information is found.
+ */
+bool LibraryMetadataCache::getClassInformation(const QString &className, OMCInterface::getClassInformation_res *pClassInformation) const
+{
+  QHash<QString, OMCInterface::getClassInformation_res>::const_iterator it = mClassInformations.find(className);
+  if (it == mClassInformations.end()) {
+    return false;
+  }
+  *pClassInformation = it.value();
+  return true;
+}
+
+/*!
+ * \brief LibraryMetadataCache::insertClassInformation
+ * Adds the class information received from OMC. The library is saved again by LibraryMetadataCache::save.\n
+ * The class information is ignored if the library of the class is not loaded with LibraryMetadataCache::load.
+ * \param className
+ * \param classInformation
+ */
+void LibraryMetadataCache::insertClassInformation(const QString &className, const OMCInterface::getClassInformation_res &classInformation)
+{
+  QString library = libraryName(className);
+  if (mLoadedLibraries.contains(library)) {
+    mClassInformations.insert(className, classInformation);
+    mModifiedLibraries.insert(library);
+  }
+}
+
+/*!
+ * \brief LibraryMetadataCache::cacheFilePath
+ * Returns the path of the cache file of the library.
+ * \param library
+ * \return
+ */
+QString LibraryMetadataCache::cacheFilePath(const QString &library)
+{
+  QString fileName = library;
+  fileName.remove(QRegExp("[^A-Za-z0-9_]"));
+  return QString("%1%2.%3.libcache").arg(Utilities::cacheDirectory()).arg(fileName).arg(qHash(library));
+}
+
+/*!
+ * \brief LibraryMetadataCache::libraryName
+ * Returns the top level class name of className.
+ * \param className
+ * \return
+ */
+QString LibraryMetadataCache::libraryName(const QString &className)
+{
+  return StringHandler::getFirstWordBeforeDot(className);
+}
+
+/*!
+ * \brief LibraryMetadataCache::fileStamp
+ * Returns the modification time and size of the file. Both are -1 if the file doesn't exist.
+ * \param fileName
+ * \return
+ */
+QPair<qint64, qint64> LibraryMetadataCache::fileStamp(const QString &fileName)
+{
+  QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists()) {
+    return qMakePair((qint64)-1, (qint64)-1);
+  }
+  return qMakePair((qint64)fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size());
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef LIBRARYMETADATACACHE_H
+#define LIBRARYMETADATACACHE_H
+
+#include "OpenModelicaScriptingAPIQt.h"
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+
+/*!
+ * \class LibraryMetadataCache
+ * \brief Stores the class information of the system libraries on disk.
+ * Each library is saved in its own file in the cache directory together with the modification time and size of its source files.
+ * The class information is only reused if the file that defines the class is unchanged.
+ */
+class LibraryMetadataCache
+{
+public:
+  LibraryMetadataCache();
+  void load(const QString &library, const QString &omcVersion);
+  void save(const QString &library);
+  void unload(const QString &library);
+  bool isLoaded(const QString &library) const {return mLoadedLibraries.contains(library);}
+  QStringList getLoadedLibraries() const {return mLoadedLibraries.keys();}
+  bool getClassInformation(const QString &className, OMCInterface::getClassInformation_res *pClassInformation) const;
+  void insertClassInformation(const QString &className, const OMCInterface::getClassInformation_res &classInformation);
+private:
+  QHash<QString, OMCInterface::getClassInformation_res> mClassInformations;
+  // the OMC version of each loaded library.
+  QHash<QString, QString> mLoadedLibraries;
+  QSet<QString> mModifiedLibraries;
+
+  static QString cacheFilePath(const QString &library);
+  static QString libraryName(const QString &className);
+  static QPair<qint64, qint64> fileStamp(const QString &fileName);
+};
+
+#endif // LIBRARYMETADATACACHE_H
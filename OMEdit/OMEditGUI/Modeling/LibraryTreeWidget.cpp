@@ -46,6 +46,12 @@
 #include "Git/GitCommands.h"
 #include "Git/CommitChangesDialog.h"
 
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtConcurrent/QtConcurrent>
+#endif
+
+#include <algorithm>
+
 /*!
  * \class LibraryTreeItem
  * \brief Contains the information about the Modelica class.
@@ -57,6 +63,7 @@
 LibraryTreeItem::LibraryTreeItem()
 {
   mIsRootItem = true;
+  mIndexed = false;
   mpParentLibraryTreeItem = 0;
   setLibraryType(LibraryTreeItem::Modelica);
   setSystemLibrary(false);
@@ -74,6 +81,8 @@ LibraryTreeItem::LibraryTreeItem()
   setClassTextBefore("");
   setClassText("");
   setClassTextAfter("");
+  setClassTextOutOfDate(false);
+  setClassTextRegenerated(false);
   setExpanded(false);
   setNonExisting(true);
   setAccessAnnotations(false);
@@ -103,6 +112,7 @@ LibraryTreeItem::LibraryTreeItem(LibraryType type, QString text, QString nameStr
   : mComponentsLoaded(false), mLibraryType(type), mSystemLibrary(false), mpModelWidget(0)
 {
   mIsRootItem = false;
+  mIndexed = false;
   mpParentLibraryTreeItem = pParent;
   setPixmap(QPixmap());
   setDragPixmap(QPixmap());
@@ -120,6 +130,8 @@ LibraryTreeItem::LibraryTreeItem(LibraryType type, QString text, QString nameStr
   setClassTextBefore("");
   setClassText("");
   setClassTextAfter("");
+  setClassTextOutOfDate(false);
+  setClassTextRegenerated(false);
   setExpanded(false);
   setNonExisting(false);
   setAccessAnnotations(false);
@@ -144,6 +156,20 @@ LibraryTreeItem::~LibraryTreeItem()
   mChildren.clear();
 }
 
+/*!
+ * \brief LibraryTreeItem::setNameStructure
+ * Sets the name structure and updates the LibraryTreeModel name index.
+ * \param nameStructure
+ */
+void LibraryTreeItem::setNameStructure(QString nameStructure)
+{
+  QString oldNameStructure = mNameStructure;
+  mNameStructure = nameStructure;
+  if (mIndexed) {
+    MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->updateLibraryTreeItemIndex(this, oldNameStructure);
+  }
+}
+
 QString LibraryTreeItem::getWhereToMoveFMU()
 {
   QString nameTemplate = OptionsDialog::instance()->getFMIPage()->getMoveFMUTextBox()->text();
@@ -300,12 +326,17 @@ void LibraryTreeItem::setClassText(QString classText)
 
 /*!
  * \brief LibraryTreeItem::getClassText
- * Returns the class text. If the class text is empty then first read it.
+ * Returns the class text. If the class text is empty then first read it.\n
+ * If the text of the containing file is out of date then it is regenerated first,
+ * unless this class is the one whose text is already regenerated.
  * \param pLibraryTreeModel
  * \return
  */
 QString LibraryTreeItem::getClassText(LibraryTreeModel *pLibraryTreeModel)
 {
+  if (!mClassTextRegenerated) {
+    pLibraryTreeModel->updateOutOfDateClassText(this);
+  }
   if (mClassText.isEmpty()) {
     pLibraryTreeModel->readLibraryTreeItemClassText(this);
   }
@@ -574,6 +605,10 @@ int LibraryTreeItem::getNestedLevelInPackage() const
 void LibraryTreeItem::insertChild(int position, LibraryTreeItem *pLibraryTreeItem)
 {
   mChildren.insert(position, pLibraryTreeItem);
+  // only the items reachable from the root item are indexed.
+  if (mIsRootItem || mIndexed) {
+    MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->addLibraryTreeItemToIndex(pLibraryTreeItem);
+  }
 }
 
 /*!
@@ -728,6 +763,9 @@ void LibraryTreeItem::tryToComplete(QList<CompleterItem> &completionClasses, QLi
 void LibraryTreeItem::removeChild(LibraryTreeItem *pLibraryTreeItem)
 {
   mChildren.removeOne(pLibraryTreeItem);
+  if (pLibraryTreeItem->isIndexed()) {
+    MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->removeLibraryTreeItemFromIndex(pLibraryTreeItem);
+  }
 }
 
 /*!
@@ -1027,16 +1065,293 @@ void LibraryTreeItem::handleCoOrdinateSystemUpdated(GraphicsView *pGraphicsView)
  * \param pLibraryWidget
  */
 LibraryTreeProxyModel::LibraryTreeProxyModel(LibraryWidget *pLibraryWidget, bool showOnlyModelica)
-  : QSortFilterProxyModel(pLibraryWidget)
+  : QSortFilterProxyModel(pLibraryWidget), mMatchedLibraryTreeItemsCache(20)
 {
   mpLibraryWidget = pLibraryWidget;
   mShowOnlyModelica = showOnlyModelica;
+  mLibraryTreeItemsDirty = true;
+  mLibraryTreeItemsGeneration = 0;
+  mRunningGeneration = 0;
+  mHasQueuedRegExp = false;
+  connect(&mFilterWatcher, SIGNAL(finished()), SLOT(libraryTreeItemsMatched()));
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::setSourceModel
+ * Sets the source model and marks the cached matches as dirty whenever the source model structure changes.
+ * \param pSourceModel
+ */
+void LibraryTreeProxyModel::setSourceModel(QAbstractItemModel *pSourceModel)
+{
+  if (sourceModel()) {
+    disconnect(sourceModel(), 0, this, SLOT(markLibraryTreeItemsDirty()));
+  }
+  /* connect before QSortFilterProxyModel so that the new rows are never filtered against the old matches. */
+  connect(pSourceModel, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)), SLOT(markLibraryTreeItemsDirty()));
+  connect(pSourceModel, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), SLOT(markLibraryTreeItemsDirty()));
+  connect(pSourceModel, SIGNAL(modelAboutToBeReset()), SLOT(markLibraryTreeItemsDirty()));
+  connect(pSourceModel, SIGNAL(layoutAboutToBeChanged()), SLOT(markLibraryTreeItemsDirty()));
+  // renaming a class changes the names in the flat list without changing the model structure.
+  if (qobject_cast<LibraryTreeModel*>(pSourceModel)) {
+    connect(pSourceModel, SIGNAL(libraryTreeItemRenamed()), SLOT(markLibraryTreeItemsDirty()));
+  }
+  QSortFilterProxyModel::setSourceModel(pSourceModel);
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::filterLibraryTreeItems
+ * Matches the LibraryTreeItems against regExp on a worker thread and sets the filter once the matches are ready.\n
+ * The matches are cached per filter. If the new filter only narrows the previous one then only the previous matches are tested.
+ * \param regExp
+ */
+void LibraryTreeProxyModel::filterLibraryTreeItems(const QRegExp &regExp)
+{
+  if (mFilterWatcher.isRunning()) {
+    // only the latest filter is interesting.
+    mQueuedRegExp = regExp;
+    mHasQueuedRegExp = true;
+    return;
+  }
+  updateFilterableLibraryTreeItems();
+  QList<int> *pMatchedIndexes = mMatchedLibraryTreeItemsCache.object(filterKey(regExp));
+  if (pMatchedIndexes) {
+    setMatchedLibraryTreeItems(regExp, *pMatchedIndexes);
+    setFilterRegExp(regExp);
+    return;
+  }
+  QStringList names;
+  mRunningIndexes = candidateIndexes(regExp, &names);
+  mRunningRegExp = regExp;
+  mRunningGeneration = mLibraryTreeItemsGeneration;
+  mFilterWatcher.setFuture(QtConcurrent::run(&LibraryTreeProxyModel::matchLibraryTreeItems, names, regExp));
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::invalidateLibraryTreeItems
+ * Clears the cached matches and filters the LibraryTreeItems again. Used when the filter related settings are changed.
+ */
+void LibraryTreeProxyModel::invalidateLibraryTreeItems()
+{
+  markLibraryTreeItemsDirty();
+  invalidate();
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::updateFilterableLibraryTreeItems
+ * Collects the LibraryTreeItems that can match the filter in a single non-recursive pass.\n
+ * The subtrees that are always filtered out are skipped. The hidden and protected classes can't match themselves
+ * but are still shown if any of their nested classes match.\n
+ * The nested classes that are not created yet are matched by name and show their nearest created enclosing class.
+ */
+void LibraryTreeProxyModel::updateFilterableLibraryTreeItems() const
+{
+  if (!mLibraryTreeItemsDirty) {
+    return;
+  }
+  mLibraryTreeItemsDirty = false;
+  mLibraryTreeItemsGeneration++;
+  mFilterableLibraryTreeItems.clear();
+  mFilterableNames.clear();
+  mMatchedLibraryTreeItemsCache.clear();
+  mLastMatchedRegExp = QRegExp();
+  mLastMatchedIndexes.clear();
+  mAcceptedRegExp = QRegExp();
+  mAcceptedLibraryTreeItems.clear();
+  LibraryTreeModel *pLibraryTreeModel = qobject_cast<LibraryTreeModel*>(sourceModel());
+  if (!pLibraryTreeModel) {
+    return;
+  }
+  bool showHiddenClasses = OptionsDialog::instance()->getGeneralSettingsPage()->getShowHiddenClasses();
+  bool showProtectedClasses = OptionsDialog::instance()->getGeneralSettingsPage()->getShowProtectedClasses();
+  QList<LibraryTreeItem*> libraryTreeItems;
+  libraryTreeItems.append(pLibraryTreeModel->getRootLibraryTreeItem()->childrenItems());
+  while (!libraryTreeItems.isEmpty()) {
+    LibraryTreeItem *pLibraryTreeItem = libraryTreeItems.takeLast();
+    // if showOnlyModelica flag is enabled then filter out all other types of LibraryTreeItem e.g., CompositeModel & Text.
+    if (mShowOnlyModelica && pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
+      continue;
+    }
+    // filter the dummy tree item "All" created for search functionality to be at the top
+    if (pLibraryTreeItem->getLibraryType() == LibraryTreeItem::Text && pLibraryTreeItem->getNameStructure().compare("OMEdit.Search.Feature") == 0) {
+      continue;
+    }
+    libraryTreeItems.append(pLibraryTreeItem->childrenItems());
+    if (pLibraryTreeModel->hasPendingLibraryTreeItems(pLibraryTreeItem)) {
+      QStringList pendingNames = pLibraryTreeModel->getPendingLibraryTreeItems(pLibraryTreeItem->getNameStructure());
+      while (!pendingNames.isEmpty()) {
+        QString pendingName = pendingNames.takeLast();
+        pendingNames.append(pLibraryTreeModel->getPendingLibraryTreeItems(pendingName));
+        addFilterableLibraryTreeItem(pLibraryTreeItem, pendingName);
+      }
+    }
+    if ((pLibraryTreeItem->getAccess() == LibraryTreeItem::hide && !showHiddenClasses)
+        || (pLibraryTreeItem->isProtected() && !showProtectedClasses)) {
+      continue;
+    }
+    addFilterableLibraryTreeItem(pLibraryTreeItem, pLibraryTreeItem->getNameStructure());
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::addFilterableLibraryTreeItem
+ * Adds name to the flat list. pLibraryTreeItem is shown when name matches the filter.
+ * \param pLibraryTreeItem
+ * \param name
+ */
+void LibraryTreeProxyModel::addFilterableLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, const QString &name) const
+{
+  mFilterableLibraryTreeItems.append(pLibraryTreeItem);
+  mFilterableNames.append(name);
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::candidateIndexes
+ * Returns the indexes of the flat list that need to be tested against regExp.\n
+ * If regExp is a plain text that contains the previous plain text filter then only the previous matches can match.
+ * \param regExp
+ * \param pNames - the names at the returned indexes.
+ * \return
+ */
+QList<int> LibraryTreeProxyModel::candidateIndexes(const QRegExp &regExp, QStringList *pNames) const
+{
+  if (!mLastMatchedRegExp.isEmpty() && mLastMatchedRegExp.patternSyntax() == regExp.patternSyntax()
+      && mLastMatchedRegExp.caseSensitivity() == regExp.caseSensitivity()
+      && isPlainPattern(mLastMatchedRegExp) && isPlainPattern(regExp)
+      && regExp.pattern().contains(mLastMatchedRegExp.pattern(), regExp.caseSensitivity())) {
+    foreach (int index, mLastMatchedIndexes) {
+      pNames->append(mFilterableNames.at(index));
+    }
+    return mLastMatchedIndexes;
+  }
+  QList<int> indexes;
+  indexes.reserve(mFilterableNames.size());
+  for (int i = 0 ; i < mFilterableNames.size() ; i++) {
+    indexes.append(i);
+  }
+  *pNames = mFilterableNames;
+  return indexes;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::setMatchedLibraryTreeItems
+ * Caches the matched indexes of regExp and marks their LibraryTreeItems and parents as visible.
+ * \param regExp
+ * \param matchedIndexes
+ */
+void LibraryTreeProxyModel::setMatchedLibraryTreeItems(const QRegExp &regExp, const QList<int> &matchedIndexes) const
+{
+  mMatchedLibraryTreeItemsCache.insert(filterKey(regExp), new QList<int>(matchedIndexes));
+  mLastMatchedRegExp = regExp;
+  mLastMatchedIndexes = matchedIndexes;
+  mAcceptedRegExp = regExp;
+  mAcceptedLibraryTreeItems.clear();
+  // if any of children matches the filter, then the parent matches the filter as well
+  foreach (int index, matchedIndexes) {
+    LibraryTreeItem *pLibraryTreeItem = mFilterableLibraryTreeItems.at(index);
+    while (pLibraryTreeItem && !pLibraryTreeItem->isRootItem() && !mAcceptedLibraryTreeItems.contains(pLibraryTreeItem)) {
+      mAcceptedLibraryTreeItems.insert(pLibraryTreeItem);
+      pLibraryTreeItem = pLibraryTreeItem->parent();
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::filterKey
+ * Returns the key of regExp for the matches cache.
+ * \param regExp
+ * \return
+ */
+QString LibraryTreeProxyModel::filterKey(const QRegExp &regExp)
+{
+  return QString("%1|%2|%3").arg(regExp.patternSyntax()).arg(regExp.caseSensitivity()).arg(regExp.pattern());
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::isPlainPattern
+ * Returns true if the pattern of regExp has no special characters i.e., it matches like a plain substring.
+ * \param regExp
+ * \return
+ */
+bool LibraryTreeProxyModel::isPlainPattern(const QRegExp &regExp)
+{
+  QString specialCharacters;
+  switch (regExp.patternSyntax()) {
+    case QRegExp::FixedString:
+      return true;
+    case QRegExp::Wildcard:
+    case QRegExp::WildcardUnix:
+      specialCharacters = "*?[]\\";
+      break;
+    default:
+      specialCharacters = "\\^$.|?*+()[]{}";
+      break;
+  }
+  foreach (QChar character, regExp.pattern()) {
+    if (specialCharacters.contains(character)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::matchLibraryTreeItems
+ * Returns the indexes of names that contain regExp. Runs on a worker thread.
+ * \param names
+ * \param regExp
+ * \return
+ */
+QList<int> LibraryTreeProxyModel::matchLibraryTreeItems(const QStringList &names, const QRegExp &regExp)
+{
+  QList<int> matches;
+  for (int i = 0 ; i < names.size() ; i++) {
+    if (names.at(i).contains(regExp)) {
+      matches.append(i);
+    }
+  }
+  return matches;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::markLibraryTreeItemsDirty
+ * Slot activated when the structure of the source model is about to change.
+ */
+void LibraryTreeProxyModel::markLibraryTreeItemsDirty()
+{
+  mLibraryTreeItemsDirty = true;
+}
+
+/*!
+ * \brief LibraryTreeProxyModel::libraryTreeItemsMatched
+ * Slot activated when the worker thread has matched the LibraryTreeItems.
+ * Applies the filter unless the source model has changed meanwhile, in which case the filter is started again.
+ */
+void LibraryTreeProxyModel::libraryTreeItemsMatched()
+{
+  QRegExp regExp = mRunningRegExp;
+  if (mHasQueuedRegExp) {
+    mHasQueuedRegExp = false;
+    filterLibraryTreeItems(mQueuedRegExp);
+    return;
+  }
+  if (mLibraryTreeItemsDirty || mRunningGeneration != mLibraryTreeItemsGeneration) {
+    filterLibraryTreeItems(regExp);
+    return;
+  }
+  QList<int> matchedIndexes;
+  foreach (int index, mFilterWatcher.result()) {
+    matchedIndexes.append(mRunningIndexes.at(index));
+  }
+  mRunningIndexes.clear();
+  setMatchedLibraryTreeItems(regExp, matchedIndexes);
+  setFilterRegExp(regExp);
 }
 
 /*!
  * \brief LibraryTreeProxyModel::filterAcceptsRow
  * Filters the LibraryTreeItems based on the filter reguler expression.
- * Also checks if LibraryTreeItem is protected and show/hide it based on Show Protected Classes settings value.
+ * Also checks if LibraryTreeItem is protected and show/hide it based on Show Protected Classes settings value.\n
+ * The visible LibraryTreeItems are computed once per filter so this is only a lookup.
  * \param sourceRow
  * \param sourceParent
  * \return
@@ -1046,33 +1361,17 @@ bool LibraryTreeProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &s
   QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
   if (index.isValid()) {
     LibraryTreeItem *pLibraryTreeItem = static_cast<LibraryTreeItem*>(index.internalPointer());
-    // if showOnlyModelica flag is enabled then filter out all other types of LibraryTreeItem e.g., CompositeModel & Text.
-    if (mShowOnlyModelica && pLibraryTreeItem && pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
-      return false;
-    }
-    // filter the dummy tree item "All" created for search functionality to be at the top
-    if (pLibraryTreeItem->getNameStructure().compare("OMEdit.Search.Feature") == 0) {
-         return false;
-    }
-    // if any of children matches the filter, then current index matches the filter as well
-    int rows = sourceModel()->rowCount(index);
-    for (int i = 0 ; i < rows ; ++i) {
-      if (filterAcceptsRow(i, index)) {
-        return true;
-      }
-    }
-    // check current index itself
-    if (pLibraryTreeItem) {
-      if ((pLibraryTreeItem->getAccess() == LibraryTreeItem::hide
-           && !OptionsDialog::instance()->getGeneralSettingsPage()->getShowHiddenClasses())
-          || (pLibraryTreeItem->isProtected() && !OptionsDialog::instance()->getGeneralSettingsPage()->getShowProtectedClasses())) {
-        return false;
-      } else {
-        return pLibraryTreeItem->getNameStructure().contains(filterRegExp());
+    if (mLibraryTreeItemsDirty || mAcceptedRegExp != filterRegExp()) {
+      updateFilterableLibraryTreeItems();
+      QStringList names;
+      QList<int> indexes = candidateIndexes(filterRegExp(), &names);
+      QList<int> matchedIndexes;
+      foreach (int i, matchLibraryTreeItems(names, filterRegExp())) {
+        matchedIndexes.append(indexes.at(i));
       }
-    } else {
-      return sourceModel()->data(index).toString().contains(filterRegExp());
+      setMatchedLibraryTreeItems(filterRegExp(), matchedIndexes);
     }
+    return mAcceptedLibraryTreeItems.contains(pLibraryTreeItem);
   } else {
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
   }
@@ -1091,6 +1390,7 @@ LibraryTreeModel::LibraryTreeModel(LibraryWidget *pLibraryWidget)
 {
   mpLibraryWidget = pLibraryWidget;
   mpRootLibraryTreeItem = new LibraryTreeItem;
+  mpLibraryIconCache = new LibraryIconCache(this);
 }
 
 /*!
@@ -1127,6 +1427,54 @@ int LibraryTreeModel::rowCount(const QModelIndex &parent) const
   return pParentLibraryTreeItem->childrenSize();
 }
 
+/*!
+ * \brief LibraryTreeModel::hasChildren
+ * Returns true if parent has any children.
+ * The classes whose nested classes are not created yet also report children so that the view shows them as expandable.
+ * \param parent
+ * \return
+ */
+bool LibraryTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  LibraryTreeItem *pParentLibraryTreeItem;
+  if (parent.column() > 0) {
+    return false;
+  }
+
+  if (!parent.isValid()) {
+    pParentLibraryTreeItem = mpRootLibraryTreeItem;
+  } else {
+    pParentLibraryTreeItem = static_cast<LibraryTreeItem*>(parent.internalPointer());
+  }
+  return pParentLibraryTreeItem->childrenSize() > 0 || hasPendingLibraryTreeItems(pParentLibraryTreeItem);
+}
+
+/*!
+ * \brief LibraryTreeModel::canFetchMore
+ * Returns true if the nested classes of parent are not created yet.
+ * \param parent
+ * \return
+ */
+bool LibraryTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  if (!parent.isValid()) {
+    return false;
+  }
+  return hasPendingLibraryTreeItems(static_cast<LibraryTreeItem*>(parent.internalPointer()));
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchMore
+ * Creates the nested classes of parent.
+ * \param parent
+ */
+void LibraryTreeModel::fetchMore(const QModelIndex &parent)
+{
+  if (parent.isValid()) {
+    fetchPendingLibraryTreeItems(static_cast<LibraryTreeItem*>(parent.internalPointer()));
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::headerData
  * Returns the data for the given role and section in the header with the specified orientation.
@@ -1228,13 +1576,14 @@ Qt::ItemFlags LibraryTreeModel::flags(const QModelIndex &index) const
 
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
- * Finds the LibraryTreeItem based on the name and case sensitivity.
+ * Finds the LibraryTreeItem based on the name and case sensitivity.\n
+ * The items reachable from the root item are looked up in the name index. Other subtrees are searched recursively.
  * \param name
  * \param pLibraryTreeItem
  * \return
  */
 LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, LibraryTreeItem *pLibraryTreeItem,
-                                                       Qt::CaseSensitivity caseSensitivity) const
+                                                       Qt::CaseSensitivity caseSensitivity)
 {
   if (!pLibraryTreeItem) {
     pLibraryTreeItem = mpRootLibraryTreeItem;
@@ -1242,6 +1591,29 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, Libr
   if (pLibraryTreeItem->getNameStructure().compare(name, caseSensitivity) == 0) {
     return pLibraryTreeItem;
   }
+  if (pLibraryTreeItem->isRootItem() || pLibraryTreeItem->isIndexed()) {
+    QList<LibraryTreeItem*> libraryTreeItems;
+    if (caseSensitivity == Qt::CaseSensitive) {
+      libraryTreeItems = mLibraryTreeItemsIndex.values(name);
+    } else {
+      libraryTreeItems = mLibraryTreeItemsCaseInsensitiveIndex.values(name.toLower());
+    }
+    foreach (LibraryTreeItem *pIndexedLibraryTreeItem, libraryTreeItems) {
+      // make sure the item is in the subtree of pLibraryTreeItem.
+      LibraryTreeItem *pParentLibraryTreeItem = pIndexedLibraryTreeItem->parent();
+      while (pParentLibraryTreeItem && pParentLibraryTreeItem != pLibraryTreeItem) {
+        pParentLibraryTreeItem = pParentLibraryTreeItem->parent();
+      }
+      if (pParentLibraryTreeItem) {
+        return pIndexedLibraryTreeItem;
+      }
+    }
+    // the class might not be created yet if the library nested classes are created on demand.
+    if (caseSensitivity == Qt::CaseSensitive && loadPendingLibraryTreeItems(name)) {
+      return findLibraryTreeItem(name, pLibraryTreeItem, caseSensitivity);
+    }
+    return 0;
+  }
   for (int i = pLibraryTreeItem->childrenSize(); --i >= 0; ) {
     if (LibraryTreeItem *item = findLibraryTreeItem(name, pLibraryTreeItem->childAt(i), caseSensitivity)) {
       return item;
@@ -1250,6 +1622,255 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItem(const QString &name, Libr
   return 0;
 }
 
+/*!
+ * \brief LibraryTreeModel::addLibraryTreeItemToIndex
+ * Adds the LibraryTreeItem and its children to the name index.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::addLibraryTreeItemToIndex(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (!pLibraryTreeItem->isIndexed()) {
+    mLibraryTreeItemsIndex.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+    mLibraryTreeItemsCaseInsensitiveIndex.insert(pLibraryTreeItem->getNameStructure().toLower(), pLibraryTreeItem);
+    pLibraryTreeItem->setIndexed(true);
+  }
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    addLibraryTreeItemToIndex(pLibraryTreeItem->childAt(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removeLibraryTreeItemFromIndex
+ * Removes the LibraryTreeItem and its children from the name index.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::removeLibraryTreeItemFromIndex(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (pLibraryTreeItem->isIndexed()) {
+    mLibraryTreeItemsIndex.remove(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+    mLibraryTreeItemsCaseInsensitiveIndex.remove(pLibraryTreeItem->getNameStructure().toLower(), pLibraryTreeItem);
+    pLibraryTreeItem->setIndexed(false);
+  }
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    removeLibraryTreeItemFromIndex(pLibraryTreeItem->childAt(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::updateLibraryTreeItemIndex
+ * Moves the LibraryTreeItem to its new name in the name index and notifies the proxy models about the rename.
+ * \param pLibraryTreeItem
+ * \param oldNameStructure
+ */
+void LibraryTreeModel::updateLibraryTreeItemIndex(LibraryTreeItem *pLibraryTreeItem, const QString &oldNameStructure)
+{
+  mLibraryTreeItemsIndex.remove(oldNameStructure, pLibraryTreeItem);
+  mLibraryTreeItemsCaseInsensitiveIndex.remove(oldNameStructure.toLower(), pLibraryTreeItem);
+  mLibraryTreeItemsIndex.insert(pLibraryTreeItem->getNameStructure(), pLibraryTreeItem);
+  mLibraryTreeItemsCaseInsensitiveIndex.insert(pLibraryTreeItem->getNameStructure().toLower(), pLibraryTreeItem);
+  renamePendingLibraryTreeItems(oldNameStructure, pLibraryTreeItem->getNameStructure());
+  emit libraryTreeItemRenamed();
+}
+
+/*!
+ * \brief LibraryTreeModel::hasPendingLibraryTreeItems
+ * Returns true if the LibraryTreeItem has nested classes that are not created yet.
+ * \param pLibraryTreeItem
+ * \return
+ */
+bool LibraryTreeModel::hasPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem) const
+{
+  if (mPendingLibraryTreeItems.isEmpty() || pLibraryTreeItem->isRootItem()) {
+    return false;
+  }
+  return mPendingLibraryTreeItems.contains(pLibraryTreeItem->getNameStructure());
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchPendingLibraryTreeItems
+ * Creates the nested classes of the LibraryTreeItem that were deferred by createLibraryTreeItems.
+ * Only one level is created. The deeper levels stay pending until their parent is expanded or accessed by name.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::fetchPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (!hasPendingLibraryTreeItems(pLibraryTreeItem)) {
+    return;
+  }
+  QStringList libs = mPendingLibraryTreeItems.take(pLibraryTreeItem->getNameStructure());
+  // create the LibraryTreeItems first and then insert them all at once.
+  QList<LibraryTreeItem*> libraryTreeItems;
+  QList<LibraryTreeItem*> nonExistingLibraryTreeItems;
+  foreach (QString lib, libs) {
+    LibraryTreeItem *pChildLibraryTreeItem = findNonExistingLibraryTreeItem(lib);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->isNonExisting()) {
+      pChildLibraryTreeItem->setSystemLibrary(pLibraryTreeItem->isSystemLibrary());
+      pChildLibraryTreeItem->setAccessAnnotations(pLibraryTreeItem->isAccessAnnotationsEnabled());
+      initializeNonExistingLibraryTreeItem(pChildLibraryTreeItem, pLibraryTreeItem, pLibraryTreeItem->isSaved());
+      nonExistingLibraryTreeItems.append(pChildLibraryTreeItem);
+    } else {
+      pChildLibraryTreeItem = createModelicaLibraryTreeItem(StringHandler::getLastWordAfterDot(lib), lib, pLibraryTreeItem,
+                                                            pLibraryTreeItem->isSaved(), pLibraryTreeItem->isSystemLibrary(),
+                                                            pLibraryTreeItem->isAccessAnnotationsEnabled());
+    }
+    libraryTreeItems.append(pChildLibraryTreeItem);
+  }
+  int row = pLibraryTreeItem->childrenSize();
+  beginInsertRows(libraryTreeItemIndex(pLibraryTreeItem), row, row + libraryTreeItems.size() - 1);
+  foreach (LibraryTreeItem *pChildLibraryTreeItem, libraryTreeItems) {
+    pLibraryTreeItem->insertChild(pLibraryTreeItem->childrenSize(), pChildLibraryTreeItem);
+  }
+  endInsertRows();
+  foreach (LibraryTreeItem *pChildLibraryTreeItem, nonExistingLibraryTreeItems) {
+    pChildLibraryTreeItem->setNonExisting(false);
+    updateLibraryTreeItem(pChildLibraryTreeItem);
+  }
+  releaseLibraryMetadataCache(StringHandler::getFirstWordBeforeDot(pLibraryTreeItem->getNameStructure()));
+  // if the LibraryTreeItem is already expanded then LibraryTreeView::libraryTreeItemExpanded will not load the pixmaps of new items.
+  if (pLibraryTreeItem->isExpanded()) {
+    for (int i = row ; i < pLibraryTreeItem->childrenSize() ; i++) {
+      requestLibraryTreeItemPixmap(pLibraryTreeItem->child(i));
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchAllPendingLibraryTreeItems
+ * Creates all the pending nested classes of the LibraryTreeItem at every level.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::fetchAllPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (mPendingLibraryTreeItems.isEmpty()) {
+    return;
+  }
+  fetchPendingLibraryTreeItems(pLibraryTreeItem);
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    fetchAllPendingLibraryTreeItems(pLibraryTreeItem->child(i));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::loadPendingLibraryTreeItems
+ * Creates the pending enclosing classes of name level by level.
+ * \param name
+ * \return true if any LibraryTreeItem is created.
+ */
+bool LibraryTreeModel::loadPendingLibraryTreeItems(const QString &name)
+{
+  if (mPendingLibraryTreeItems.isEmpty()) {
+    return false;
+  }
+  // list of enclosing classes starting from the top level class.
+  QStringList names;
+  QString nameStructure = name;
+  forever {
+    names.prepend(nameStructure);
+    QString parentName = StringHandler::removeLastWordAfterDot(nameStructure);
+    if (parentName.compare(nameStructure) == 0) {
+      break;
+    }
+    nameStructure = parentName;
+  }
+  bool fetched = false;
+  for (int i = 0 ; i < names.size() - 1 ; i++) {
+    if (mPendingLibraryTreeItems.contains(names.at(i))) {
+      if (!mPendingLibraryTreeItems.value(names.at(i)).contains(names.at(i + 1))) {
+        break;
+      }
+      LibraryTreeItem *pLibraryTreeItem = mLibraryTreeItemsIndex.value(names.at(i), 0);
+      if (!pLibraryTreeItem) {
+        break;
+      }
+      fetchPendingLibraryTreeItems(pLibraryTreeItem);
+      fetched = true;
+    }
+  }
+  return fetched;
+}
+
+/*!
+ * \brief LibraryTreeModel::releaseLibraryMetadataCache
+ * Saves and releases the library metadata cache of the library once all its nested classes are created.
+ * \param library - the top level class name.
+ */
+void LibraryTreeModel::releaseLibraryMetadataCache(const QString &library)
+{
+  if (!mLibraryMetadataCache.isLoaded(library)) {
+    return;
+  }
+  QString prefix = library + ".";
+  QHash<QString, QStringList>::const_iterator it;
+  for (it = mPendingLibraryTreeItems.constBegin() ; it != mPendingLibraryTreeItems.constEnd() ; ++it) {
+    if (it.key().compare(library) == 0 || it.key().startsWith(prefix)) {
+      return;
+    }
+  }
+  mLibraryMetadataCache.save(library);
+  mLibraryMetadataCache.unload(library);
+}
+
+/*!
+ * \brief LibraryTreeModel::saveLibraryMetadataCache
+ * Saves the library metadata cache of the libraries that still have pending nested classes. Called when OMEdit is closed.
+ */
+void LibraryTreeModel::saveLibraryMetadataCache()
+{
+  foreach (QString library, mLibraryMetadataCache.getLoadedLibraries()) {
+    mLibraryMetadataCache.save(library);
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::removePendingLibraryTreeItems
+ * Removes the pending nested classes of nameStructure and of its nested classes.
+ * \param nameStructure
+ */
+void LibraryTreeModel::removePendingLibraryTreeItems(const QString &nameStructure)
+{
+  if (mPendingLibraryTreeItems.isEmpty()) {
+    return;
+  }
+  QString prefix = nameStructure + ".";
+  QHash<QString, QStringList>::iterator it = mPendingLibraryTreeItems.begin();
+  while (it != mPendingLibraryTreeItems.end()) {
+    if (it.key().compare(nameStructure) == 0 || it.key().startsWith(prefix)) {
+      it = mPendingLibraryTreeItems.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::renamePendingLibraryTreeItems
+ * Moves the pending nested classes of oldNameStructure to newNameStructure.
+ * \param oldNameStructure
+ * \param newNameStructure
+ */
+void LibraryTreeModel::renamePendingLibraryTreeItems(const QString &oldNameStructure, const QString &newNameStructure)
+{
+  if (mPendingLibraryTreeItems.isEmpty() || oldNameStructure.compare(newNameStructure) == 0) {
+    return;
+  }
+  QString prefix = oldNameStructure + ".";
+  QHash<QString, QStringList> renamedLibraryTreeItems;
+  QHash<QString, QStringList>::iterator it = mPendingLibraryTreeItems.begin();
+  while (it != mPendingLibraryTreeItems.end()) {
+    if (it.key().compare(oldNameStructure) == 0 || it.key().startsWith(prefix)) {
+      QStringList libs;
+      foreach (QString lib, it.value()) {
+        libs.append(newNameStructure + lib.mid(oldNameStructure.length()));
+      }
+      renamedLibraryTreeItems.insert(newNameStructure + it.key().mid(oldNameStructure.length()), libs);
+      it = mPendingLibraryTreeItems.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  mPendingLibraryTreeItems.unite(renamedLibraryTreeItems);
+}
+
 /*!
  * \brief LibraryTreeModel::findLibraryTreeItem
  * Finds the LibraryTreeItem based on the Regular Expression.
@@ -1368,6 +1989,11 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItem(QString name, LibraryTr
                                                          bool isSystemLibrary, bool load, int row, bool activateAccessAnnotations)
 {
   QString nameStructure = pParentLibraryTreeItem->getNameStructure().isEmpty() ? name : pParentLibraryTreeItem->getNameStructure() + "." + name;
+  // the class information of the system libraries is read from the library metadata cache.
+  bool useLibraryMetadataCache = isSystemLibrary && load && pParentLibraryTreeItem == mpRootLibraryTreeItem;
+  if (useLibraryMetadataCache) {
+    mLibraryMetadataCache.load(nameStructure, MainWindow::instance()->getOMCProxy()->getVersion());
+  }
   // check if is in non-existing classes.
   LibraryTreeItem *pLibraryTreeItem = findNonExistingLibraryTreeItem(nameStructure);
   if (pLibraryTreeItem && pLibraryTreeItem->isNonExisting()) {
@@ -1381,6 +2007,11 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItem(QString name, LibraryTr
     pLibraryTreeItem = createLibraryTreeItemImpl(name, pParentLibraryTreeItem, isSaved, isSystemLibrary, load, row, activateAccessAnnotations);
     endInsertRows();
   }
+  if (useLibraryMetadataCache) {
+    // the cache stays loaded for the nested classes that are created on demand.
+    mLibraryMetadataCache.save(nameStructure);
+    releaseLibraryMetadataCache(nameStructure);
+  }
   return pLibraryTreeItem;
 }
 
@@ -1520,7 +2151,11 @@ void LibraryTreeModel::updateLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
 /*!
  * \brief LibraryTreeModel::updateLibraryTreeItemClassText
  * Updates the class text of LibraryTreeItem
- * Uses OMCProxy::listFile() and OMCProxy::diffModelicaFileListings() to get the correct Modelica Text.
+ * Uses OMCProxy::listFile() and OMCProxy::diffModelicaFileListings() to get the correct Modelica Text.\n
+ * If the class is nested in a package saved in one file then only the text of the class is regenerated.
+ * If the class is nested in an already regenerated class then the top-most such class is regenerated instead
+ * since the text of the nested class is part of it.
+ * The text of the file is marked out of date and regenerated by LibraryTreeModel::updateOutOfDateClassText() when it is needed.
  * \param pLibraryTreeItem
  * \sa OMCProxy::listFile()
  * \sa OMCProxy::diffModelicaFileListings()
@@ -1542,20 +2177,28 @@ void LibraryTreeModel::updateLibraryTreeItemClassText(LibraryTreeItem *pLibraryT
     // we also mark the containing parent class unsaved because it is very important for saving of single file packages.
     pParentLibraryTreeItem->setIsSaved(false);
     updateLibraryTreeItem(pParentLibraryTreeItem);
-    OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
-    QString before = pParentLibraryTreeItem->getClassText(this);
-    QString after = pOMCProxy->listFile(pParentLibraryTreeItem->getNameStructure());
-    QString contents = pOMCProxy->diffModelicaFileListings(before, after);
-    pParentLibraryTreeItem->setClassText(contents);
     if (pParentLibraryTreeItem->getModelWidget()) {
       pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
     }
-    // if we first updated the parent class then the child classes needs to be updated as well.
-    if (pParentLibraryTreeItem != pLibraryTreeItem) {
-      pOMCProxy->loadString(pParentLibraryTreeItem->getClassText(this), pParentLibraryTreeItem->getFileName(), Helper::utf8,
-                            pParentLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure, false);
-      updateChildLibraryTreeItemClassText(pParentLibraryTreeItem, contents, pParentLibraryTreeItem->getFileName());
-      pParentLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pParentLibraryTreeItem->getNameStructure()));
+    LibraryTreeItem *pRegeneratedLibraryTreeItem = pLibraryTreeItem;
+    for (LibraryTreeItem *pAncestorLibraryTreeItem = pLibraryTreeItem->parent() ;
+         pAncestorLibraryTreeItem && pAncestorLibraryTreeItem != pParentLibraryTreeItem ;
+         pAncestorLibraryTreeItem = pAncestorLibraryTreeItem->parent()) {
+      if (pAncestorLibraryTreeItem->isClassTextRegenerated()) {
+        pRegeneratedLibraryTreeItem = pAncestorLibraryTreeItem;
+      }
+    }
+    if (pParentLibraryTreeItem != pLibraryTreeItem && regenerateLibraryTreeItemClassText(pRegeneratedLibraryTreeItem)) {
+      // the classes nested in the regenerated class are part of its text now.
+      QList<LibraryTreeItem*> nestedLibraryTreeItems;
+      takeRegeneratedLibraryTreeItems(pRegeneratedLibraryTreeItem, pParentLibraryTreeItem->getFileName(), true, &nestedLibraryTreeItems);
+      pParentLibraryTreeItem->setClassTextOutOfDate(true);
+      // the text of the file is shown so regenerate it right away.
+      if (isClassTextVisible(pLibraryTreeItem->parent(), pParentLibraryTreeItem)) {
+        updateOutOfDateClassText(pParentLibraryTreeItem);
+      }
+    } else {
+      regenerateContainingFileClassText(pParentLibraryTreeItem, true, pParentLibraryTreeItem != pLibraryTreeItem);
     }
   } else if (pLibraryTreeItem->getLibraryType() == LibraryTreeItem::OMS) {
     updateOMSLibraryTreeItemClassText(pLibraryTreeItem);
@@ -1579,6 +2222,10 @@ void LibraryTreeModel::updateLibraryTreeItemClassTextManually(LibraryTreeItem *p
   pParentLibraryTreeItem->setIsSaved(false);
   updateLibraryTreeItem(pParentLibraryTreeItem);
   OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  // the contents are the whole file so the regenerated classes are part of it.
+  pParentLibraryTreeItem->setClassTextOutOfDate(false);
+  QList<LibraryTreeItem*> regeneratedLibraryTreeItems;
+  takeRegeneratedLibraryTreeItems(pParentLibraryTreeItem, pParentLibraryTreeItem->getFileName(), false, &regeneratedLibraryTreeItems);
   pParentLibraryTreeItem->setClassText(contents);
   if (pParentLibraryTreeItem->getModelWidget()) {
     pParentLibraryTreeItem->getModelWidget()->setWindowTitle(QString(pParentLibraryTreeItem->getName()).append("*"));
@@ -1613,6 +2260,23 @@ void LibraryTreeModel::updateChildLibraryTreeItemClassText(LibraryTreeItem *pLib
   }
 }
 
+/*!
+ * \brief LibraryTreeModel::updateOutOfDateClassText
+ * Regenerates the text of the file containing the LibraryTreeItem if it is out of date.\n
+ * Called before the text of the file is used, e.g., when it is saved or shown in the text view.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::updateOutOfDateClassText(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (pLibraryTreeItem->isRootItem() || pLibraryTreeItem->getLibraryType() != LibraryTreeItem::Modelica) {
+    return;
+  }
+  LibraryTreeItem *pParentLibraryTreeItem = getContainingFileParentLibraryTreeItem(pLibraryTreeItem);
+  if (pParentLibraryTreeItem && pParentLibraryTreeItem->isClassTextOutOfDate()) {
+    regenerateContainingFileClassText(pParentLibraryTreeItem, false, false);
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::readLibraryTreeItemClassText
  * Reads the LibraryTreeItem class text from file/OMC.
@@ -1686,6 +2350,7 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
   if (!pLibraryTreeItem->getModelWidget()) {
     showModelWidget(pLibraryTreeItem, false);
   }
+  int libraryIconSize = OptionsDialog::instance()->getGeneralSettingsPage()->getLibraryIconSizeSpinBox()->value();
   GraphicsView *pGraphicsView = pLibraryTreeItem->getModelWidget()->getIconGraphicsView();
   if (pGraphicsView && pGraphicsView->hasAnnotation()) {
     qreal left = pGraphicsView->mCoOrdinateSystem.getExtent().at(0).x();
@@ -1701,18 +2366,17 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
     rectangle.setY(rectangle.y() - adjust);
     rectangle.setWidth(rectangle.width() + adjust);
     rectangle.setHeight(rectangle.height() + adjust);
-    int libraryIconSize = OptionsDialog::instance()->getGeneralSettingsPage()->getLibraryIconSizeSpinBox()->value();
-    QPixmap libraryPixmap(QSize(libraryIconSize, libraryIconSize));
-    libraryPixmap.fill(QColor(Qt::transparent));
-    QPainter libraryPainter(&libraryPixmap);
+    QImage libraryImage(QSize(libraryIconSize, libraryIconSize), QImage::Format_ARGB32_Premultiplied);
+    libraryImage.fill(Qt::transparent);
+    QPainter libraryPainter(&libraryImage);
     libraryPainter.setRenderHint(QPainter::Antialiasing);
     libraryPainter.setRenderHint(QPainter::SmoothPixmapTransform);
     libraryPainter.setWindow(rectangle.toRect());
     libraryPainter.scale(1.0, -1.0);
     // drag pixmap
-    QPixmap dragPixmap(QSize(50, 50));
-    dragPixmap.fill(QColor(Qt::transparent));
-    QPainter dragPainter(&dragPixmap);
+    QImage dragImage(QSize(50, 50), QImage::Format_ARGB32_Premultiplied);
+    dragImage.fill(Qt::transparent);
+    QPainter dragPainter(&dragImage);
     dragPainter.setRenderHint(QPainter::Antialiasing);
     dragPainter.setRenderHint(QPainter::SmoothPixmapTransform);
     dragPainter.setWindow(rectangle.toRect());
@@ -1725,11 +2389,27 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
     pGraphicsView->setRenderingLibraryPixmap(false);
     libraryPainter.end();
     dragPainter.end();
-    pLibraryTreeItem->setPixmap(libraryPixmap);
-    pLibraryTreeItem->setDragPixmap(dragPixmap);
+    pLibraryTreeItem->setPixmap(QPixmap::fromImage(libraryImage));
+    pLibraryTreeItem->setDragPixmap(QPixmap::fromImage(dragImage));
+    mpLibraryIconCache->saveIcon(pLibraryTreeItem, libraryIconSize, libraryImage, dragImage);
   } else {
     pLibraryTreeItem->setPixmap(QPixmap());
     pLibraryTreeItem->setDragPixmap(QPixmap());
+    mpLibraryIconCache->saveIcon(pLibraryTreeItem, libraryIconSize, QImage(), QImage());
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::requestLibraryTreeItemPixmap
+ * Loads the pixmap for LibraryTreeItem from the LibraryIconCache in the background.
+ * If the icon is not cached then it is rendered with LibraryTreeModel::loadLibraryTreeItemPixmap.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::requestLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem)
+{
+  int libraryIconSize = OptionsDialog::instance()->getGeneralSettingsPage()->getLibraryIconSizeSpinBox()->value();
+  if (!mpLibraryIconCache->loadIcon(pLibraryTreeItem, libraryIconSize)) {
+    loadLibraryTreeItemPixmap(pLibraryTreeItem);
   }
 }
 
@@ -1813,7 +2493,7 @@ void LibraryTreeModel::showModelWidget(LibraryTreeItem *pLibraryTreeItem, bool s
 void LibraryTreeModel::showHideProtectedClasses()
 {
   /* invalidate the view so that the items show the updated values. */
-  mpLibraryWidget->getLibraryTreeProxyModel()->invalidate();
+  mpLibraryWidget->getLibraryTreeProxyModel()->invalidateLibraryTreeItems();
 }
 
 /*!
@@ -2060,6 +2740,8 @@ bool LibraryTreeModel::unloadLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem,
       unloadClassChildren(pLibraryTreeItem->child(i));
       i = 0;  //Restart iteration
     }
+    removePendingLibraryTreeItems(pLibraryTreeItem->getNameStructure());
+    releaseLibraryMetadataCache(pLibraryTreeItem->getNameStructure());
     // make the class non existing
     pLibraryTreeItem->setNonExisting(true);
     pLibraryTreeItem->setClassText("");
@@ -2418,15 +3100,156 @@ void LibraryTreeModel::updateOMSLibraryTreeItemClassText(LibraryTreeItem *pLibra
 }
 
 /*!
- * \brief LibraryTreeModel::readLibraryTreeItemClassTextFromText
- * Reads the contents of the Modelica class nested in another class.
+ * \brief LibraryTreeModel::regenerateLibraryTreeItemClassText
+ * Regenerates the text of a class nested in a package saved in one file from its OMC listing.\n
+ * The listing is indented like the class in the file and merged with the current text of the class.
+ * \param pLibraryTreeItem
+ * \return false if the class text is not read yet and the text of the whole file needs to be regenerated.
+ */
+bool LibraryTreeModel::regenerateLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem)
+{
+  // the class text is read and the class starts on its own line.
+  if (!pLibraryTreeItem->getClassTextBefore().endsWith("\n")) {
+    return false;
+  }
+  // the class is regenerated again so it doesn't need the file text.
+  bool regenerated = pLibraryTreeItem->isClassTextRegenerated();
+  pLibraryTreeItem->setClassTextRegenerated(true);
+  QString before = pLibraryTreeItem->getClassText(this);
+  pLibraryTreeItem->setClassTextRegenerated(regenerated);
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  QString listing = pOMCProxy->list(pLibraryTreeItem->getNameStructure());
+  if (listing.isEmpty()) {
+    return false;
+  }
+  // indent the listing like the class in the file.
+  QString indentation = before.left(TabSettings::firstNonSpace(before));
+  QStringList lines = listing.split("\n");
+  for (int i = 0 ; i < lines.size() ; i++) {
+    if (!lines.at(i).isEmpty()) {
+      lines[i].prepend(indentation);
+    }
+  }
+  QString after = lines.join("\n");
+  pLibraryTreeItem->setClassText(pOMCProxy->diffModelicaFileListings(before, after));
+  pLibraryTreeItem->setClassTextRegenerated(true);
+  return true;
+}
+
+/*!
+ * \brief LibraryTreeModel::isClassTextVisible
+ * Returns true if the text view of the LibraryTreeItem or any of its parents up to pParentLibraryTreeItem is visible.
+ * \param pLibraryTreeItem
+ * \param pParentLibraryTreeItem
+ * \return
+ */
+bool LibraryTreeModel::isClassTextVisible(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem)
+{
+  while (pLibraryTreeItem && !pLibraryTreeItem->isRootItem()) {
+    if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getEditor()
+        && pLibraryTreeItem->getModelWidget()->getEditor()->isVisible()) {
+      return true;
+    }
+    if (pLibraryTreeItem == pParentLibraryTreeItem) {
+      break;
+    }
+    pLibraryTreeItem = pLibraryTreeItem->parent();
+  }
+  return false;
+}
+
+/*!
+ * \brief libraryTreeItemLineNumberGreaterThan
+ * Sorts the LibraryTreeItems by their start line in descending order.
+ * \param pLibraryTreeItem1
+ * \param pLibraryTreeItem2
+ * \return
+ */
+static bool libraryTreeItemLineNumberGreaterThan(LibraryTreeItem *pLibraryTreeItem1, LibraryTreeItem *pLibraryTreeItem2)
+{
+  return pLibraryTreeItem1->mClassInformation.lineNumberStart > pLibraryTreeItem2->mClassInformation.lineNumberStart;
+}
+
+/*!
+ * \brief LibraryTreeModel::regenerateContainingFileClassText
+ * Regenerates the text of a file and the text of the classes saved in it.\n
+ * If listFile is false and the preserve text indentation option is enabled then the regenerated classes are spliced into the file text.
+ * Otherwise the whole file is listed and merged with OMCProxy::diffModelicaFileListings().
+ * If reloadFile is true or any class is spliced then the file text is loaded in OMC so that OMC and OMEdit have same line numbers.
+ * \param pParentLibraryTreeItem - the class containing the file.
+ * \param listFile
+ * \param reloadFile
+ */
+void LibraryTreeModel::regenerateContainingFileClassText(LibraryTreeItem *pParentLibraryTreeItem, bool listFile, bool reloadFile)
+{
+  pParentLibraryTreeItem->setClassTextOutOfDate(false);
+  QList<LibraryTreeItem*> regeneratedLibraryTreeItems;
+  takeRegeneratedLibraryTreeItems(pParentLibraryTreeItem, pParentLibraryTreeItem->getFileName(), false, &regeneratedLibraryTreeItems);
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  QString contents = pParentLibraryTreeItem->getClassText(this);
+  if (listFile || !OptionsDialog::instance()->getModelicaEditorPage()->getPreserveTextIndentationCheckBox()->isChecked()) {
+    contents = pOMCProxy->diffModelicaFileListings(contents, pOMCProxy->listFile(pParentLibraryTreeItem->getNameStructure()));
+  } else {
+    // splice the classes from the end of the file so the line numbers of the classes before them stay valid.
+    std::sort(regeneratedLibraryTreeItems.begin(), regeneratedLibraryTreeItems.end(), libraryTreeItemLineNumberGreaterThan);
+    foreach (LibraryTreeItem *pLibraryTreeItem, regeneratedLibraryTreeItems) {
+      QString before, text, after;
+      splitClassText(pLibraryTreeItem, contents, &before, &text, &after);
+      contents = before + StringHandler::trimmedEnd(pLibraryTreeItem->getClassText(this)) + "\n" + after;
+    }
+  }
+  pParentLibraryTreeItem->setClassText(contents);
+  // if we first updated the parent class then the child classes needs to be updated as well.
+  if (reloadFile || !regeneratedLibraryTreeItems.isEmpty()) {
+    pOMCProxy->loadString(contents, pParentLibraryTreeItem->getFileName(), Helper::utf8,
+                          pParentLibraryTreeItem->getSaveContentsType() == LibraryTreeItem::SaveFolderStructure, false);
+    updateChildLibraryTreeItemClassText(pParentLibraryTreeItem, contents, pParentLibraryTreeItem->getFileName());
+    pParentLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pParentLibraryTreeItem->getNameStructure()));
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::takeRegeneratedLibraryTreeItems
+ * Collects the regenerated classes saved in the file and clears their regenerated flag.\n
+ * The classes nested in a regenerated class are not collected since they are part of its text.
+ * \param pLibraryTreeItem
+ * \param fileName
+ * \param nested - true if pLibraryTreeItem is nested in a regenerated class.
+ * \param pLibraryTreeItems
+ */
+void LibraryTreeModel::takeRegeneratedLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem, const QString &fileName, bool nested,
+                                                       QList<LibraryTreeItem*> *pLibraryTreeItems)
+{
+  for (int i = 0 ; i < pLibraryTreeItem->childrenSize() ; i++) {
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
+    if (pChildLibraryTreeItem && pChildLibraryTreeItem->getFileName().compare(fileName) == 0) {
+      bool regenerated = pChildLibraryTreeItem->isClassTextRegenerated();
+      if (regenerated) {
+        pChildLibraryTreeItem->setClassTextRegenerated(false);
+        if (!nested) {
+          pLibraryTreeItems->append(pChildLibraryTreeItem);
+        }
+      }
+      takeRegeneratedLibraryTreeItems(pChildLibraryTreeItem, fileName, nested || regenerated, pLibraryTreeItems);
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::splitClassText
+ * Splits the contents of the file into the text before the class, the class text and the text after the class.
  * \param pLibraryTreeItem
  * \param contents
+ * \param pBefore
+ * \param pText
+ * \param pAfter
  */
-void LibraryTreeModel::readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents)
+void LibraryTreeModel::splitClassText(LibraryTreeItem *pLibraryTreeItem, const QString &contents, QString *pBefore, QString *pText,
+                                      QString *pAfter)
 {
   QString before, text, after;
-  QTextStream textStream(&contents);
+  QString fileContents = contents;
+  QTextStream textStream(&fileContents);
   int lineNumber = 1;
   while (!textStream.atEnd()) {
     QString currentLine = textStream.readLine();
@@ -2471,6 +3294,21 @@ void LibraryTreeModel::readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLi
     }
     lineNumber++;
   }
+  *pBefore = before;
+  *pText = text;
+  *pAfter = after;
+}
+
+/*!
+ * \brief LibraryTreeModel::readLibraryTreeItemClassTextFromText
+ * Reads the contents of the Modelica class nested in another class.
+ * \param pLibraryTreeItem
+ * \param contents
+ */
+void LibraryTreeModel::readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents)
+{
+  QString before, text, after;
+  splitClassText(pLibraryTreeItem, contents, &before, &text, &after);
   pLibraryTreeItem->setClassTextBefore(before);
   pLibraryTreeItem->setClassText(text);
   pLibraryTreeItem->setClassTextAfter(after);
@@ -2507,7 +3345,9 @@ QString LibraryTreeModel::readLibraryTreeItemClassTextFromFile(LibraryTreeItem *
 
 /*!
  * \brief LibraryTreeModel::createLibraryTreeItems
- * Creates all the nested Library items.
+ * Creates all the nested Library items.\n
+ * For system libraries only the number of levels set in OptionsDialog are created. The deeper levels are kept as pending and are created on demand.
+ * The user libraries are always created completely since saving them needs all their nested classes.
  * \param pLibraryTreeItem
  */
 void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
@@ -2518,6 +3358,13 @@ void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
     if (!libs.isEmpty()) {
       libs.removeFirst();
     }
+    removePendingLibraryTreeItems(pLibraryTreeItem->getNameStructure());
+    int prefetchLevels = 0;
+    if (pLibraryTreeItem->isSystemLibrary()) {
+      prefetchLevels = OptionsDialog::instance()->getGeneralSettingsPage()->getLibraryPrefetchLevelsSpinBox()->value();
+    }
+    QHash<QString, int> levels;
+    levels.insert(pLibraryTreeItem->getNameStructure(), 0);
     LibraryTreeItem *pParentLibraryTreeItem = 0;
     foreach (QString lib, libs) {
       /* $Code is a special OpenModelica keyword. No API command will work if we use it. */
@@ -2526,6 +3373,14 @@ void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
       }
       QString name = StringHandler::getLastWordAfterDot(lib);
       QString parentName = StringHandler::removeLastWordAfterDot(lib);
+      if (prefetchLevels > 0) {
+        int level = levels.value(parentName, 0) + 1;
+        levels.insert(lib, level);
+        if (level > prefetchLevels) {
+          mPendingLibraryTreeItems[parentName].append(lib);
+          continue;
+        }
+      }
       if (!(pParentLibraryTreeItem && pParentLibraryTreeItem->getNameStructure().compare(parentName) == 0)) {
         pParentLibraryTreeItem = findLibraryTreeItem(parentName, pLibraryTreeItem);
       }
@@ -2603,15 +3458,12 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(QString name, Libra
       // create library tree items
       createLibraryTreeItems(pLibraryTreeItem);
       // load the LibraryTreeItem pixmap
-      loadLibraryTreeItemPixmap(pLibraryTreeItem);
+      requestLibraryTreeItemPixmap(pLibraryTreeItem);
     }
     updateLibraryTreeItem(pLibraryTreeItem);
   } else {
-    OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
-    OMCInterface::getClassInformation_res classInformation = pOMCProxy->getClassInformation(nameStructure);
-    pLibraryTreeItem = new LibraryTreeItem(LibraryTreeItem::Modelica, name, nameStructure, classInformation, "", isSaved, pParentLibraryTreeItem);
-    pLibraryTreeItem->setSystemLibrary(pParentLibraryTreeItem == mpRootLibraryTreeItem ? isSystemLibrary : pParentLibraryTreeItem->isSystemLibrary());
-    pLibraryTreeItem->setAccessAnnotations(activateAccessAnnotations);
+    bool systemLibrary = pParentLibraryTreeItem == mpRootLibraryTreeItem ? isSystemLibrary : pParentLibraryTreeItem->isSystemLibrary();
+    pLibraryTreeItem = createModelicaLibraryTreeItem(name, nameStructure, pParentLibraryTreeItem, isSaved, systemLibrary, activateAccessAnnotations);
     if (row == -1) {
       row = pParentLibraryTreeItem->childrenSize();
     }
@@ -2620,21 +3472,51 @@ LibraryTreeItem* LibraryTreeModel::createLibraryTreeItemImpl(QString name, Libra
       // create library tree items
       createLibraryTreeItems(pLibraryTreeItem);
       // load the LibraryTreeItem pixmap
-      loadLibraryTreeItemPixmap(pLibraryTreeItem);
+      requestLibraryTreeItemPixmap(pLibraryTreeItem);
     }
   }
   return pLibraryTreeItem;
 }
 
 /*!
- * \brief LibraryTreeModel::createNonExistingLibraryTreeItem
+ * \brief LibraryTreeModel::createModelicaLibraryTreeItem
+ * Creates a Modelica LibraryTreeItem without inserting it in its parent.
+ * The class information of the system libraries is read from the library metadata cache.
+ * \param name
+ * \param nameStructure
+ * \param pParentLibraryTreeItem
+ * \param isSaved
+ * \param systemLibrary
+ * \param activateAccessAnnotations
+ * \return
+ */
+LibraryTreeItem* LibraryTreeModel::createModelicaLibraryTreeItem(QString name, QString nameStructure, LibraryTreeItem *pParentLibraryTreeItem,
+                                                                 bool isSaved, bool systemLibrary, bool activateAccessAnnotations)
+{
+  OMCInterface::getClassInformation_res classInformation;
+  if (!(systemLibrary && mLibraryMetadataCache.getClassInformation(nameStructure, &classInformation))) {
+    OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+    classInformation = pOMCProxy->getClassInformation(nameStructure);
+    if (systemLibrary) {
+      mLibraryMetadataCache.insertClassInformation(nameStructure, classInformation);
+    }
+  }
+  LibraryTreeItem *pLibraryTreeItem = new LibraryTreeItem(LibraryTreeItem::Modelica, name, nameStructure, classInformation, "", isSaved,
+                                                          pParentLibraryTreeItem);
+  pLibraryTreeItem->setSystemLibrary(systemLibrary);
+  pLibraryTreeItem->setAccessAnnotations(activateAccessAnnotations);
+  return pLibraryTreeItem;
+}
+
+/*!
+ * \brief LibraryTreeModel::initializeNonExistingLibraryTreeItem
+ * Reads the class information of the non-existing LibraryTreeItem without inserting it in its parent.
  * \param pLibraryTreeItem
  * \param pParentLibraryTreeItem
  * \param isSaved
- * \param row
  */
-void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem,
-                                                        bool isSaved, int row)
+void LibraryTreeModel::initializeNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem,
+                                                            bool isSaved)
 {
   pLibraryTreeItem->setParent(pParentLibraryTreeItem);
   OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
@@ -2642,6 +3524,19 @@ void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibrar
   pLibraryTreeItem->setSaveContentsType(LibraryTreeItem::SaveInOneFile);
   pLibraryTreeItem->setClassInformation(pOMCProxy->getClassInformation(pLibraryTreeItem->getNameStructure()));
   pLibraryTreeItem->setIsSaved(isSaved);
+}
+
+/*!
+ * \brief LibraryTreeModel::createNonExistingLibraryTreeItem
+ * \param pLibraryTreeItem
+ * \param pParentLibraryTreeItem
+ * \param isSaved
+ * \param row
+ */
+void LibraryTreeModel::createNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem,
+                                                        bool isSaved, int row)
+{
+  initializeNonExistingLibraryTreeItem(pLibraryTreeItem, pParentLibraryTreeItem, isSaved);
   if (row == -1) {
     row = pParentLibraryTreeItem->childrenSize();
   }
@@ -2831,6 +3726,7 @@ void LibraryTreeModel::unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, Libr
   pLibraryTreeItem->removeInheritedClasses();
   // notify the inherits classes
   pLibraryTreeItem->emitUnLoaded();
+  removePendingLibraryTreeItems(pLibraryTreeItem->getNameStructure());
   addNonExistingLibraryTreeItem(pLibraryTreeItem);
   pParentLibraryTreeItem->removeChild(pLibraryTreeItem);
 }
@@ -3198,6 +4094,8 @@ LibraryTreeItem* LibraryTreeView::getSelectedLibraryTreeItem()
  */
 void LibraryTreeView::libraryTreeItemExpanded(LibraryTreeItem *pLibraryTreeItem)
 {
+  // create the nested classes if they are not created yet.
+  mpLibraryWidget->getLibraryTreeModel()->fetchPendingLibraryTreeItems(pLibraryTreeItem);
   if (!pLibraryTreeItem->isExpanded()) {
     // set the range for progress bar.
     int progressValue = 0;
@@ -3207,7 +4105,7 @@ void LibraryTreeView::libraryTreeItemExpanded(LibraryTreeItem *pLibraryTreeItem)
     for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
       LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
       MainWindow::instance()->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(pChildLibraryTreeItem->getNameStructure()));
-      mpLibraryWidget->getLibraryTreeModel()->loadLibraryTreeItemPixmap(pChildLibraryTreeItem);
+      mpLibraryWidget->getLibraryTreeModel()->requestLibraryTreeItemPixmap(pChildLibraryTreeItem);
       MainWindow::instance()->getStatusBar()->clearMessage();
       MainWindow::instance()->getProgressBar()->setValue(++progressValue);
     }
@@ -4089,8 +4987,10 @@ LibraryWidget::LibraryWidget(QWidget *pParent)
   // tree search filters
   mpTreeSearchFilters = new TreeSearchFilters(this);
   mpTreeSearchFilters->getFilterTextBox()->setPlaceholderText(Helper::filterClasses);
+  mpTreeSearchFilters->getFilterTimer()->setInterval(250);
   connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(returnPressed()), SLOT(searchClasses()));
-  connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(textEdited(QString)), SLOT(searchClasses()));
+  connect(mpTreeSearchFilters->getFilterTextBox(), SIGNAL(textEdited(QString)), mpTreeSearchFilters->getFilterTimer(), SLOT(start()));
+  connect(mpTreeSearchFilters->getFilterTimer(), SIGNAL(timeout()), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getCaseSensitiveCheckBox(), SIGNAL(toggled(bool)), SLOT(searchClasses()));
   connect(mpTreeSearchFilters->getSyntaxComboBox(), SIGNAL(currentIndexChanged(int)), SLOT(searchClasses()));
   mpTreeSearchFilters->getExpandAllButton()->hide();
@@ -4842,6 +5742,8 @@ bool LibraryWidget::saveModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibrary
   if (pLibraryTreeItem->getModelWidget() && !pLibraryTreeItem->getModelWidget()->validateText(&pLibraryTreeItem)) {
     return false;
   }
+  // bring the file text up to date with the graphical changes made to its nested classes
+  mpLibraryTreeModel->updateOutOfDateClassText(pLibraryTreeItem);
   // save the class
   QString contents;
   if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getEditor()) {
@@ -4877,6 +5779,7 @@ bool LibraryWidget::saveModelicaLibraryTreeItemOneFile(LibraryTreeItem *pLibrary
  */
 void LibraryWidget::saveChildLibraryTreeItemsOneFile(LibraryTreeItem *pLibraryTreeItem)
 {
+  mpLibraryTreeModel->fetchAllPendingLibraryTreeItems(pLibraryTreeItem);
   for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
     LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
     saveChildLibraryTreeItemsOneFileHelper(pChildLibraryTreeItem);
@@ -4910,6 +5813,8 @@ void LibraryWidget::saveChildLibraryTreeItemsOneFileHelper(LibraryTreeItem *pLib
  */
 bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryTreeItem)
 {
+  // the nested classes that are not created yet would be treated as deleted i.e., left out of package.order and their files renamed.
+  mpLibraryTreeModel->fetchAllPendingLibraryTreeItems(pLibraryTreeItem);
   if (!pLibraryTreeItem->isSaved()) {
     MainWindow::instance()->getStatusBar()->showMessage(tr("Saving %1").arg(pLibraryTreeItem->getNameStructure()));
     QString directoryName;
@@ -4941,6 +5846,8 @@ bool LibraryWidget::saveModelicaLibraryTreeItemFolder(LibraryTreeItem *pLibraryT
     if (!QDir().exists(directoryName)) {
       QDir().mkpath(directoryName);
     }
+    // bring the file text up to date with the graphical changes made to its nested classes
+    mpLibraryTreeModel->updateOutOfDateClassText(pLibraryTreeItem);
     // save the class
     QString contents;
     if (pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getEditor()) {
@@ -5246,5 +6153,6 @@ void LibraryWidget::searchClasses()
   QRegExp::PatternSyntax syntax = QRegExp::PatternSyntax(mpTreeSearchFilters->getSyntaxComboBox()->itemData(mpTreeSearchFilters->getSyntaxComboBox()->currentIndex()).toInt());
   Qt::CaseSensitivity caseSensitivity = mpTreeSearchFilters->getCaseSensitiveCheckBox()->isChecked() ? Qt::CaseSensitive: Qt::CaseInsensitive;
   QRegExp regExp(searchText, caseSensitivity, syntax);
-  mpLibraryTreeProxyModel->setFilterRegExp(regExp);
+  mpTreeSearchFilters->getFilterTimer()->stop();
+  mpLibraryTreeProxyModel->filterLibraryTreeItems(regExp);
 }
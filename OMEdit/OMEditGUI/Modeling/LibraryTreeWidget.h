@@ -40,9 +40,13 @@
 #include "Simulation/SimulationOptions.h"
 #include "OMS/OMSProxy.h"
 #include "OMS/OMSSimulationOptions.h"
+#include "Modeling/LibraryMetadataCache.h"
+#include "Modeling/LibraryIconCache.h"
 
 #include <QTreeView>
 #include <QSortFilterProxyModel>
+#include <QFutureWatcher>
+#include <QCache>
 
 class CompleterItem;
 class GraphicsView;
@@ -81,6 +85,8 @@ public:
                   QString fileName, bool isSaved, LibraryTreeItem *pParent = 0);
   ~LibraryTreeItem();
   bool isRootItem() const {return mIsRootItem;}
+  void setIndexed(bool indexed) {mIndexed = indexed;}
+  bool isIndexed() const {return mIndexed;}
   int childrenSize() const {return mChildren.size();}
   LibraryTreeItem* childAt(int index) const {return mChildren.at(index);}
   QList<LibraryTreeItem*> childrenItems() {return mChildren;}
@@ -88,11 +94,12 @@ public:
   void setLibraryType(LibraryType libraryType) {mLibraryType = libraryType;}
   void setSystemLibrary(bool systemLibrary) {mSystemLibrary = systemLibrary;}
   bool isSystemLibrary() {return mSystemLibrary;}
+  QString getVersion() const {return mClassInformation.version;}
   void setModelWidget(ModelWidget *pModelWidget);
   ModelWidget* getModelWidget() {return mpModelWidget;}
   void setName(QString name) {mName = name;}
   const QString& getName() const {return mName;}
-  void setNameStructure(QString nameStructure) {mNameStructure = nameStructure;}
+  void setNameStructure(QString nameStructure);
   const QString& getNameStructure() {return mNameStructure;}
   QString getWhereToMoveFMU();
   void setClassInformation(OMCInterface::getClassInformation_res classInformation);
@@ -122,6 +129,10 @@ public:
   QString getClassText(LibraryTreeModel *pLibraryTreeModel);
   void setClassTextAfter(QString classTextAfter) {mClassTextAfter = classTextAfter;}
   QString getClassTextAfter() {return mClassTextAfter;}
+  void setClassTextOutOfDate(bool outOfDate) {mClassTextOutOfDate = outOfDate;}
+  bool isClassTextOutOfDate() const {return mClassTextOutOfDate;}
+  void setClassTextRegenerated(bool regenerated) {mClassTextRegenerated = regenerated;}
+  bool isClassTextRegenerated() const {return mClassTextRegenerated;}
   void setExpanded(bool expanded) {mExpanded = expanded;}
   bool isExpanded() const {return mExpanded;}
   void setNonExisting(bool nonExisting) {mNonExisting = nonExisting;}
@@ -193,6 +204,7 @@ public:
   OMSSimulationOptions mOMSSimulationOptions;
 private:
   bool mIsRootItem;
+  bool mIndexed;
   LibraryTreeItem *mpParentLibraryTreeItem;
   QList<LibraryTreeItem*> mChildren;
   QList<LibraryTreeItem*> mInheritedClasses;
@@ -214,6 +226,8 @@ private:
   QString mClassTextBefore;
   QString mClassText;
   QString mClassTextAfter;
+  bool mClassTextOutOfDate;
+  bool mClassTextRegenerated;
   bool mExpanded;
   bool mNonExisting;
   bool mAccessAnnotations;
@@ -255,9 +269,41 @@ class LibraryTreeProxyModel : public QSortFilterProxyModel
   Q_OBJECT
 public:
   LibraryTreeProxyModel(LibraryWidget *pLibraryWidget, bool showOnlyModelica);
+  void setSourceModel(QAbstractItemModel *pSourceModel);
+  void filterLibraryTreeItems(const QRegExp &regExp);
+  void invalidateLibraryTreeItems();
 private:
   LibraryWidget *mpLibraryWidget;
   bool mShowOnlyModelica;
+  // flat list of the names that can match the filter and the LibraryTreeItems that are shown when they match.
+  mutable bool mLibraryTreeItemsDirty;
+  mutable int mLibraryTreeItemsGeneration;
+  mutable QList<LibraryTreeItem*> mFilterableLibraryTreeItems;
+  mutable QStringList mFilterableNames;
+  // matched indexes of the flat list per filter and the visible LibraryTreeItems of the current filter.
+  mutable QCache<QString, QList<int> > mMatchedLibraryTreeItemsCache;
+  mutable QRegExp mLastMatchedRegExp;
+  mutable QList<int> mLastMatchedIndexes;
+  mutable QRegExp mAcceptedRegExp;
+  mutable QSet<LibraryTreeItem*> mAcceptedLibraryTreeItems;
+  // filter running on the worker thread.
+  QFutureWatcher<QList<int> > mFilterWatcher;
+  QRegExp mRunningRegExp;
+  QList<int> mRunningIndexes;
+  int mRunningGeneration;
+  QRegExp mQueuedRegExp;
+  bool mHasQueuedRegExp;
+
+  void updateFilterableLibraryTreeItems() const;
+  void addFilterableLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, const QString &name) const;
+  QList<int> candidateIndexes(const QRegExp &regExp, QStringList *pNames) const;
+  void setMatchedLibraryTreeItems(const QRegExp &regExp, const QList<int> &matchedIndexes) const;
+  static QString filterKey(const QRegExp &regExp);
+  static bool isPlainPattern(const QRegExp &regExp);
+  static QList<int> matchLibraryTreeItems(const QStringList &names, const QRegExp &regExp);
+private slots:
+  void markLibraryTreeItemsDirty();
+  void libraryTreeItemsMatched();
 protected:
   virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
 };
@@ -270,17 +316,28 @@ public:
   LibraryTreeItem* getRootLibraryTreeItem() {return mpRootLibraryTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const;
   int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+  bool canFetchMore(const QModelIndex &parent) const;
+  void fetchMore(const QModelIndex &parent);
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
   QModelIndex parent(const QModelIndex & index) const;
   QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
   Qt::ItemFlags flags(const QModelIndex &index) const;
   LibraryTreeItem* findLibraryTreeItem(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0,
-                                       Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
+                                       Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
   LibraryTreeItem* findLibraryTreeItem(const QRegExp &regExp, LibraryTreeItem *pLibraryTreeItem = 0) const;
   LibraryTreeItem* findLibraryTreeItemOneLevel(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0,
                                                Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
   LibraryTreeItem* findNonExistingLibraryTreeItem(const QString &name, Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
+  void addLibraryTreeItemToIndex(LibraryTreeItem *pLibraryTreeItem);
+  void removeLibraryTreeItemFromIndex(LibraryTreeItem *pLibraryTreeItem);
+  void updateLibraryTreeItemIndex(LibraryTreeItem *pLibraryTreeItem, const QString &oldNameStructure);
+  bool hasPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem) const;
+  QStringList getPendingLibraryTreeItems(const QString &nameStructure) const {return mPendingLibraryTreeItems.value(nameStructure);}
+  void fetchPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
+  void fetchAllPendingLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
+  void saveLibraryMetadataCache();
   QModelIndex libraryTreeItemIndex(const LibraryTreeItem *pLibraryTreeItem) const;
   void addModelicaLibraries();
   LibraryTreeItem* createLibraryTreeItem(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
@@ -300,9 +357,11 @@ public:
   void updateLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
   void updateLibraryTreeItemClassTextManually(LibraryTreeItem *pLibraryTreeItem, QString contents);
   void updateChildLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem, QString contents, QString fileName);
+  void updateOutOfDateClassText(LibraryTreeItem *pLibraryTreeItem);
   void readLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
   LibraryTreeItem* getContainingFileParentLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem);
+  void requestLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem);
   void loadDependentLibraries(QStringList libraries);
   LibraryTreeItem* getLibraryTreeItemFromFile(QString fileName, int lineNumber);
   void showModelWidget(LibraryTreeItem *pLibraryTreeItem, bool show = true, StringHandler::ViewType viewType = StringHandler::NoView);
@@ -323,10 +382,25 @@ private:
   LibraryWidget *mpLibraryWidget;
   LibraryTreeItem *mpRootLibraryTreeItem;
   QList<LibraryTreeItem*> mNonExistingLibraryTreeItemsList;
+  QMultiHash<QString, LibraryTreeItem*> mLibraryTreeItemsIndex;
+  QMultiHash<QString, LibraryTreeItem*> mLibraryTreeItemsCaseInsensitiveIndex;
+  QHash<QString, QStringList> mPendingLibraryTreeItems;
+  LibraryMetadataCache mLibraryMetadataCache;
+  LibraryIconCache *mpLibraryIconCache;
+  bool loadPendingLibraryTreeItems(const QString &name);
+  void removePendingLibraryTreeItems(const QString &nameStructure);
+  void releaseLibraryMetadataCache(const QString &library);
+  void renamePendingLibraryTreeItems(const QString &oldNameStructure, const QString &newNameStructure);
   QModelIndex libraryTreeItemIndexHelper(const LibraryTreeItem *pLibraryTreeItem, const LibraryTreeItem *pParentLibraryTreeItem,
                                          const QModelIndex &parentIndex) const;
   LibraryTreeItem* getLibraryTreeItemFromFileHelper(LibraryTreeItem *pLibraryTreeItem, QString fileName, int lineNumber);
   void updateOMSLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
+  bool regenerateLibraryTreeItemClassText(LibraryTreeItem *pLibraryTreeItem);
+  bool isClassTextVisible(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem);
+  void regenerateContainingFileClassText(LibraryTreeItem *pParentLibraryTreeItem, bool listFile, bool reloadFile);
+  void takeRegeneratedLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem, const QString &fileName, bool nested,
+                                       QList<LibraryTreeItem*> *pLibraryTreeItems);
+  void splitClassText(LibraryTreeItem *pLibraryTreeItem, const QString &contents, QString *pBefore, QString *pText, QString *pAfter);
   void readLibraryTreeItemClassTextFromText(LibraryTreeItem *pLibraryTreeItem, QString contents);
   QString readLibraryTreeItemClassTextFromFile(LibraryTreeItem *pLibraryTreeItem);
 public:
@@ -335,6 +409,9 @@ public:
 private:
   LibraryTreeItem* createLibraryTreeItemImpl(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
                                              bool isSystemLibrary = false, bool load = false, int row = -1, bool activateAccessAnnotations = false);
+  LibraryTreeItem* createModelicaLibraryTreeItem(QString name, QString nameStructure, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved,
+                                                 bool systemLibrary, bool activateAccessAnnotations);
+  void initializeNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved);
   void createNonExistingLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
                                         int row = -1);
   void createLibraryTreeItemsImpl(QFileInfo fileInfo, LibraryTreeItem *pParentLibraryTreeItem);
@@ -357,6 +434,8 @@ private:
   void deleteFileChildren(LibraryTreeItem *pLibraryTreeItem);
 protected:
   Qt::DropActions supportedDropActions() const;
+signals:
+  void libraryTreeItemRenamed();
 };
 
 class LibraryTreeView : public QTreeView
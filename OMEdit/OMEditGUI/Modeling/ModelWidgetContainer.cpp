@@ -84,7 +84,7 @@ GraphicsScene::GraphicsScene(StringHandler::ViewType viewType, ModelWidget *pMod
  * \param animationView
  */
 GraphicsView::GraphicsView(StringHandler::ViewType viewType, ModelWidget *parent, bool visualizationView)
-  : QGraphicsView(parent), mViewType(viewType), mVisualizationView(visualizationView), mSkipBackground(false)
+  : QGraphicsView(parent), mViewType(viewType), mVisualizationView(visualizationView), mSkipBackground(false), mComponentsHashValid(false)
 {
   /* Ticket #3275
    * Set the scroll bars policy to always on to avoid unnecessary resize events.
@@ -537,21 +537,42 @@ void GraphicsView::deleteComponentFromClass(Component *pComponent)
 
 /*!
  * \brief GraphicsView::getComponentObject
- * Finds the Component
+ * Finds the Component.\n
+ * The components are looked up in mComponentsHash which is rebuilt when components are added or removed.
+ * Components can be renamed without going through GraphicsView so a hit is verified and a miss falls back to the lists.
  * \param componentName
  * \return
  */
 Component* GraphicsView::getComponentObject(QString componentName)
 {
+  if (!mComponentsHashValid) {
+    mComponentsHash.clear();
+    mComponentsHash.reserve(mComponentsList.size() + mInheritedComponentsList.size());
+    foreach (Component *pComponent, mComponentsList) {
+      mComponentsHash.insert(pComponent->getName(), pComponent);
+    }
+    // inherited components take precedence
+    foreach (Component *pInheritedComponent, mInheritedComponentsList) {
+      mComponentsHash.insert(pInheritedComponent->getName(), pInheritedComponent);
+    }
+    mComponentsHashValid = true;
+  }
+  Component *pComponent = mComponentsHash.value(componentName, 0);
+  if (pComponent && pComponent->getName().compare(componentName) == 0) {
+    return pComponent;
+  }
   // look in inherited components
   foreach (Component *pInheritedComponent, mInheritedComponentsList) {
     if (pInheritedComponent->getName().compare(componentName) == 0) {
+      // a component is renamed so rebuild the hash on next lookup.
+      mComponentsHashValid = false;
       return pInheritedComponent;
     }
   }
   // look in components
   foreach (Component *pComponent, mComponentsList) {
     if (pComponent->getName().compare(componentName) == 0) {
+      mComponentsHashValid = false;
       return pComponent;
     }
   }
@@ -679,6 +700,46 @@ void GraphicsView::updateConnectionInClass(LineAnnotation *pConnectionLineAnnota
   }
 }
 
+/*!
+ * \brief GraphicsView::addConnectionsToView
+ * Adds the connections of a class being loaded to the view in one go.\n
+ * Does the same as AddConnectionCommand without pushing a command for each connection on the undo stack.
+ * The scene index is switched off while the connections are added and rebuilt once afterwards.
+ * \param connections
+ */
+void GraphicsView::addConnectionsToView(const QList<LineAnnotation*> &connections)
+{
+  if (connections.isEmpty()) {
+    return;
+  }
+  QGraphicsScene::ItemIndexMethod itemIndexMethod = scene()->itemIndexMethod();
+  scene()->setItemIndexMethod(QGraphicsScene::NoIndex);
+  mConnectionsList.reserve(mConnectionsList.size() + connections.size());
+  foreach (LineAnnotation *pConnectionLineAnnotation, connections) {
+    pConnectionLineAnnotation->updateToolTip();
+    pConnectionLineAnnotation->drawCornerItems();
+    pConnectionLineAnnotation->setCornerItemsActiveOrPassive();
+    // Add the start component connection details.
+    Component *pStartComponent = pConnectionLineAnnotation->getStartComponent();
+    if (pStartComponent->getRootParentComponent()) {
+      pStartComponent->getRootParentComponent()->addConnectionDetails(pConnectionLineAnnotation);
+    } else {
+      pStartComponent->addConnectionDetails(pConnectionLineAnnotation);
+    }
+    // Add the end component connection details.
+    Component *pEndComponent = pConnectionLineAnnotation->getEndComponent();
+    if (pEndComponent->getRootParentComponent()) {
+      pEndComponent->getRootParentComponent()->addConnectionDetails(pConnectionLineAnnotation);
+    } else {
+      pEndComponent->addConnectionDetails(pConnectionLineAnnotation);
+    }
+    addConnectionToList(pConnectionLineAnnotation);
+    addItem(pConnectionLineAnnotation);
+    pConnectionLineAnnotation->emitAdded();
+  }
+  scene()->setItemIndexMethod(itemIndexMethod);
+}
+
 /*!
  * \brief GraphicsView::removeConnectionsFromView
  * Removes the connections from the view.
@@ -1188,7 +1249,7 @@ bool GraphicsView::hasAnnotation()
  */
 void GraphicsView::addItem(QGraphicsItem *pGraphicsItem)
 {
-  if (!scene()->items().contains(pGraphicsItem)) {
+  if (pGraphicsItem->scene() != scene()) {
     scene()->addItem(pGraphicsItem);
   }
 }
@@ -1200,7 +1261,7 @@ void GraphicsView::addItem(QGraphicsItem *pGraphicsItem)
  */
 void GraphicsView::removeItem(QGraphicsItem *pGraphicsItem)
 {
-  if (scene()->items().contains(pGraphicsItem)) {
+  if (pGraphicsItem->scene() == scene()) {
     scene()->removeItem(pGraphicsItem);
   }
 }
@@ -3551,10 +3612,13 @@ void ModelWidget::getModelConnections()
   // get the connections
   MainWindow *pMainWindow = MainWindow::instance();
   LibraryTreeModel *pLibraryTreeModel = pMainWindow->getLibraryWidget()->getLibraryTreeModel();
-  int connectionCount = pMainWindow->getOMCProxy()->getConnectionCount(mpLibraryTreeItem->getNameStructure());
-  for (int i = 1 ; i <= connectionCount ; i++) {
-    // get the connection from OMC
-    QStringList connectionList = pMainWindow->getOMCProxy()->getNthConnection(mpLibraryTreeItem->getNameStructure(), i);
+  QList<QList<QString> > connections;
+  QStringList connectionsAnnotations;
+  pMainWindow->getOMCProxy()->getConnections(mpLibraryTreeItem->getNameStructure(), &connections, &connectionsAnnotations);
+  QList<LineAnnotation*> connectionLineAnnotations;
+  connectionLineAnnotations.reserve(connections.size());
+  for (int i = 0 ; i < connections.size() ; i++) {
+    QStringList connectionList = connections.at(i);
     QString connectionString = QString("{%1}").arg(connectionList.join(","));
     // if the connectionString only contains two items then continue the loop,
     // because connection is not valid then
@@ -3641,15 +3705,12 @@ void ModelWidget::getModelConnections()
                                                             Helper::scriptingKind, Helper::errorLevel));
       continue;
     }
-    // get the connector annotations from OMC
-    QString connectionAnnotationString = pMainWindow->getOMCProxy()->getNthConnectionAnnotation(mpLibraryTreeItem->getNameStructure(), i);
-    QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(connectionAnnotationString), '(', ')');
+    AnnotationNode shapesList = AnnotationNode::parse(connectionsAnnotations.at(i)).at(0);
     // Now parse the shapes available in list
     QString lineShape = "";
-    foreach (QString shape, shapesList) {
-      if (shape.startsWith("Line")) {
-        lineShape = shape.mid(QString("Line").length());
-        lineShape = StringHandler::removeFirstLastParentheses(lineShape);
+    for (int j = 0 ; j < shapesList.size() ; j++) {
+      if (shapesList.at(j).isRecord() && shapesList.at(j).getName().compare("Line") == 0) {
+        lineShape = shapesList.at(j).internArguments();
         break;  // break the loop once we have got the line annotation.
       }
     }
@@ -3657,8 +3718,10 @@ void ModelWidget::getModelConnections()
     pConnectionLineAnnotation = new LineAnnotation(lineShape, pStartConnectorComponent, pEndConnectorComponent, mpDiagramGraphicsView);
     pConnectionLineAnnotation->setStartComponentName(connectionList.at(0));
     pConnectionLineAnnotation->setEndComponentName(connectionList.at(1));
-    mpUndoStack->push(new AddConnectionCommand(pConnectionLineAnnotation, false));
+    connectionLineAnnotations.append(pConnectionLineAnnotation);
   }
+  // loading the connections is not an undoable change so add them directly to the view.
+  mpDiagramGraphicsView->addConnectionsToView(connectionLineAnnotations);
 }
 
 /*!
@@ -4156,6 +4219,8 @@ bool ModelWidget::modelicaEditorTextChanged(LibraryTreeItem **pLibraryTreeItem)
   LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->getContainingFileParentLibraryTreeItem(mpLibraryTreeItem);
   removeDynamicResults(); // show static values during editing
   if (pParentLibraryTreeItem != mpLibraryTreeItem) {
+    // the text before and after this class must include the pending graphical changes of the other classes in the file
+    pLibraryTreeModel->updateOutOfDateClassText(mpLibraryTreeItem);
     stringToLoad = mpLibraryTreeItem->getClassTextBefore() + StringHandler::trimmedEnd(modelicaText) + "\n" + mpLibraryTreeItem->getClassTextAfter();
   } else {
     stringToLoad = modelicaText;
@@ -5325,29 +5390,25 @@ void ModelWidget::getModelIconDiagramShapes(StringHandler::ViewType viewType)
       annotationString = pOMCProxy->getDiagramAnnotation(mpLibraryTreeItem->getNameStructure());
     }
   }
-  annotationString = StringHandler::removeFirstLastCurlBrackets(annotationString);
-  if (annotationString.isEmpty()) {
-    drawBaseCoOrdinateSystem(this, pGraphicsView);
-    return;
-  }
-  QStringList list = StringHandler::getStrings(annotationString);
+  // the annotation is parsed once and the shapes are created from the parsed values.
+  AnnotationNode list = AnnotationNode::parse(annotationString).at(0);
   // read the coordinate system
   if (list.size() < 8) {
     drawBaseCoOrdinateSystem(this, pGraphicsView);
     return;
   }
 
-  qreal left = qMin(list.at(0).toFloat(), list.at(2).toFloat());
-  qreal bottom = qMin(list.at(1).toFloat(), list.at(3).toFloat());
-  qreal right = qMax(list.at(0).toFloat(), list.at(2).toFloat());
-  qreal top = qMax(list.at(1).toFloat(), list.at(3).toFloat());
+  qreal left = qMin(list.at(0).toReal(), list.at(2).toReal());
+  qreal bottom = qMin(list.at(1).toReal(), list.at(3).toReal());
+  qreal right = qMax(list.at(0).toReal(), list.at(2).toReal());
+  qreal top = qMax(list.at(1).toReal(), list.at(3).toReal());
   QList<QPointF> extent;
   extent << QPointF(left, bottom) << QPointF(right, top);
   pGraphicsView->mCoOrdinateSystem.setExtent(extent);
-  pGraphicsView->mCoOrdinateSystem.setPreserveAspectRatio((list.at(4).compare("true") == 0) ? true : false);
-  pGraphicsView->mCoOrdinateSystem.setInitialScale(list.at(5).toFloat());
-  qreal horizontal = list.at(6).toFloat();
-  qreal vertical = list.at(7).toFloat();
+  pGraphicsView->mCoOrdinateSystem.setPreserveAspectRatio((list.at(4).getSource().compare("true") == 0) ? true : false);
+  pGraphicsView->mCoOrdinateSystem.setInitialScale(list.at(5).toReal());
+  qreal horizontal = list.at(6).toReal();
+  qreal vertical = list.at(7).toReal();
   pGraphicsView->mCoOrdinateSystem.setGrid(QPointF(horizontal, vertical));
   pGraphicsView->mCoOrdinateSystem.setValid(true);
   pGraphicsView->setExtentRectangle(left, bottom, right, top);
@@ -5355,58 +5416,52 @@ void ModelWidget::getModelIconDiagramShapes(StringHandler::ViewType viewType)
   // read the shapes
   if (list.size() < 9)
     return;
-  QStringList shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(list.at(8)), '(', ')');
   // Now parse the shapes available in list
-  foreach (QString shape, shapesList) {
-    if (shape.startsWith("Line")) {
-      shape = shape.mid(QString("Line").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
+  for (int i = 0 ; i < list.at(8).size() ; i++) {
+    const AnnotationNode &shapeNode = list.at(8).at(i);
+    if (!shapeNode.isRecord()) {
+      continue;
+    }
+    // the shapes get the already parsed arguments from the cache.
+    QString shapeName = shapeNode.getName();
+    QString shape = shapeNode.internArguments();
+    if (shapeName.compare("Line") == 0) {
       LineAnnotation *pLineAnnotation = new LineAnnotation(shape, pGraphicsView);
       pLineAnnotation->initializeTransformation();
       pLineAnnotation->drawCornerItems();
       pLineAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pLineAnnotation);
       pGraphicsView->addItem(pLineAnnotation);
-    } else if (shape.startsWith("Polygon")) {
-      shape = shape.mid(QString("Polygon").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
+    } else if (shapeName.compare("Polygon") == 0) {
       PolygonAnnotation *pPolygonAnnotation = new PolygonAnnotation(shape, pGraphicsView);
       pPolygonAnnotation->initializeTransformation();
       pPolygonAnnotation->drawCornerItems();
       pPolygonAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pPolygonAnnotation);
       pGraphicsView->addItem(pPolygonAnnotation);
-    } else if (shape.startsWith("Rectangle")) {
-      shape = shape.mid(QString("Rectangle").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
+    } else if (shapeName.compare("Rectangle") == 0) {
       RectangleAnnotation *pRectangleAnnotation = new RectangleAnnotation(shape, pGraphicsView);
       pRectangleAnnotation->initializeTransformation();
       pRectangleAnnotation->drawCornerItems();
       pRectangleAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pRectangleAnnotation);
       pGraphicsView->addItem(pRectangleAnnotation);
-    } else if (shape.startsWith("Ellipse")) {
-      shape = shape.mid(QString("Ellipse").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
+    } else if (shapeName.compare("Ellipse") == 0) {
       EllipseAnnotation *pEllipseAnnotation = new EllipseAnnotation(shape, pGraphicsView);
       pEllipseAnnotation->initializeTransformation();
       pEllipseAnnotation->drawCornerItems();
       pEllipseAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pEllipseAnnotation);
       pGraphicsView->addItem(pEllipseAnnotation);
-    } else if (shape.startsWith("Text")) {
-      shape = shape.mid(QString("Text").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
+    } else if (shapeName.compare("Text") == 0) {
       TextAnnotation *pTextAnnotation = new TextAnnotation(shape, pGraphicsView);
       pTextAnnotation->initializeTransformation();
       pTextAnnotation->drawCornerItems();
       pTextAnnotation->setCornerItemsActiveOrPassive();
       pGraphicsView->addShapeToList(pTextAnnotation);
       pGraphicsView->addItem(pTextAnnotation);
-    } else if (shape.startsWith("Bitmap")) {
+    } else if (shapeName.compare("Bitmap") == 0) {
       /* create the bitmap shape */
-      shape = shape.mid(QString("Bitmap").length());
-      shape = StringHandler::removeFirstLastParentheses(shape);
       BitmapAnnotation *pBitmapAnnotation = new BitmapAnnotation(mpLibraryTreeItem->mClassInformation.fileName, shape, pGraphicsView);
       pBitmapAnnotation->initializeTransformation();
       pBitmapAnnotation->drawCornerItems();
@@ -5500,12 +5555,9 @@ void ModelWidget::removeClassComponents(StringHandler::ViewType viewType)
 void ModelWidget::getModelComponents()
 {
   MainWindow *pMainWindow = MainWindow::instance();
-  // get the components
-  mComponentsList = pMainWindow->getOMCProxy()->getComponents(mpLibraryTreeItem->getNameStructure());
-  // get the components annotations
-  if (!mComponentsList.isEmpty()) {
-    mComponentsAnnotationsList = pMainWindow->getOMCProxy()->getComponentAnnotations(mpLibraryTreeItem->getNameStructure());
-  }
+  // get the components and their annotations
+  pMainWindow->getOMCProxy()->getComponentsAndAnnotations(mpLibraryTreeItem->getNameStructure(), &mComponentsList,
+                                                          &mComponentsAnnotationsList);
 }
 
 /*!
@@ -5649,16 +5701,17 @@ void ModelWidget::getModelTransitions()
       continue;
     }
     // get the transition annotations
-    QStringList shapesList = StringHandler::getStrings(transition.at(7), '(', ')');
+    AnnotationNode shapesList = AnnotationNode::parse(transition.at(7));
     // Now parse the shapes available in list
     QString lineShape, textShape = "";
-    foreach (QString shape, shapesList) {
-      if (shape.startsWith("Line")) {
-        lineShape = shape.mid(QString("Line").length());
-        lineShape = StringHandler::removeFirstLastParentheses(lineShape);
-      } else if (shape.startsWith("Text")) {
-        textShape = shape.mid(QString("Text").length());
-        textShape = StringHandler::removeFirstLastParentheses(textShape);
+    for (int j = 0 ; j < shapesList.size() ; j++) {
+      if (!shapesList.at(j).isRecord()) {
+        continue;
+      }
+      if (shapesList.at(j).getName().compare("Line") == 0) {
+        lineShape = shapesList.at(j).internArguments();
+      } else if (shapesList.at(j).getName().compare("Text") == 0) {
+        textShape = shapesList.at(j).internArguments();
       }
     }
     LineAnnotation *pTransitionLineAnnotation;
@@ -5690,13 +5743,12 @@ void ModelWidget::getModelInitialStates()
       continue;
     }
     // get the transition annotations
-    QStringList shapesList = StringHandler::getStrings(initialState.at(1), '(', ')');
+    AnnotationNode shapesList = AnnotationNode::parse(initialState.at(1));
     // Now parse the shapes available in list
     QString lineShape = "";
-    foreach (QString shape, shapesList) {
-      if (shape.startsWith("Line")) {
-        lineShape = shape.mid(QString("Line").length());
-        lineShape = StringHandler::removeFirstLastParentheses(lineShape);
+    for (int j = 0 ; j < shapesList.size() ; j++) {
+      if (shapesList.at(j).isRecord() && shapesList.at(j).getName().compare("Line") == 0) {
+        lineShape = shapesList.at(j).internArguments();
       }
     }
     LineAnnotation *pInitialStateLineAnnotation;
@@ -5875,7 +5927,7 @@ void ModelWidget::getCompositeModelConnections()
       QDomElement annotationElement = connectionChildren.at(j).toElement();
       if (annotationElement.tagName().compare("Annotation") == 0) {
         annotationFound = true;
-        shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(QString(annotation).arg(annotationElement.attribute("Points"))), '(', ')');
+        shapesList = StringHandler::getStringsInCurlBrackets(QString(annotation).arg(annotationElement.attribute("Points")), '(', ')');
       }
     }
     if (!annotationFound) {
@@ -5886,7 +5938,7 @@ void ModelWidget::getCompositeModelConnections()
       QPointF endPoint = pEndInterfacePointComponent->mapToScene(pEndInterfacePointComponent->boundingRect().center());
       points.append(point.arg(endPoint.x()).arg(endPoint.y()));
       QString pointsString = QString("{%1}").arg(points.join(","));
-      shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(QString(annotation).arg(pointsString)), '(', ')');
+      shapesList = StringHandler::getStringsInCurlBrackets(QString(annotation).arg(pointsString), '(', ')');
     }
     // Now parse the shapes available in list
     QString lineShape = "";
@@ -6146,7 +6198,7 @@ void ModelWidget::drawOMSModelConnections()
         QPointF endPoint = pEndBusConnectorComponent->mapToScene(pEndBusConnectorComponent->boundingRect().center());
         points.append(point.arg(endPoint.x()).arg(endPoint.y()));
         QString pointsString = QString("{%1}").arg(points.join(","));
-        shapesList = StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(QString(annotation).arg(pointsString)), '(', ')');
+        shapesList = StringHandler::getStringsInCurlBrackets(QString(annotation).arg(pointsString), '(', ')');
         // Now parse the shapes available in list
         QString lineShape = "";
         foreach (QString shape, shapesList) {
@@ -6338,6 +6390,7 @@ void ModelWidget::showTextView(bool checked)
   }
   mpDiagramGraphicsView->hide();
   if (mpEditor) {
+    MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->updateOutOfDateClassText(mpLibraryTreeItem);
     mpEditor->show();
     mpEditor->getPlainTextEdit()->setFocus(Qt::ActiveWindowFocusReason);
     mpEditor->getPlainTextEdit()->updateCursorPosition();
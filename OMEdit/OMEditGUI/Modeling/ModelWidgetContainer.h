@@ -109,6 +109,8 @@ private:
   QList<LineAnnotation*> mInitialStatesList;
   QList<ShapeAnnotation*> mShapesList;
   QList<Component*> mInheritedComponentsList;
+  QHash<QString, Component*> mComponentsHash;
+  bool mComponentsHashValid;
   QList<LineAnnotation*> mInheritedConnectionsList;
   QList<ShapeAnnotation*> mInheritedShapesList;
   LineAnnotation *mpConnectionLineAnnotation;
@@ -189,13 +191,13 @@ public:
   bool addComponent(QString className, QPointF position);
   void addComponentToView(QString name, LibraryTreeItem *pLibraryTreeItem, QString annotation, QPointF position,
                           ComponentInfo *pComponentInfo, bool addObject = true, bool openingClass = false);
-  void addComponentToList(Component *pComponent) {mComponentsList.append(pComponent);}
-  void addInheritedComponentToList(Component *pComponent) {mInheritedComponentsList.append(pComponent);}
+  void addComponentToList(Component *pComponent) {mComponentsList.append(pComponent); mComponentsHashValid = false;}
+  void addInheritedComponentToList(Component *pComponent) {mInheritedComponentsList.append(pComponent); mComponentsHashValid = false;}
   void addComponentToClass(Component *pComponent);
   void deleteComponent(Component *pComponent);
   void deleteComponentFromClass(Component *pComponent);
-  void deleteComponentFromList(Component *pComponent) {mComponentsList.removeOne(pComponent);}
-  void deleteInheritedComponentFromList(Component *pComponent) {mInheritedComponentsList.removeOne(pComponent);}
+  void deleteComponentFromList(Component *pComponent) {mComponentsList.removeOne(pComponent); mComponentsHashValid = false;}
+  void deleteInheritedComponentFromList(Component *pComponent) {mInheritedComponentsList.removeOne(pComponent); mComponentsHashValid = false;}
   Component* getComponentObject(QString componentName);
   QString getUniqueComponentName(QString componentName, int number = 1);
   bool checkComponentName(QString componentName);
@@ -207,6 +209,7 @@ public:
   void deleteConnectionFromClass(LineAnnotation *pConnectionLineAnnotation);
   void updateConnectionInClass(LineAnnotation *pConnectionLineAnnotation);
   void addConnectionToList(LineAnnotation *pConnectionLineAnnotation) {mConnectionsList.append(pConnectionLineAnnotation);}
+  void addConnectionsToView(const QList<LineAnnotation*> &connections);
   void addInheritedConnectionToList(LineAnnotation *pConnectionLineAnnotation) {mInheritedConnectionsList.append(pConnectionLineAnnotation);}
   void deleteConnectionFromList(LineAnnotation *pConnectionLineAnnotation) {mConnectionsList.removeOne(pConnectionLineAnnotation);}
   void removeConnectionsFromView();
@@ -233,7 +236,7 @@ public:
   void bringForward(ShapeAnnotation *pShape);
   void sendToBack(ShapeAnnotation *pShape);
   void sendBackward(ShapeAnnotation *pShape);
-  void removeAllComponents() {mComponentsList.clear();}
+  void removeAllComponents() {mComponentsList.clear(); mComponentsHashValid = false;}
   void removeAllShapes() {mShapesList.clear();}
   void removeAllConnections() {mConnectionsList.clear();}
   void removeAllTransitions() {mTransitionsList.clear();}
@@ -691,6 +691,7 @@ void SaveAsClassDialog::saveAsModelicaClass()
   {
     duplicateModelText.prepend(QString("within ").append(mpParentClassComboBox->currentText()).append(";"));
   }
+  MainWindow::instance()->getOMCProxy()->invalidateCachedUserClasses();
   MainWindow::instance()->getOMCProxy()->sendCommand(duplicateModelText);
   if (MainWindow::instance()->getOMCProxy()->getResult().toLower().contains("error"))
   {
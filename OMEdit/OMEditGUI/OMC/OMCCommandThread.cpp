@@ -0,0 +1,212 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+extern "C" {
+#include "meta/meta_modelica.h"
+#include "gc.h"
+
+int omc_Main_handleCommand(void *threadData, void *imsg, void **omsg);
+}
+
+#include "OMCCommandThread.h"
+
+#include <QTime>
+
+/*!
+ * \class OMCCommandThread
+ * \brief Runs OMC commands in the background so that long running commands don't block the GUI thread.
+ */
+/*!
+ * \brief OMCCommandThread::OMCCommandThread
+ * \param threadData - the OMC thread data.
+ * \param pOMCMutex - the mutex serializing the access to OMC.
+ * \param pParent
+ */
+OMCCommandThread::OMCCommandThread(threadData_t *threadData, QMutex *pOMCMutex, QObject *pParent)
+  : QThread(pParent), mpThreadData(threadData), mpOMCMutex(pOMCMutex), mStop(false)
+{
+  // OMC is deeply recursive so use the same stack size as the main thread of 64 bit OMEdit.
+  setStackSize(33554432);
+  // threads not created by the garbage collector must register themselves.
+  GC_allow_register_threads();
+}
+
+/*!
+ * \brief OMCCommandThread::enqueueCommand
+ * Adds the command to the queue of its priority.
+ * \param expression - the command to send.
+ * \param priority - the priority of the command.
+ * \return the future holding the command result.
+ */
+QFuture<QString> OMCCommandThread::enqueueCommand(const QString &expression, Priority priority)
+{
+  Command command;
+  command.mExpression = expression;
+  command.mFutureInterface.reportStarted();
+  QFuture<QString> future = command.mFutureInterface.future();
+  QMutexLocker locker(&mQueueMutex);
+  if (mStop) {
+    command.mFutureInterface.reportCanceled();
+    command.mFutureInterface.reportFinished();
+  } else {
+    mQueues[priority].enqueue(command);
+    mQueueWaitCondition.wakeOne();
+  }
+  return future;
+}
+
+/*!
+ * \brief OMCCommandThread::stop
+ * Stops the thread after the current command. The queued commands are canceled.
+ */
+void OMCCommandThread::stop()
+{
+  QMutexLocker locker(&mQueueMutex);
+  mStop = true;
+  for (int i = LowPriority ; i <= HighPriority ; i++) {
+    while (!mQueues[i].isEmpty()) {
+      Command command = mQueues[i].dequeue();
+      command.mFutureInterface.reportCanceled();
+      command.mFutureInterface.reportFinished();
+    }
+  }
+  mQueueWaitCondition.wakeAll();
+}
+
+/*!
+ * \brief OMCCommandThread::run
+ * Executes the queued commands until the thread is stopped.
+ */
+void OMCCommandThread::run()
+{
+  struct GC_stack_base stackBase;
+  GC_get_stack_base(&stackBase);
+  GC_register_my_thread(&stackBase);
+  // OMC looks up the thread data of the calling thread so set it for this thread as main() does for the GUI thread.
+  pthread_setspecific(mmc_thread_data_key, mpThreadData);
+  Command command;
+  while (takeNextCommand(&command)) {
+    if (command.mFutureInterface.isCanceled()) {
+      command.mFutureInterface.reportFinished();
+      continue;
+    }
+    QTime commandTime;
+    commandTime.start();
+    QString result = sendCommand(command.mExpression);
+    command.mFutureInterface.reportResult(result);
+    command.mFutureInterface.reportFinished();
+    emit commandFinished(command.mExpression, result, commandTime.elapsed());
+  }
+  pthread_setspecific(mmc_thread_data_key, NULL);
+  GC_unregister_my_thread();
+}
+
+/*!
+ * \brief OMCCommandThread::takeNextCommand
+ * Waits for a command and takes it from the highest priority queue.
+ * \param pCommand - set to the next command.
+ * \return false if the thread is stopped.
+ */
+bool OMCCommandThread::takeNextCommand(Command *pCommand)
+{
+  QMutexLocker locker(&mQueueMutex);
+  forever {
+    if (mStop) {
+      return false;
+    }
+    for (int i = HighPriority ; i >= LowPriority ; i--) {
+      if (!mQueues[i].isEmpty()) {
+        *pCommand = mQueues[i].dequeue();
+        return true;
+      }
+    }
+    mQueueWaitCondition.wait(&mQueueMutex);
+  }
+}
+
+/*!
+ * \brief OMCCommandThread::handleCommand
+ * Sends the command to OMC. Used by the command thread and OMCProxy::sendCommand.\n
+ * The caller must hold the OMC mutex.
+ * \param threadData - the OMC thread data.
+ * \param expression - the command to send.
+ * \param pResult - set to the command result.
+ * \return false if OMC failed to handle the command.
+ */
+bool OMCCommandThread::handleCommand(threadData_t *threadData, const QString &expression, QString *pResult)
+{
+  bool success = true;
+  void *reply_str = NULL;
+  *pResult = "";
+
+  MMC_TRY_TOP_INTERNAL()
+
+  MMC_TRY_STACK()
+
+  if (omc_Main_handleCommand(threadData, mmc_mk_scon(expression.toStdString().c_str()), &reply_str)) {
+    *pResult = MMC_STRINGDATA(reply_str);
+  } else {
+    success = false;
+  }
+
+  MMC_ELSE()
+    *pResult = "";
+    fprintf(stderr, "Stack overflow detected and was not caught.\nSend us a bug report at https://trac.openmodelica.org/OpenModelica/newticket\n    Include the following trace:\n");
+    printStacktraceMessages();
+    fflush(NULL);
+  MMC_CATCH_STACK()
+
+  MMC_CATCH_TOP(*pResult = "");
+
+  return success;
+}
+
+/*!
+ * \brief OMCCommandThread::sendCommand
+ * Sends the command to OMC while holding the OMC mutex.
+ * \param expression - the command to send.
+ * \return the command result.
+ */
+QString OMCCommandThread::sendCommand(const QString &expression)
+{
+  QString result;
+  threadData_t *threadData = mpThreadData;
+  QMutexLocker locker(mpOMCMutex);
+  // the stack overflow checks must use the stack of this thread.
+  void *stackBottom = threadData->stackBottom;
+  mmc_init_stackoverflow(threadData);
+  handleCommand(threadData, expression, &result);
+  threadData->stackBottom = stackBottom;
+  return result;
+}
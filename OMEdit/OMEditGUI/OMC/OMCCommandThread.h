@@ -0,0 +1,91 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCCOMMANDTHREAD_H
+#define OMCCOMMANDTHREAD_H
+
+extern "C" {
+#include "meta/meta_modelica.h"
+}
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QFuture>
+#include <QFutureInterface>
+
+/*!
+ * \class OMCCommandThread
+ * \brief Runs OMC commands in the background so that long running commands don't block the GUI thread.\n
+ * The commands are queued with a priority and are executed one at a time. OMC is not thread safe so every command holds
+ * the OMC mutex which is also held by the synchronous OMCProxy calls.
+ * \note Only send commands that don't call back into the GUI e.g., plot.
+ */
+class OMCCommandThread : public QThread
+{
+  Q_OBJECT
+public:
+  enum Priority {
+    LowPriority,    /* background work e.g., prefetching library and documentation information. */
+    NormalPriority,
+    HighPriority    /* commands the user is waiting for e.g., check model. */
+  };
+  OMCCommandThread(threadData_t *threadData, QMutex *pOMCMutex, QObject *pParent = 0);
+  QFuture<QString> enqueueCommand(const QString &expression, Priority priority = NormalPriority);
+  void stop();
+  static bool handleCommand(threadData_t *threadData, const QString &expression, QString *pResult);
+protected:
+  virtual void run();
+private:
+  class Command
+  {
+  public:
+    QString mExpression;
+    QFutureInterface<QString> mFutureInterface;
+  };
+  threadData_t *mpThreadData;
+  QMutex *mpOMCMutex;
+  QMutex mQueueMutex;
+  QWaitCondition mQueueWaitCondition;
+  QQueue<Command> mQueues[HighPriority + 1];
+  bool mStop;
+
+  bool takeNextCommand(Command *pCommand);
+  QString sendCommand(const QString &expression);
+signals:
+  void commandFinished(QString expression, QString result, int elapsed);
+};
+
+#endif // OMCCOMMANDTHREAD_H
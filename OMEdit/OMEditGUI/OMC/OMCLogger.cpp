@@ -0,0 +1,252 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "OMCLogger.h"
+#include "Util/Helper.h"
+
+#include <QFont>
+
+/*!
+ * \class OMCLogWriterThread
+ * \brief Writes the OMC communication log and the commands script in the background.
+ */
+/*!
+ * \brief OMCLogWriterThread::OMCLogWriterThread
+ * Opens the log files.
+ * \param communicationLogFilePath
+ * \param commandsLogFilePath
+ * \param pParent
+ */
+OMCLogWriterThread::OMCLogWriterThread(const QString &communicationLogFilePath, const QString &commandsLogFilePath, QObject *pParent)
+  : QThread(pParent), mTotalOMCCallsTime(0.0), mStop(false)
+{
+  mpCommunicationLogFile = fopen(communicationLogFilePath.toStdString().c_str(), "w");
+  mpCommandsLogFile = fopen(commandsLogFilePath.toStdString().c_str(), "w");
+}
+
+/*!
+ * \brief OMCLogWriterThread::addEntry
+ * Queues the entry for writing.
+ * \param entry
+ */
+void OMCLogWriterThread::addEntry(const OMCLogEntry &entry)
+{
+  QMutexLocker locker(&mEntriesMutex);
+  mEntries.append(entry);
+  mEntriesWaitCondition.wakeOne();
+}
+
+/*!
+ * \brief OMCLogWriterThread::stop
+ * Stops the thread once the queued entries are written.
+ */
+void OMCLogWriterThread::stop()
+{
+  QMutexLocker locker(&mEntriesMutex);
+  mStop = true;
+  mEntriesWaitCondition.wakeOne();
+}
+
+/*!
+ * \brief OMCLogWriterThread::run
+ * Writes the queued entries in batches and closes the files when stopped.
+ */
+void OMCLogWriterThread::run()
+{
+  forever {
+    QList<OMCLogEntry> entries;
+    bool stop;
+    mEntriesMutex.lock();
+    while (mEntries.isEmpty() && !mStop) {
+      mEntriesWaitCondition.wait(&mEntriesMutex);
+    }
+    entries.swap(mEntries);
+    stop = mStop;
+    mEntriesMutex.unlock();
+    foreach (const OMCLogEntry &entry, entries) {
+      writeEntry(entry);
+    }
+    // flush once per batch so the logs are readable if OMEdit crashes.
+    if (mpCommunicationLogFile) {
+      fflush(mpCommunicationLogFile);
+    }
+    if (mpCommandsLogFile) {
+      fflush(mpCommandsLogFile);
+    }
+    if (stop) {
+      break;
+    }
+  }
+  if (mpCommunicationLogFile) {
+    fclose(mpCommunicationLogFile);
+    mpCommunicationLogFile = 0;
+  }
+  if (mpCommandsLogFile) {
+    fclose(mpCommandsLogFile);
+    mpCommandsLogFile = 0;
+  }
+}
+
+/*!
+ * \brief OMCLogWriterThread::writeEntry
+ * Writes the entry to the communication log and the commands to the commands script.
+ * \param entry
+ */
+void OMCLogWriterThread::writeEntry(const OMCLogEntry &entry)
+{
+  const QString time = entry.mTime.toString("hh:mm:ss:zzz");
+  if (entry.mType == OMCLogEntry::Command) {
+    write(mpCommunicationLogFile, entry.mText + " " + time + "\n");
+    if (entry.mText.compare("quit()") == 0) {
+      write(mpCommandsLogFile, entry.mText + ";\n");
+    } else {
+      write(mpCommandsLogFile, entry.mText + "; getErrorString();\n");
+    }
+  } else {
+    write(mpCommunicationLogFile, entry.mText + " " + time + "\n");
+    const double elapsed = (double)entry.mElapsed / 1000;
+    mTotalOMCCallsTime += elapsed;
+    const QString firstLine = entry.mCommand.left(entry.mCommand.indexOf('\n'));
+    write(mpCommunicationLogFile, "#s#; " + QString::number(elapsed) + "; " + QString::number(mTotalOMCCallsTime) + "; '" + firstLine + "'\n\n");
+  }
+}
+
+/*!
+ * \brief OMCLogWriterThread::write
+ * Writes the text as UTF-8. Uses fwrite so the embedded null characters are written as well.
+ * \param pFile
+ * \param text
+ */
+void OMCLogWriterThread::write(FILE *pFile, const QString &text)
+{
+  if (pFile) {
+    const QByteArray bytes = text.toUtf8();
+    fwrite(bytes.constData(), 1, bytes.size(), pFile);
+  }
+}
+
+/*!
+ * \class OMCLoggerModel
+ * \brief Keeps the last OMC log entries in a ring buffer for the OMC logger view.\n
+ * The view only asks for the visible rows so the cost of a log entry doesn't depend on the size of the log.
+ */
+/*!
+ * \brief OMCLoggerModel::OMCLoggerModel
+ * \param capacity - the maximum number of entries. The oldest entries are dropped.
+ * \param pParent
+ */
+OMCLoggerModel::OMCLoggerModel(int capacity, QObject *pParent)
+  : QAbstractListModel(pParent), mEntries(capacity), mFirst(0), mCount(0)
+{
+  mFlushTimer.setSingleShot(true);
+  mFlushTimer.setInterval(100);
+  connect(&mFlushTimer, SIGNAL(timeout()), SLOT(flushPendingEntries()));
+}
+
+/*!
+ * \brief OMCLoggerModel::addEntry
+ * Adds the entry. The view is updated by the flush timer.
+ * \param entry
+ */
+void OMCLoggerModel::addEntry(const OMCLogEntry &entry)
+{
+  mPendingEntries.append(entry);
+  if (mPendingEntries.size() > mEntries.size()) {
+    mPendingEntries.removeFirst();
+  }
+  if (!mFlushTimer.isActive()) {
+    mFlushTimer.start();
+  }
+}
+
+int OMCLoggerModel::rowCount(const QModelIndex &parent) const
+{
+  return parent.isValid() ? 0 : mCount;
+}
+
+QVariant OMCLoggerModel::data(const QModelIndex &index, int role) const
+{
+  if (!index.isValid() || index.row() >= mCount) {
+    return QVariant();
+  }
+  const OMCLogEntry &entry = entryAt(index.row());
+  switch (role) {
+    case Qt::DisplayRole: {
+      // only show the start of the first line. The full text is shown for the selected entry.
+      int length = entry.mText.indexOf('\n');
+      length = (length < 0 || length > 500) ? qMin(entry.mText.length(), 500) : length;
+      if (length < entry.mText.length()) {
+        return QString("%1 ...").arg(entry.mText.left(length));
+      }
+      return entry.mText;
+    }
+    case FullTextRole:
+      return entry.mText;
+    case Qt::FontRole:
+      return QFont(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2,
+                   entry.mType == OMCLogEntry::Command ? QFont::Bold : QFont::Normal, false);
+    default:
+      return QVariant();
+  }
+}
+
+/*!
+ * \brief OMCLoggerModel::flushPendingEntries
+ * Moves the pending entries to the ring buffer. Drops the oldest entries if the buffer is full.
+ */
+void OMCLoggerModel::flushPendingEntries()
+{
+  if (mPendingEntries.isEmpty()) {
+    return;
+  }
+  const int capacity = mEntries.size();
+  const int overflow = qMin(mCount, mCount + mPendingEntries.size() - capacity);
+  if (overflow > 0) {
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    for (int i = 0 ; i < overflow ; i++) {
+      // release the text of the dropped entries.
+      mEntries[(mFirst + i) % capacity] = OMCLogEntry();
+    }
+    mFirst = (mFirst + overflow) % capacity;
+    mCount -= overflow;
+    endRemoveRows();
+  }
+  beginInsertRows(QModelIndex(), mCount, mCount + mPendingEntries.size() - 1);
+  foreach (const OMCLogEntry &entry, mPendingEntries) {
+    mEntries[(mFirst + mCount) % capacity] = entry;
+    mCount++;
+  }
+  endInsertRows();
+  mPendingEntries.clear();
+}
@@ -0,0 +1,124 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCLOGGER_H
+#define OMCLOGGER_H
+
+#include <stdio.h>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QTime>
+#include <QTimer>
+#include <QVector>
+#include <QAbstractListModel>
+
+/*!
+ * \class OMCLogEntry
+ * \brief A command sent to OMC or a response received from it.
+ */
+class OMCLogEntry
+{
+public:
+  enum Type {
+    Command,
+    Response
+  };
+  OMCLogEntry() : mType(Command), mElapsed(0) {}
+  OMCLogEntry(Type type, const QString &text, const QString &command, int elapsed)
+    : mType(type), mText(text), mCommand(command), mTime(QTime::currentTime()), mElapsed(elapsed) {}
+  Type mType;
+  QString mText;
+  QString mCommand;   /* the command of the response. */
+  QTime mTime;
+  int mElapsed;       /* the command time in milliseconds. */
+};
+
+/*!
+ * \class OMCLogWriterThread
+ * \brief Writes the OMC communication log and the commands script in the background.\n
+ * The entries are queued by the GUI thread and formatted and written in batches by this thread.
+ */
+class OMCLogWriterThread : public QThread
+{
+  Q_OBJECT
+public:
+  OMCLogWriterThread(const QString &communicationLogFilePath, const QString &commandsLogFilePath, QObject *pParent = 0);
+  void addEntry(const OMCLogEntry &entry);
+  void stop();
+protected:
+  virtual void run();
+private:
+  FILE *mpCommunicationLogFile;
+  FILE *mpCommandsLogFile;
+  double mTotalOMCCallsTime;
+  QMutex mEntriesMutex;
+  QWaitCondition mEntriesWaitCondition;
+  QList<OMCLogEntry> mEntries;
+  bool mStop;
+
+  void writeEntry(const OMCLogEntry &entry);
+  static void write(FILE *pFile, const QString &text);
+};
+
+/*!
+ * \class OMCLoggerModel
+ * \brief Keeps the last OMC log entries in a ring buffer for the OMC logger view.\n
+ * The added entries are announced to the view in batches.
+ */
+class OMCLoggerModel : public QAbstractListModel
+{
+  Q_OBJECT
+public:
+  enum {
+    FullTextRole = Qt::UserRole
+  };
+  OMCLoggerModel(int capacity, QObject *pParent = 0);
+  void addEntry(const OMCLogEntry &entry);
+  int rowCount(const QModelIndex &parent = QModelIndex()) const;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+private:
+  QVector<OMCLogEntry> mEntries;
+  int mFirst;
+  int mCount;
+  QList<OMCLogEntry> mPendingEntries;
+  QTimer mFlushTimer;
+
+  const OMCLogEntry& entryAt(int row) const {return mEntries.at((mFirst + row) % mEntries.size());}
+private slots:
+  void flushPendingEntries();
+};
+
+#endif // OMCLOGGER_H
@@ -0,0 +1,423 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "OMCProfiler.h"
+#include "OMCProxy.h"
+#include "Util/Helper.h"
+#include "Util/Utilities.h"
+#include "Util/StringHandler.h"
+
+#include <qjson/serializer.h>
+#include <QFile>
+#include <QMessageBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+
+/*!
+ * \class OMCCommandStatistics
+ * \brief Holds the latency histogram and the payload size of the calls of one OMC API.\n
+ * The latencies are counted in buckets of the 1-2-5 series so adding a call is cheap.
+ * The percentiles are the upper limits of the buckets capped by the maximum latency.
+ */
+const int OMCCommandStatistics::bucketsLimits[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000};
+// one bucket per limit and one for the calls taking longer than the last limit.
+const int OMCCommandStatistics::bucketsCount = sizeof(OMCCommandStatistics::bucketsLimits) / sizeof(int) + 1;
+
+OMCCommandStatistics::OMCCommandStatistics()
+  : mCount(0), mTotalTime(0), mMaximumTime(0), mPayloadBytes(0), mBuckets(bucketsCount, 0)
+{
+}
+
+/*!
+ * \brief OMCCommandStatistics::addCall
+ * Adds the call to the statistics.
+ * \param elapsed - the call time in milliseconds.
+ * \param payloadBytes - the size of the command and the response.
+ */
+void OMCCommandStatistics::addCall(int elapsed, int payloadBytes)
+{
+  mCount++;
+  mTotalTime += elapsed;
+  mMaximumTime = qMax(mMaximumTime, elapsed);
+  mPayloadBytes += payloadBytes;
+  int bucket = 0;
+  while (bucket < bucketsCount - 1 && elapsed > bucketsLimits[bucket]) {
+    bucket++;
+  }
+  mBuckets[bucket]++;
+}
+
+/*!
+ * \brief OMCCommandStatistics::getPercentile
+ * Returns the latency percentile estimated from the histogram.
+ * \param percent
+ * \return the latency in milliseconds.
+ */
+int OMCCommandStatistics::getPercentile(int percent) const
+{
+  if (mCount == 0) {
+    return 0;
+  }
+  qint64 rank = qMax((qint64)1, ((qint64)mCount * percent + 99) / 100);
+  qint64 cumulativeCount = 0;
+  for (int i = 0 ; i < bucketsCount - 1 ; i++) {
+    cumulativeCount += mBuckets.at(i);
+    if (cumulativeCount >= rank) {
+      return qMin(bucketsLimits[i], mMaximumTime);
+    }
+  }
+  return mMaximumTime;
+}
+
+/*!
+ * \class OMCProfiler
+ * \brief Aggregates the OMC calls statistics per API name.
+ */
+/*!
+ * \brief OMCProfiler::addCommand
+ * Adds the command to the statistics of its API.\n
+ * A batched command, see OMCProxy::sendCommands, is counted as one call of each API in the batch.
+ * The time and the payload are split evenly between them since OMC doesn't report the time of each statement.
+ * \param command - the command sent to OMC.
+ * \param elapsed - the command time in milliseconds.
+ * \param payloadBytes - the size of the command and the response.
+ */
+void OMCProfiler::addCommand(const QString &command, int elapsed, int payloadBytes)
+{
+  QStringList apiNames = getAPINames(command);
+  if (apiNames.isEmpty()) {
+    apiNames.append(getAPIName(command));
+  }
+  const int count = apiNames.size();
+  for (int i = 0 ; i < count ; i++) {
+    // hand out the remainders to the first APIs so the totals stay exact.
+    mStatistics[apiNames.at(i)].addCall(elapsed / count + (i < elapsed % count ? 1 : 0),
+                                        payloadBytes / count + (i < payloadBytes % count ? 1 : 0));
+  }
+}
+
+/*!
+ * \brief OMCProfiler::toCSV
+ * Returns the statistics as comma separated values.
+ * \return
+ */
+QString OMCProfiler::toCSV() const
+{
+  QString csv = "api,count,total(ms),p50(ms),p95(ms),max(ms),payload(bytes)\n";
+  QMap<QString, OMCCommandStatistics>::const_iterator i;
+  for (i = mStatistics.constBegin() ; i != mStatistics.constEnd() ; ++i) {
+    csv.append(QString("%1,%2,%3,%4,%5,%6,%7\n").arg(i.key()).arg(i.value().getCount()).arg(i.value().getTotalTime())
+               .arg(i.value().getPercentile(50)).arg(i.value().getPercentile(95)).arg(i.value().getMaximumTime())
+               .arg(i.value().getPayloadBytes()));
+  }
+  return csv;
+}
+
+/*!
+ * \brief OMCProfiler::toJSON
+ * Returns the statistics as a JSON array.
+ * \return
+ */
+QByteArray OMCProfiler::toJSON() const
+{
+  QVariantList statisticsList;
+  QMap<QString, OMCCommandStatistics>::const_iterator i;
+  for (i = mStatistics.constBegin() ; i != mStatistics.constEnd() ; ++i) {
+    QVariantMap statistics;
+    statistics.insert("api", i.key());
+    statistics.insert("count", i.value().getCount());
+    statistics.insert("total", i.value().getTotalTime());
+    statistics.insert("p50", i.value().getPercentile(50));
+    statistics.insert("p95", i.value().getPercentile(95));
+    statistics.insert("max", i.value().getMaximumTime());
+    statistics.insert("payload", i.value().getPayloadBytes());
+    statisticsList.append(statistics);
+  }
+  QJson::Serializer serializer;
+  serializer.setIndentMode(QJson::IndentFull);
+  return serializer.serialize(statisticsList);
+}
+
+/*!
+ * \brief OMCProfiler::getAPIName
+ * Returns the API name of the command i.e., the first token of the expression.
+ * \param command
+ * \return
+ */
+QString OMCProfiler::getAPIName(const QString &command)
+{
+  int index = 0;
+  while (index < command.length()) {
+    const QChar character = command.at(index);
+    if (character == '(' || character == ';' || character.isSpace()) {
+      break;
+    }
+    index++;
+  }
+  return command.left(index);
+}
+
+/*!
+ * \class OMCProfilerWidget
+ * \brief Shows the OMC calls statistics. The table is refreshed every second while the widget is visible.
+ */
+/*!
+ * \brief OMCProfilerWidget::OMCProfilerWidget
+ * \param pOMCProxy
+ */
+OMCProfilerWidget::OMCProfilerWidget(OMCProxy *pOMCProxy)
+  : QWidget(0), mpOMCProxy(pOMCProxy)
+{
+  resize(800, 480);
+  setWindowIcon(QIcon(":/Resources/icons/console.svg"));
+  setWindowTitle(QString(Helper::applicationName).append(" - ").append(tr("OMC Profiler")));
+  mpResponseCacheLabel = new Label;
+  // statistics tree widget
+  mpStatisticsTreeWidget = new QTreeWidget;
+  mpStatisticsTreeWidget->setIndentation(0);
+  mpStatisticsTreeWidget->setColumnCount(7);
+  mpStatisticsTreeWidget->setTextElideMode(Qt::ElideMiddle);
+  mpStatisticsTreeWidget->setSortingEnabled(true);
+  mpStatisticsTreeWidget->sortByColumn(2, Qt::DescendingOrder);
+  QStringList headerLabels;
+  headerLabels << tr("API") << tr("Calls") << tr("Total (ms)") << tr("p50 (ms)") << tr("p95 (ms)") << tr("Max (ms)") << tr("Payload (bytes)");
+  mpStatisticsTreeWidget->setHeaderLabels(headerLabels);
+  // buttons
+  mpResetButton = new QPushButton(Helper::reset);
+  connect(mpResetButton, SIGNAL(clicked()), SLOT(resetStatistics()));
+  mpExportCSVButton = new QPushButton(tr("Export CSV"));
+  connect(mpExportCSVButton, SIGNAL(clicked()), SLOT(exportCSV()));
+  mpExportJSONButton = new QPushButton(tr("Export JSON"));
+  connect(mpExportJSONButton, SIGNAL(clicked()), SLOT(exportJSON()));
+  QHBoxLayout *pButtonsLayout = new QHBoxLayout;
+  pButtonsLayout->setContentsMargins(0, 0, 0, 0);
+  pButtonsLayout->addStretch();
+  pButtonsLayout->addWidget(mpResetButton);
+  pButtonsLayout->addWidget(mpExportCSVButton);
+  pButtonsLayout->addWidget(mpExportJSONButton);
+  // refresh timer
+  mRefreshTimer.setInterval(1000);
+  connect(&mRefreshTimer, SIGNAL(timeout()), SLOT(refreshStatistics()));
+  // set the layout
+  QGridLayout *pMainLayout = new QGridLayout;
+  pMainLayout->setContentsMargins(1, 1, 1, 1);
+  pMainLayout->addWidget(mpResponseCacheLabel, 0, 0);
+  pMainLayout->addWidget(mpStatisticsTreeWidget, 1, 0);
+  pMainLayout->addLayout(pButtonsLayout, 2, 0);
+  setLayout(pMainLayout);
+}
+
+/*!
+ * \brief OMCProfilerWidget::exportStatistics
+ * Asks for a file name and writes the contents to it.
+ * \param fileTypes
+ * \param defaultSuffix
+ * \param contents
+ */
+void OMCProfilerWidget::exportStatistics(const QString &fileTypes, const QString &defaultSuffix, const QByteArray &contents)
+{
+  QString fileName = StringHandler::getSaveFileName(this, QString("%1 - %2").arg(Helper::applicationName, tr("Export OMC Profile")), NULL,
+                                                    fileTypes, NULL, defaultSuffix);
+  if (fileName.isEmpty()) {
+    return;
+  }
+  QFile file(fileName);
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write(contents);
+    file.close();
+  } else {
+    QMessageBox::critical(this, QString("%1 - %2").arg(Helper::applicationName, Helper::error),
+                          GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName).arg(file.errorString()), Helper::ok);
+  }
+}
+
+/*!
+ * \brief OMCProfilerWidget::showEvent
+ * Starts refreshing the statistics.
+ * \param event
+ */
+void OMCProfilerWidget::showEvent(QShowEvent *event)
+{
+  refreshStatistics();
+  mRefreshTimer.start();
+  QWidget::showEvent(event);
+}
+
+/*!
+ * \brief OMCProfilerWidget::hideEvent
+ * Stops refreshing the statistics.
+ * \param event
+ */
+void OMCProfilerWidget::hideEvent(QHideEvent *event)
+{
+  mRefreshTimer.stop();
+  QWidget::hideEvent(event);
+}
+
+/*!
+ * \brief OMCProfilerWidget::refreshStatistics
+ * Refills the statistics table.
+ */
+void OMCProfilerWidget::refreshStatistics()
+{
+  OMCResponseCache *pResponseCache = mpOMCProxy->getResponseCache();
+  mpResponseCacheLabel->setText(tr("Response cache: %1 entries, %2 hits, %3 misses").arg(pResponseCache->size())
+                                .arg(pResponseCache->getHits()).arg(pResponseCache->getMisses()));
+  mpStatisticsTreeWidget->setUpdatesEnabled(false);
+  mpStatisticsTreeWidget->clear();
+  const QMap<QString, OMCCommandStatistics> &statistics = mpOMCProxy->getOMCProfiler()->getStatistics();
+  QList<QTreeWidgetItem*> items;
+  QMap<QString, OMCCommandStatistics>::const_iterator i;
+  for (i = statistics.constBegin() ; i != statistics.constEnd() ; ++i) {
+    QTreeWidgetItem *pItem = new QTreeWidgetItem;
+    pItem->setText(0, i.key());
+    // set the numbers as data so the columns are sorted numerically.
+    pItem->setData(1, Qt::DisplayRole, i.value().getCount());
+    pItem->setData(2, Qt::DisplayRole, i.value().getTotalTime());
+    pItem->setData(3, Qt::DisplayRole, i.value().getPercentile(50));
+    pItem->setData(4, Qt::DisplayRole, i.value().getPercentile(95));
+    pItem->setData(5, Qt::DisplayRole, i.value().getMaximumTime());
+    pItem->setData(6, Qt::DisplayRole, i.value().getPayloadBytes());
+    items.append(pItem);
+  }
+  mpStatisticsTreeWidget->addTopLevelItems(items);
+  mpStatisticsTreeWidget->setUpdatesEnabled(true);
+}
+
+/*!
+ * \brief OMCProfilerWidget::resetStatistics
+ * Clears the statistics.
+ */
+void OMCProfilerWidget::resetStatistics()
+{
+  mpOMCProxy->getOMCProfiler()->reset();
+  refreshStatistics();
+}
+
+/*!
+ * \brief OMCProfilerWidget::exportCSV
+ * Exports the statistics as CSV.
+ */
+void OMCProfilerWidget::exportCSV()
+{
+  exportStatistics(Helper::csvFileTypes, "csv", mpOMCProxy->getOMCProfiler()->toCSV().toUtf8());
+}
+
+/*!
+ * \brief OMCProfilerWidget::exportJSON
+ * Exports the statistics as JSON.
+ */
+void OMCProfilerWidget::exportJSON()
+{
+  exportStatistics(Helper::jsonFileTypes, "json", mpOMCProxy->getOMCProfiler()->toJSON());
+}
+
+/*!
+ * \brief OMCProfiler::getAPINames
+ * Returns the API names of the statements of the command.\n
+ * The statements are separated by the semicolons outside of strings and brackets.
+ * String literal statements, e.g., the separator used by OMCProxy::sendCommands, are skipped.
+ * \param command
+ * \return
+ */
+QStringList OMCProfiler::getAPINames(const QString &command)
+{
+  QStringList apiNames;
+  const QChar *data = command.unicode();
+  const int length = command.length();
+  int depth = 0;
+  bool inString = false;
+  int begin = 0;
+  for (int i = 0 ; i <= length ; i++) {
+    if (i < length) {
+      const QChar character = data[i];
+      if (inString) {
+        if (character == '\\') {
+          i++;
+        } else if (character == '"') {
+          inString = false;
+        }
+        continue;
+      } else if (character == '"') {
+        inString = true;
+        continue;
+      } else if (character == '(' || character == '{' || character == '[') {
+        depth++;
+        continue;
+      } else if (character == ')' || character == '}' || character == ']') {
+        depth--;
+        continue;
+      } else if (character != ';' || depth > 0) {
+        continue;
+      }
+    }
+    // end of a statement
+    while (begin < i && data[begin].isSpace()) {
+      begin++;
+    }
+    if (begin < i && data[begin] != '"') {
+      apiNames.append(getAPIName(command.mid(begin, i - begin)));
+    }
+    begin = i + 1;
+  }
+  return apiNames;
+}
+
+/*!
+ * \brief OMCProfiler::getUtf8Length
+ * Returns the number of bytes of the string encoded as UTF-8 without encoding it.
+ * \param string
+ * \return
+ */
+int OMCProfiler::getUtf8Length(const QString &string)
+{
+  const QChar *data = string.unicode();
+  const int length = string.length();
+  int bytes = 0;
+  for (int i = 0 ; i < length ; i++) {
+    const ushort code = data[i].unicode();
+    if (code < 0x80) {
+      bytes += 1;
+    } else if (code < 0x800) {
+      bytes += 2;
+    } else if (data[i].isHighSurrogate() && i + 1 < length && data[i + 1].isLowSurrogate()) {
+      // a surrogate pair is one code point of four bytes.
+      bytes += 4;
+      i++;
+    } else {
+      bytes += 3;
+    }
+  }
+  return bytes;
+}
@@ -0,0 +1,122 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCPROFILER_H
+#define OMCPROFILER_H
+
+#include <QWidget>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QTimer>
+#include <QVector>
+#include <QMap>
+#include <QStringList>
+
+class Label;
+
+/*!
+ * \class OMCCommandStatistics
+ * \brief Holds the latency histogram and the payload size of the calls of one OMC API.
+ */
+class OMCCommandStatistics
+{
+public:
+  OMCCommandStatistics();
+  void addCall(int elapsed, int payloadBytes);
+  int getCount() const {return mCount;}
+  qint64 getTotalTime() const {return mTotalTime;}
+  int getMaximumTime() const {return mMaximumTime;}
+  int getPercentile(int percent) const;
+  qint64 getPayloadBytes() const {return mPayloadBytes;}
+
+  static const int bucketsLimits[];
+  static const int bucketsCount;
+private:
+  int mCount;
+  qint64 mTotalTime;
+  int mMaximumTime;
+  qint64 mPayloadBytes;
+  QVector<int> mBuckets;
+};
+
+/*!
+ * \class OMCProfiler
+ * \brief Aggregates the OMC calls statistics per API name.
+ */
+class OMCProfiler
+{
+public:
+  void addCommand(const QString &command, int elapsed, int payloadBytes);
+  const QMap<QString, OMCCommandStatistics>& getStatistics() const {return mStatistics;}
+  void reset() {mStatistics.clear();}
+  QString toCSV() const;
+  QByteArray toJSON() const;
+  static QString getAPIName(const QString &command);
+  static QStringList getAPINames(const QString &command);
+  static int getUtf8Length(const QString &string);
+private:
+  QMap<QString, OMCCommandStatistics> mStatistics;
+};
+
+class OMCProxy;
+/*!
+ * \class OMCProfilerWidget
+ * \brief Shows the OMC calls statistics. The table is refreshed every second while the widget is visible.
+ */
+class OMCProfilerWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  OMCProfilerWidget(OMCProxy *pOMCProxy);
+private:
+  OMCProxy *mpOMCProxy;
+  QTreeWidget *mpStatisticsTreeWidget;
+  Label *mpResponseCacheLabel;
+  QPushButton *mpResetButton;
+  QPushButton *mpExportCSVButton;
+  QPushButton *mpExportJSONButton;
+  QTimer mRefreshTimer;
+
+  void exportStatistics(const QString &fileTypes, const QString &defaultSuffix, const QByteArray &contents);
+protected:
+  virtual void showEvent(QShowEvent *event);
+  virtual void hideEvent(QHideEvent *event);
+private slots:
+  void refreshStatistics();
+  void resetStatistics();
+  void exportCSV();
+  void exportJSON();
+};
+
+#endif // OMCPROFILER_H
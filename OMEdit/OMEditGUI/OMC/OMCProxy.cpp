@@ -41,7 +41,6 @@ void (*omc_assert)(threadData_t*,FILE_INFO info,const char *msg,...) __attribute
 void (*omc_assert_warning)(FILE_INFO info,const char *msg,...) = omc_assert_warning_function;
 void (*omc_terminate)(FILE_INFO info,const char *msg,...) = omc_terminate_function;
 void (*omc_throw)(threadData_t*) __attribute__ ((noreturn)) = omc_throw_function;
-int omc_Main_handleCommand(void *threadData, void *imsg, void **omsg);
 void* omc_Main_init(void *threadData, void *args);
 void omc_System_initGarbageCollector(void *threadData);
 #ifdef WIN32
@@ -62,6 +61,186 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
 
 #include <QMessageBox>
 
+/*!
+ * \class OMCResponseCache
+ * \brief LRU cache for the results of read-only OMC queries keyed by the expression string.
+ */
+/*!
+ * \brief OMCResponseCache::OMCResponseCache
+ * \param maxEntries - the maximum number of results kept in the cache.
+ */
+OMCResponseCache::OMCResponseCache(int maxEntries)
+  : mCurrentGeneration(0), mChangeCount(0), mHits(0), mMisses(0)
+{
+  mEntries.setMaxCost(maxEntries);
+}
+
+OMCResponseCache::~OMCResponseCache()
+{
+  // delete the entries while the class index they remove themselves from still exists.
+  mEntries.clear();
+}
+
+/*!
+ * \brief OMCResponseCache::addDependency
+ * Records that className inherits from baseClassName so invalidating the base class also invalidates className.
+ * \param baseClassName
+ * \param className
+ */
+void OMCResponseCache::addDependency(const QString &baseClassName, const QString &className)
+{
+  mDependents[baseClassName].insert(className);
+}
+
+/*!
+ * \brief OMCResponseCache::invalidateClass
+ * Invalidates the cached results of the class, its enclosing classes, its nested classes and the classes inheriting from it.
+ * \param className
+ */
+void OMCResponseCache::invalidateClass(const QString &className)
+{
+  mChangeCount++;
+  if (className.isEmpty() || mEntries.isEmpty()) {
+    return;
+  }
+  QSet<QString> invalidatedClasses;
+  invalidateClassHelper(className, &invalidatedClasses);
+  // the enclosing classes list the class so their own results are invalid as well. Their other nested classes are still valid.
+  QString enclosingClassName = className;
+  forever {
+    QString parentClassName = StringHandler::removeLastWordAfterDot(enclosingClassName);
+    if (parentClassName.isEmpty() || parentClassName.compare(enclosingClassName) == 0) {
+      break;
+    }
+    mGenerations.insert(parentClassName, ++mCurrentGeneration);
+    enclosingClassName = parentClassName;
+  }
+}
+
+/*!
+ * \brief OMCResponseCache::invalidateAllExcept
+ * Removes all the cached results except the ones that belong to the given top level classes.
+ * \param topLevelClasses
+ */
+void OMCResponseCache::invalidateAllExcept(const QStringList &topLevelClasses)
+{
+  mChangeCount++;
+  foreach (QString className, mClassExpressions.keys()) {
+    if (!topLevelClasses.contains(StringHandler::getFirstWordBeforeDot(className))) {
+      removeClassEntries(className);
+    }
+  }
+}
+
+/*!
+ * \brief OMCResponseCache::clear
+ * Removes all the cached results.
+ * \param classesChanged - false if the results are removed for another reason than a change of the loaded classes e.g., new OMC flags.
+ */
+void OMCResponseCache::clear(bool classesChanged)
+{
+  if (classesChanged) {
+    mChangeCount++;
+  }
+  mClassExpressions.clear();
+  mEntries.clear();
+  mGenerations.clear();
+  mDependents.clear();
+}
+
+/*!
+ * \brief OMCResponseCache::insertEntry
+ * Inserts the entry of the expression. The entry is tagged with the current generation of its class.\n
+ * The expression is added to the class index after inserting the entry since QCache deletes the replaced entry which removes its index.
+ * \param expression
+ * \param pEntry
+ */
+void OMCResponseCache::insertEntry(const QString &expression, Entry *pEntry)
+{
+  pEntry->mGeneration = mGenerations.value(pEntry->mClassName, 0);
+  pEntry->mpCache = this;
+  pEntry->mExpression = expression;
+  const QString className = pEntry->mClassName;
+  if (mEntries.insert(expression, pEntry)) {
+    mClassExpressions[className].insert(expression);
+  }
+}
+
+/*!
+ * \brief OMCResponseCache::findEntry
+ * Finds the entry of the expression. Drops the entry if its class is invalidated after it was cached.
+ * \param expression
+ * \return the entry or 0 if there is no valid entry.
+ */
+OMCResponseCache::Entry* OMCResponseCache::findEntry(const QString &expression)
+{
+  Entry *pEntry = mEntries.object(expression);
+  if (pEntry && pEntry->mGeneration != mGenerations.value(pEntry->mClassName, 0)) {
+    mEntries.remove(expression);
+    pEntry = 0;
+  }
+  if (pEntry) {
+    mHits++;
+  } else {
+    mMisses++;
+  }
+  return pEntry;
+}
+
+/*!
+ * \brief OMCResponseCache::invalidateClassHelper
+ * Helper function for OMCResponseCache::invalidateClass()
+ * \param className
+ * \param pInvalidatedClasses - the classes already invalidated. Avoids cycles in the dependencies.
+ */
+void OMCResponseCache::invalidateClassHelper(const QString &className, QSet<QString> *pInvalidatedClasses)
+{
+  if (pInvalidatedClasses->contains(className)) {
+    return;
+  }
+  pInvalidatedClasses->insert(className);
+  mGenerations.insert(className, ++mCurrentGeneration);
+  // remove the entries of the nested classes
+  const QString nestedClassPrefix = className + ".";
+  foreach (QString nestedClassName, mClassExpressions.keys()) {
+    if (nestedClassName.startsWith(nestedClassPrefix)) {
+      removeClassEntries(nestedClassName);
+    }
+  }
+  foreach (QString dependentClassName, mDependents.value(className)) {
+    invalidateClassHelper(dependentClassName, pInvalidatedClasses);
+  }
+}
+
+/*!
+ * \brief OMCResponseCache::removeClassEntries
+ * Removes all the cached results of the class.
+ * \param className
+ */
+void OMCResponseCache::removeClassEntries(const QString &className)
+{
+  foreach (QString expression, mClassExpressions.take(className)) {
+    mEntries.remove(expression);
+  }
+}
+
+/*!
+ * \brief OMCResponseCache::removeExpressionIndex
+ * Removes the expression from the class index. Called when the entry of the expression is deleted or evicted.
+ * \param className
+ * \param expression
+ */
+void OMCResponseCache::removeExpressionIndex(const QString &className, const QString &expression)
+{
+  QHash<QString, QSet<QString> >::iterator it = mClassExpressions.find(className);
+  if (it != mClassExpressions.end()) {
+    it.value().remove(expression);
+    if (it.value().isEmpty()) {
+      mClassExpressions.erase(it);
+    }
+  }
+}
+
 /*!
  * \class OMCProxy
  * \brief Interface to send commands to OpenModelica Compiler.
@@ -72,21 +251,38 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
  * \param pParent
  */
 OMCProxy::OMCProxy(threadData_t* threadData, QWidget *pParent)
-  : QObject(pParent), mHasInitialized(false), mResult(""), mTotalOMCCallsTime(0.0)
+  : QObject(pParent), mHasInitialized(false), mResult(""), mOMCMutex(QMutex::Recursive)
 {
   mCurrentCommandIndex = -1;
+  mpOMCCommandThread = 0;
+  mpOMCLogWriterThread = 0;
   // OMC Commands Logger Widget
   mpOMCLoggerWidget = new QWidget;
   mpOMCLoggerWidget->resize(640, 480);
   mpOMCLoggerWidget->setWindowIcon(QIcon(":/Resources/icons/console.svg"));
   mpOMCLoggerWidget->setWindowTitle(QString(Helper::applicationName).append(" - ").append(Helper::OpenModelicaCompilerCLI));
-  // OMC Logger textbox
-  mpOMCLoggerTextBox = new QPlainTextEdit;
-  mOMCLoggerTextCursor = QTextCursor(mpOMCLoggerTextBox->document());
-  mpOMCLoggerTextBox->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-  mpOMCLoggerTextBox->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-  mpOMCLoggerTextBox->setReadOnly(true);
-  mpOMCLoggerTextBox->setLineWrapMode(QPlainTextEdit::WidgetWidth);
+  // OMC Logger view. Shows one line per entry and only the visible entries are rendered.
+  mpOMCLoggerModel = new OMCLoggerModel(10000, this);
+  connect(mpOMCLoggerModel, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)), SLOT(omcLoggerRowsAboutToBeInserted()));
+  connect(mpOMCLoggerModel, SIGNAL(rowsInserted(QModelIndex,int,int)), SLOT(omcLoggerRowsInserted()));
+  mOMCLoggerAtBottom = true;
+  mpOMCLoggerListView = new QListView;
+  mpOMCLoggerListView->setUniformItemSizes(true);
+  mpOMCLoggerListView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+  mpOMCLoggerListView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+  mpOMCLoggerListView->setModel(mpOMCLoggerModel);
+  connect(mpOMCLoggerListView->selectionModel(), SIGNAL(currentChanged(QModelIndex,QModelIndex)), SLOT(showOMCLoggerEntry(QModelIndex)));
+  // OMC Logger entry textbox shows the full text of the selected entry.
+  mpOMCLoggerEntryTextBox = new QPlainTextEdit;
+  mpOMCLoggerEntryTextBox->setReadOnly(true);
+  mpOMCLoggerEntryTextBox->setLineWrapMode(QPlainTextEdit::WidgetWidth);
+  mpOMCLoggerEntryTextBox->setFont(QFont(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2));
+  QSplitter *pOMCLoggerSplitter = new QSplitter(Qt::Vertical);
+  pOMCLoggerSplitter->setChildrenCollapsible(false);
+  pOMCLoggerSplitter->addWidget(mpOMCLoggerListView);
+  pOMCLoggerSplitter->addWidget(mpOMCLoggerEntryTextBox);
+  pOMCLoggerSplitter->setStretchFactor(0, 3);
+  pOMCLoggerSplitter->setStretchFactor(1, 1);
   mpExpressionTextBox = new CustomExpressionBox(this);
   connect(mpExpressionTextBox, SIGNAL(returnPressed()), SLOT(sendCustomExpression()));
   mpOMCLoggerSendButton = new QPushButton(tr("Send"));
@@ -98,7 +294,7 @@ OMCProxy::OMCProxy(threadData_t* threadData, QWidget *pParent)
   pHorizontalLayout->addWidget(mpOMCLoggerSendButton);
   QVBoxLayout *pVerticalalLayout = new QVBoxLayout;
   pVerticalalLayout->setContentsMargins(1, 1, 1, 1);
-  pVerticalalLayout->addWidget(mpOMCLoggerTextBox);
+  pVerticalalLayout->addWidget(pOMCLoggerSplitter);
   pVerticalalLayout->addLayout(pHorizontalLayout);
   mpOMCLoggerWidget->setLayout(pVerticalalLayout);
   if (MainWindow::instance()->isDebug()) {
@@ -122,6 +318,8 @@ OMCProxy::OMCProxy(threadData_t* threadData, QWidget *pParent)
     pOMCDiffWidgetLayout->addWidget(mpOMCDiffMergedLabel, 2, 0, 1, 2);
     pOMCDiffWidgetLayout->addWidget(mpOMCDiffMergedTextBox, 3, 0, 1, 2);
     mpOMCDiffWidget->setLayout(pOMCDiffWidgetLayout);
+    // OMC Profiler widget
+    mpOMCProfilerWidget = new OMCProfilerWidget(this);
   }
   mUnitConversionList.clear();
   mDerivedUnitsMap.clear();
@@ -138,6 +336,7 @@ OMCProxy::~OMCProxy()
   delete mpOMCLoggerWidget;
   if (MainWindow::instance()->isDebug()) {
     delete mpOMCDiffWidget;
+    delete mpOMCProfilerWidget;
   }
 }
 
@@ -186,12 +385,11 @@ bool OMCProxy::initializeOMC(threadData_t *threadData)
 {
   /* create the tmp path */
   QString& tmpPath = Utilities::tempDirectory();
-  /* create a file to write OMEdit communication log */
+  /* create the files to write OMEdit communication log and OMEdit commands. They are written by a background thread. */
   QString communicationLogFilePath = QString("%1omeditcommunication.log").arg(tmpPath);
-  mpCommunicationLogFile = fopen(communicationLogFilePath.toStdString().c_str(), "w");
-  /* create a file to write OMEdit commands */
   QString commandsLogFilePath = QString("%1omeditcommands.mos").arg(tmpPath);
-  mpCommandsLogFile = fopen(commandsLogFilePath.toStdString().c_str(), "w");
+  mpOMCLogWriterThread = new OMCLogWriterThread(communicationLogFilePath, commandsLogFilePath, this);
+  mpOMCLogWriterThread->start();
   // read the locale
   QSettings *pSettings = Utilities::getApplicationSettings();
   QLocale settingsLocale = QLocale(pSettings->value("language").toString());
@@ -206,10 +404,14 @@ bool OMCProxy::initializeOMC(threadData_t *threadData)
   threadData->plotClassPointer = MainWindow::instance();
   threadData->plotCB = MainWindow::PlotCallbackFunction;
   MMC_CATCH_TOP(return false;)
-  mpOMCInterface = new OMCInterface(threadData);
-  connect(mpOMCInterface, SIGNAL(logCommand(QString,QTime*)), this, SLOT(logCommand(QString,QTime*)));
-  connect(mpOMCInterface, SIGNAL(logResponse(QString,QString,QTime*)), this, SLOT(logResponse(QString,QString,QTime*)));
-  connect(mpOMCInterface, SIGNAL(throwException(QString)), SLOT(showException(QString)));
+  // every call through mpOMCInterface holds the OMC mutex so it doesn't run at the same time as the OMCCommandThread commands.
+  mpOMCInterface.reset(new OMCInterface(threadData), &mOMCMutex);
+  connect(mpOMCInterface.data(), SIGNAL(logCommand(QString,QTime*)), this, SLOT(logCommand(QString,QTime*)));
+  connect(mpOMCInterface.data(), SIGNAL(logResponse(QString,QString,QTime*)), this, SLOT(logResponse(QString,QString,QTime*)));
+  connect(mpOMCInterface.data(), SIGNAL(throwException(QString)), SLOT(showException(QString)));
+  mpOMCCommandThread = new OMCCommandThread(threadData, &mOMCMutex, this);
+  connect(mpOMCCommandThread, SIGNAL(commandFinished(QString,QString,int)), SLOT(logAsyncCommand(QString,QString,int)));
+  mpOMCCommandThread->start();
   mHasInitialized = true;
   // get OpenModelica version
   Helper::OpenModelicaVersion = getVersion();
@@ -238,12 +440,14 @@ bool OMCProxy::initializeOMC(threadData_t *threadData)
  */
 void OMCProxy::quitOMC()
 {
-  sendCommand("quit()");
-  if (mpCommunicationLogFile) {
-    fclose(mpCommunicationLogFile);
+  if (mpOMCCommandThread) {
+    mpOMCCommandThread->stop();
+    mpOMCCommandThread->wait();
   }
-  if (mpCommandsLogFile) {
-    fclose(mpCommandsLogFile);
+  sendCommand("quit()");
+  if (mpOMCLogWriterThread) {
+    mpOMCLogWriterThread->stop();
+    mpOMCLogWriterThread->wait();
   }
 }
 
@@ -254,35 +458,100 @@ void OMCProxy::quitOMC()
  */
 void OMCProxy::sendCommand(const QString expression, bool saveToHistory)
 {
+  QMutexLocker locker(&mOMCMutex);
+  // the commands typed by the user can change any class.
+  if (saveToHistory) {
+    invalidateCachedUserClasses();
+  }
   // write command to the commands log.
   QTime commandTime;
   commandTime.start();
   logCommand(expression, &commandTime, saveToHistory);
-  // TODO: Call this in a thread that loops over received messages? Avoid MMC_TRY_TOP all the time, etc
-  void *reply_str = NULL;
-  threadData_t *threadData = mpOMCInterface->threadData;
-
-  MMC_TRY_TOP_INTERNAL()
-
-  MMC_TRY_STACK()
-
-  if (!omc_Main_handleCommand(threadData, mmc_mk_scon(expression.toStdString().c_str()), &reply_str)) {
+  if (!OMCCommandThread::handleCommand(mpOMCInterface->threadData, expression, &mResult)) {
     if (expression == "quit()") {
       return;
     }
     exitApplication();
   }
-  mResult = MMC_STRINGDATA(reply_str);
   logResponse(expression, mResult.trimmed(), &commandTime);
+}
 
-  MMC_ELSE()
-    mResult = "";
-    fprintf(stderr, "Stack overflow detected and was not caught.\nSend us a bug report at https://trac.openmodelica.org/OpenModelica/newticket\n    Include the following trace:\n");
-    printStacktraceMessages();
-    fflush(NULL);
-  MMC_CATCH_STACK()
+/*!
+ * \brief OMCProxy::sendCommands
+ * Sends a batch of expressions to OMC in one omc_Main_handleCommand call and splits the replies.\n
+ * The expressions are sent as a statement list with a string literal between each of them which is used to split the reply.
+ * We can't use an array since OMC arrays must have elements of the same type.
+ * OMC stops evaluating a statement list at the first failing statement, so if the reply has fewer parts than the expressions
+ * then the results before the failed expression are kept, the failed expression is sent alone and the rest are batched again.
+ * \note Only use this for read-only queries since a failed expression is resent.
+ * \param expressions - the list of expressions to send.
+ * \return the list of results, one per expression.
+ */
+QStringList OMCProxy::sendCommands(const QStringList expressions)
+{
+  QStringList results;
+  if (expressions.isEmpty()) {
+    return results;
+  } else if (expressions.size() == 1) {
+    sendCommand(expressions.at(0));
+    results.append(getResult());
+    return results;
+  }
+  const QString separator = "\"__OMEdit_Batch_Separator__\"";
+  sendCommand(expressions.join(QString("; %1; ").arg(separator)));
+  results = mResult.split(separator);
+  for (int i = 0 ; i < results.size() ; i++) {
+    results[i] = results.at(i).trimmed();
+  }
+  if (results.size() < expressions.size()) {
+    // the last part is the reply of the failed expression. Resend it alone and batch the remaining expressions again.
+    int failedIndex = results.size() - 1;
+    results.removeLast();
+    sendCommand(expressions.at(failedIndex));
+    results.append(getResult());
+    results.append(sendCommands(expressions.mid(failedIndex + 1)));
+  } else if (results.size() > expressions.size()) {
+    // one of the replies contains the separator so we can't tell the replies apart.
+    results.clear();
+    foreach (QString expression, expressions) {
+      sendCommand(expression);
+      results.append(getResult());
+    }
+  }
+  mResult = results.last();
+  return results;
+}
 
-  MMC_CATCH_TOP(mResult = "");
+/*!
+ * \brief OMCProxy::sendCommandAsync
+ * Queues the expression on the OMCCommandThread.\n
+ * The OMCProxy methods that update OMEdit after the command, e.g., printing the messages, must be called when the future is finished.
+ * \param expression - the expression to send.
+ * \param priority - the priority of the command.
+ * \return the future holding the command result.
+ * \sa OMCProxy::sendCommand
+ */
+QFuture<QString> OMCProxy::sendCommandAsync(const QString expression, OMCCommandThread::Priority priority)
+{
+  return mpOMCCommandThread->enqueueCommand(expression, priority);
+}
+
+/*!
+ * \brief OMCProxy::invalidateCachedUserClasses
+ * Invalidates the cached results of all the classes except the ones in system libraries.
+ */
+void OMCProxy::invalidateCachedUserClasses()
+{
+  QStringList systemLibraries;
+  LibraryWidget *pLibraryWidget = MainWindow::instance()->getLibraryWidget();
+  if (pLibraryWidget) {
+    foreach (LibraryTreeItem *pLibraryTreeItem, pLibraryWidget->getLibraryTreeModel()->getRootLibraryTreeItem()->childrenItems()) {
+      if (pLibraryTreeItem->isSystemLibrary()) {
+        systemLibraries.append(pLibraryTreeItem->getNameStructure());
+      }
+    }
+  }
+  mResponseCache.invalidateAllExcept(systemLibraries);
 }
 
 /*!
@@ -306,19 +575,20 @@ QString OMCProxy::getResult()
 /*!
  * \brief OMCProxy::logCommand
  * Writes OMC command in OMC Logger window.
- * Writes the command to the omeditcommunication.log file.
- * Writes the command to the omeditcommands.mos file.
+ * Queues the command for the omeditcommunication.log and omeditcommands.mos files which are written by OMCLogWriterThread.
  * \param command - the command to write
  * \param commandTime - the command start time
  */
 void OMCProxy::logCommand(QString command, QTime *commandTime, bool saveToHistory)
 {
+  Q_UNUSED(commandTime);
   if (isLoggingEnabled()) {
-    // insert the command to the logger window.
-    QFont font(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2, QFont::Bold, false);
-    QTextCharFormat format;
-    format.setFont(font);
-    Utilities::insertText(mpOMCLoggerTextBox, command + "\n", format);
+    // insert the command to the logger window and queue it for the log files.
+    OMCLogEntry entry(OMCLogEntry::Command, command, command, 0);
+    mpOMCLoggerModel->addEntry(entry);
+    if (mpOMCLogWriterThread) {
+      mpOMCLogWriterThread->addEntry(entry);
+    }
     if (saveToHistory) {
       // add the expression to commands list
       mCommandsList.append(command);
@@ -326,54 +596,77 @@ void OMCProxy::logCommand(QString command, QTime *commandTime, bool saveToHistor
       mCurrentCommandIndex = mCommandsList.count();
       mpExpressionTextBox->setText("");
     }
-    // write the log to communication log file
-    if (mpCommunicationLogFile) {
-      fputs(QString("%1 %2\n").arg(command, commandTime->currentTime().toString("hh:mm:ss:zzz")).toStdString().c_str(), mpCommunicationLogFile);
-    }
-    // write commands mos file
-    if (mpCommandsLogFile) {
-      if (command.compare("quit()") == 0) {
-        fputs(QString("%1;\n").arg(command).toStdString().c_str(), mpCommandsLogFile);
-      } else {
-        fputs(QString("%1; getErrorString();\n").arg(command).toStdString().c_str(), mpCommandsLogFile);
-      }
-    }
   }
 }
 
 /*!
  * \brief OMCProxy::logResponse
  * Writes OMC response in OMC Logger window.
- * Writes the response to the omeditcommunication.log file.
+ * Queues the response for the omeditcommunication.log file which is written by OMCLogWriterThread.
+ * Adds the command time and payload to the OMC profiler statistics.
  * \param response - the response to write
  * \param responseTime - the response end time
  */
 void OMCProxy::logResponse(QString command, QString response, QTime *responseTime)
 {
-  QString firstLine("");
-  for (int i = 0; i < command.length(); i++)
-    if (command[i] != '\n')
-    {
-      firstLine.append(command[i]);
-    }
-    else
-      break;
-
+  // always collect the statistics, they are cheap compared to the OMC call.
+  mOMCProfiler.addCommand(command, responseTime->elapsed(),
+                          OMCProfiler::getUtf8Length(command) + OMCProfiler::getUtf8Length(response));
   if (isLoggingEnabled()) {
-    // insert the response to the logger window.
-    QFont font(Helper::monospacedFontInfo.family(), Helper::monospacedFontInfo.pointSize() - 2, QFont::Normal, false);
-    QTextCharFormat format;
-    format.setFont(font);
-    Utilities::insertText(mpOMCLoggerTextBox, response + "\n\n", format);
-    // write the log to communication log file
-    if (mpCommunicationLogFile) {
-      fputs(QString("%1 %2\n").arg(response).arg(responseTime->currentTime().toString("hh:mm:ss:zzz")).toStdString().c_str(), mpCommunicationLogFile);
-      mTotalOMCCallsTime += (double)responseTime->elapsed() / 1000;
-      fputs(QString("#s#; %1; %2; \'%3\'\n\n").arg(QString::number((double)responseTime->elapsed() / 1000)).arg(QString::number(mTotalOMCCallsTime)).arg(firstLine).toStdString().c_str(),  mpCommunicationLogFile);
+    // insert the response to the logger window and queue it for the log file.
+    OMCLogEntry entry(OMCLogEntry::Response, response, command, responseTime->elapsed());
+    mpOMCLoggerModel->addEntry(entry);
+    if (mpOMCLogWriterThread) {
+      mpOMCLogWriterThread->addEntry(entry);
     }
   }
 }
 
+/*!
+ * \brief OMCProxy::omcLoggerRowsAboutToBeInserted
+ * Remembers if the OMC logger view is scrolled to the bottom before the new entries are added.
+ */
+void OMCProxy::omcLoggerRowsAboutToBeInserted()
+{
+  QScrollBar *pScrollBar = mpOMCLoggerListView->verticalScrollBar();
+  mOMCLoggerAtBottom = pScrollBar->value() == pScrollBar->maximum();
+}
+
+/*!
+ * \brief OMCProxy::omcLoggerRowsInserted
+ * Keeps the OMC logger view scrolled to the bottom if it was before the new entries are added.
+ */
+void OMCProxy::omcLoggerRowsInserted()
+{
+  if (mOMCLoggerAtBottom) {
+    mpOMCLoggerListView->scrollToBottom();
+  }
+}
+
+/*!
+ * \brief OMCProxy::showOMCLoggerEntry
+ * Shows the full text of the OMC logger entry.
+ * \param index
+ */
+void OMCProxy::showOMCLoggerEntry(const QModelIndex &index)
+{
+  mpOMCLoggerEntryTextBox->setPlainText(index.data(OMCLoggerModel::FullTextRole).toString());
+}
+
+/*!
+ * \brief OMCProxy::logAsyncCommand
+ * Logs the command executed by OMCCommandThread.
+ * \param command - the command to write
+ * \param response - the response to write
+ * \param elapsed - the command execution time in milliseconds
+ */
+void OMCProxy::logAsyncCommand(QString command, QString response, int elapsed)
+{
+  QTime commandTime = QTime::currentTime().addMSecs(-elapsed);
+  logCommand(command, &commandTime, false);
+  logResponse(command, response.trimmed(), &commandTime);
+}
+
 /*!
  * \brief Writes the exception to MessagesWidget.
  * \param exception
@@ -405,6 +698,8 @@ void OMCProxy::sendCustomExpression()
   if (mpExpressionTextBox->text().isEmpty())
     return;
 
+  // the custom expression can modify any class.
+  mResponseCache.clear();
   sendCommand(mpExpressionTextBox->text(), true);
   mpExpressionTextBox->setText("");
 }
@@ -424,6 +719,20 @@ void OMCProxy::openOMCDiffWidget()
   }
 }
 
+/*!
+ * \brief OMCProxy::openOMCProfilerWidget
+ * Opens the OMC Profiler widget.
+ */
+void OMCProxy::openOMCProfilerWidget()
+{
+  if (MainWindow::instance()->isDebug()) {
+    mpOMCProfilerWidget->show();
+    mpOMCProfilerWidget->raise();
+    mpOMCProfilerWidget->activateWindow();
+    mpOMCProfilerWidget->setWindowState(mpOMCProfilerWidget->windowState() & (~Qt::WindowMinimized | Qt::WindowActive));
+  }
+}
+
 /*!
   Removes the CORBA IOR file. We only call this method when we are unable to connect to OMC.\n
   In normal case OMCProxy::stopServer will delete that file.
@@ -739,7 +1048,12 @@ QStringList OMCProxy::searchClassNames(QString searchText, bool findInText)
   */
 OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString className)
 {
-  OMCInterface::getClassInformation_res classInformation = mpOMCInterface->getClassInformation(className);
+  const QString expression = "getClassInformation(" + className + ")";
+  OMCInterface::getClassInformation_res classInformation;
+  if (mResponseCache.find(expression, &classInformation)) {
+    return classInformation;
+  }
+  classInformation = mpOMCInterface->getClassInformation(className);
   QString comment = classInformation.comment.replace("\\\"", "\"");
   comment = makeDocumentationUriToFileName(comment);
   // since tooltips can't handle file:// scheme so we have to remove it in order to display images and make links work.
@@ -749,6 +1063,7 @@ OMCInterface::getClassInformation_res OMCProxy::getClassInformation(QString clas
   comment.replace("src=\"file://", "src=\"");
 #endif
   classInformation.comment = comment;
+  mResponseCache.insert(expression, className, classInformation);
   return classInformation;
 }
 
@@ -797,7 +1112,11 @@ QString OMCProxy::getBuiltinType(QString typeName)
   */
 bool OMCProxy::isWhat(StringHandler::ModelicaClasses type, QString className)
 {
+  const QString expression = QString("isWhat(%1, %2)").arg(type).arg(className);
   bool result = false;
+  if (mResponseCache.find(expression, &result)) {
+    return result;
+  }
   switch (type) {
     case StringHandler::Model:
       result = mpOMCInterface->isModel(className);
@@ -841,6 +1160,7 @@ bool OMCProxy::isWhat(StringHandler::ModelicaClasses type, QString className)
     default:
       result = false;
   }
+  mResponseCache.insert(expression, className, result);
   return result;
 }
 
@@ -889,7 +1209,12 @@ bool OMCProxy::isReplaceable(QString parentClassName, QString className)
   */
 StringHandler::ModelicaClasses OMCProxy::getClassRestriction(QString className)
 {
-  QString result = mpOMCInterface->getClassRestriction(className);
+  const QString expression = "getClassRestriction(" + className + ")";
+  QString result;
+  if (!mResponseCache.find(expression, &result)) {
+    result = mpOMCInterface->getClassRestriction(className);
+    mResponseCache.insert(expression, className, result);
+  }
 
   if (result.toLower().contains("model"))
     return StringHandler::Model;
@@ -962,6 +1287,7 @@ QString OMCProxy::getComponentModifierValue(QString className, QString name)
   */
 bool OMCProxy::setComponentModifierValue(QString className, QString modifierName, QString modifierValue)
 {
+  invalidateCachedClass(className);
   QString expression;
   if (modifierValue.isEmpty()) {
     expression = QString("setComponentModifierValue(%1, %2, $Code(()))").arg(className).arg(modifierName);
@@ -990,6 +1316,7 @@ bool OMCProxy::setComponentModifierValue(QString className, QString modifierName
  */
 bool OMCProxy::removeComponentModifiers(QString className, QString name)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->removeComponentModifiers(className, name, true);
 }
 
@@ -1031,6 +1358,7 @@ QString OMCProxy::getExtendsModifierValue(QString className, QString extendsClas
 
 bool OMCProxy::setExtendsModifierValue(QString className, QString extendsClassName, QString modifierName, QString modifierValue)
 {
+  invalidateCachedClass(className);
   QString expression;
   if (modifierValue.isEmpty()) {
     expression = QString("setExtendsModifierValue(%1, %2, %3, $Code(()))").arg(className).arg(extendsClassName).arg(modifierName);
@@ -1074,6 +1402,7 @@ bool OMCProxy::isExtendsModifierFinal(QString className, QString extendsClassNam
  */
 bool OMCProxy::removeExtendsModifiers(QString className, QString extendsClassName)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->removeExtendsModifiers(className, extendsClassName, true);
 }
 
@@ -1085,9 +1414,14 @@ bool OMCProxy::removeExtendsModifiers(QString className, QString extendsClassNam
 QString OMCProxy::getIconAnnotation(QString className)
 {
   QString expression = "getIconAnnotation(" + className + ")";
+  QString result;
+  if (mResponseCache.find(expression, &result)) {
+    return result;
+  }
   sendCommand(expression);
-  QString result = getResult();
+  result = getResult();
   printMessagesStringInternal();
+  mResponseCache.insert(expression, className, result);
   return result;
 }
 
@@ -1099,20 +1433,34 @@ QString OMCProxy::getIconAnnotation(QString className)
 QString OMCProxy::getDiagramAnnotation(QString className)
 {
   QString expression = "getDiagramAnnotation(" + className + ")";
+  QString result;
+  if (mResponseCache.find(expression, &result)) {
+    return result;
+  }
   sendCommand(expression);
-  QString result = getResult();
+  result = getResult();
   printMessagesStringInternal();
+  mResponseCache.insert(expression, className, result);
   return result;
 }
 
 /*!
   Gets the number of connection from a model.
+  The count is cached so that OMCProxy::getConnections can use the one fetched along with the components.
   \param className - is the name of the model.
   \return the number of connections.
+  \sa OMCProxy::getComponentsAndAnnotations()
   */
 int OMCProxy::getConnectionCount(QString className)
 {
-  return mpOMCInterface->getConnectionCount(className);
+  QString expression = "getConnectionCount(" + className + ")";
+  QString result;
+  if (mResponseCache.find(expression, &result)) {
+    return result.toInt();
+  }
+  int connectionCount = mpOMCInterface->getConnectionCount(className);
+  mResponseCache.insert(expression, className, QString::number(connectionCount));
+  return connectionCount;
 }
 
 /*!
@@ -1140,6 +1488,37 @@ QString OMCProxy::getNthConnectionAnnotation(QString className, int num)
   return getResult();
 }
 
+/*!
+ * \brief OMCProxy::getConnections
+ * Returns all the connections of a model along with their annotations.\n
+ * Fetches the connections and the annotations in one batch instead of calling getNthConnection and getNthConnectionAnnotation for each.\n
+ * The connection count is normally already cached by OMCProxy::getComponentsAndAnnotations.
+ * \param className - is the name of the model.
+ * \param pConnections - the list of connections i.e, {from, to, comment}
+ * \param pAnnotations - the list of connection annotations.
+ * \sa OMCProxy::getNthConnection()
+ * \sa OMCProxy::getNthConnectionAnnotation()
+ */
+void OMCProxy::getConnections(QString className, QList<QList<QString> > *pConnections, QStringList *pAnnotations)
+{
+  pConnections->clear();
+  pAnnotations->clear();
+  int connectionCount = getConnectionCount(className);
+  if (connectionCount < 1) {
+    return;
+  }
+  QStringList expressions;
+  for (int i = 1 ; i <= connectionCount ; i++) {
+    expressions << "getNthConnection(" + className + ", " + QString::number(i) + ")"
+                << "getNthConnectionAnnotation(" + className + ", " + QString::number(i) + ")";
+  }
+  QStringList results = sendCommands(expressions);
+  for (int i = 0 ; i < results.size() - 1 ; i += 2) {
+    pConnections->append(StringHandler::unparseStrings(results.at(i)));
+    pAnnotations->append(results.at(i + 1));
+  }
+}
+
 /*!
  * \brief OMCProxy::getTransitions
  * Returns the list of transitions in a class.
@@ -1215,8 +1594,17 @@ QString OMCProxy::getNthInheritedClass(QString className, int num)
  */
 QList<QString> OMCProxy::getInheritedClasses(QString className)
 {
-  QList<QString> result = mpOMCInterface->getInheritedClasses(className);
+  const QString expression = "getInheritedClasses(" + className + ")";
+  QList<QString> result;
+  if (mResponseCache.find(expression, &result)) {
+    return result;
+  }
+  result = mpOMCInterface->getInheritedClasses(className);
   printMessagesStringInternal();
+  mResponseCache.insert(expression, className, result);
+  foreach (QString inheritedClass, result) {
+    mResponseCache.addDependency(inheritedClass, className);
+  }
   return result;
 }
 
@@ -1230,17 +1618,31 @@ QList<QString> OMCProxy::getInheritedClasses(QString className)
 QList<ComponentInfo*> OMCProxy::getComponents(QString className)
 {
   QString expression = "getComponents(" + className + ", useQuotes = true)";
-  sendCommand(expression);
-  QString result = getResult();
+  QString result;
+  if (!mResponseCache.find(expression, &result)) {
+    sendCommand(expression);
+    result = getResult();
+    mResponseCache.insert(expression, className, result);
+  }
+  return parseComponents(result);
+}
+
+/*!
+ * \brief OMCProxy::parseComponents
+ * Parses the result of getComponents and creates an object of ComponentInfo for each component.
+ * \param result - the getComponents result.
+ * \return the list of components
+ */
+QList<ComponentInfo*> OMCProxy::parseComponents(QString result)
+{
   QList<ComponentInfo*> componentInfoList;
-  QStringList list = StringHandler::unparseArrays(result);
+  // unparse the strings of each component in place instead of copying the component info strings first.
+  QList<QPair<int, int> > ranges = StringHandler::unparseArraysRanges(result);
+  componentInfoList.reserve(ranges.size());
 
-  for (int i = 0 ; i < list.size() ; i++) {
-    if (list.at(i) == "Error") {
-      continue;
-    }
+  for (int i = 0 ; i < ranges.size() ; i++) {
     ComponentInfo *pComponentInfo = new ComponentInfo();
-    pComponentInfo->parseComponentInfoString(list.at(i));
+    pComponentInfo->parseComponentInfo(StringHandler::unparseStrings(result, ranges.at(i).first, ranges.at(i).second));
     componentInfoList.append(pComponentInfo);
   }
 
@@ -1255,8 +1657,47 @@ QList<ComponentInfo*> OMCProxy::getComponents(QString className)
 QStringList OMCProxy::getComponentAnnotations(QString className)
 {
   QString expression = "getComponentAnnotations(" + className + ")";
-  sendCommand(expression);
-  return StringHandler::getStrings(StringHandler::removeFirstLastCurlBrackets(getResult()));
+  QString result;
+  if (!mResponseCache.find(expression, &result)) {
+    sendCommand(expression);
+    result = getResult();
+    mResponseCache.insert(expression, className, result);
+  }
+  return StringHandler::getStringsInCurlBrackets(result);
+}
+
+/*!
+ * \brief OMCProxy::getComponentsAndAnnotations
+ * Gets the components and the component annotations of a model in one OMC call.\n
+ * The connection count is fetched in the same batch and cached so that OMCProxy::getConnections doesn't need a round trip for it.
+ * \param className - is the name of the model.
+ * \param pComponents - the list of components.
+ * \param pAnnotations - the list of component annotations.
+ * \sa OMCProxy::getComponents()
+ * \sa OMCProxy::getComponentAnnotations()
+ */
+void OMCProxy::getComponentsAndAnnotations(QString className, QList<ComponentInfo*> *pComponents, QStringList *pAnnotations)
+{
+  QStringList expressions;
+  expressions << "getComponents(" + className + ", useQuotes = true)"
+              << "getComponentAnnotations(" + className + ")"
+              << "getConnectionCount(" + className + ")";
+  QStringList results;
+  QString componentsResult, annotationsResult;
+  if (mResponseCache.find(expressions.at(0), &componentsResult) && mResponseCache.find(expressions.at(1), &annotationsResult)) {
+    results << componentsResult << annotationsResult;
+  } else {
+    results = sendCommands(expressions);
+    mResponseCache.insert(expressions.at(0), className, results.at(0));
+    mResponseCache.insert(expressions.at(1), className, results.at(1));
+    mResponseCache.insert(expressions.at(2), className, results.at(2));
+  }
+  *pComponents = parseComponents(results.at(0));
+  if (pComponents->isEmpty()) {
+    pAnnotations->clear();
+  } else {
+    *pAnnotations = StringHandler::getStringsInCurlBrackets(results.at(1));
+  }
 }
 
 QString OMCProxy::getDocumentationAnnotationInfoHeader(LibraryTreeItem *pLibraryTreeItem, QString infoHeader)
@@ -1404,6 +1845,7 @@ QString OMCProxy::changeDirectory(QString directory)
   */
 bool OMCProxy::loadModel(QString className, QString priorityVersion, bool notify, QString languageStandard, bool requireExactVersion)
 {
+  mResponseCache.clear();
   bool result = false;
   QList<QString> priorityVersionList;
   priorityVersionList << priorityVersion;
@@ -1419,6 +1861,7 @@ bool OMCProxy::loadModel(QString className, QString priorityVersion, bool notify
   */
 bool OMCProxy::loadFile(QString fileName, QString encoding, bool uses)
 {
+  mResponseCache.clear();
   bool result = false;
   fileName = fileName.replace('\\', '/');
   result = mpOMCInterface->loadFile(fileName, encoding, uses);
@@ -1438,6 +1881,8 @@ bool OMCProxy::loadFile(QString fileName, QString encoding, bool uses)
  */
 bool OMCProxy::loadString(QString value, QString fileName, QString encoding, bool merge, bool checkError)
 {
+  // the loaded text can redefine any class that is not part of a system library.
+  invalidateCachedUserClasses();
   bool result = mpOMCInterface->loadString(value, fileName, encoding, merge);
   if (checkError) {
     printMessagesStringInternal();
@@ -1502,6 +1947,7 @@ bool OMCProxy::createClass(QString type, QString className, LibraryTreeItem *pEx
     expression = QString("%1 %2 extends %3; %4 end %5;").arg(type).arg(className).arg(pExtendsLibraryTreeItem->getNameStructure())
                  .arg(equationOrAlgorithm).arg(className);
   }
+  invalidateCachedClass(className);
   return loadString(expression, className, Helper::utf8, false, false);
 }
 
@@ -1538,6 +1984,7 @@ bool OMCProxy::createSubClass(QString type, QString className, LibraryTreeItem *
   } else {
     fileName = pParentLibraryTreeItem->getNameStructure() + "." + className;
   }
+  invalidateCachedClass(pParentLibraryTreeItem->getNameStructure() + "." + className);
   return loadString(expression, fileName, Helper::utf8, false, false);
 }
 
@@ -1562,6 +2009,8 @@ bool OMCProxy::existClass(QString className)
   */
 bool OMCProxy::renameClass(QString oldName, QString newName)
 {
+  invalidateCachedClass(oldName);
+  invalidateCachedClass(newName);
   sendCommand("renameClass(" + oldName + ", " + newName + ")");
   if (StringHandler::unparseBool(getResult()))
     return false;
@@ -1576,6 +2025,7 @@ bool OMCProxy::renameClass(QString oldName, QString newName)
   */
 bool OMCProxy::deleteClass(QString className)
 {
+  invalidateCachedClass(className);
   sendCommand("deleteClass(" + className + ")");
   if (StringHandler::unparseBool(getResult()))
     return true;
@@ -1608,6 +2058,7 @@ QString OMCProxy::getSourceFile(QString className)
  */
 bool OMCProxy::setSourceFile(QString className, QString path)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->setSourceFile(className, path);
 }
 
@@ -1630,6 +2081,7 @@ bool OMCProxy::save(QString className)
 
 bool OMCProxy::saveModifiedModel(QString modelText)
 {
+  mResponseCache.clear();
   sendCommand(modelText);
   if (getResult().toLower().contains("error"))
     return false;
@@ -1722,6 +2174,7 @@ QString OMCProxy::diffModelicaFileListings(QString before, QString after)
  */
 bool OMCProxy::addClassAnnotation(QString className, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand("addClassAnnotation(" + className + ", " + annotation + ")");
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -1769,6 +2222,7 @@ QString OMCProxy::getDefaultComponentPrefixes(QString className)
   */
 bool OMCProxy::addComponent(QString name, QString className, QString componentName, QString placementAnnotation)
 {
+  invalidateCachedClass(componentName);
   sendCommand("addComponent(" + name + ", " + className + "," + componentName + "," + placementAnnotation + ")");
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -1785,6 +2239,7 @@ bool OMCProxy::addComponent(QString name, QString className, QString componentNa
   */
 bool OMCProxy::deleteComponent(QString name, QString componentName)
 {
+  invalidateCachedClass(componentName);
   sendCommand("deleteComponent(" + name + "," + componentName + ")");
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -1804,6 +2259,7 @@ bool OMCProxy::deleteComponent(QString name, QString componentName)
   */
 bool OMCProxy::renameComponent(QString className, QString oldName, QString newName)
 {
+  invalidateCachedClass(className);
   sendCommand("renameComponent(" + className + "," + oldName + "," + newName + ")");
   if (getResult().toLower().contains("error")) {
     return false;
@@ -1822,6 +2278,7 @@ bool OMCProxy::renameComponent(QString className, QString oldName, QString newNa
   */
 bool OMCProxy::updateComponent(QString name, QString className, QString componentName, QString placementAnnotation)
 {
+  invalidateCachedClass(componentName);
   sendCommand("updateComponent(" + name + "," + className + "," + componentName + "," + placementAnnotation + ")");
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -1840,6 +2297,7 @@ bool OMCProxy::updateComponent(QString name, QString className, QString componen
   */
 bool OMCProxy::renameComponentInClass(QString className, QString oldName, QString newName)
 {
+  invalidateCachedClass(className);
   sendCommand("renameComponentInClass(" + className + "," + oldName + "," + newName + ")");
   if (getResult().toLower().contains("error")) {
     return false;
@@ -1858,6 +2316,7 @@ bool OMCProxy::renameComponentInClass(QString className, QString oldName, QStrin
   */
 bool OMCProxy::updateConnection(QString from, QString to, QString className, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand("updateConnection(" + from + "," + to + "," + className + "," + annotation + ")");
   if (getResult().toLower().compare("ok") == 0) {
     return true;
@@ -1883,6 +2342,7 @@ bool OMCProxy::updateConnection(QString from, QString to, QString className, QSt
 bool OMCProxy::setComponentProperties(QString className, QString componentName, QString isFinal, QString isFlow, QString isProtected,
                                       QString isReplaceAble, QString variability, QString isInner, QString isOuter, QString causality)
 {
+  invalidateCachedClass(className);
   sendCommand("setComponentProperties(" + className + "," + componentName + ",{" + isFinal + "," + isFlow + "," + isProtected +
               "," + isReplaceAble + "}, {\"" + variability + "\"}, {" + isInner + "," + isOuter + "}, {\"" + causality + "\"})");
 
@@ -1901,6 +2361,7 @@ bool OMCProxy::setComponentProperties(QString className, QString componentName,
   */
 bool OMCProxy::setComponentComment(QString className, QString componentName, QString comment)
 {
+  invalidateCachedClass(className);
   sendCommand("setComponentComment(" + className + "," + componentName + ",\"" + comment + "\")");
   if (getResult().toLower().contains("error"))
     return false;
@@ -1918,6 +2379,7 @@ bool OMCProxy::setComponentComment(QString className, QString componentName, QSt
  */
 bool OMCProxy::setComponentDimensions(QString className, QString componentName, QString dimensions)
 {
+  invalidateCachedClass(className);
   sendCommand("setComponentDimensions(" + className + "," + componentName + "," + dimensions + ")");
   if (getResult().toLower().compare("ok") == 0) {
     return true;
@@ -1936,6 +2398,7 @@ bool OMCProxy::setComponentDimensions(QString className, QString componentName,
  */
 bool OMCProxy::addConnection(QString from, QString to, QString className, QString annotation)
 {
+  invalidateCachedClass(className);
   if (annotation.compare("annotate=Line()") == 0) {
     sendCommand("addConnection(" + from + "," + to + "," + className + ")");
   } else {
@@ -1957,6 +2420,7 @@ bool OMCProxy::addConnection(QString from, QString to, QString className, QStrin
   */
 bool OMCProxy::deleteConnection(QString from, QString to, QString className)
 {
+  invalidateCachedClass(className);
   sendCommand("deleteConnection(" + from + "," + to + "," + className + ")");
   if (getResult().toLower().compare("ok") == 0) {
     return true;
@@ -1983,6 +2447,7 @@ bool OMCProxy::deleteConnection(QString from, QString to, QString className)
 bool OMCProxy::addTransition(QString className, QString from, QString to, QString condition, bool immediate, bool reset, bool synchronize,
                              int priority, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand(QString("addTransition(%1, \"%2\", \"%3\", \"%4\", %5, %6, %7, %8, %9)").arg(className).arg(from).arg(to)
               .arg(StringHandler::escapeString(condition)).arg(immediate ? "true" : "false").arg(reset ? "true" : "false")
               .arg(synchronize ? "true" : "false").arg(priority).arg(annotation));
@@ -2009,6 +2474,7 @@ bool OMCProxy::addTransition(QString className, QString from, QString to, QStrin
 bool OMCProxy::deleteTransition(QString className, QString from, QString to, QString condition, bool immediate, bool reset, bool synchronize,
                                 int priority)
 {
+  invalidateCachedClass(className);
   bool result = mpOMCInterface->deleteTransition(className, from, to, condition, immediate, reset, synchronize, priority);
   if (!result) {
     printMessagesStringInternal();
@@ -2039,6 +2505,7 @@ bool OMCProxy::updateTransition(QString className, QString from, QString to, QSt
                                 bool oldSynchronize, int oldPriority, QString condition, bool immediate, bool reset, bool synchronize,
                                 int priority, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand(QString("updateTransition(%1, \"%2\", \"%3\", \"%4\", %5, %6, %7, %8, \"%9\", %10, %11, %12, %13, %14)").arg(className).arg(from)
               .arg(to).arg(StringHandler::escapeString(oldCondition)).arg(oldImmediate ? "true" : "false").arg(oldReset ? "true" : "false")
               .arg(oldSynchronize ? "true" : "false").arg(oldPriority).arg(StringHandler::escapeString(condition))
@@ -2062,6 +2529,7 @@ bool OMCProxy::updateTransition(QString className, QString from, QString to, QSt
  */
 bool OMCProxy::addInitialState(QString className, QString state, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand(QString("addInitialState(%1, \"%2\", %3)").arg(className).arg(state).arg(annotation));
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -2080,6 +2548,7 @@ bool OMCProxy::addInitialState(QString className, QString state, QString annotat
  */
 bool OMCProxy::deleteInitialState(QString className, QString state)
 {
+  invalidateCachedClass(className);
   bool result = mpOMCInterface->deleteInitialState(className, state);
   if (!result) {
     printMessagesStringInternal();
@@ -2097,6 +2566,7 @@ bool OMCProxy::deleteInitialState(QString className, QString state)
  */
 bool OMCProxy::updateInitialState(QString className, QString state, QString annotation)
 {
+  invalidateCachedClass(className);
   sendCommand(QString("updateInitialState(%1, \"%2\", %9)").arg(className).arg(state).arg(annotation));
   if (StringHandler::unparseBool(getResult())) {
     return true;
@@ -2211,9 +2681,30 @@ bool OMCProxy::closeSimulationResultFile()
 QString OMCProxy::checkModel(QString className)
 {
   QString result = mpOMCInterface->checkModel(className);
+  finishModelCheck();
+  return result;
+}
+
+/*!
+ * \brief OMCProxy::checkModelAsync
+ * Checks the model on the OMCCommandThread.\n
+ * Call OMCProxy::finishModelCheck() when the future is finished.
+ * \param className - the name of the class.
+ * \return the future holding the OMC reply of the model check.
+ */
+QFuture<QString> OMCProxy::checkModelAsync(QString className)
+{
+  return sendCommandAsync(QString("checkModel(%1)").arg(className), OMCCommandThread::HighPriority);
+}
+
+/*!
+ * \brief OMCProxy::finishModelCheck
+ * Prints the messages of the model check or instantiation and loads the libraries it has loaded in OMC.
+ */
+void OMCProxy::finishModelCheck()
+{
   printMessagesStringInternal();
   MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
-  return result;
 }
 
 /*!
@@ -2238,11 +2729,22 @@ bool OMCProxy::ngspicetoModelica(QString fileName)
 QString OMCProxy::checkAllModelsRecursive(QString className)
 {
   QString result = mpOMCInterface->checkAllModelsRecursive(className, false);
-  printMessagesStringInternal();
-  MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
+  finishModelCheck();
   return result;
 }
 
+/*!
+ * \brief OMCProxy::checkAllModelsRecursiveAsync
+ * Checks all nested modelica classes on the OMCCommandThread.\n
+ * Call OMCProxy::finishModelCheck() when the future is finished.
+ * \param className - the name of the class.
+ * \return the future holding the OMC reply of the models check.
+ */
+QFuture<QString> OMCProxy::checkAllModelsRecursiveAsync(QString className)
+{
+  return sendCommandAsync(QString("checkAllModelsRecursive(%1, false)").arg(className), OMCCommandThread::HighPriority);
+}
+
 /*!
  * \brief OMCProxy::instantiateModel
  * Instantiates the model.
@@ -2252,11 +2754,22 @@ QString OMCProxy::checkAllModelsRecursive(QString className)
 QString OMCProxy::instantiateModel(QString className)
 {
   QString result = mpOMCInterface->instantiateModel(className);
-  printMessagesStringInternal();
-  MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->loadDependentLibraries(getClassNames());
+  finishModelCheck();
   return result;
 }
 
+/*!
+ * \brief OMCProxy::instantiateModelAsync
+ * Instantiates the model on the OMCCommandThread.\n
+ * Call OMCProxy::finishModelCheck() when the future is finished.
+ * \param className - the name of the class.
+ * \return the future holding the OMC reply of the instantiation.
+ */
+QFuture<QString> OMCProxy::instantiateModelAsync(QString className)
+{
+  return sendCommandAsync(QString("instantiateModel(%1)").arg(className), OMCCommandThread::HighPriority);
+}
+
 /*!
  * \brief OMCProxy::isExperiment
  * Returns the simulation options stored in the model.
@@ -2440,6 +2953,7 @@ bool OMCProxy::setIndexReductionMethod(QString method)
  */
 bool OMCProxy::setCommandLineOptions(QString options)
 {
+  mResponseCache.clear(false);
   bool result = mpOMCInterface->setCommandLineOptions(options);
   if (!result) {
     printMessagesStringInternal();
@@ -2454,6 +2968,7 @@ bool OMCProxy::setCommandLineOptions(QString options)
  */
 bool OMCProxy::clearCommandLineOptions()
 {
+  mResponseCache.clear(false);
   bool result = mpOMCInterface->clearCommandLineOptions();
   if (result) {
     return true;
@@ -2816,6 +3331,7 @@ bool OMCProxy::exportToFigaro(QString className, QString directory, QString data
  */
 bool OMCProxy::copyClass(QString className, QString newClassName, QString withIn)
 {
+  invalidateCachedClass(withIn.isEmpty() ? newClassName : withIn + "." + newClassName);
   bool result = mpOMCInterface->copyClass(className, newClassName, withIn.isEmpty() ? "TopLevel" : withIn);
   if (!result) printMessagesStringInternal();
   return result;
@@ -2937,6 +3453,7 @@ void OMCProxy::getLogStreams(QStringList *names, QStringList *descriptions)
  */
 bool OMCProxy::moveClass(QString className, int offset)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->moveClass(className, offset);
 }
 
@@ -2948,6 +3465,7 @@ bool OMCProxy::moveClass(QString className, int offset)
  */
 bool OMCProxy::moveClassToTop(QString className)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->moveClassToTop(className);
 }
 
@@ -2959,6 +3477,7 @@ bool OMCProxy::moveClassToTop(QString className)
  */
 bool OMCProxy::moveClassToBottom(QString className)
 {
+  invalidateCachedClass(className);
   return mpOMCInterface->moveClassToBottom(className);
 }
 
@@ -2970,6 +3489,7 @@ bool OMCProxy::moveClassToBottom(QString className)
  */
 bool OMCProxy::inferBindings(QString className)
 {
+  invalidateCachedClass(className);
   bool result = mpOMCInterface->inferBindings(className);
   printMessagesStringInternal();
   return result;
@@ -3042,6 +3562,7 @@ QList<QString> OMCProxy::parseEncryptedPackage(QString fileName, QString working
  */
 bool OMCProxy::loadEncryptedPackage(QString fileName, QString workingDirectory)
 {
+  mResponseCache.clear();
   bool result = mpOMCInterface->loadEncryptedPackage(fileName, workingDirectory);
   printMessagesStringInternal();
   return result;
@@ -39,6 +39,14 @@
 #include "Util/StringHandler.h"
 #include "Util/Helper.h"
 #include "Util/Utilities.h"
+#include "OMCCommandThread.h"
+#include "OMCProfiler.h"
+#include "OMCLogger.h"
+
+#include <QCache>
+#include <QSet>
+#include <QListView>
+#include <QSplitter>
 
 class CustomExpressionBox;
 class ComponentInfo;
@@ -46,12 +54,123 @@ class StringHandler;
 class OMCInterface;
 class LibraryTreeItem;
 
+/*!
+ * \class OMCInterfaceLocker
+ * \brief Holds the OMC mutex for the duration of one OMCInterface call.\n
+ * It is returned by value from OMCInterfacePointer::operator->() so the mutex is taken before the call and released at the end
+ * of the full expression, also when the call fails and only emits throwException.
+ */
+class OMCInterfaceLocker
+{
+public:
+  OMCInterfaceLocker(OMCInterface *pOMCInterface, QMutex *pOMCMutex)
+    : mpOMCInterface(pOMCInterface), mpOMCMutex(pOMCMutex) {mpOMCMutex->lock();}
+  // the OMC mutex is recursive so a copy can simply take it once more.
+  OMCInterfaceLocker(const OMCInterfaceLocker &other)
+    : mpOMCInterface(other.mpOMCInterface), mpOMCMutex(other.mpOMCMutex) {mpOMCMutex->lock();}
+  ~OMCInterfaceLocker() {mpOMCMutex->unlock();}
+  OMCInterface* operator->() const {return mpOMCInterface;}
+private:
+  OMCInterfacePointer mpOMCInterface;
+  QMutex *mpOMCMutex;
+
+  OMCInterfaceLocker& operator=(const OMCInterfaceLocker &other);
+};
+
+/*!
+ * \class OMCInterfacePointer
+ * \brief Pointer to the OMCInterface that locks the OMC mutex around every call made through it.\n
+ * The OMCInterface calls can't be run at the same time as the OMCCommandThread commands.
+ */
+class OMCInterfacePointer
+{
+public:
+  OMCInterfacePointer() : mpOMCInterface(0), mpOMCMutex(0) {}
+  void reset(OMCInterface *pOMCInterface, QMutex *pOMCMutex) {mpOMCInterface = pOMCInterface; mpOMCMutex = pOMCMutex;}
+  OMCInterface* data() const {return mpOMCInterface;}
+  OMCInterfaceLocker operator->() const {return OMCInterfaceLocker(mpOMCInterface, mpOMCMutex);}
+private:
+  OMCInterface *mpOMCInterface;
+  QMutex *mpOMCMutex;
+};
+
 typedef struct {
   QString mFromUnit;
   QString mToUnit;
   OMCInterface::convertUnits_res mConvertUnits;
 } UnitConverion;
 
+/*!
+ * \class OMCResponseCache
+ * \brief LRU cache for the results of read-only OMC queries keyed by the expression string.\n
+ * Each entry is tagged with the generation of the class it belongs to. Invalidating a class bumps its generation
+ * so the stale entries are dropped lazily on the next lookup.
+ */
+class OMCResponseCache
+{
+private:
+  class Entry
+  {
+  public:
+    Entry(const QString &className, quint64 generation) : mpCache(0), mClassName(className), mGeneration(generation) {}
+    // QCache deletes the entry when it is evicted so the entry removes itself from the class index.
+    virtual ~Entry() {if (mpCache) mpCache->removeExpressionIndex(mClassName, mExpression);}
+    OMCResponseCache *mpCache;
+    QString mExpression;
+    QString mClassName;
+    quint64 mGeneration;
+  };
+  template <typename T>
+  class ValueEntry : public Entry
+  {
+  public:
+    ValueEntry(const QString &className, quint64 generation, const T &value) : Entry(className, generation), mValue(value) {}
+    T mValue;
+  };
+public:
+  OMCResponseCache(int maxEntries = 5000);
+  ~OMCResponseCache();
+  template <typename T>
+  bool find(const QString &expression, T *pValue)
+  {
+    ValueEntry<T> *pValueEntry = dynamic_cast<ValueEntry<T>*>(findEntry(expression));
+    if (pValueEntry) {
+      *pValue = pValueEntry->mValue;
+      return true;
+    }
+    return false;
+  }
+  template <typename T>
+  void insert(const QString &expression, const QString &className, const T &value)
+  {
+    insertEntry(expression, new ValueEntry<T>(className, 0, value));
+  }
+  void addDependency(const QString &baseClassName, const QString &className);
+  void invalidateClass(const QString &className);
+  void invalidateAllExcept(const QStringList &topLevelClasses);
+  void clear(bool classesChanged = true);
+  int getHits() const {return mHits;}
+  int getMisses() const {return mMisses;}
+  int size() const {return mEntries.size();}
+  quint64 getChangeCount() const {return mChangeCount;}
+private:
+  QCache<QString, Entry> mEntries;
+  QHash<QString, QSet<QString> > mClassExpressions;
+  QHash<QString, quint64> mGenerations;
+  QHash<QString, QSet<QString> > mDependents;
+  quint64 mCurrentGeneration;
+  // the number of times the loaded classes are changed.
+  quint64 mChangeCount;
+  int mHits;
+  int mMisses;
+
+  Entry* findEntry(const QString &expression);
+  void insertEntry(const QString &expression, Entry *pEntry);
+  void removeClassEntries(const QString &className);
+  void removeExpressionIndex(const QString &className, const QString &expression);
+  void invalidateClassHelper(const QString &className, QSet<QString> *pInvalidatedClasses);
+};
+
 class OMCProxy : public QObject
 {
   Q_OBJECT
@@ -61,8 +180,10 @@ private:
   QWidget *mpOMCLoggerWidget;
   CustomExpressionBox *mpExpressionTextBox;
   QPushButton *mpOMCLoggerSendButton;
-  QPlainTextEdit *mpOMCLoggerTextBox;
-  QTextCursor mOMCLoggerTextCursor;
+  OMCLoggerModel *mpOMCLoggerModel;
+  QListView *mpOMCLoggerListView;
+  QPlainTextEdit *mpOMCLoggerEntryTextBox;
+  bool mOMCLoggerAtBottom;
   QWidget *mpOMCDiffWidget;
   Label *mpOMCDiffBeforeLabel;
   QPlainTextEdit *mpOMCDiffBeforeTextBox;
@@ -73,14 +194,22 @@ private:
   QString mObjectRefFile;
   QList<QString> mCommandsList;
   int mCurrentCommandIndex;
-  FILE *mpCommunicationLogFile;
-  FILE *mpCommandsLogFile;
-  double mTotalOMCCallsTime;
+  OMCLogWriterThread *mpOMCLogWriterThread;
   QList<UnitConverion> mUnitConversionList;
   QMap<QString, QList<QString> > mDerivedUnitsMap;
   OMCInterface *mpOMCInterface;
   bool mIsLoggingEnabled;
+  OMCResponseCache mResponseCache;
+  QMutex mOMCMutex;
+  OMCProfiler mOMCProfiler;
+  OMCProfilerWidget *mpOMCProfilerWidget;
+  OMCCommandThread *mpOMCCommandThread;
+
+  QList<ComponentInfo*> parseComponents(QString result);
+  void invalidateCachedClass(const QString &className) {mResponseCache.invalidateClass(className);}
 public:
+  void invalidateCachedUserClasses();
+  quint64 getLoadedClassesChangeCount() const {return mResponseCache.getChangeCount();}
   OMCProxy(threadData_t *threadData, QWidget *pParent = 0);
   ~OMCProxy();
   void getPreviousCommand();
@@ -88,12 +217,16 @@ public:
   bool initializeOMC(threadData_t *threadData);
   void quitOMC();
   void sendCommand(const QString expression, bool saveToHistory = false);
+  QStringList sendCommands(const QStringList expressions);
+  QFuture<QString> sendCommandAsync(const QString expression, OMCCommandThread::Priority priority = OMCCommandThread::NormalPriority);
   void setResult(QString value);
   QString getResult();
   void exitApplication();
   void removeObjectRefFile();
   void setLoggingEnabled(bool enable) {mIsLoggingEnabled = enable;}
   bool isLoggingEnabled() {return mIsLoggingEnabled;}
+  OMCResponseCache* getResponseCache() {return &mResponseCache;}
+  OMCProfiler* getOMCProfiler() {return &mOMCProfiler;}
   QString getErrorString(bool warningsAsErrors = false);
   bool printMessagesStringInternal();
   int getMessagesStringInternal();
@@ -145,6 +278,8 @@ public:
   QList<QString> getInheritedClasses(QString className);
   QList<ComponentInfo*> getComponents(QString className);
   QStringList getComponentAnnotations(QString className);
+  void getComponentsAndAnnotations(QString className, QList<ComponentInfo*> *pComponents, QStringList *pAnnotations);
+  void getConnections(QString className, QList<QList<QString> > *pConnections, QStringList *pAnnotations);
   QString getDocumentationAnnotationInfoHeader(LibraryTreeItem *pLibraryTreeItem, QString infoHeader);
   QString getDocumentationAnnotation(LibraryTreeItem *pLibraryTreeItem);
   QList<QString> getDocumentationAnnotationInClass(LibraryTreeItem *pLibraryTreeItem);
@@ -170,6 +305,7 @@ public:
   QString listFile(QString className, bool nestedClasses = true);
   QString diffModelicaFileListings(QString before, QString after);
   QString instantiateModel(QString className);
+  QFuture<QString> instantiateModelAsync(QString className);
   bool addClassAnnotation(QString className, QString annotation);
   QString getDefaultComponentName(QString className);
   QString getDefaultComponentPrefixes(QString className);
@@ -202,8 +338,11 @@ public:
   QStringList readSimulationResultVars(QString fileName);
   bool closeSimulationResultFile();
   QString checkModel(QString className);
+  QFuture<QString> checkModelAsync(QString className);
   bool ngspicetoModelica(QString fileName);
   QString checkAllModelsRecursive(QString className);
+  QFuture<QString> checkAllModelsRecursiveAsync(QString className);
+  void finishModelCheck();
   bool isExperiment(QString className);
   OMCInterface::getSimulationOptions_res getSimulationOptions(QString className, double defaultTolerance = 1e-6);
   QString buildModelFMU(QString className, QString version, QString type, QString fileNamePrefix, QList<QString> platforms, bool includeResources = true);
@@ -269,6 +408,12 @@ public slots:
   void openOMCLoggerWidget();
   void sendCustomExpression();
   void openOMCDiffWidget();
+  void openOMCProfilerWidget();
+private slots:
+  void logAsyncCommand(QString command, QString response, int elapsed);
+  void omcLoggerRowsAboutToBeInserted();
+  void omcLoggerRowsInserted();
+  void showOMCLoggerEntry(const QModelIndex &index);
 };
 
 class CustomExpressionBox : public QLineEdit
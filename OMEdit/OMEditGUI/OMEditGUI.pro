@@ -125,9 +125,14 @@ SOURCES += main.cpp \
   MainWindow.cpp \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.cpp \
   OMC/OMCProxy.cpp \
+  OMC/OMCCommandThread.cpp \
+  OMC/OMCProfiler.cpp \
+  OMC/OMCLogger.cpp \
   Modeling/MessagesWidget.cpp \
   Modeling/ItemDelegate.cpp \
   Modeling/LibraryTreeWidget.cpp \
+  Modeling/LibraryMetadataCache.cpp \
+  Modeling/LibraryIconCache.cpp \
   Modeling/Commands.cpp \
   Modeling/CoOrdinateSystem.cpp \
   Modeling/ModelWidgetContainer.cpp \
@@ -146,6 +151,7 @@ SOURCES += main.cpp \
   Editors/HTMLEditor.cpp \
   Plotting/PlotWindowContainer.cpp \
   Component/Component.cpp \
+  Annotations/AnnotationNode.cpp \
   Annotations/ShapeAnnotation.cpp \
   Component/CornerItem.cpp \
   Annotations/LineAnnotation.cpp \
@@ -161,6 +167,9 @@ SOURCES += main.cpp \
   Simulation/SimulationDialog.cpp \
   Simulation/SimulationOutputWidget.cpp \
   Simulation/SimulationProcessThread.cpp \
+  Simulation/SimulationJobScheduler.cpp \
+  Simulation/ParameterSweep.cpp \
+  Simulation/CompilationCache.cpp \
   Simulation/SimulationOutputHandler.cpp \
   Simulation/OpcUaClient.cpp \
   TLM/FetchInterfaceDataDialog.cpp \
@@ -171,6 +180,10 @@ SOURCES += main.cpp \
   FMI/ImportFMUDialog.cpp \
   FMI/ImportFMUModelDescriptionDialog.cpp \
   Plotting/VariablesWidget.cpp \
+  Plotting/ResultFileReader.cpp \
+  Plotting/ResultFileLoader.cpp \
+  Plotting/PlotCurveLevelOfDetail.cpp \
+  Plotting/LiveResultReader.cpp \
   Plotting/DiagramWindow.cpp \
   Options/NotificationsDialog.cpp \
   Annotations/ShapePropertiesDialog.cpp \
@@ -214,9 +227,14 @@ HEADERS  += Util/Helper.h \
   MainWindow.h \
   $$OPENMODELICAHOME/include/omc/scripting-API/OpenModelicaScriptingAPIQt.h \
   OMC/OMCProxy.h \
+  OMC/OMCCommandThread.h \
+  OMC/OMCProfiler.h \
+  OMC/OMCLogger.h \
   Modeling/MessagesWidget.h \
   Modeling/ItemDelegate.h \
   Modeling/LibraryTreeWidget.h \
+  Modeling/LibraryMetadataCache.h \
+  Modeling/LibraryIconCache.h \
   Modeling/Commands.h \
   Modeling/CoOrdinateSystem.h \
   Modeling/ModelWidgetContainer.h \
@@ -235,6 +253,7 @@ HEADERS  += Util/Helper.h \
   Editors/HTMLEditor.h \
   Plotting/PlotWindowContainer.h \
   Component/Component.h \
+  Annotations/AnnotationNode.h \
   Annotations/ShapeAnnotation.h \
   Component/CornerItem.h \
   Annotations/LineAnnotation.h \
@@ -251,6 +270,9 @@ HEADERS  += Util/Helper.h \
   Simulation/SimulationDialog.h \
   Simulation/SimulationOutputWidget.h \
   Simulation/SimulationProcessThread.h \
+  Simulation/SimulationJobScheduler.h \
+  Simulation/ParameterSweep.h \
+  Simulation/CompilationCache.h \
   Simulation/SimulationOutputHandler.h \
   Simulation/OpcUaClient.h \
   TLM/FetchInterfaceDataDialog.h \
@@ -262,6 +284,10 @@ HEADERS  += Util/Helper.h \
   FMI/ImportFMUDialog.h \
   FMI/ImportFMUModelDescriptionDialog.h \
   Plotting/VariablesWidget.h \
+  Plotting/ResultFileReader.h \
+  Plotting/ResultFileLoader.h \
+  Plotting/PlotCurveLevelOfDetail.h \
+  Plotting/LiveResultReader.h \
   Plotting/DiagramWindow.h \
   Options/NotificationsDialog.h \
   Annotations/ShapePropertiesDialog.h \
@@ -210,6 +210,10 @@ void OptionsDialog::readGeneralSettings()
   if (mpSettings->contains("libraryIconSize")) {
     mpGeneralSettingsPage->getLibraryIconSizeSpinBox()->setValue(mpSettings->value("libraryIconSize").toInt());
   }
+  // read library prefetch levels
+  if (mpSettings->contains("libraryPrefetchLevels")) {
+    mpGeneralSettingsPage->getLibraryPrefetchLevelsSpinBox()->setValue(mpSettings->value("libraryPrefetchLevels").toInt());
+  }
   // read show protected classes
   if (mpSettings->contains("showProtectedClasses")) {
     mpGeneralSettingsPage->setShowProtectedClasses(mpSettings->value("showProtectedClasses").toBool());
@@ -614,9 +618,24 @@ void OptionsDialog::readSimulationSettings()
   if (mpSettings->contains("simulation/deleteEntireSimulationDirectory")) {
     mpSimulationPage->getDeleteEntireSimulationDirectoryCheckBox()->setChecked(mpSettings->value("simulation/deleteEntireSimulationDirectory").toBool());
   }
+  if (mpSettings->contains("simulation/parallelCompilations")) {
+    mpSimulationPage->getParallelCompilationsSpinBox()->setValue(mpSettings->value("simulation/parallelCompilations").toInt());
+  }
+  if (mpSettings->contains("simulation/parallelSimulations")) {
+    mpSimulationPage->getParallelSimulationsSpinBox()->setValue(mpSettings->value("simulation/parallelSimulations").toInt());
+  }
+  if (mpSettings->contains("simulation/compilationCacheSize")) {
+    mpSimulationPage->getCompilationCacheSizeSpinBox()->setValue(mpSettings->value("simulation/compilationCacheSize").toInt());
+  }
   if (mpSettings->contains("simulation/outputMode")) {
     mpSimulationPage->setOutputMode(mpSettings->value("simulation/outputMode").toString());
   }
+  if (mpSettings->contains("simulation/outputSize")) {
+    mpSimulationPage->getOutputSizeSpinBox()->setValue(mpSettings->value("simulation/outputSize").toInt());
+  }
+  if (mpSettings->contains("simulation/saveRemovedOutput")) {
+    mpSimulationPage->getSaveRemovedOutputCheckBox()->setChecked(mpSettings->value("simulation/saveRemovedOutput").toBool());
+  }
 }
 //! Reads the Messages section settings from omedit.ini
 void OptionsDialog::readMessagesSettings()
@@ -958,6 +977,8 @@ void OptionsDialog::saveGeneralSettings()
   mpSettings->setValue("activateAccessAnnotations", mpGeneralSettingsPage->getActivateAccessAnnotationsComboBox()->itemData(mpGeneralSettingsPage->getActivateAccessAnnotationsComboBox()->currentIndex()).toInt());
   // save library icon size
   mpSettings->setValue("libraryIconSize", mpGeneralSettingsPage->getLibraryIconSizeSpinBox()->value());
+  // save library prefetch levels
+  mpSettings->setValue("libraryPrefetchLevels", mpGeneralSettingsPage->getLibraryPrefetchLevelsSpinBox()->value());
   // save show protected classes
   mpSettings->setValue("showProtectedClasses", mpGeneralSettingsPage->getShowProtectedClasses());
   // save show hidden classes
@@ -1226,7 +1247,12 @@ void OptionsDialog::saveSimulationSettings()
   mpSettings->setValue("simulation/closeSimulationOutputWidgetsBeforeSimulation", mpSimulationPage->getCloseSimulationOutputWidgetsBeforeSimulationCheckBox()->isChecked());
   mpSettings->setValue("simulation/deleteIntermediateCompilationFiles", mpSimulationPage->getDeleteIntermediateCompilationFilesCheckBox()->isChecked());
   mpSettings->setValue("simulation/deleteEntireSimulationDirectory", mpSimulationPage->getDeleteEntireSimulationDirectoryCheckBox()->isChecked());
+  mpSettings->setValue("simulation/parallelCompilations", mpSimulationPage->getParallelCompilationsSpinBox()->value());
+  mpSettings->setValue("simulation/parallelSimulations", mpSimulationPage->getParallelSimulationsSpinBox()->value());
+  mpSettings->setValue("simulation/compilationCacheSize", mpSimulationPage->getCompilationCacheSizeSpinBox()->value());
   mpSettings->setValue("simulation/outputMode", mpSimulationPage->getOutputMode());
+  mpSettings->setValue("simulation/outputSize", mpSimulationPage->getOutputSizeSpinBox()->value());
+  mpSettings->setValue("simulation/saveRemovedOutput", mpSimulationPage->getSaveRemovedOutputCheckBox()->isChecked());
 }
 
 //! Saves the Messages section settings to omedit.ini
@@ -1797,6 +1823,15 @@ GeneralSettingsPage::GeneralSettingsPage(OptionsDialog *pOptionsDialog)
   mpLibraryIconSizeSpinBox = new QSpinBox;
   mpLibraryIconSizeSpinBox->setMinimum(16);
   mpLibraryIconSizeSpinBox->setValue(24);
+  // library prefetch levels
+  mpLibraryPrefetchLevelsLabel = new Label(tr("Prefetch Nested Class Levels:"));
+  mpLibraryPrefetchLevelsLabel->setToolTip(tr("Specifies how many levels of nested classes are created when a system library is loaded. "
+                                              "The deeper levels are created when a class is expanded or accessed by name. "
+                                              "All creates every nested class when the library is loaded."));
+  mpLibraryPrefetchLevelsSpinBox = new QSpinBox;
+  mpLibraryPrefetchLevelsSpinBox->setRange(0, 99);
+  mpLibraryPrefetchLevelsSpinBox->setSpecialValueText(tr("All"));
+  mpLibraryPrefetchLevelsSpinBox->setValue(2);
   // show protected classes
   mpShowProtectedClasses = new QCheckBox(tr("Show Protected Classes"));
   // show hidden classes
@@ -1807,8 +1842,10 @@ GeneralSettingsPage::GeneralSettingsPage(OptionsDialog *pOptionsDialog)
   pLibrariesBrowserLayout->setColumnStretch(1, 1);
   pLibrariesBrowserLayout->addWidget(mpLibraryIconSizeLabel, 0, 0);
   pLibrariesBrowserLayout->addWidget(mpLibraryIconSizeSpinBox, 0, 1);
-  pLibrariesBrowserLayout->addWidget(mpShowProtectedClasses, 1, 0, 1, 2);
-  pLibrariesBrowserLayout->addWidget(mpShowHiddenClasses, 2, 0, 1, 2);
+  pLibrariesBrowserLayout->addWidget(mpLibraryPrefetchLevelsLabel, 1, 0);
+  pLibrariesBrowserLayout->addWidget(mpLibraryPrefetchLevelsSpinBox, 1, 1);
+  pLibrariesBrowserLayout->addWidget(mpShowProtectedClasses, 2, 0, 1, 2);
+  pLibrariesBrowserLayout->addWidget(mpShowHiddenClasses, 3, 0, 1, 2);
   mpLibrariesBrowserGroupBox->setLayout(pLibrariesBrowserLayout);
   // Modeling View Mode
   mpModelingViewModeGroupBox = new QGroupBox(tr("Default Modeling View Mode"));
@@ -3613,6 +3650,28 @@ SimulationPage::SimulationPage(OptionsDialog *pOptionsDialog)
   mpDeleteIntermediateCompilationFilesCheckBox->setChecked(true);
   /* Delete entire simulation directory checkbox */
   mpDeleteEntireSimulationDirectoryCheckBox = new QCheckBox(tr("Delete entire simulation directory of the model when OMEdit is closed"));
+  /* Parallel compilations spinbox */
+  mpParallelCompilationsLabel = new Label(tr("Parallel compilations:"));
+  mpParallelCompilationsLabel->setToolTip(tr("Specifies how many models are compiled at the same time. Further simulations are queued."));
+  mpParallelCompilationsSpinBox = new QSpinBox;
+  mpParallelCompilationsSpinBox->setRange(0, 256);
+  mpParallelCompilationsSpinBox->setSpecialValueText(tr("Automatic"));
+  /* Parallel simulations spinbox */
+  mpParallelSimulationsLabel = new Label(tr("Parallel simulations:"));
+  mpParallelSimulationsLabel->setToolTip(tr("Specifies how many simulation executables run at the same time. Further simulations are queued."));
+  mpParallelSimulationsSpinBox = new QSpinBox;
+  mpParallelSimulationsSpinBox->setRange(0, 256);
+  mpParallelSimulationsSpinBox->setSpecialValueText(tr("Automatic"));
+  /* Compilation cache size spinbox */
+  mpCompilationCacheSizeLabel = new Label(tr("Compilation cache size:"));
+  mpCompilationCacheSizeLabel->setToolTip(tr("Specifies the disk space used for the executables of already compiled models.\n"
+                                             "A model whose generated code is unchanged is not compiled again."));
+  mpCompilationCacheSizeSpinBox = new QSpinBox;
+  mpCompilationCacheSizeSpinBox->setRange(0, std::numeric_limits<int>::max());
+  mpCompilationCacheSizeSpinBox->setSingleStep(256);
+  mpCompilationCacheSizeSpinBox->setSuffix(" MB");
+  mpCompilationCacheSizeSpinBox->setSpecialValueText(tr("Disabled"));
+  mpCompilationCacheSizeSpinBox->setValue(1024);
   // simulation output format
   mpOutputGroupBox = new QGroupBox(Helper::output);
   mpStructuredRadioButton = new QRadioButton(tr("Structured"));
@@ -3627,10 +3686,24 @@ SimulationPage::SimulationPage(OptionsDialog *pOptionsDialog)
   QHBoxLayout *pOutputRadioButtonsLayout = new QHBoxLayout;
   pOutputRadioButtonsLayout->addWidget(mpStructuredRadioButton);
   pOutputRadioButtonsLayout->addWidget(mpFormattedTextRadioButton);
+  // simulation output size
+  mpOutputSizeLabel = new Label(tr("Output size:"));
+  mpOutputSizeLabel->setToolTip(tr("Specifies the maximum number of top level messages (lines for formatted text) kept in the simulation output window."));
+  mpOutputSizeSpinBox = new QSpinBox;
+  mpOutputSizeSpinBox->setRange(0, std::numeric_limits<int>::max());
+  mpOutputSizeSpinBox->setSingleStep(1000);
+  mpOutputSizeSpinBox->setSuffix(" messages");
+  mpOutputSizeSpinBox->setSpecialValueText(Helper::unlimited);
+  // save the messages removed from the simulation output
+  mpSaveRemovedOutputCheckBox = new QCheckBox(tr("Save the messages removed from the output window in the simulation directory"));
+  mpSaveRemovedOutputCheckBox->setChecked(true);
   // set the layout of output view mode group
   QGridLayout *pOutputGroupGridLayout = new QGridLayout;
   pOutputGroupGridLayout->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-  pOutputGroupGridLayout->addLayout(pOutputRadioButtonsLayout, 0, 0);
+  pOutputGroupGridLayout->addLayout(pOutputRadioButtonsLayout, 0, 0, 1, 2);
+  pOutputGroupGridLayout->addWidget(mpOutputSizeLabel, 1, 0);
+  pOutputGroupGridLayout->addWidget(mpOutputSizeSpinBox, 1, 1);
+  pOutputGroupGridLayout->addWidget(mpSaveRemovedOutputCheckBox, 2, 0, 1, 2);
   mpOutputGroupBox->setLayout(pOutputGroupGridLayout);
   // set the layout of simulation group
   QGridLayout *pSimulationLayout = new QGridLayout;
@@ -3652,6 +3725,12 @@ SimulationPage::SimulationPage(OptionsDialog *pOptionsDialog)
   pSimulationLayout->addWidget(mpCloseSimulationOutputWidgetsBeforeSimulationCheckBox, row++, 0, 1, 2);
   pSimulationLayout->addWidget(mpDeleteIntermediateCompilationFilesCheckBox, row++, 0, 1, 2);
   pSimulationLayout->addWidget(mpDeleteEntireSimulationDirectoryCheckBox, row++, 0, 1, 2);
+  pSimulationLayout->addWidget(mpParallelCompilationsLabel, row, 0);
+  pSimulationLayout->addWidget(mpParallelCompilationsSpinBox, row++, 1);
+  pSimulationLayout->addWidget(mpParallelSimulationsLabel, row, 0);
+  pSimulationLayout->addWidget(mpParallelSimulationsSpinBox, row++, 1);
+  pSimulationLayout->addWidget(mpCompilationCacheSizeLabel, row, 0);
+  pSimulationLayout->addWidget(mpCompilationCacheSizeSpinBox, row++, 1);
   pSimulationLayout->addWidget(mpOutputGroupBox, row++, 0, 1, 2);
   mpSimulationGroupBox->setLayout(pSimulationLayout);
   // set the layout
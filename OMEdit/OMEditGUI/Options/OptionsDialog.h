@@ -228,6 +228,7 @@ public:
   QCheckBox* getHideVariablesBrowserCheckBox() {return mpHideVariablesBrowserCheckBox;}
   QComboBox* getActivateAccessAnnotationsComboBox() {return mpActivateAccessAnnotationsComboBox;}
   QSpinBox* getLibraryIconSizeSpinBox() {return mpLibraryIconSizeSpinBox;}
+  QSpinBox* getLibraryPrefetchLevelsSpinBox() {return mpLibraryPrefetchLevelsSpinBox;}
   void setShowProtectedClasses(bool value) {mpShowProtectedClasses->setChecked(value);}
   bool getShowProtectedClasses() {return mpShowProtectedClasses->isChecked();}
   void setShowHiddenClasses(bool value) {mpShowHiddenClasses->setChecked(value);}
@@ -263,6 +264,8 @@ private:
   QGroupBox *mpLibrariesBrowserGroupBox;
   Label *mpLibraryIconSizeLabel;
   QSpinBox *mpLibraryIconSizeSpinBox;
+  Label *mpLibraryPrefetchLevelsLabel;
+  QSpinBox *mpLibraryPrefetchLevelsSpinBox;
   QCheckBox *mpShowProtectedClasses;
   QCheckBox *mpShowHiddenClasses;
   QGroupBox *mpModelingViewModeGroupBox;
@@ -613,8 +616,13 @@ public:
   QCheckBox* getCloseSimulationOutputWidgetsBeforeSimulationCheckBox() {return mpCloseSimulationOutputWidgetsBeforeSimulationCheckBox;}
   QCheckBox* getDeleteIntermediateCompilationFilesCheckBox() {return mpDeleteIntermediateCompilationFilesCheckBox;}
   QCheckBox* getDeleteEntireSimulationDirectoryCheckBox() {return mpDeleteEntireSimulationDirectoryCheckBox;}
+  QSpinBox* getParallelCompilationsSpinBox() {return mpParallelCompilationsSpinBox;}
+  QSpinBox* getParallelSimulationsSpinBox() {return mpParallelSimulationsSpinBox;}
+  QSpinBox* getCompilationCacheSizeSpinBox() {return mpCompilationCacheSizeSpinBox;}
   void setOutputMode(QString value);
   QString getOutputMode();
+  QSpinBox* getOutputSizeSpinBox() {return mpOutputSizeSpinBox;}
+  QCheckBox* getSaveRemovedOutputCheckBox() {return mpSaveRemovedOutputCheckBox;}
 private:
   OptionsDialog *mpOptionsDialog;
   QGroupBox *mpSimulationGroupBox;
@@ -635,9 +643,18 @@ private:
   QCheckBox *mpCloseSimulationOutputWidgetsBeforeSimulationCheckBox;
   QCheckBox *mpDeleteIntermediateCompilationFilesCheckBox;
   QCheckBox *mpDeleteEntireSimulationDirectoryCheckBox;
+  Label *mpParallelCompilationsLabel;
+  QSpinBox *mpParallelCompilationsSpinBox;
+  Label *mpParallelSimulationsLabel;
+  QSpinBox *mpParallelSimulationsSpinBox;
+  Label *mpCompilationCacheSizeLabel;
+  QSpinBox *mpCompilationCacheSizeSpinBox;
   QGroupBox *mpOutputGroupBox;
   QRadioButton *mpStructuredRadioButton;
   QRadioButton *mpFormattedTextRadioButton;
+  Label *mpOutputSizeLabel;
+  QSpinBox *mpOutputSizeSpinBox;
+  QCheckBox *mpSaveRemovedOutputCheckBox;
 public slots:
   void targetBuildChanged(int index);
 };
@@ -0,0 +1,351 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "LiveResultReader.h"
+#include "MainWindow.h"
+#include "Modeling/MessagesWidget.h"
+#include "Options/OptionsDialog.h"
+#include "Plotting/PlotWindowContainer.h"
+#include "Plotting/ResultFileReader.h"
+#include "Plotting/VariablesWidget.h"
+
+#include <QFileInfo>
+#include <QVarLengthArray>
+
+/* The number of times per second the result file is read and the live plot is redrawn. */
+#define LIVE_RESULT_FRAME_RATE 10
+/* The number of latest samples kept for each plotted variable. */
+#define LIVE_RESULT_BUFFER_SIZE 100000
+
+LiveResultBuffer::LiveResultBuffer(int capacity)
+  : mXValues(capacity), mYValues(capacity), mHead(0), mSize(0)
+{
+
+}
+
+/*!
+ * \brief LiveResultBuffer::append
+ * Appends the sample. Overwrites the oldest sample when the buffer is full.
+ * \param x
+ * \param y
+ */
+void LiveResultBuffer::append(double x, double y)
+{
+  if (mSize < mXValues.size()) {
+    int index = (mHead + mSize) % mXValues.size();
+    mXValues[index] = x;
+    mYValues[index] = y;
+    mSize++;
+  } else {
+    mXValues[mHead] = x;
+    mYValues[mHead] = y;
+    mHead = (mHead + 1) % mXValues.size();
+  }
+}
+
+/*!
+ * \brief LiveResultBuffer::at
+ * Returns the ith oldest sample.
+ * \param i
+ * \return
+ */
+QPointF LiveResultBuffer::at(int i) const
+{
+  int index = (mHead + i) % mXValues.size();
+  return QPointF(mXValues.at(index), mYValues.at(index));
+}
+
+/*!
+ * \brief LiveResultBuffer::boundingRect
+ * Returns the bounding rectangle of the samples in the buffer.
+ * \return
+ */
+QRectF LiveResultBuffer::boundingRect() const
+{
+  if (mSize == 0) {
+    return QRectF(1.0, 1.0, -2.0, -2.0); // invalid rectangle, same as Qwt uses for empty data.
+  }
+  double minY = at(0).y(), maxY = minY;
+  for (int i = 1 ; i < mSize ; i++) {
+    double y = mYValues.at((mHead + i) % mXValues.size());
+    minY = qMin(minY, y);
+    maxY = qMax(maxY, y);
+  }
+  double minX = at(0).x();
+  double maxX = at(mSize - 1).x();
+  return QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+LiveResultReader::LiveResultReader(SimulationOptions simulationOptions, QObject *pParent)
+  : QObject(pParent), mSimulationOptions(simulationOptions), mReadOffset(0), mHeaderRead(false), mVariablesInserted(false), mTimeColumn(0)
+{
+  mResultFile.setFileName(QString("%1/%2").arg(mSimulationOptions.getWorkingDirectory(), mSimulationOptions.getFullResultFileName()));
+  mStartDateTime = QDateTime::currentDateTime();
+  MainWindow::instance()->getVariablesWidget()->addLiveResultReader(this);
+  connect(&mReadTimer, SIGNAL(timeout()), SLOT(readResults()));
+  mReadTimer.start(1000 / LIVE_RESULT_FRAME_RATE);
+}
+
+LiveResultReader::~LiveResultReader()
+{
+  MainWindow::instance()->getVariablesWidget()->removeLiveResultReader(this);
+  // the live plot window is replaced by a plot of the complete result file.
+  if (mpPlotWindow && mpPlotWindow->getSubWindow()) {
+    mpPlotWindow->getSubWindow()->close();
+  }
+}
+
+/*!
+ * \brief LiveResultReader::plotVariable
+ * Adds or removes the curve of the variable from the live plot window.
+ * A new curve starts with the rows already read that are still in the buffer.
+ * The variables checked before the header is read are plotted once the header is read.
+ * \param variable
+ * \param plot
+ */
+void LiveResultReader::plotVariable(const QString &variable, bool plot)
+{
+  if (!mHeaderRead) {
+    mPendingPlotVariables.removeAll(variable);
+    if (plot) {
+      mPendingPlotVariables.append(variable);
+    }
+    return;
+  }
+  if (plot) {
+    if (mLiveResultBuffers.contains(variable)) {
+      return;
+    }
+    if (!mVariablesColumns.contains(variable)) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                            tr("Variable %1 is not in the result file %2 of the running simulation.")
+                                                            .arg(variable, getFileName()), Helper::scriptingKind, Helper::warningLevel));
+      return;
+    }
+    OMPlot::PlotWindow *pPlotWindow = getPlotWindow();
+    if (!pPlotWindow) {
+      return;
+    }
+    QSharedPointer<LiveResultBuffer> pLiveResultBuffer(new LiveResultBuffer(LIVE_RESULT_BUFFER_SIZE));
+    readBufferedRows(variable, pLiveResultBuffer);
+    mLiveResultBuffers.insert(variable, pLiveResultBuffer);
+    PlottingPage *pPlottingPage = OptionsDialog::instance()->getPlottingPage();
+    pPlotWindow->setCurveWidth(pPlottingPage->getCurveThickness());
+    pPlotWindow->setCurveStyle(pPlottingPage->getCurvePattern());
+    pPlotWindow->setVariablesList(QStringList(variable));
+    pPlotWindow->setInteractivePlotData(new LiveCurveData(pLiveResultBuffer));
+    pPlotWindow->plotInteractive(0);
+  } else {
+    if (!mLiveResultBuffers.remove(variable) || !mpPlotWindow) {
+      return;
+    }
+    foreach (OMPlot::PlotCurve *pPlotCurve, mpPlotWindow->getPlot()->getPlotCurvesList()) {
+      if (pPlotCurve->getName().compare(variable) == 0) {
+        mpPlotWindow->getPlot()->removeCurve(pPlotCurve);
+        pPlotCurve->detach();
+      }
+    }
+  }
+  if (mpPlotWindow->getAutoScaleButton()->isChecked()) {
+    mpPlotWindow->fitInView();
+  } else {
+    mpPlotWindow->getPlot()->replot();
+  }
+}
+
+/*!
+ * \brief LiveResultReader::readHeader
+ * Reads the variable names and inserts them in the Variables Browser. Plots the variables checked before the header was read.
+ * \param line
+ */
+void LiveResultReader::readHeader(const QByteArray &line)
+{
+  QStringList header = ResultFileReader::parseCSVHeader(QString::fromUtf8(line));
+  QStringList variables;
+  mVariablesColumns.clear();
+  for (int i = 0 ; i < header.size() ; i++) {
+    if (!header.at(i).isEmpty() && !mVariablesColumns.contains(header.at(i))) {
+      mVariablesColumns.insert(header.at(i), i);
+      variables.append(header.at(i));
+    }
+  }
+  mTimeColumn = mVariablesColumns.value("time", 0);
+  mHeaderRead = true;
+  foreach (QString variable, mPendingPlotVariables) {
+    plotVariable(variable, true);
+  }
+  mPendingPlotVariables.clear();
+  if (!mVariablesInserted) {
+    mVariablesInserted = true;
+    MainWindow::instance()->getVariablesWidget()->insertVariablesItemsToTree(getFileName(), mSimulationOptions.getWorkingDirectory(), variables,
+                                                                            mSimulationOptions);
+    if (OptionsDialog::instance()->getSimulationPage()->getSwitchToPlottingPerspectiveCheckBox()->isChecked()) {
+      MainWindow::instance()->getPerspectiveTabBar()->setCurrentIndex(2);
+    }
+  }
+}
+
+/*!
+ * \brief LiveResultReader::appendRow
+ * Parses the columns of the plotted variables and appends them to their buffers.
+ * \param line
+ * \param liveResultBuffers
+ */
+void LiveResultReader::appendRow(const QByteArray &line, const QHash<QString, QSharedPointer<LiveResultBuffer> > &liveResultBuffers)
+{
+  QVarLengthArray<int, 256> fieldsStarts;
+  fieldsStarts.append(0);
+  for (int i = 0 ; i < line.size() ; i++) {
+    if (line.at(i) == ',') {
+      fieldsStarts.append(i + 1);
+    }
+  }
+  if (mTimeColumn >= fieldsStarts.size()) {
+    return;
+  }
+  bool ok;
+  int timeEnd = mTimeColumn + 1 < fieldsStarts.size() ? fieldsStarts.at(mTimeColumn + 1) - 1 : line.size();
+  double time = line.mid(fieldsStarts.at(mTimeColumn), timeEnd - fieldsStarts.at(mTimeColumn)).trimmed().toDouble(&ok);
+  if (!ok) {
+    return;
+  }
+  QHash<QString, QSharedPointer<LiveResultBuffer> >::const_iterator iterator;
+  for (iterator = liveResultBuffers.constBegin() ; iterator != liveResultBuffers.constEnd() ; ++iterator) {
+    int column = mVariablesColumns.value(iterator.key());
+    if (column < fieldsStarts.size()) {
+      int end = column + 1 < fieldsStarts.size() ? fieldsStarts.at(column + 1) - 1 : line.size();
+      double value = line.mid(fieldsStarts.at(column), end - fieldsStarts.at(column)).trimmed().toDouble(&ok);
+      if (ok) {
+        iterator.value()->append(time, value);
+      }
+    }
+  }
+}
+
+/*!
+ * \brief LiveResultReader::readBufferedRows
+ * Fills the buffer of a newly plotted variable from the rows already read. Only the rows that fit in the buffer are read again.
+ * \param variable
+ * \param pLiveResultBuffer
+ */
+void LiveResultReader::readBufferedRows(const QString &variable, QSharedPointer<LiveResultBuffer> pLiveResultBuffer)
+{
+  if (mRowsOffsets.isEmpty() || !mResultFile.isOpen() || !mResultFile.seek(mRowsOffsets.head())) {
+    return;
+  }
+  QHash<QString, QSharedPointer<LiveResultBuffer> > liveResultBuffers;
+  liveResultBuffers.insert(variable, pLiveResultBuffer);
+  QByteArray data = mResultFile.read(mReadOffset - mRowsOffsets.head());
+  int lineStart = 0;
+  for (int lineEnd = data.indexOf('\n') ; lineEnd >= 0 ; lineEnd = data.indexOf('\n', lineStart)) {
+    appendRow(data.mid(lineStart, lineEnd - lineStart), liveResultBuffers);
+    lineStart = lineEnd + 1;
+  }
+}
+
+/*!
+ * \brief LiveResultReader::getPlotWindow
+ * Returns the live plot window. Creates it if needed.
+ * \return
+ */
+OMPlot::PlotWindow* LiveResultReader::getPlotWindow()
+{
+  if (!mpPlotWindow) {
+    mpPlotWindow = MainWindow::instance()->getPlotWindowContainer()->addInteractivePlotWindow(true, getFileName());
+    if (mpPlotWindow) {
+      mpPlotWindow->setWindowTitle(tr("Live Plot : %1").arg(getFileName()));
+      mpPlotWindow->setInteractiveModelName(getFileName());
+      // the simulation is controlled from the simulation output window.
+      mpPlotWindow->getStartSimulationButton()->hide();
+      mpPlotWindow->getPauseSimulationButton()->hide();
+      mpPlotWindow->getSimulationSpeedBox()->hide();
+    }
+  }
+  return mpPlotWindow;
+}
+
+/*!
+ * \brief LiveResultReader::readResults
+ * Slot activated when mReadTimer timeout SIGNAL is raised.
+ * Reads the rows written since the last call and redraws the live plot window.
+ */
+void LiveResultReader::readResults()
+{
+  if (!mResultFile.isOpen()) {
+    QFileInfo resultFileInfo(mResultFile.fileName());
+    resultFileInfo.setCaching(false);
+    // wait for the simulation to create the result file. Don't read the result file of the previous simulation.
+    if (!resultFileInfo.exists() || mStartDateTime.secsTo(resultFileInfo.lastModified()) < 0 || !mResultFile.open(QIODevice::ReadOnly)) {
+      return;
+    }
+  }
+  // the result file is written again e.g., the simulation is restarted.
+  if (mResultFile.size() < mReadOffset) {
+    mReadOffset = 0;
+    mHeaderRead = false;
+    mRowsOffsets.clear();
+    foreach (QSharedPointer<LiveResultBuffer> pLiveResultBuffer, mLiveResultBuffers) {
+      pLiveResultBuffer->clear();
+    }
+  }
+  if (!mResultFile.seek(mReadOffset)) {
+    return;
+  }
+  QByteArray data = mResultFile.readAll();
+  bool rowsAppended = false;
+  // only read the complete lines, the rest is read on the next call.
+  int lineStart = 0;
+  for (int lineEnd = data.indexOf('\n') ; lineEnd >= 0 ; lineEnd = data.indexOf('\n', lineStart)) {
+    QByteArray line = data.mid(lineStart, lineEnd - lineStart);
+    if (!mHeaderRead) {
+      readHeader(line);
+    } else if (!line.trimmed().isEmpty()) {
+      mRowsOffsets.enqueue(mReadOffset + lineStart);
+      if (mRowsOffsets.size() > LIVE_RESULT_BUFFER_SIZE) {
+        mRowsOffsets.dequeue();
+      }
+      appendRow(line, mLiveResultBuffers);
+      rowsAppended = true;
+    }
+    lineStart = lineEnd + 1;
+  }
+  mReadOffset += lineStart;
+  if (rowsAppended && mpPlotWindow && !mLiveResultBuffers.isEmpty()) {
+    if (mpPlotWindow->getAutoScaleButton()->isChecked()) {
+      mpPlotWindow->fitInView();
+    } else {
+      mpPlotWindow->getPlot()->replot();
+    }
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef LIVERESULTREADER_H
+#define LIVERESULTREADER_H
+
+#include "Simulation/SimulationOptions.h"
+#include "OMPlot.h"
+
+#include <QFile>
+#include <QDateTime>
+#include <QTimer>
+#include <QQueue>
+#include <QPointer>
+#include <QSharedPointer>
+
+/*!
+ * \class LiveResultBuffer
+ * \brief Fixed size ring buffer holding the latest samples of a variable.
+ */
+class LiveResultBuffer
+{
+public:
+  LiveResultBuffer(int capacity);
+  void append(double x, double y);
+  void clear() {mHead = 0; mSize = 0;}
+  int size() const {return mSize;}
+  QPointF at(int i) const;
+  QRectF boundingRect() const;
+private:
+  QVector<double> mXValues;
+  QVector<double> mYValues;
+  int mHead;
+  int mSize;
+};
+
+/*!
+ * \class LiveCurveData
+ * \brief Curve data reading the samples from a LiveResultBuffer. The curve owns the data, the buffer is shared with the LiveResultReader.
+ */
+class LiveCurveData : public QwtSeriesData<QPointF>
+{
+public:
+  LiveCurveData(QSharedPointer<LiveResultBuffer> pLiveResultBuffer) : mpLiveResultBuffer(pLiveResultBuffer) {}
+  virtual QPointF sample(size_t i) const {return mpLiveResultBuffer->at(i);}
+  virtual size_t size() const {return mpLiveResultBuffer->size();}
+  virtual QRectF boundingRect() const {return mpLiveResultBuffer->boundingRect();}
+private:
+  QSharedPointer<LiveResultBuffer> mpLiveResultBuffer;
+};
+
+/*!
+ * \class LiveResultReader
+ * \brief Follows the csv result file of a running simulation.
+ * The new rows are read at a fixed rate. The variables checked in the Variables Browser are appended to ring buffers and plotted in a live plot window.
+ */
+class LiveResultReader : public QObject
+{
+  Q_OBJECT
+public:
+  LiveResultReader(SimulationOptions simulationOptions, QObject *pParent = 0);
+  ~LiveResultReader();
+  QString getFileName() {return mSimulationOptions.getFullResultFileName();}
+  QStringList getPlottedVariables() const {return mLiveResultBuffers.keys();}
+  void plotVariable(const QString &variable, bool plot);
+private:
+  SimulationOptions mSimulationOptions;
+  QFile mResultFile;
+  QDateTime mStartDateTime;
+  qint64 mReadOffset;
+  bool mHeaderRead;
+  bool mVariablesInserted;
+  QHash<QString, int> mVariablesColumns;
+  int mTimeColumn;
+  QQueue<qint64> mRowsOffsets;
+  QHash<QString, QSharedPointer<LiveResultBuffer> > mLiveResultBuffers;
+  // the variables checked before the header is read.
+  QStringList mPendingPlotVariables;
+  QTimer mReadTimer;
+  QPointer<OMPlot::PlotWindow> mpPlotWindow;
+  void readHeader(const QByteArray &line);
+  void appendRow(const QByteArray &line, const QHash<QString, QSharedPointer<LiveResultBuffer> > &liveResultBuffers);
+  void readBufferedRows(const QString &variable, QSharedPointer<LiveResultBuffer> pLiveResultBuffer);
+  OMPlot::PlotWindow* getPlotWindow();
+private slots:
+  void readResults();
+};
+
+#endif // LIVERESULTREADER_H
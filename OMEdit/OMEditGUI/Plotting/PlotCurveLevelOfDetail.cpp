@@ -0,0 +1,215 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "PlotCurveLevelOfDetail.h"
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtConcurrent/QtConcurrent>
+#endif
+
+#include <algorithm>
+
+/* Curves with fewer samples are drawn as they are. */
+#define LEVEL_OF_DETAIL_MIN_SAMPLES 16384
+/* The coarsest level is not reduced below this number of points. */
+#define LEVEL_OF_DETAIL_MIN_POINTS 2048
+
+PlotCurveLevelOfDetail::PlotCurveLevelOfDetail(const QVector<double> &xAxisVector, const QVector<double> &yAxisVector, QwtPlot *pPlot)
+  : mXAxisVector(xAxisVector), mYAxisVector(yAxisVector), mpPlot(pPlot), mLevel(0)
+{
+  // compute the bounding rectangle of the full resolution samples once.
+  int size = qMin(mXAxisVector.size(), mYAxisVector.size());
+  if (size > 0) {
+    double minX = mXAxisVector.at(0), maxX = mXAxisVector.at(0), minY = mYAxisVector.at(0), maxY = mYAxisVector.at(0);
+    for (int i = 1 ; i < size ; i++) {
+      minX = qMin(minX, mXAxisVector.at(i));
+      maxX = qMax(maxX, mXAxisVector.at(i));
+      minY = qMin(minY, mYAxisVector.at(i));
+      maxY = qMax(maxY, mYAxisVector.at(i));
+    }
+    mBoundingRect = QRectF(minX, minY, maxX - minX, maxY - minY);
+  } else {
+    mBoundingRect = QRectF(1.0, 1.0, -2.0, -2.0); // invalid rectangle, same as Qwt uses for empty data.
+  }
+  if (size >= LEVEL_OF_DETAIL_MIN_SAMPLES) {
+    connect(&mLevelsFutureWatcher, SIGNAL(finished()), SLOT(levelsBuilt()));
+    mLevelsFutureWatcher.setFuture(QtConcurrent::run(PlotCurveLevelOfDetail::buildLevels, mXAxisVector, mYAxisVector));
+  }
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::attach
+ * Replaces the data of the curve with a PlotCurveLevelOfDetail built from the curve axis vectors.
+ * Should be called again whenever the axis vectors of the curve are changed.
+ * \param pPlotCurve
+ * \param pPlot
+ */
+void PlotCurveLevelOfDetail::attach(OMPlot::PlotCurve *pPlotCurve, QwtPlot *pPlot)
+{
+  if (qMin(pPlotCurve->mXAxisVector.size(), pPlotCurve->mYAxisVector.size()) < LEVEL_OF_DETAIL_MIN_SAMPLES) {
+    return;
+  }
+  // the curve takes the ownership of the data.
+  pPlotCurve->QwtSeriesStore<QPointF>::setData(new PlotCurveLevelOfDetail(pPlotCurve->mXAxisVector, pPlotCurve->mYAxisVector, pPlot));
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::sample
+ * Returns the sample of the selected level.
+ * \param i
+ * \return
+ */
+QPointF PlotCurveLevelOfDetail::sample(size_t i) const
+{
+  if (mLevel > 0) {
+    return mLevels.at(mLevel - 1).at(i);
+  }
+  return QPointF(mXAxisVector.at(i), mYAxisVector.at(i));
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::size
+ * Returns the number of samples of the selected level.
+ * \return
+ */
+size_t PlotCurveLevelOfDetail::size() const
+{
+  if (mLevel > 0) {
+    return mLevels.at(mLevel - 1).size();
+  }
+  return qMin(mXAxisVector.size(), mYAxisVector.size());
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::boundingRect
+ * Returns the bounding rectangle of the full resolution samples. The decimation keeps the extremes so it is the same for every level.
+ * \return
+ */
+QRectF PlotCurveLevelOfDetail::boundingRect() const
+{
+  return mBoundingRect;
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::setRectOfInterest
+ * Called by Qwt whenever the scales change, i.e., on zoom and pan. Selects the level that matches the visible range.
+ * \param rect
+ */
+void PlotCurveLevelOfDetail::setRectOfInterest(const QRectF &rect)
+{
+  mRectOfInterest = rect;
+  selectLevel();
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::buildLevels
+ * Builds the decimation levels. Every level takes groups of four points of the previous level and keeps the minimum and the maximum
+ * in the order they occur, so peaks are never lost. Runs on a worker thread.
+ * \param xAxisVector
+ * \param yAxisVector
+ * \return
+ */
+PlotCurveLevels PlotCurveLevelOfDetail::buildLevels(QVector<double> xAxisVector, QVector<double> yAxisVector)
+{
+  PlotCurveLevels levels;
+  int size = qMin(xAxisVector.size(), yAxisVector.size());
+  // the visible range is found with a binary search so the decimation is only valid for increasing x values, i.e., time.
+  for (int i = 1 ; i < size ; i++) {
+    if (xAxisVector.at(i) < xAxisVector.at(i - 1)) {
+      return levels;
+    }
+  }
+  QVector<QPointF> previousLevel(size);
+  for (int i = 0 ; i < size ; i++) {
+    previousLevel[i] = QPointF(xAxisVector.at(i), yAxisVector.at(i));
+  }
+  while (previousLevel.size() / 2 >= LEVEL_OF_DETAIL_MIN_POINTS) {
+    QVector<QPointF> level;
+    level.reserve(previousLevel.size() / 2 + 2);
+    for (int i = 0 ; i < previousLevel.size() ; i += 4) {
+      int end = qMin(i + 4, previousLevel.size());
+      int minIndex = i, maxIndex = i;
+      for (int j = i + 1 ; j < end ; j++) {
+        if (previousLevel.at(j).y() < previousLevel.at(minIndex).y()) {
+          minIndex = j;
+        }
+        if (previousLevel.at(j).y() > previousLevel.at(maxIndex).y()) {
+          maxIndex = j;
+        }
+      }
+      level.append(previousLevel.at(qMin(minIndex, maxIndex)));
+      level.append(previousLevel.at(qMax(minIndex, maxIndex)));
+    }
+    levels.append(level);
+    previousLevel = level;
+  }
+  return levels;
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::selectLevel
+ * Selects the coarsest level that still has two points per pixel of the canvas in the visible range.
+ */
+void PlotCurveLevelOfDetail::selectLevel()
+{
+  mLevel = 0;
+  if (mLevels.isEmpty() || !mpPlot || mRectOfInterest.width() <= 0) {
+    return;
+  }
+  int pixels = qMax(mpPlot->canvas()->width(), 1);
+  int first = std::lower_bound(mXAxisVector.constBegin(), mXAxisVector.constEnd(), mRectOfInterest.left()) - mXAxisVector.constBegin();
+  int last = std::upper_bound(mXAxisVector.constBegin(), mXAxisVector.constEnd(), mRectOfInterest.right()) - mXAxisVector.constBegin();
+  // each level halves the number of points.
+  for (int visibleSamples = last - first ; visibleSamples > 2 * pixels && mLevel < mLevels.size() ; visibleSamples /= 2) {
+    mLevel++;
+  }
+}
+
+/*!
+ * \brief PlotCurveLevelOfDetail::levelsBuilt
+ * Slot activated when mLevelsFutureWatcher finished SIGNAL is raised.
+ * Takes the levels and redraws the plot with the matching level.
+ */
+void PlotCurveLevelOfDetail::levelsBuilt()
+{
+  mLevels = mLevelsFutureWatcher.result();
+  if (mLevels.isEmpty() || !mpPlot) {
+    return;
+  }
+  if (mRectOfInterest.width() <= 0) {
+    mRectOfInterest = mBoundingRect;
+  }
+  selectLevel();
+  mpPlot->replot();
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PLOTCURVELEVELOFDETAIL_H
+#define PLOTCURVELEVELOFDETAIL_H
+
+#include "OMPlot.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QFutureWatcher>
+
+typedef QVector<QVector<QPointF> > PlotCurveLevels;
+
+/*!
+ * \class PlotCurveLevelOfDetail
+ * \brief Curve data that serves a min/max decimated copy of the samples matching the width of the plot canvas.
+ * Each level halves the number of points of the previous one while keeping the minimum and maximum of every bucket.
+ * The levels are built on a worker thread. Until they are ready the full resolution samples are drawn.
+ */
+class PlotCurveLevelOfDetail : public QObject, public QwtSeriesData<QPointF>
+{
+  Q_OBJECT
+public:
+  PlotCurveLevelOfDetail(const QVector<double> &xAxisVector, const QVector<double> &yAxisVector, QwtPlot *pPlot);
+  static void attach(OMPlot::PlotCurve *pPlotCurve, QwtPlot *pPlot);
+  virtual QPointF sample(size_t i) const;
+  virtual size_t size() const;
+  virtual QRectF boundingRect() const;
+  virtual void setRectOfInterest(const QRectF &rect);
+private:
+  QVector<double> mXAxisVector;
+  QVector<double> mYAxisVector;
+  QPointer<QwtPlot> mpPlot;
+  QRectF mBoundingRect;
+  PlotCurveLevels mLevels;
+  int mLevel;
+  QRectF mRectOfInterest;
+  QFutureWatcher<PlotCurveLevels> mLevelsFutureWatcher;
+  static PlotCurveLevels buildLevels(QVector<double> xAxisVector, QVector<double> yAxisVector);
+  void selectLevel();
+private slots:
+  void levelsBuilt();
+};
+
+#endif // PLOTCURVELEVELOFDETAIL_H
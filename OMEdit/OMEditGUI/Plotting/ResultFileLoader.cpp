@@ -0,0 +1,335 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "ResultFileLoader.h"
+#include "Plotting/ResultFileReader.h"
+#include "Util/Utilities.h"
+#include "Util/Helper.h"
+
+#include <QFileInfo>
+#include <QDir>
+#include <QRegExp>
+#include <QProgressBar>
+#include <QToolButton>
+#include <QHBoxLayout>
+#include <algorithm>
+
+/* Number of chunks the variables are sorted in. The loader reports progress and checks for cancellation after each chunk. */
+#define RESULT_FILE_LOADER_SORT_CHUNKS 16
+
+/*!
+ * \class ResultVariablesInformation
+ * \brief The attributes of the variables from the model_init.xml file and the final values of the variables from the result file.
+ */
+/*!
+ * \brief ResultVariablesInformation::readInitXml
+ * Reads the ScalarVariable attributes of the model_init.xml file. A missing file is not an error.
+ * \param fileName
+ * \return false if the file exists but can't be read.
+ */
+bool ResultVariablesInformation::readInitXml(const QString &fileName)
+{
+  mScalarVariables.clear();
+  QFile initFile(fileName);
+  if (!initFile.exists()) {
+    return true;
+  }
+  if (!initFile.open(QIODevice::ReadOnly)) {
+    mErrors.append(GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName()).arg(initFile.errorString()));
+    return false;
+  }
+  QXmlStreamReader xmlReader(&initFile);
+  /* We'll parse the XML until we reach end of it.*/
+  while (!xmlReader.atEnd() && !xmlReader.hasError()) {
+    /* If token is StartElement named ScalarVariable, we'll dig the information from there.*/
+    if (xmlReader.readNext() == QXmlStreamReader::StartElement && xmlReader.name() == "ScalarVariable") {
+      QHash<QString, QString> scalarVariable = parseScalarVariable(xmlReader);
+      mScalarVariables.insert(scalarVariable.value("name"), scalarVariable);
+    }
+  }
+  xmlReader.clear();
+  initFile.close();
+  return true;
+}
+
+/*!
+ * \brief ResultVariablesInformation::readFinalValue
+ * Reads the final value of the variable if it is in the model_init.xml file and is not a tunable parameter.
+ * The tunable parameters show their start value instead.
+ * \param pResultFileReader
+ * \param variable
+ * \return
+ */
+bool ResultVariablesInformation::readFinalValue(ResultFileReader *pResultFileReader, const QString &variable)
+{
+  if (!mScalarVariables.contains(variable) || isValueChangeable(variable)) {
+    return false;
+  }
+  double value;
+  if (!pResultFileReader->readVariableFinalValue(variable, &value)) {
+    return false;
+  }
+  mFinalValues.insert(variable, value);
+  return true;
+}
+
+/*!
+ * \brief ResultVariablesInformation::isValueChangeable
+ * Returns true if the variable is a tunable parameter.
+ * \param variable
+ * \return
+ */
+bool ResultVariablesInformation::isValueChangeable(const QString &variable) const
+{
+  return mScalarVariables.value(variable).value("isValueChangeable").compare("true") == 0;
+}
+
+/*!
+ * \brief ResultVariablesInformation::getFinalValue
+ * Returns the final value read by ResultVariablesInformation::readFinalValue.
+ * \param variable
+ * \param pValue - left unchanged if the final value is not read.
+ * \return
+ */
+bool ResultVariablesInformation::getFinalValue(const QString &variable, double *pValue) const
+{
+  QHash<QString, double>::const_iterator iterator = mFinalValues.find(variable);
+  if (iterator == mFinalValues.end()) {
+    return false;
+  }
+  *pValue = iterator.value();
+  return true;
+}
+
+/*!
+ * \brief ResultVariablesInformation::getInitFileName
+ * Returns the model_init.xml file of the result file i.e., the result file name without the result suffix followed by _init.xml.
+ * \param resultFileName - the absolute path of the result file.
+ * \return
+ */
+QString ResultVariablesInformation::getInitFileName(const QString &resultFileName)
+{
+  QFileInfo fileInfo(resultFileName);
+  QRegExp resultTypeRegExp("(\\.mat|\\.plt|\\.csv|_res.mat|_res.plt|_res.csv)");
+  return fileInfo.absoluteDir().absolutePath() + "/" + fileInfo.fileName().remove(resultTypeRegExp) + "_init.xml";
+}
+
+/*!
+ * \brief ResultVariablesInformation::parseScalarVariable
+ * Reads the attributes of the ScalarVariable element and of its type element i.e., Real, Integer, Boolean etc.
+ * \param xmlReader
+ * \return
+ */
+QHash<QString, QString> ResultVariablesInformation::parseScalarVariable(QXmlStreamReader &xmlReader)
+{
+  QHash<QString, QString> scalarVariable;
+  /* Let's get the attributes for ScalarVariable */
+  QXmlStreamAttributes attributes = xmlReader.attributes();
+  /* Read the ScalarVariable attributes. */
+  scalarVariable["name"] = attributes.value("name").toString();
+  scalarVariable["description"] = attributes.value("description").toString();
+  scalarVariable["isValueChangeable"] = attributes.value("isValueChangeable").toString();
+  scalarVariable["variability"] = attributes.value("variability").toString();
+  /* Read the next element i.e Real, Integer, Boolean etc. */
+  xmlReader.readNext();
+  while (!xmlReader.atEnd() && !(xmlReader.tokenType() == QXmlStreamReader::EndElement && xmlReader.name() == "ScalarVariable")) {
+    if (xmlReader.tokenType() == QXmlStreamReader::StartElement) {
+      QXmlStreamAttributes attributes = xmlReader.attributes();
+      scalarVariable["start"] = attributes.value("start").toString();
+      scalarVariable["unit"] = attributes.value("unit").toString();
+      scalarVariable["displayUnit"] = attributes.value("displayUnit").toString();
+    }
+    xmlReader.readNext();
+  }
+  return scalarVariable;
+}
+
+/*!
+ * \brief ResultFileLoader::ResultFileLoader
+ * \param fileName - the absolute path of the result file.
+ * \param pParent
+ */
+ResultFileLoader::ResultFileLoader(const QString &fileName, QObject *pParent)
+  : QThread(pParent), mFileName(fileName), mCancelled(0)
+{
+}
+
+/*!
+ * \brief ResultFileLoader::run
+ * Reads and sorts the variables of the result file, reads the model_init.xml file and the final values of the variables.\n
+ * The variables are read directly from the result file instead of through OMC so the GUI thread and the OMC connection stay free.
+ * Opening the file is not interruptible, cancellation is checked after it, while sorting and for each final value.
+ */
+void ResultFileLoader::run()
+{
+  emit progressChanged(0);
+  ResultFileReader resultFileReader;
+  if (!resultFileReader.open(mFileName)) {
+    mErrorString = resultFileReader.getErrorString();
+    return;
+  }
+  mVariables = resultFileReader.getVariables();
+  if (isCancelled()) {
+    return;
+  }
+  emit progressChanged(30);
+  if (!sortVariables()) {
+    mVariables.clear();
+    return;
+  }
+  mVariablesInformation.readInitXml(ResultVariablesInformation::getInitFileName(mFileName));
+  if (!readFinalValues(&resultFileReader)) {
+    mVariables.clear();
+    return;
+  }
+  emit progressChanged(100);
+}
+
+/*!
+ * \brief ResultFileLoader::sortVariables
+ * Sorts the variables in chunks and merges them.
+ * \return false if the loading is cancelled.
+ */
+bool ResultFileLoader::sortVariables()
+{
+  const int size = mVariables.size();
+  const int chunkSize = qMax(1, (size + RESULT_FILE_LOADER_SORT_CHUNKS - 1) / RESULT_FILE_LOADER_SORT_CHUNKS);
+  QStringList::iterator begin = mVariables.begin();
+  for (int i = 0 ; i < size ; i += chunkSize) {
+    if (isCancelled()) {
+      return false;
+    }
+    std::sort(begin + i, begin + qMin(i + chunkSize, size));
+    emit progressChanged(30 + (30 * qMin(i + chunkSize, size)) / size);
+  }
+  for (int width = chunkSize ; width < size ; width *= 2) {
+    if (isCancelled()) {
+      return false;
+    }
+    for (int i = 0 ; i + width < size ; i += 2 * width) {
+      std::inplace_merge(begin + i, begin + i + width, begin + qMin(i + 2 * width, size));
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief ResultFileLoader::readFinalValues
+ * Reads the final values of the variables.
+ * \param pResultFileReader
+ * \return false if the loading is cancelled.
+ */
+bool ResultFileLoader::readFinalValues(ResultFileReader *pResultFileReader)
+{
+  const int size = mVariables.size();
+  const int progressStep = qMax(1, size / 40);
+  for (int i = 0 ; i < size ; i++) {
+    if (isCancelled()) {
+      return false;
+    }
+    mVariablesInformation.readFinalValue(pResultFileReader, mVariables.at(i));
+    if ((i + 1) % progressStep == 0) {
+      emit progressChanged(60 + (40 * (i + 1)) / size);
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief ResultFileLoaderWidget::ResultFileLoaderWidget
+ * \param fileName - the absolute path of the result file.
+ * \param pParent
+ */
+ResultFileLoaderWidget::ResultFileLoaderWidget(const QString &fileName, QWidget *pParent)
+  : QWidget(pParent)
+{
+  mpResultFileLoader = new ResultFileLoader(fileName, this);
+  mpFileNameLabel = new Label(tr("Loading %1").arg(QFileInfo(fileName).fileName()));
+  mpFileNameLabel->setElideMode(Qt::ElideMiddle);
+  mpFileNameLabel->setToolTip(fileName);
+  mpProgressBar = new QProgressBar;
+  mpProgressBar->setRange(0, 100);
+  mpProgressBar->setTextVisible(false);
+  mpProgressBar->setMaximumHeight(16);
+  mpCancelButton = new QToolButton;
+  mpCancelButton->setIcon(QIcon(":/Resources/icons/delete.svg"));
+  mpCancelButton->setToolTip(Helper::cancel);
+  mpCancelButton->setAutoRaise(true);
+  connect(mpCancelButton, SIGNAL(clicked()), SLOT(cancelLoading()));
+  connect(mpResultFileLoader, SIGNAL(progressChanged(int)), mpProgressBar, SLOT(setValue(int)));
+  connect(mpResultFileLoader, SIGNAL(finished()), SLOT(loadingFinished()));
+  // set the layout
+  QHBoxLayout *pMainLayout = new QHBoxLayout;
+  pMainLayout->setContentsMargins(0, 0, 0, 0);
+  pMainLayout->addWidget(mpFileNameLabel, 1);
+  pMainLayout->addWidget(mpProgressBar, 1);
+  pMainLayout->addWidget(mpCancelButton);
+  setLayout(pMainLayout);
+}
+
+/*!
+ * \brief ResultFileLoaderWidget::~ResultFileLoaderWidget
+ * Cancels the loading. Opening the result file is not interruptible so the GUI thread doesn't wait for the ResultFileLoader.
+ * The cancelled ResultFileLoader is detached from the widget and deletes itself when it is finished.
+ */
+ResultFileLoaderWidget::~ResultFileLoaderWidget()
+{
+  mpResultFileLoader->cancel();
+  mpResultFileLoader->disconnect(this);
+  mpResultFileLoader->setParent(0);
+  connect(mpResultFileLoader, SIGNAL(finished()), mpResultFileLoader, SLOT(deleteLater()));
+  if (!mpResultFileLoader->isRunning()) {
+    delete mpResultFileLoader;
+  }
+}
+
+/*!
+ * \brief ResultFileLoaderWidget::cancelLoading
+ * Cancels the loading. The widget is removed when the ResultFileLoader is finished.
+ */
+void ResultFileLoaderWidget::cancelLoading()
+{
+  mpResultFileLoader->cancel();
+  mpCancelButton->setEnabled(false);
+  mpFileNameLabel->setText(tr("Cancelling %1").arg(QFileInfo(mpResultFileLoader->getFileName()).fileName()));
+}
+
+/*!
+ * \brief ResultFileLoaderWidget::loadingFinished
+ * Called when the ResultFileLoader is finished.
+ */
+void ResultFileLoaderWidget::loadingFinished()
+{
+  emit resultFileLoaded(this);
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef RESULTFILELOADER_H
+#define RESULTFILELOADER_H
+
+#include <QThread>
+#include <QWidget>
+#include <QAtomicInt>
+#include <QStringList>
+#include <QHash>
+#include <QXmlStreamReader>
+
+class Label;
+class QProgressBar;
+class QToolButton;
+class ResultFileReader;
+
+/*!
+ * \class ResultVariablesInformation
+ * \brief The attributes of the variables from the model_init.xml file and the final values of the variables from the result file.\n
+ * It doesn't use any GUI class so it can be filled by the ResultFileLoader thread and handed to the VariablesTreeModel.
+ */
+class ResultVariablesInformation
+{
+public:
+  bool readInitXml(const QString &fileName);
+  bool readFinalValue(ResultFileReader *pResultFileReader, const QString &variable);
+  QHash<QString, QString> getScalarVariable(const QString &variable) const {return mScalarVariables.value(variable);}
+  bool isValueChangeable(const QString &variable) const;
+  bool getFinalValue(const QString &variable, double *pValue) const;
+  QStringList getErrors() const {return mErrors;}
+  void addError(const QString &error) {mErrors.append(error);}
+  static QString getInitFileName(const QString &resultFileName);
+private:
+  QHash<QString, QHash<QString, QString> > mScalarVariables;
+  QHash<QString, double> mFinalValues;
+  QStringList mErrors;
+
+  static QHash<QString, QString> parseScalarVariable(QXmlStreamReader &xmlReader);
+};
+
+/*!
+ * \class ResultFileLoader
+ * \brief Reads the variables of a result file in a worker thread.
+ * Each result file is read by its own ResultFileLoader so several result files can be loaded in parallel.
+ */
+class ResultFileLoader : public QThread
+{
+  Q_OBJECT
+public:
+  ResultFileLoader(const QString &fileName, QObject *pParent = 0);
+  QString getFileName() const {return mFileName;}
+  QStringList getVariables() const {return mVariables;}
+  const ResultVariablesInformation& getVariablesInformation() const {return mVariablesInformation;}
+  QString getErrorString() const {return mErrorString;}
+  void cancel() {mCancelled.store(1);}
+  bool isCancelled() const {return mCancelled.load() != 0;}
+protected:
+  virtual void run();
+private:
+  QString mFileName;
+  QStringList mVariables;
+  ResultVariablesInformation mVariablesInformation;
+  QString mErrorString;
+  QAtomicInt mCancelled;
+
+  bool sortVariables();
+  bool readFinalValues(ResultFileReader *pResultFileReader);
+signals:
+  void progressChanged(int value);
+};
+
+/*!
+ * \class ResultFileLoaderWidget
+ * \brief Shows the progress of a ResultFileLoader in the variables browser and allows cancelling it.
+ */
+class ResultFileLoaderWidget : public QWidget
+{
+  Q_OBJECT
+public:
+  ResultFileLoaderWidget(const QString &fileName, QWidget *pParent = 0);
+  ~ResultFileLoaderWidget();
+  ResultFileLoader* getResultFileLoader() {return mpResultFileLoader;}
+  void start() {mpResultFileLoader->start();}
+private:
+  ResultFileLoader *mpResultFileLoader;
+  Label *mpFileNameLabel;
+  QProgressBar *mpProgressBar;
+  QToolButton *mpCancelButton;
+private slots:
+  void cancelLoading();
+  void loadingFinished();
+signals:
+  void resultFileLoaded(ResultFileLoaderWidget *pResultFileLoaderWidget);
+};
+
+#endif // RESULTFILELOADER_H
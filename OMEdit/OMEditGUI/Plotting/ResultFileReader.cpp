@@ -0,0 +1,708 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "ResultFileReader.h"
+
+#include <QObject>
+#include <QFileInfo>
+#include <qnumeric.h>
+#include <algorithm>
+#include <string.h>
+
+/* The decoded columns are kept until they exceed this number of bytes. */
+#define RESULT_FILE_READER_CACHE_SIZE (64 * 1024 * 1024)
+/* The offset of every nth field of each csv row is indexed so a column is found without splitting the fields before it. */
+#define RESULT_FILE_READER_CSV_FIELDS_STRIDE 32
+
+/*!
+ * \brief findLineEnd
+ * Returns the position of the end of line starting at pBegin or pEnd if the line is not terminated.
+ * \param pBegin
+ * \param pEnd
+ * \return
+ */
+static const char* findLineEnd(const char *pBegin, const char *pEnd)
+{
+  const char *pLineEnd = static_cast<const char*>(memchr(pBegin, '\n', pEnd - pBegin));
+  return pLineEnd ? pLineEnd : pEnd;
+}
+
+/*!
+ * \brief findFieldEnd
+ * Returns the position of the next comma in the line or pLineEnd if there is none.
+ * \param pBegin
+ * \param pLineEnd
+ * \return
+ */
+static const char* findFieldEnd(const char *pBegin, const char *pLineEnd)
+{
+  const char *pFieldEnd = static_cast<const char*>(memchr(pBegin, ',', pLineEnd - pBegin));
+  return pFieldEnd ? pFieldEnd : pLineEnd;
+}
+
+/*!
+ * \brief parseDouble
+ * Parses the number between pBegin and pEnd without copying the mapped data.
+ * \param pBegin
+ * \param pEnd
+ * \param ok
+ * \return
+ */
+static double parseDouble(const char *pBegin, const char *pEnd, bool *ok)
+{
+  while (pBegin < pEnd && (*pBegin == ' ' || *pBegin == '\t')) {
+    pBegin++;
+  }
+  while (pEnd > pBegin && (*(pEnd - 1) == ' ' || *(pEnd - 1) == '\t' || *(pEnd - 1) == '\r')) {
+    pEnd--;
+  }
+  return QByteArray::fromRawData(pBegin, pEnd - pBegin).toDouble(ok);
+}
+
+/*!
+ * \brief isBlankLine
+ * Returns true if the line only contains white spaces.
+ * \param pBegin
+ * \param pLineEnd
+ * \return
+ */
+static bool isBlankLine(const char *pBegin, const char *pLineEnd)
+{
+  for (const char *p = pBegin ; p < pLineEnd ; p++) {
+    if (*p != ' ' && *p != '\t' && *p != '\r') {
+      return false;
+    }
+  }
+  return true;
+}
+
+ResultFileReader::ResultFileReader()
+  : mFileType(NoFile), mpData(0), mDataSize(0), mCSVColumnsCount(0), mCSVLastRowRead(false), mTimeColumnRead(false)
+{
+  mModelicaMatReader.file = 0;
+  mColumnsCache.setMaxCost(RESULT_FILE_READER_CACHE_SIZE);
+}
+
+ResultFileReader::~ResultFileReader()
+{
+  close();
+}
+
+/*!
+ * \brief ResultFileReader::open
+ * Opens the result file and builds the index of its variables.
+ * \param fileName
+ * \return
+ */
+bool ResultFileReader::open(const QString &fileName)
+{
+  close();
+  mFileName = fileName;
+  if (fileName.endsWith(".mat")) {
+    const char *msg = omc_new_matlab4_reader(fileName.toStdString().c_str(), &mModelicaMatReader);
+    if (msg) {
+      mModelicaMatReader.file = 0;
+      mErrorString = QString(msg);
+      return false;
+    }
+    mFileType = MatFile;
+    for (uint32_t i = 0 ; i < mModelicaMatReader.nall ; i++) {
+      mVariables.append(QString(mModelicaMatReader.allInfo[i].name));
+    }
+    return true;
+  } else if (fileName.endsWith(".csv")) {
+    if (!mapFile() || !indexCSVFile()) {
+      close();
+      return false;
+    }
+    mFileType = CSVFile;
+    return true;
+  } else if (fileName.endsWith(".plt")) {
+    if (!mapFile() || !indexPltFile()) {
+      close();
+      return false;
+    }
+    mFileType = PltFile;
+    return true;
+  }
+  mErrorString = QObject::tr("Unknown result file type %1.").arg(QFileInfo(fileName).suffix());
+  return false;
+}
+
+/*!
+ * \brief ResultFileReader::close
+ * Closes the result file and clears the index and the decoded columns.
+ */
+void ResultFileReader::close()
+{
+  if (mModelicaMatReader.file) {
+    omc_free_matlab4_reader(&mModelicaMatReader);
+    mModelicaMatReader.file = 0;
+  }
+  if (mFile.isOpen()) {
+    if (mpData && mFileContents.isEmpty()) {
+      mFile.unmap(reinterpret_cast<uchar*>(const_cast<char*>(mpData)));
+    }
+    mFile.close();
+  }
+  mFileContents.clear();
+  mpData = 0;
+  mDataSize = 0;
+  mFileType = NoFile;
+  mVariables.clear();
+  mCSVColumnsIndex.clear();
+  mCSVColumnsCount = 0;
+  mCSVRowsOffsets.clear();
+  mCSVFieldsOffsets.clear();
+  mCSVLastRowRead = false;
+  mCSVLastRow.clear();
+  mPltDataSetsIndex.clear();
+  mTimeColumnRead = false;
+  mTimeColumn.clear();
+  mColumnsCache.clear();
+}
+
+/*!
+ * \brief ResultFileReader::getVariables
+ * Returns the list of variables of the result file.
+ * \return
+ */
+QStringList ResultFileReader::getVariables() const
+{
+  return mVariables;
+}
+
+/*!
+ * \brief ResultFileReader::hasVariable
+ * Returns true if the variable exists in the result file.
+ * \param variable
+ * \return
+ */
+bool ResultFileReader::hasVariable(const QString &variable) const
+{
+  switch (mFileType) {
+    case MatFile:
+      return omc_matlab4_find_var(const_cast<ModelicaMatReader*>(&mModelicaMatReader), variable.toStdString().c_str()) != 0;
+    case CSVFile:
+      return mCSVColumnsIndex.contains(variable);
+    case PltFile:
+      return mPltDataSetsIndex.contains(variable);
+    default:
+      return false;
+  }
+}
+
+/*!
+ * \brief ResultFileReader::readTimeColumn
+ * Returns the time column of the result file. The time column is decoded once.
+ * \return
+ */
+QVector<double> ResultFileReader::readTimeColumn()
+{
+  if (mTimeColumnRead) {
+    return mTimeColumn;
+  }
+  mTimeColumnRead = true;
+  switch (mFileType) {
+    case MatFile:
+      if (!decodeMatColumn("time", &mTimeColumn)) {
+        double *pValues = omc_matlab4_read_vals(&mModelicaMatReader, 1);
+        if (pValues) {
+          mTimeColumn = QVector<double>(mModelicaMatReader.nrows);
+          memcpy(mTimeColumn.data(), pValues, mModelicaMatReader.nrows * sizeof(double));
+        }
+      }
+      break;
+    case CSVFile:
+      decodeCSVColumn(mCSVColumnsIndex.value("time", 0), &mTimeColumn);
+      break;
+    case PltFile:
+      // all the data sets of a plt file share the time values.
+      if (!mVariables.isEmpty()) {
+        decodePltDataSet(mVariables.first(), 0, &mTimeColumn);
+      }
+      break;
+    default:
+      break;
+  }
+  return mTimeColumn;
+}
+
+/*!
+ * \brief ResultFileReader::readVariableColumn
+ * Returns the values of the variable. The column is decoded on first use and then served from the cache.
+ * \param variable
+ * \param ok - set to false if the variable is not found.
+ * \return
+ */
+QVector<double> ResultFileReader::readVariableColumn(const QString &variable, bool *ok)
+{
+  if (ok) {
+    *ok = true;
+  }
+  if (QVector<double> *pColumn = mColumnsCache.object(variable)) {
+    return *pColumn;
+  }
+  QVector<double> column;
+  bool decoded = false;
+  switch (mFileType) {
+    case MatFile:
+      decoded = decodeMatColumn(variable, &column);
+      break;
+    case CSVFile:
+      decoded = mCSVColumnsIndex.contains(variable) && decodeCSVColumn(mCSVColumnsIndex.value(variable), &column);
+      break;
+    case PltFile:
+      decoded = mPltDataSetsIndex.contains(variable) && decodePltDataSet(variable, 1, &column);
+      break;
+    default:
+      break;
+  }
+  if (!decoded) {
+    if (ok) {
+      *ok = false;
+    }
+    return QVector<double>();
+  }
+  mColumnsCache.insert(variable, new QVector<double>(column), qMax<int>(1, column.size() * sizeof(double)));
+  return column;
+}
+
+/*!
+ * \brief ResultFileReader::readVariableValue
+ * Reads the value of the variable at time. The value is interpolated linearly between the two closest time points.
+ * \param variable
+ * \param time
+ * \param pValue - left unchanged if the variable is not found.
+ * \return
+ */
+bool ResultFileReader::readVariableValue(const QString &variable, double time, double *pValue)
+{
+  bool ok;
+  QVector<double> values = readVariableColumn(variable, &ok);
+  if (!ok || values.isEmpty()) {
+    return false;
+  }
+  QVector<double> timeColumn = readTimeColumn();
+  if (timeColumn.size() != values.size()) {
+    return false;
+  }
+  *pValue = interpolate(timeColumn, values, time);
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::readVariableFinalValue
+ * Reads the value of the variable at the stop time.\n
+ * Only the last sample is read, i.e., one value of the mat file, the last row of the csv file or the last line of the plt data set.
+ * Nothing is added to the columns cache.
+ * \param variable
+ * \param pValue - left unchanged if the variable is not found.
+ * \return
+ */
+bool ResultFileReader::readVariableFinalValue(const QString &variable, double *pValue)
+{
+  if (QVector<double> *pColumn = mColumnsCache.object(variable)) {
+    if (pColumn->isEmpty()) {
+      return false;
+    }
+    *pValue = pColumn->last();
+    return true;
+  }
+  switch (mFileType) {
+    case MatFile: {
+      ModelicaMatVariable_t *pVariable = omc_matlab4_find_var(&mModelicaMatReader, variable.toStdString().c_str());
+      if (!pVariable) {
+        return false;
+      } else if (pVariable->isParam) {
+        return omc_matlab4_val(pValue, &mModelicaMatReader, pVariable, omc_matlab4_startTime(&mModelicaMatReader)) == 0;
+      } else if (mModelicaMatReader.nrows == 0) {
+        return false;
+      }
+      return omc_matlab4_read_single_val(pValue, &mModelicaMatReader, pVariable->index, mModelicaMatReader.nrows - 1) == 0;
+    }
+    case CSVFile: {
+      if (!mCSVLastRowRead) {
+        mCSVLastRowRead = true;
+        decodeCSVLastRow();
+      }
+      int column = mCSVColumnsIndex.value(variable, -1);
+      if (column < 0 || column >= mCSVLastRow.size() || qIsNaN(mCSVLastRow.at(column))) {
+        return false;
+      }
+      *pValue = mCSVLastRow.at(column);
+      return true;
+    }
+    case PltFile:
+      return mPltDataSetsIndex.contains(variable) && decodePltFinalValue(variable, pValue);
+    default:
+      return false;
+  }
+}
+
+/*!
+ * \brief ResultFileReader::parseCSVHeader
+ * Splits the header line of a csv result file into the variable names. The position of a name in the list is its column.
+ * \param header
+ * \return
+ */
+QStringList ResultFileReader::parseCSVHeader(const QString &header)
+{
+  // the variable names are quoted and may contain commas e.g "a[1,2]".
+  QStringList names;
+  QString name;
+  bool inQuotes = false;
+  for (int i = 0 ; i <= header.length() ; i++) {
+    QChar c = i < header.length() ? header.at(i) : QChar(',');
+    if (c == '"') {
+      inQuotes = !inQuotes;
+    } else if (c == ',' && !inQuotes) {
+      names.append(name.trimmed());
+      name.clear();
+    } else {
+      name.append(c);
+    }
+  }
+  return names;
+}
+
+/*!
+ * \brief ResultFileReader::mapFile
+ * Maps the result file into memory. Reads the file if mapping is not possible.
+ * \return
+ */
+bool ResultFileReader::mapFile()
+{
+  mFile.setFileName(mFileName);
+  if (!mFile.open(QIODevice::ReadOnly)) {
+    mErrorString = mFile.errorString();
+    return false;
+  }
+  mDataSize = mFile.size();
+  if (mDataSize <= 0) {
+    mErrorString = QObject::tr("The file is empty.");
+    return false;
+  }
+  mpData = reinterpret_cast<const char*>(mFile.map(0, mDataSize));
+  if (!mpData) {
+    mFileContents = mFile.readAll();
+    if (mFileContents.isEmpty()) {
+      mErrorString = mFile.errorString();
+      return false;
+    }
+    mpData = mFileContents.constData();
+    mDataSize = mFileContents.size();
+  }
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::indexCSVFile
+ * Reads the variable names from the header and stores the offset of each row.
+ * \return
+ */
+bool ResultFileReader::indexCSVFile()
+{
+  const char *pEnd = mpData + mDataSize;
+  const char *pHeaderEnd = findLineEnd(mpData, pEnd);
+  QStringList header = parseCSVHeader(QString::fromUtf8(mpData, pHeaderEnd - mpData));
+  mCSVColumnsCount = header.size();
+  for (int i = 0 ; i < header.size() ; i++) {
+    if (!header.at(i).isEmpty() && !mCSVColumnsIndex.contains(header.at(i))) {
+      mCSVColumnsIndex.insert(header.at(i), i);
+      mVariables.append(header.at(i));
+    }
+  }
+  if (mVariables.isEmpty()) {
+    mErrorString = QObject::tr("No variables found in the header.");
+    return false;
+  }
+  for (const char *p = pHeaderEnd < pEnd ? pHeaderEnd + 1 : pEnd ; p < pEnd ; ) {
+    const char *pLineEnd = findLineEnd(p, pEnd);
+    if (!isBlankLine(p, pLineEnd)) {
+      mCSVRowsOffsets.append(p - mpData);
+    }
+    p = pLineEnd + 1;
+  }
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::indexPltFile
+ * Stores the byte range of each data set.
+ * \return
+ */
+bool ResultFileReader::indexPltFile()
+{
+  const char *pEnd = mpData + mDataSize;
+  static const char dataSet[] = "DataSet:";
+  const int dataSetLength = sizeof(dataSet) - 1;
+  QString variable;
+  qint64 dataSetStart = 0;
+  for (const char *p = mpData ; p < pEnd ; ) {
+    const char *pLineEnd = findLineEnd(p, pEnd);
+    if (pLineEnd - p >= dataSetLength && strncmp(p, dataSet, dataSetLength) == 0) {
+      if (!variable.isEmpty()) {
+        mPltDataSetsIndex.insert(variable, qMakePair(dataSetStart, static_cast<qint64>(p - mpData)));
+      }
+      variable = QString::fromUtf8(p + dataSetLength, pLineEnd - p - dataSetLength).trimmed();
+      mVariables.append(variable);
+      dataSetStart = qMin(static_cast<qint64>(pLineEnd + 1 - mpData), mDataSize);
+    }
+    p = pLineEnd + 1;
+  }
+  if (variable.isEmpty()) {
+    mErrorString = QObject::tr("No data sets found.");
+    return false;
+  }
+  mPltDataSetsIndex.insert(variable, qMakePair(dataSetStart, mDataSize));
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::decodeMatColumn
+ * Reads the values of the variable from the mat file. Parameters are expanded to the number of time points.
+ * \param variable
+ * \param pColumn
+ * \return
+ */
+bool ResultFileReader::decodeMatColumn(const QString &variable, QVector<double> *pColumn)
+{
+  ModelicaMatVariable_t *pVariable = omc_matlab4_find_var(&mModelicaMatReader, variable.toStdString().c_str());
+  if (!pVariable) {
+    return false;
+  }
+  if (pVariable->isParam) {
+    double value;
+    if (omc_matlab4_val(&value, &mModelicaMatReader, pVariable, omc_matlab4_startTime(&mModelicaMatReader))) {
+      return false;
+    }
+    pColumn->fill(value, qMax<int>(mModelicaMatReader.nrows, 1));
+    return true;
+  }
+  double *pValues = omc_matlab4_read_vals(&mModelicaMatReader, pVariable->index);
+  if (!pValues) {
+    return false;
+  }
+  *pColumn = QVector<double>(mModelicaMatReader.nrows);
+  memcpy(pColumn->data(), pValues, mModelicaMatReader.nrows * sizeof(double));
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::indexCSVFields
+ * Stores the offset of every RESULT_FILE_READER_CSV_FIELDS_STRIDE field of each row relative to the row start.
+ * A missing field is stored as the line end so decoding that column fails like before.
+ */
+void ResultFileReader::indexCSVFields()
+{
+  const int fieldsPerRow = (mCSVColumnsCount - 1) / RESULT_FILE_READER_CSV_FIELDS_STRIDE;
+  if (fieldsPerRow <= 0) {
+    return;
+  }
+  const char *pEnd = mpData + mDataSize;
+  mCSVFieldsOffsets.resize(mCSVRowsOffsets.size() * fieldsPerRow);
+  for (int i = 0 ; i < mCSVRowsOffsets.size() ; i++) {
+    const char *pRow = mpData + mCSVRowsOffsets.at(i);
+    const char *pLineEnd = findLineEnd(pRow, pEnd);
+    const char *p = pRow;
+    for (int j = 1 ; j <= fieldsPerRow * RESULT_FILE_READER_CSV_FIELDS_STRIDE ; j++) {
+      if (p < pLineEnd) {
+        p = findFieldEnd(p, pLineEnd);
+        if (p < pLineEnd) {
+          p++;
+        }
+      }
+      if (j % RESULT_FILE_READER_CSV_FIELDS_STRIDE == 0) {
+        mCSVFieldsOffsets[i * fieldsPerRow + j / RESULT_FILE_READER_CSV_FIELDS_STRIDE - 1] = p - pRow;
+      }
+    }
+  }
+}
+
+/*!
+ * \brief ResultFileReader::decodeCSVColumn
+ * Parses the column of each indexed row.\n
+ * Each row is entered at the closest indexed field before the column so decoding a column doesn't depend on its position.
+ * \param column
+ * \param pColumn
+ * \return
+ */
+bool ResultFileReader::decodeCSVColumn(int column, QVector<double> *pColumn)
+{
+  const int fieldsPerRow = (mCSVColumnsCount - 1) / RESULT_FILE_READER_CSV_FIELDS_STRIDE;
+  const int indexedField = qMin(column / RESULT_FILE_READER_CSV_FIELDS_STRIDE, fieldsPerRow);
+  if (indexedField > 0 && mCSVFieldsOffsets.isEmpty()) {
+    indexCSVFields();
+  }
+  const char *pEnd = mpData + mDataSize;
+  QVector<double> values(mCSVRowsOffsets.size());
+  for (int i = 0 ; i < mCSVRowsOffsets.size() ; i++) {
+    const char *p = mpData + mCSVRowsOffsets.at(i);
+    const char *pLineEnd = findLineEnd(p, pEnd);
+    if (indexedField > 0) {
+      p += mCSVFieldsOffsets.at(i * fieldsPerRow + indexedField - 1);
+      if (p >= pLineEnd) {
+        return false;
+      }
+    }
+    for (int j = indexedField * RESULT_FILE_READER_CSV_FIELDS_STRIDE ; j < column ; j++) {
+      p = findFieldEnd(p, pLineEnd);
+      if (p == pLineEnd) {
+        return false;
+      }
+      p++;
+    }
+    bool ok;
+    values[i] = parseDouble(p, findFieldEnd(p, pLineEnd), &ok);
+    if (!ok) {
+      return false;
+    }
+  }
+  *pColumn = values;
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::decodeCSVLastRow
+ * Splits the last row once and parses all of its fields. A field that is not a number is stored as NaN.
+ */
+void ResultFileReader::decodeCSVLastRow()
+{
+  mCSVLastRow.clear();
+  if (mCSVRowsOffsets.isEmpty()) {
+    return;
+  }
+  const char *pEnd = mpData + mDataSize;
+  const char *p = mpData + mCSVRowsOffsets.last();
+  const char *pLineEnd = findLineEnd(p, pEnd);
+  mCSVLastRow.reserve(mCSVColumnsCount);
+  while (mCSVLastRow.size() < mCSVColumnsCount) {
+    const char *pFieldEnd = findFieldEnd(p, pLineEnd);
+    bool ok;
+    double value = parseDouble(p, pFieldEnd, &ok);
+    mCSVLastRow.append(ok ? value : qQNaN());
+    if (pFieldEnd == pLineEnd) {
+      break;
+    }
+    p = pFieldEnd + 1;
+  }
+}
+
+/*!
+ * \brief ResultFileReader::decodePltDataSet
+ * Parses the data set of the variable.
+ * \param variable
+ * \param field - 0 for the time values and 1 for the variable values.
+ * \param pColumn
+ * \return
+ */
+bool ResultFileReader::decodePltDataSet(const QString &variable, int field, QVector<double> *pColumn) const
+{
+  QPair<qint64, qint64> range = mPltDataSetsIndex.value(variable);
+  const char *pEnd = mpData + range.second;
+  QVector<double> values;
+  for (const char *p = mpData + range.first ; p < pEnd ; ) {
+    const char *pLineEnd = findLineEnd(p, pEnd);
+    const char *pComma = findFieldEnd(p, pLineEnd);
+    if (pComma != pLineEnd) {
+      bool ok;
+      double value = field == 0 ? parseDouble(p, pComma, &ok) : parseDouble(pComma + 1, findFieldEnd(pComma + 1, pLineEnd), &ok);
+      if (!ok) {
+        return false;
+      }
+      values.append(value);
+    }
+    p = pLineEnd + 1;
+  }
+  *pColumn = values;
+  return true;
+}
+
+/*!
+ * \brief ResultFileReader::decodePltFinalValue
+ * Parses the value of the last line of the data set of the variable.
+ * \param variable
+ * \param pValue
+ * \return
+ */
+bool ResultFileReader::decodePltFinalValue(const QString &variable, double *pValue) const
+{
+  QPair<qint64, qint64> range = mPltDataSetsIndex.value(variable);
+  const char *pBegin = mpData + range.first;
+  const char *pEnd = mpData + range.second;
+  // walk back over the lines of the data set until one holds a time and a value pair.
+  while (pEnd > pBegin) {
+    const char *pLineBegin = pEnd;
+    while (pLineBegin > pBegin && *(pLineBegin - 1) != '\n') {
+      pLineBegin--;
+    }
+    const char *pComma = findFieldEnd(pLineBegin, pEnd);
+    if (pComma != pEnd) {
+      bool ok;
+      double value = parseDouble(pComma + 1, findFieldEnd(pComma + 1, pEnd), &ok);
+      if (ok) {
+        *pValue = value;
+      }
+      return ok;
+    }
+    pEnd = pLineBegin > pBegin ? pLineBegin - 1 : pBegin;
+  }
+  return false;
+}
+
+/*!
+ * \brief ResultFileReader::interpolate
+ * Finds the time with a binary search and interpolates linearly between the two closest points.
+ * At an event, i.e., duplicate time points, the value before the event is returned.
+ * \param time
+ * \param values
+ * \param t
+ * \return
+ */
+double ResultFileReader::interpolate(const QVector<double> &time, const QVector<double> &values, double t)
+{
+  if (t <= time.first()) {
+    return values.first();
+  } else if (t >= time.last()) {
+    return values.last();
+  }
+  int i = std::lower_bound(time.constBegin(), time.constEnd(), t) - time.constBegin();
+  if (time.at(i) == t) {
+    return values.at(i);
+  }
+  double t0 = time.at(i - 1);
+  double t1 = time.at(i);
+  return values.at(i - 1) + (values.at(i) - values.at(i - 1)) * (t - t0) / (t1 - t0);
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef RESULTFILEREADER_H
+#define RESULTFILEREADER_H
+
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QCache>
+#include <QVector>
+#include <QStringList>
+
+#include "util/read_matlab4.h"
+
+/*!
+ * \class ResultFileReader
+ * \brief Random access to the variables of a .mat, .csv or .plt result file.
+ * The .csv and .plt files are memory mapped and indexed once when opened. The .mat files are read through the matlab4 reader.
+ * The columns are decoded on first use and kept in a cache. Values at a given time are found with a binary search on the time column.
+ * The final values are read from the last sample only.
+ */
+class ResultFileReader
+{
+public:
+  ResultFileReader();
+  ~ResultFileReader();
+  bool open(const QString &fileName);
+  void close();
+  bool isOpen() const {return mFileType != NoFile;}
+  QString getFileName() const {return mFileName;}
+  QString getErrorString() const {return mErrorString;}
+  QStringList getVariables() const;
+  bool hasVariable(const QString &variable) const;
+  QVector<double> readTimeColumn();
+  QVector<double> readVariableColumn(const QString &variable, bool *ok = 0);
+  bool readVariableValue(const QString &variable, double time, double *pValue);
+  bool readVariableFinalValue(const QString &variable, double *pValue);
+  static QStringList parseCSVHeader(const QString &header);
+private:
+  enum FileType {
+    NoFile,
+    MatFile,
+    CSVFile,
+    PltFile
+  };
+  FileType mFileType;
+  QString mFileName;
+  QString mErrorString;
+  ModelicaMatReader mModelicaMatReader;
+  QFile mFile;
+  QByteArray mFileContents;
+  const char *mpData;
+  qint64 mDataSize;
+  QStringList mVariables;
+  QHash<QString, int> mCSVColumnsIndex;
+  int mCSVColumnsCount;
+  QVector<qint64> mCSVRowsOffsets;
+  QVector<quint32> mCSVFieldsOffsets;
+  bool mCSVLastRowRead;
+  QVector<double> mCSVLastRow;
+  QHash<QString, QPair<qint64, qint64> > mPltDataSetsIndex;
+  bool mTimeColumnRead;
+  QVector<double> mTimeColumn;
+  QCache<QString, QVector<double> > mColumnsCache;
+  bool mapFile();
+  bool indexCSVFile();
+  bool indexPltFile();
+  bool decodeMatColumn(const QString &variable, QVector<double> *pColumn);
+  void indexCSVFields();
+  bool decodeCSVColumn(int column, QVector<double> *pColumn);
+  void decodeCSVLastRow();
+  bool decodePltDataSet(const QString &variable, int field, QVector<double> *pColumn) const;
+  bool decodePltFinalValue(const QString &variable, double *pValue) const;
+  static double interpolate(const QVector<double> &time, const QVector<double> &values, double t);
+};
+
+#endif // RESULTFILEREADER_H
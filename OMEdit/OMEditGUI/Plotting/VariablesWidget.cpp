@@ -39,17 +39,61 @@
 #include "Modeling/ItemDelegate.h"
 #include "Options/OptionsDialog.h"
 #include "Modeling/MessagesWidget.h"
-#include "util/read_matlab4.h"
 #include "Plotting/PlotWindowContainer.h"
 #include "Plotting/DiagramWindow.h"
+#include "Plotting/PlotCurveLevelOfDetail.h"
+#include "Plotting/LiveResultReader.h"
+#include "Plotting/ResultFileLoader.h"
 #include "Simulation/SimulationDialog.h"
 #include "Simulation/SimulationOutputWidget.h"
 #include "Simulation/SimulationProcessThread.h"
 
 #include <QObject>
+#include <QFileInfo>
+#include <QSet>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 using namespace OMPlot;
 
+/*!
+ * \brief convertPlotCurveValues
+ * Converts the curve values in place.
+ * \param pValues
+ * \param offset
+ * \param scaleFactor
+ */
+static void convertPlotCurveValues(QVector<double> *pValues, qreal offset, qreal scaleFactor)
+{
+  double *pData = pValues->data();
+  for (int i = 0 ; i < pValues->size() ; i++) {
+    pData[i] = Utilities::convertUnit(pData[i], offset, scaleFactor);
+  }
+}
+
+/*!
+ * \brief parseVariableParts
+ * Splits the result variable into its parts. der( and previous( are removed from the variable.\n
+ * Called from the worker threads by VariablesTreeModel::insertVariablesItems.
+ * \param plotVariable
+ * \return
+ */
+static QStringList parseVariableParts(const QString &plotVariable)
+{
+  if (plotVariable.startsWith("der(")) {
+    QString str = plotVariable;
+    str.chop((str.lastIndexOf("der(")/4)+1);
+    return StringHandler::makeVariablePartsWithInd(str.mid(str.lastIndexOf("der(") + 4));
+  } else if (plotVariable.startsWith("previous(")) { //TODO: edit in same way as for der(
+    QString str = plotVariable;
+    str.chop((str.lastIndexOf("previous(")/9)+1);
+    return StringHandler::makeVariablePartsWithInd(str.mid(str.lastIndexOf("previous(") + 9));
+  } else {
+    return StringHandler::makeVariablePartsWithInd(plotVariable);
+  }
+}
+
 /*!
  * \class VariablesTreeItem
  * \brief Contains the information about the result variable.
@@ -484,70 +528,19 @@ QModelIndex VariablesTreeModel::variablesTreeItemIndexHelper(const VariablesTree
   return QModelIndex();
 }
 
-void VariablesTreeModel::parseInitXml(QXmlStreamReader &xmlReader)
-{
-  mScalarVariablesList.clear();
-  /* We'll parse the XML until we reach end of it.*/
-  while(!xmlReader.atEnd() && !xmlReader.hasError())
-  {
-    /* Read next element.*/
-    QXmlStreamReader::TokenType token = xmlReader.readNext();
-    /* If token is just StartDocument, we'll go to next.*/
-    if(token == QXmlStreamReader::StartDocument)
-      continue;
-    /* If token is StartElement, we'll see if we can read it.*/
-    if(token == QXmlStreamReader::StartElement)
-    {
-      /* If it's named ScalarVariable, we'll dig the information from there.*/
-      if(xmlReader.name() == "ScalarVariable")
-      {
-        QHash<QString, QString> scalarVariable = parseScalarVariable(xmlReader);
-        mScalarVariablesList.insert(scalarVariable.value("name"),scalarVariable);
-      }
-    }
-  }
-  xmlReader.clear();
-}
-
-QHash<QString, QString> VariablesTreeModel::parseScalarVariable(QXmlStreamReader &xmlReader)
-{
-  QHash<QString, QString> scalarVariable;
-  /* Let's check that we're really getting a ScalarVariable. */
-  if(xmlReader.tokenType() != QXmlStreamReader::StartElement && xmlReader.name() == "ScalarVariable")
-    return scalarVariable;
-  /* Let's get the attributes for ScalarVariable */
-  QXmlStreamAttributes attributes = xmlReader.attributes();
-  /* Read the ScalarVariable attributes. */
-  scalarVariable["name"] = attributes.value("name").toString();
-  scalarVariable["description"] = attributes.value("description").toString();
-  scalarVariable["isValueChangeable"] = attributes.value("isValueChangeable").toString();
-  scalarVariable["variability"] = attributes.value("variability").toString();
-  /* Read the next element i.e Real, Integer, Boolean etc. */
-  xmlReader.readNext();
-  while(!(xmlReader.tokenType() == QXmlStreamReader::EndElement && xmlReader.name() == "ScalarVariable"))
-  {
-    if(xmlReader.tokenType() == QXmlStreamReader::StartElement)
-    {
-      QXmlStreamAttributes attributes = xmlReader.attributes();
-      scalarVariable["start"] = attributes.value("start").toString();
-      scalarVariable["unit"] = attributes.value("unit").toString();
-      scalarVariable["displayUnit"] = attributes.value("displayUnit").toString();
-    }
-    xmlReader.readNext();
-  }
-  return scalarVariable;
-}
-
 /*!
  * \brief VariablesTreeModel::insertVariablesItems
- * Inserts the variables in the Variables Browser.
+ * Inserts the variables in the Variables Browser.\n
+ * The ResultFileLoader hands over the variables information it has read in its thread.
+ * Otherwise the model_init.xml file and the final values are read here.
  * \param fileName
  * \param filePath
  * \param variablesList
  * \param simulationOptions
+ * \param pVariablesInformation - the information read by the ResultFileLoader or 0.
  */
 void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath, QStringList variablesList,
-                                              SimulationOptions simulationOptions)
+                                              SimulationOptions simulationOptions, const ResultVariablesInformation *pVariablesInformation)
 {
   QString toolTip;
   if (simulationOptions.isInteractiveSimulation()) {
@@ -563,80 +556,69 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
 
   VariablesTreeItem *pTopVariablesTreeItem = new VariablesTreeItem(Variabledata, mpRootVariablesTreeItem, true);
   pTopVariablesTreeItem->setSimulationOptions(simulationOptions);
-  int row = rowCount();
-  beginInsertRows(index, row, row);
-  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
-  endInsertRows();
   // set the newly inserted VariablesTreeItem active
   mpActiveVariablesTreeItem = pTopVariablesTreeItem;
   if (simulationOptions.isValid() && !simulationOptions.isInteractiveSimulation()) {
     pTopVariablesTreeItem->setActive();
   }
-  /* open the model_init.xml file for reading */
-  QString initFileName;
-  if (simulationOptions.isValid()) {
-    initFileName = QString(simulationOptions.getOutputFileName()).append("_init.xml");
+  ResultVariablesInformation variablesInformation;
+  if (pVariablesInformation) {
+    variablesInformation = *pVariablesInformation;
   } else {
-    initFileName = QString(text).append("_init.xml");
-  }
-  QFile initFile(QString(filePath).append(QDir::separator()).append(initFileName));
-  if (initFile.exists()) {
-    if (initFile.open(QIODevice::ReadOnly)) {
-      QXmlStreamReader initXmlReader(&initFile);
-      parseInitXml(initXmlReader);
-      initFile.close();
+    /* read the model_init.xml file */
+    if (simulationOptions.isValid()) {
+      variablesInformation.readInitXml(QString(filePath).append("/").append(simulationOptions.getOutputFileName()).append("_init.xml"));
     } else {
-      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(initFile.fileName())
-                                                            .arg(initFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
+      variablesInformation.readInitXml(QString(filePath).append("/").append(text).append("_init.xml"));
     }
-  }
-  /* open the .mat file */
-  ModelicaMatReader matReader;
-  matReader.file = 0;
-  const char *msg[] = {""};
-  if (fileName.endsWith(".mat")) {
-    //Read in mat file
-    if (0 != (msg[0] = omc_new_matlab4_reader(QString(filePath + "/" + fileName).toStdString().c_str(), &matReader))) {
-      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
-                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName)
-                                                            .arg(QString(msg[0])), Helper::scriptingKind, Helper::errorLevel));
+    /* read the final values from the result file */
+    ResultFileReader resultFileReader;
+    if (resultFileReader.open(QString(filePath + "/" + fileName))) {
+      foreach (QString variable, variablesList) {
+        variablesInformation.readFinalValue(&resultFileReader, variable);
+      }
+    } else {
+      variablesInformation.addError(GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE).arg(fileName).arg(resultFileReader.getErrorString()));
     }
   }
+  foreach (QString error, variablesInformation.getErrors()) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, error, Helper::scriptingKind,
+                                                          Helper::errorLevel));
+  }
 
   // remove time from variables list
   variablesList.removeOne("time");
-  QStringList variables;
-  foreach (QString plotVariable, variablesList) {
+  // split the variables into parts on the worker threads.
+  QList<QStringList> variablesParts = QtConcurrent::blockingMapped<QList<QStringList> >(variablesList, parseVariableParts);
+  /* The variables are added to pTopVariablesTreeItem before it is inserted in the model.
+   * The VariablesTreeItems of this result are looked up by name in variablesTreeItems instead of searching the tree.
+   */
+  QRegExp arrayIndexRegExp("\\[\\d+\\]");
+  QString topVariablePrefix = pTopVariablesTreeItem->getVariableName() + ".";
+  QHash<QString, VariablesTreeItem*> variablesTreeItems;
+  QHash<QString, OMCInterface::convertUnits_res> unitConversions;
+  for (int i = 0 ; i < variablesList.size() ; i++) {
+    const QString &plotVariable = variablesList.at(i);
+    const QStringList &variables = variablesParts.at(i);
+    bool isDerivative = plotVariable.startsWith("der(");
+    bool isPrevious = plotVariable.startsWith("previous(");
+    bool isLastArrayIndex = !variables.isEmpty() && arrayIndexRegExp.exactMatch(variables.last());
     QString parentVariable;
-    if (plotVariable.startsWith("der(")) {
-      QString str = plotVariable;
-      str.chop((str.lastIndexOf("der(")/4)+1);
-      variables = StringHandler::makeVariablePartsWithInd(str.mid(str.lastIndexOf("der(") + 4));
-    } else if (plotVariable.startsWith("previous(")) { //TODO: edit in same way as for der(
-      QString str = plotVariable;
-      str.chop((str.lastIndexOf("previous(")/9)+1);
-      variables = StringHandler::makeVariablePartsWithInd(str.mid(str.lastIndexOf("previous(") + 9));
-    } else {
-      variables = StringHandler::makeVariablePartsWithInd(plotVariable);
-    }
     int count = 1;
     VariablesTreeItem *pParentVariablesTreeItem = 0;
     foreach (QString variable, variables) {
-      if (count == 1) { /* first loop iteration */
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
+      bool isArrayIndex = (variables.size() == count) ? isLastArrayIndex : arrayIndexRegExp.exactMatch(variable);
+      /* if second to last of array */
+      bool isMainArray = variables.size() == count+1 && isLastArrayIndex;
       QString findVariable;
       /* if last item of non-array or second to last of array*/
-      if (((variables.size() == count && !QRegExp("\\[\\d+\\]").exactMatch(variable)) ||
-              (variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last())))
-              && plotVariable.startsWith("der(")) {
+      if (((variables.size() == count && !isArrayIndex) || isMainArray) && isDerivative) {
         if (parentVariable.isEmpty()) {
           findVariable = QString("%1.%2").arg(fileName , StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der("));
         } else {
           findVariable = QString("%1.%2.%3").arg(fileName, parentVariable, StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der("));
         }
-      } else if (variables.size() == count && plotVariable.startsWith("previous(")) { //TODO: edit in same way as for der(
+      } else if (variables.size() == count && isPrevious) { //TODO: edit in same way as for der(
         if (parentVariable.isEmpty()) {
           findVariable = QString("%1.%2").arg(fileName , StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous("));
         } else {
@@ -649,116 +631,104 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
           findVariable = QString("%1.%2.%3").arg(fileName, parentVariable, variable);
         }
       }
-      if ((pParentVariablesTreeItem = findVariablesTreeItem(findVariable, pParentVariablesTreeItem)) != NULL) {
-        QString addVar;
-        //if second to last of array, add der(
-        if ((variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last())) && plotVariable.startsWith("der("))
-          addVar = StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
-        else
-          addVar = variable;
-        if (count == 1) {
-          parentVariable = addVar;
-        } else {
-          parentVariable += "." + addVar;
-        }
-        count++;
-        continue;
-      }
-      /* If pParentVariablesTreeItem is 0 and it is first loop iteration then use pTopVariablesTreeItem as parent.
-       * If loop iteration is not first and pParentVariablesTreeItem is 0 then find the parent item.
-       */
-      if (!pParentVariablesTreeItem && count > 1) {
-        pParentVariablesTreeItem = findVariablesTreeItem(fileName + "." + parentVariable, pTopVariablesTreeItem);
-      } else {
-        pParentVariablesTreeItem = pTopVariablesTreeItem;
-      }
-      QModelIndex index = variablesTreeItemIndex(pParentVariablesTreeItem);
-      QVector<QVariant> variableData;
-      /*if last but one of array derivative*/
-      if (variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last()) && plotVariable.startsWith("der(")) {
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(") << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
-      }
-      /* if last item of non-array derivative*/
-      else if (variables.size() == count && !QRegExp("\\[\\d+\\]").exactMatch(variable) && plotVariable.startsWith("der(")) {
-        variableData << filePath << fileName << fileName + "." + plotVariable << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
-      }
-      /*if last but one of array previous*/
-      else if (variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last()) && plotVariable.startsWith("previous(")) {
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(") << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(");
-      }
-      /* if last item of non-array previous*/
-      else if (variables.size() == count && !QRegExp("\\[\\d+\\]").exactMatch(variable) && plotVariable.startsWith("previous(")) {
-        variableData << filePath << fileName << fileName + "." + plotVariable << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(");
-      }
-      /* if last item of array derivative*/
-      else if (variables.size() == count && QRegExp("\\[\\d+\\]").exactMatch(variable)) {
-        variableData << filePath << fileName << fileName + "." + plotVariable << variable;
+      QString addVar;
+      //if second to last of array, add der(
+      if (isMainArray && isDerivative) {
+        addVar = StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
       } else {
-        variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
+        addVar = variable;
       }
-      /* find the variable in the xml file */
-      QString variableToFind = variableData[2].toString();
-      variableToFind.remove(QRegExp(pTopVariablesTreeItem->getVariableName() + "."));
-      /* get the variable information i.e value, unit, displayunit, description */
-      QString value, variability, unit, displayUnit, description;
-      bool changeAble = false;
-      getVariableInformation(&matReader, variableToFind, &value, &changeAble, &variability, &unit, &displayUnit, &description);
-      variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
-      /* set the variable unit */
-      variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
-      /* set the variable displayUnit */
-      variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
-      /* set the variable displayUnits */
-      if (!variableData[5].toString().isEmpty()) {
-        QStringList displayUnits, displayUnitOptions;
-        displayUnits << variableData[5].toString();
-        if (!variableData[6].toString().isEmpty()) {
-          displayUnitOptions << variableData[6].toString();
-          /* convert value to displayUnit */
-          OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(variableData[5].toString(), variableData[6].toString());
-          if (convertUnit.unitsCompatible) {
-            bool ok = true;
-            qreal realValue = variableData[4].toDouble(&ok);
-            if (ok) {
-              realValue = Utilities::convertUnit(realValue, convertUnit.offset, convertUnit.scaleFactor);
-              variableData[4] = QString::number(realValue);
+      VariablesTreeItem *pVariablesTreeItem = variablesTreeItems.value(findVariable, 0);
+      if (!pVariablesTreeItem) {
+        /* If it is first loop iteration then use pTopVariablesTreeItem as parent otherwise find the parent item. */
+        if (count > 1) {
+          pParentVariablesTreeItem = variablesTreeItems.value(fileName + "." + parentVariable, pTopVariablesTreeItem);
+        } else {
+          pParentVariablesTreeItem = pTopVariablesTreeItem;
+        }
+        QVector<QVariant> variableData;
+        /*if last but one of array derivative*/
+        if (isMainArray && isDerivative) {
+          variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(") << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
+        }
+        /* if last item of non-array derivative*/
+        else if (variables.size() == count && !isArrayIndex && isDerivative) {
+          variableData << filePath << fileName << fileName + "." + plotVariable << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
+        }
+        /*if last but one of array previous*/
+        else if (isMainArray && isPrevious) {
+          variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(") << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(");
+        }
+        /* if last item of non-array previous*/
+        else if (variables.size() == count && !isArrayIndex && isPrevious) {
+          variableData << filePath << fileName << fileName + "." + plotVariable << StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "previous(");
+        }
+        /* if last item of array derivative*/
+        else if (variables.size() == count && isArrayIndex) {
+          variableData << filePath << fileName << fileName + "." + plotVariable << variable;
+        } else {
+          variableData << filePath << fileName << pParentVariablesTreeItem->getVariableName() + "." + variable << variable;
+        }
+        /* find the variable in the xml file */
+        QString variableToFind = variableData[2].toString();
+        if (variableToFind.startsWith(topVariablePrefix)) {
+          variableToFind.remove(0, topVariablePrefix.length());
+        }
+        /* get the variable information i.e value, unit, displayunit, description */
+        QString value, variability, unit, displayUnit, description;
+        bool changeAble = false;
+        getVariableInformation(variablesInformation, variableToFind, &value, &changeAble, &variability, &unit, &displayUnit, &description);
+        variableData << StringHandler::unparse(QString("\"").append(value).append("\""));
+        /* set the variable unit */
+        variableData << StringHandler::unparse(QString("\"").append(unit).append("\""));
+        /* set the variable displayUnit */
+        variableData << StringHandler::unparse(QString("\"").append(displayUnit).append("\""));
+        /* set the variable displayUnits */
+        if (!variableData[5].toString().isEmpty()) {
+          QStringList displayUnits, displayUnitOptions;
+          displayUnits << variableData[5].toString();
+          if (!variableData[6].toString().isEmpty()) {
+            displayUnitOptions << variableData[6].toString();
+            /* convert value to displayUnit. The conversion is only fetched once per unit and displayUnit pair. */
+            QString unitConversionKey = variableData[5].toString() + "|" + variableData[6].toString();
+            QHash<QString, OMCInterface::convertUnits_res>::iterator unitConversionIterator = unitConversions.find(unitConversionKey);
+            if (unitConversionIterator == unitConversions.end()) {
+              unitConversionIterator = unitConversions.insert(unitConversionKey, MainWindow::instance()->getOMCProxy()->convertUnits(variableData[5].toString(), variableData[6].toString()));
+            }
+            OMCInterface::convertUnits_res convertUnit = unitConversionIterator.value();
+            if (convertUnit.unitsCompatible) {
+              bool ok = true;
+              qreal realValue = variableData[4].toDouble(&ok);
+              if (ok) {
+                realValue = Utilities::convertUnit(realValue, convertUnit.offset, convertUnit.scaleFactor);
+                variableData[4] = QString::number(realValue);
+              }
             }
+          } else { /* use unit as displayUnit */
+            variableData[6] = variableData[5];
           }
-        } else { /* use unit as displayUnit */
-          variableData[6] = variableData[5];
+          displayUnits << displayUnitOptions;
+          variableData << displayUnits;
+        } else {
+          variableData << QStringList();
         }
-        displayUnits << displayUnitOptions;
-        variableData << displayUnits;
-      } else {
-        variableData << QStringList();
-      }
-      /* set the variable description */
-      variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
-      /* construct tooltip text */
-      if (simulationOptions.isInteractiveSimulation()) {
-        variableData << tr("Variable: %1\nVariability: %2").arg(variableToFind).arg(variability);
-      } else {
-        variableData << tr("File: %1/%2\nVariable: %3\nVariability: %4").arg(filePath).arg(fileName).arg(variableToFind).arg(variability);
-      }
-      /*is main array*/
-      if (variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last())) {
-        variableData << true;
-      } else {
-        variableData << false;
+        /* set the variable description */
+        variableData << StringHandler::unparse(QString("\"").append(description).append("\""));
+        /* construct tooltip text */
+        if (simulationOptions.isInteractiveSimulation()) {
+          variableData << tr("Variable: %1\nVariability: %2").arg(variableToFind).arg(variability);
+        } else {
+          variableData << tr("File: %1/%2\nVariable: %3\nVariability: %4").arg(filePath).arg(fileName).arg(variableToFind).arg(variability);
+        }
+        /*is main array*/
+        variableData << isMainArray;
+        pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
+        pVariablesTreeItem->setEditable(changeAble);
+        pVariablesTreeItem->setVariability(variability);
+        pParentVariablesTreeItem->insertChild(pParentVariablesTreeItem->getChildren().size(), pVariablesTreeItem);
+        variablesTreeItems.insert(pVariablesTreeItem->getVariableName(), pVariablesTreeItem);
       }
-      VariablesTreeItem *pVariablesTreeItem = new VariablesTreeItem(variableData, pParentVariablesTreeItem);
-      pVariablesTreeItem->setEditable(changeAble);
-      pVariablesTreeItem->setVariability(variability);
-      int row = rowCount(index);
-      beginInsertRows(index, row, row);
-      pParentVariablesTreeItem->insertChild(row, pVariablesTreeItem);
-      endInsertRows();
-      QString addVar;
-      //if second to last of array, add der(
-      if ((variables.size() == count+1 && QRegExp("\\[\\d+\\]").exactMatch(variables.last())) && plotVariable.startsWith("der("))
-        addVar = StringHandler::joinDerivativeAndPreviousVariable(plotVariable, variable, "der(");
-      else
-        addVar = variable;
+      pParentVariablesTreeItem = pVariablesTreeItem;
       if (count == 1) {
         parentVariable = addVar;
       } else {
@@ -767,12 +737,11 @@ void VariablesTreeModel::insertVariablesItems(QString fileName, QString filePath
       count++;
     }
   }
-  /* close the .mat file */
-  if (fileName.endsWith(".mat")) {
-    if (matReader.file) {
-      omc_free_matlab4_reader(&matReader);
-    }
-  }
+  // insert the complete result tree in the model at once.
+  int row = rowCount();
+  beginInsertRows(index, row, row);
+  mpRootVariablesTreeItem->insertChild(row, pTopVariablesTreeItem);
+  endInsertRows();
   mpVariablesTreeView->collapseAll();
   QModelIndex idx = variablesTreeItemIndex(pTopVariablesTreeItem);
   idx = mpVariablesTreeView->getVariablesWidget()->getVariableTreeProxyModel()->mapFromSource(idx);
@@ -853,7 +822,7 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
 /*!
  * \brief VariablesTreeModel::getVariableInformation
  * Returns the variable information like value, unit, displayunit and description.
- * \param pMatReader
+ * \param variablesInformation
  * \param variableToFind
  * \param value
  * \param changeAble
@@ -862,26 +831,19 @@ void VariablesTreeModel::plotAllVariables(VariablesTreeItem *pVariablesTreeItem,
  * \param displayUnit
  * \param description
  */
-void VariablesTreeModel::getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble,
-                                                QString *variability, QString *unit, QString *displayUnit, QString *description)
+void VariablesTreeModel::getVariableInformation(const ResultVariablesInformation &variablesInformation, QString variableToFind, QString *value,
+                                                bool *changeAble, QString *variability, QString *unit, QString *displayUnit, QString *description)
 {
-  QHash<QString, QString> hash = mScalarVariablesList.value(variableToFind);
+  QHash<QString, QString> hash = variablesInformation.getScalarVariable(variableToFind);
   if (hash["name"].compare(variableToFind) == 0) {
     *changeAble = (hash["isValueChangeable"].compare("true") == 0) ? true : false;
     *variability = hash["variability"];
     if (*changeAble) {
       *value = hash["start"];
-    } else { /* if the variable is not a tunable parameter then read the final value of the variable. Only mat result files are supported. */
-      if ((pMatReader->file != NULL) && strcmp(pMatReader->fileName, "")) {
-        *value = "";
-        ModelicaMatVariable_t *var;
-        if (0 == (var = omc_matlab4_find_var(pMatReader, variableToFind.toStdString().c_str()))) {
-          qDebug() << QString("%1 not found in %2").arg(variableToFind).arg(pMatReader->fileName);
-        }
-        double res;
-        if (var && !omc_matlab4_val(&res, pMatReader, var, omc_matlab4_stopTime(pMatReader))) {
-          *value = QString::number(res);
-        }
+    } else { /* if the variable is not a tunable parameter then use the final value of the variable. */
+      double res;
+      if (variablesInformation.getFinalValue(variableToFind, &res)) {
+        *value = QString::number(res);
       }
     }
     *unit = hash["unit"];
@@ -1139,8 +1101,9 @@ VariablesWidget::VariablesWidget(QWidget *pParent)
   mpVariablesTreeView->setColumnWidth(3, 70);
   mpVariablesTreeView->setColumnHidden(2, true); // hide Unit column
   mpLastActiveSubWindow = 0;
-  mModelicaMatReader.file = 0;
-  mpCSVData = 0;
+  // the rows of the result files being loaded
+  mpResultFileLoadersLayout = new QVBoxLayout;
+  mpResultFileLoadersLayout->setContentsMargins(0, 0, 0, 0);
   // create the layout
   QGridLayout *pMainLayout = new QGridLayout;
   pMainLayout->setContentsMargins(0, 0, 0, 0);
@@ -1150,7 +1113,8 @@ VariablesWidget::VariablesWidget(QWidget *pParent)
   pMainLayout->addWidget(mpSimulationTimeComboBox, 1, 1);
   pMainLayout->addWidget(mpSimulationTimeSlider, 2, 0, 1, 2);
   pMainLayout->addWidget(mpToolBar, 3, 0, 1, 2);
-  pMainLayout->addWidget(mpVariablesTreeView, 4, 0, 1, 2);
+  pMainLayout->addLayout(mpResultFileLoadersLayout, 4, 0, 1, 2);
+  pMainLayout->addWidget(mpVariablesTreeView, 5, 0, 1, 2);
   setLayout(pMainLayout);
   connect(mpTreeSearchFilters->getExpandAllButton(), SIGNAL(clicked()), mpVariablesTreeView, SLOT(expandAll()));
   connect(mpTreeSearchFilters->getCollapseAllButton(), SIGNAL(clicked()), mpVariablesTreeView, SLOT(collapseAll()));
@@ -1166,6 +1130,18 @@ VariablesWidget::VariablesWidget(QWidget *pParent)
   //connect(mpVariablesTreeModel, SIGNAL(itemChecked(QModelIndex)), SLOT(selectInteractivePlotWindow(QModelIndex)));
 }
 
+/*!
+ * \brief VariablesWidget::~VariablesWidget
+ * Cancels the result files being loaded.
+ */
+VariablesWidget::~VariablesWidget()
+{
+  qDeleteAll(mResultFileLoaderWidgets);
+  mResultFileLoaderWidgets.clear();
+  qDeleteAll(mParameterSweepResultFileReaders);
+  mParameterSweepResultFileReaders.clear();
+}
+
 /*!
  * \brief VariablesWidget::insertVariablesItemsToTree
  * Inserts the result variables in the Variables Browser.
@@ -1173,9 +1149,10 @@ VariablesWidget::VariablesWidget(QWidget *pParent)
  * \param filePath
  * \param variablesList
  * \param simulationOptions
+ * \param pVariablesInformation - the information read by the ResultFileLoader or 0.
  */
 void VariablesWidget::insertVariablesItemsToTree(QString fileName, QString filePath, QStringList variablesList,
-                                                 SimulationOptions simulationOptions)
+                                                 SimulationOptions simulationOptions, const ResultVariablesInformation *pVariablesInformation)
 {
   /* Show results in model diagram if it is present in ModelWidgetContainer
    * and if switch to plotting perspective is disabled
@@ -1204,7 +1181,7 @@ void VariablesWidget::insertVariablesItemsToTree(QString fileName, QString fileP
   mpVariableTreeProxyModel->setFilterRegExp(QRegExp(""));
   mpVariablesTreeView->collapseAll();
   /* add the plot variables */
-  mpVariablesTreeModel->insertVariablesItems(fileName, filePath, variablesList, simulationOptions);
+  mpVariablesTreeModel->insertVariablesItems(fileName, filePath, variablesList, simulationOptions, pVariablesInformation);
 
   /* re-check previously checked variables */
   if (simulationOptions.isInteractiveSimulation() && simulationOptions.isReSimulate()) {
@@ -1225,6 +1202,49 @@ void VariablesWidget::insertVariablesItemsToTree(QString fileName, QString fileP
   findVariables();
 }
 
+/*!
+ * \brief VariablesWidget::loadResultFile
+ * Loads the result file in a worker thread and inserts its variables in the tree when it is loaded.\n
+ * A result file that is already being loaded is cancelled and loaded again.
+ * \param fileName - the absolute path of the result file.
+ */
+void VariablesWidget::loadResultFile(const QString &fileName)
+{
+  ResultFileLoaderWidget *pResultFileLoaderWidget = mResultFileLoaderWidgets.take(fileName);
+  if (pResultFileLoaderWidget) {
+    mpResultFileLoadersLayout->removeWidget(pResultFileLoaderWidget);
+    // doesn't wait for the old loader. It is cancelled and deletes itself when it is finished.
+    delete pResultFileLoaderWidget;
+  }
+  pResultFileLoaderWidget = new ResultFileLoaderWidget(fileName);
+  connect(pResultFileLoaderWidget, SIGNAL(resultFileLoaded(ResultFileLoaderWidget*)), SLOT(resultFileLoaded(ResultFileLoaderWidget*)));
+  mResultFileLoaderWidgets.insert(fileName, pResultFileLoaderWidget);
+  mpResultFileLoadersLayout->addWidget(pResultFileLoaderWidget);
+  pResultFileLoaderWidget->start();
+}
+
+/*!
+ * \brief VariablesWidget::addLiveResultReader
+ * Adds the LiveResultReader of a running simulation. The variables of its result are plotted by the LiveResultReader.
+ * \param pLiveResultReader
+ */
+void VariablesWidget::addLiveResultReader(LiveResultReader *pLiveResultReader)
+{
+  mLiveResultReaders.insert(pLiveResultReader->getFileName(), pLiveResultReader);
+}
+
+/*!
+ * \brief VariablesWidget::removeLiveResultReader
+ * Removes the LiveResultReader when the simulation is finished.
+ * \param pLiveResultReader
+ */
+void VariablesWidget::removeLiveResultReader(LiveResultReader *pLiveResultReader)
+{
+  if (mLiveResultReaders.value(pLiveResultReader->getFileName()) == pLiveResultReader) {
+    mLiveResultReaders.remove(pLiveResultReader->getFileName());
+  }
+}
+
 /*!
  * \brief VariablesWidget::variablesUpdated
  * Updates the already plotted variables after simulation with new values.
@@ -1517,46 +1537,143 @@ void VariablesWidget::initializeVisualization(SimulationOptions simulationOption
 double VariablesWidget::readVariableValue(QString variable, double time)
 {
   double value = 0.0;
-  if (mModelicaMatReader.file) {
-    ModelicaMatVariable_t* var = omc_matlab4_find_var(&mModelicaMatReader, variable.toStdString().c_str());
-    if (var) {
-      omc_matlab4_val(&value, &mModelicaMatReader, var, time);
+  mResultFileReader.readVariableValue(variable, time, &value);
+  return value;
+}
+
+/*!
+ * \brief VariablesWidget::addParameterSweep
+ * Registers the result files of the other runs of a parameter sweep.
+ * The variables plotted from the result file are overlaid with the same variables from the other runs.
+ * The result files of the previous sweep of the same result file are closed.
+ * \param resultFile - the result file shown in the variables browser.
+ * \param resultFiles - the result files of the other runs.
+ */
+void VariablesWidget::addParameterSweep(const QString &resultFile, const QStringList &resultFiles)
+{
+  foreach (QString runResultFile, mParameterSweepResultFiles.value(resultFile)) {
+    delete mParameterSweepResultFileReaders.take(runResultFile);
+  }
+  if (resultFiles.isEmpty()) {
+    mParameterSweepResultFiles.remove(resultFile);
+  } else {
+    mParameterSweepResultFiles.insert(resultFile, resultFiles);
+  }
+}
+
+/*!
+ * \brief VariablesWidget::getParameterSweepResultFileReader
+ * Returns the reader of the result file of a parameter sweep run. The result file is opened once and kept open
+ * so plotting more variables of the sweep only decodes their columns.
+ * \param resultFile
+ * \return the reader or 0 if the result file can't be opened.
+ */
+ResultFileReader* VariablesWidget::getParameterSweepResultFileReader(const QString &resultFile)
+{
+  ResultFileReader *pResultFileReader = mParameterSweepResultFileReaders.value(resultFile, 0);
+  if (!pResultFileReader) {
+    pResultFileReader = new ResultFileReader;
+    if (!pResultFileReader->open(resultFile)) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                            GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE)
+                                                            .arg(resultFile, pResultFileReader->getErrorString()),
+                                                            Helper::scriptingKind, Helper::errorLevel));
+      delete pResultFileReader;
+      return 0;
     }
-  } else if (mpCSVData) {
-    double *timeDataSet = read_csv_dataset(mpCSVData, "time");
-    if (timeDataSet) {
-      for (int i = 0 ; i < mpCSVData->numsteps ; i++) {
-        if (QString::number(timeDataSet[i]).compare(QString::number(time)) == 0) {
-          double *varDataSet = read_csv_dataset(mpCSVData, variable.toStdString().c_str());
-          if (varDataSet) {
-            value = varDataSet[i];
-            break;
-          }
-        }
-      }
+    mParameterSweepResultFileReaders.insert(resultFile, pResultFileReader);
+  }
+  return pResultFileReader;
+}
+
+/*!
+ * \brief VariablesWidget::plotParameterSweepVariable
+ * Plots the variable from the other runs of the parameter sweep of its result file.\n
+ * The values are read through the ResultFileReader of each run instead of loading the run in the plot window for each variable.
+ * \param pVariablesTreeItem
+ * \param pPlotWindow
+ */
+void VariablesWidget::plotParameterSweepVariable(VariablesTreeItem *pVariablesTreeItem, PlotWindow *pPlotWindow)
+{
+  QStringList resultFiles = mParameterSweepResultFiles.value(QString("%1/%2").arg(pVariablesTreeItem->getFilePath(), pVariablesTreeItem->getFileName()));
+  if (resultFiles.isEmpty()) {
+    return;
+  }
+  // the unit conversions are the same for all runs
+  OMCInterface::convertUnits_res convertUnit;
+  bool convertValues = pVariablesTreeItem->getUnit().compare(pVariablesTreeItem->getDisplayUnit()) != 0;
+  if (convertValues) {
+    convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(pVariablesTreeItem->getUnit(), pVariablesTreeItem->getDisplayUnit());
+    convertValues = convertUnit.unitsCompatible;
+  }
+  OMCInterface::convertUnits_res convertTimeUnit;
+  bool convertTime = pPlotWindow->getTimeUnit().compare("s") != 0;
+  if (convertTime) {
+    convertTimeUnit = MainWindow::instance()->getOMCProxy()->convertUnits("s", pPlotWindow->getTimeUnit());
+    convertTime = convertTimeUnit.unitsCompatible;
+  }
+  QString plotVariable = pVariablesTreeItem->getPlotVariable();
+  foreach (QString resultFile, resultFiles) {
+    ResultFileReader *pResultFileReader = getParameterSweepResultFileReader(resultFile);
+    if (!pResultFileReader) {
+      continue;
     }
-  } else if (mPlotFileReader.isOpen()) {
-    QTextStream textStream(&mPlotFileReader);
-    QString currentLine;
-    bool variableFound = false;
-    while (!textStream.atEnd()) {
-      currentLine = textStream.readLine();
-      if (currentLine.compare(QString("DataSet: %1").arg(variable)) == 0) {
-        variableFound = true;
-      } else if (variableFound) {
-        if (currentLine.startsWith("DataSet:")) { // new dataset started. Unable to find the value.
-          break;
-        }
-        QStringList values = currentLine.split(",");
-        if (QString::number(time).compare(values[0]) == 0) {
-          value = values[1].toDouble();
-          break;
-        }
-      }
+    bool ok;
+    QVector<double> values = pResultFileReader->readVariableColumn(plotVariable, &ok);
+    QVector<double> time = pResultFileReader->readTimeColumn();
+    if (!ok || values.size() != time.size()) {
+      continue;
+    }
+    if (convertValues) {
+      convertPlotCurveValues(&values, convertUnit.offset, convertUnit.scaleFactor);
+    }
+    if (convertTime) {
+      convertPlotCurveValues(&time, convertTimeUnit.offset, convertTimeUnit.scaleFactor);
+    }
+    // the curve takes the ownership of the data and uses the result file name as its file name.
+    pPlotWindow->setVariablesList(QStringList(plotVariable));
+    pPlotWindow->setUnit(pVariablesTreeItem->getUnit());
+    pPlotWindow->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
+    pPlotWindow->setInteractiveModelName(QFileInfo(resultFile).fileName());
+    pPlotWindow->setInteractivePlotData(new PlotCurveLevelOfDetail(time, values, pPlotWindow->getPlot()));
+    QPair<QVector<double>*, QVector<double>*> axisVectors = pPlotWindow->plotInteractive(0);
+    // keep the axis vectors like a normal plot so the unit changes convert them.
+    *axisVectors.first = time;
+    *axisVectors.second = values;
+  }
+}
+
+/*!
+ * \brief VariablesWidget::removeParameterSweepVariable
+ * Removes the curves of the variable plotted from the other runs of the parameter sweep of its result file.
+ * \param pVariablesTreeItem
+ * \param pPlotWindow
+ */
+void VariablesWidget::removeParameterSweepVariable(VariablesTreeItem *pVariablesTreeItem, PlotWindow *pPlotWindow)
+{
+  QStringList resultFiles = mParameterSweepResultFiles.value(QString("%1/%2").arg(pVariablesTreeItem->getFilePath(), pVariablesTreeItem->getFileName()));
+  if (resultFiles.isEmpty()) {
+    return;
+  }
+  QSet<QString> fileNames;
+  foreach (QString resultFile, resultFiles) {
+    fileNames.insert(QFileInfo(resultFile).fileName());
+  }
+  bool removed = false;
+  foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
+    if (fileNames.contains(pPlotCurve->getFileName()) && pPlotCurve->getName().compare(pVariablesTreeItem->getPlotVariable()) == 0) {
+      pPlotWindow->getPlot()->removeCurve(pPlotCurve);
+      pPlotCurve->detach();
+      removed = true;
+    }
+  }
+  if (removed) {
+    if (pPlotWindow->getAutoScaleButton()->isChecked()) {
+      pPlotWindow->fitInView();
+    } else {
+      pPlotWindow->getPlot()->replot();
     }
-    textStream.seek(0);
   }
-  return value;
 }
 
 void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickness, int curveStyle, PlotCurve *pPlotCurve,
@@ -1569,6 +1686,16 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
   if (!pVariablesTreeItem) {
     return;
   }
+  // the variables of a running simulation are plotted in the live plot window.
+  if (!mLiveResultReaders.isEmpty() && !pVariablesTreeItem->isRootItem()) {
+    LiveResultReader *pLiveResultReader = mLiveResultReaders.value(pVariablesTreeItem->rootParent()->getFileName(), 0);
+    if (pLiveResultReader) {
+      if (!pVariablesTreeItem->isMainArray()) {
+        pLiveResultReader->plotVariable(pVariablesTreeItem->getPlotVariable(), pVariablesTreeItem->isChecked());
+      }
+      return;
+    }
+  }
   try {
     // if pPlotWindow is 0 then get the current window.
     if (!pPlotWindow) {
@@ -1636,6 +1763,7 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
         pPlotWindow->setVariablesList(QStringList(pVariablesTreeItem->getPlotVariable()));
         pPlotWindow->setUnit(pVariablesTreeItem->getUnit());
         pPlotWindow->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
+        bool isNewCurve = !pPlotCurve;
         if (pPlotWindow->getPlotType() == PlotWindow::PLOT)
             pPlotWindow->plot(pPlotCurve);
         else/* ie. (pPlotWindow->getPlotType() == PlotWindow::PLOTARRAY)*/{
@@ -1660,9 +1788,7 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
           OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(pVariablesTreeItem->getUnit(),
                                                                                                  pVariablesTreeItem->getDisplayUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->mYAxisVector.size() ; i++) {
-              pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->mYAxisVector.at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
+            convertPlotCurveValues(&pPlotCurve->mYAxisVector, convertUnit.offset, convertUnit.scaleFactor);
             pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
             pPlotWindow->getPlot()->replot();
           } else {
@@ -1674,13 +1800,19 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
         if (pPlotWindow->getTimeUnit().compare("s") != 0) {
           OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits("s", pPlotWindow->getTimeUnit());
           if (convertUnit.unitsCompatible) {
-            for (int i = 0 ; i < pPlotCurve->mXAxisVector.size() ; i++) {
-              pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->mXAxisVector.at(i), convertUnit.offset, convertUnit.scaleFactor));
-            }
+            convertPlotCurveValues(&pPlotCurve->mXAxisVector, convertUnit.offset, convertUnit.scaleFactor);
             pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
             pPlotWindow->getPlot()->replot();
           }
         }
+        // draw long curves from the decimation levels
+        if (pPlotCurve && pPlotWindow->getPlotType() == PlotWindow::PLOT) {
+          PlotCurveLevelOfDetail::attach(pPlotCurve, pPlotWindow->getPlot());
+        }
+        // overlay the variable from the other runs of a parameter sweep
+        if (isNewCurve && pPlotWindow->getPlotType() == PlotWindow::PLOT) {
+          plotParameterSweepVariable(pVariablesTreeItem, pPlotWindow);
+        }
         if (pPlotWindow->getAutoScaleButton()->isChecked()) {
           pPlotWindow->fitInView();
         } else {
@@ -1703,6 +1835,7 @@ void VariablesWidget::plotVariables(const QModelIndex &index, qreal curveThickne
             break;
           }
         }
+        removeParameterSweepVariable(pVariablesTreeItem, pPlotWindow);
       }
     } else if (pPlotWindow->getPlotType() == PlotWindow::PLOTPARAMETRIC || pPlotWindow->getPlotType() == PlotWindow::PLOTARRAYPARAMETRIC) {  // if plottype is PLOTPARAMETRIC or PLOTARRAYPARAMETRIC then
       // check the item checkstate
@@ -1950,10 +2083,11 @@ void VariablesWidget::unitChanged(const QModelIndex &index)
       foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
         QString curveTitle = pPlotCurve->getNameStructure();
         if (curveTitle.compare(pVariablesTreeItem->getVariableName()) == 0) {
-          for (int i = 0 ; i < pPlotCurve->mYAxisVector.size() ; i++) {
-            pPlotCurve->updateYAxisValue(i, Utilities::convertUnit(pPlotCurve->mYAxisVector.at(i), convertUnit.offset, convertUnit.scaleFactor));
-          }
+          convertPlotCurveValues(&pPlotCurve->mYAxisVector, convertUnit.offset, convertUnit.scaleFactor);
           pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+          if (pPlotWindow->getPlotType() == PlotWindow::PLOT) {
+            PlotCurveLevelOfDetail::attach(pPlotCurve, pPlotWindow->getPlot());
+          }
           pPlotCurve->setDisplayUnit(pVariablesTreeItem->getDisplayUnit());
           pPlotCurve->setTitleLocal();
           pPlotWindow->getPlot()->replot();
@@ -2062,17 +2196,7 @@ void VariablesWidget::selectInteractivePlotWindow(VariablesTreeItem *pVariablesT
  */
 void VariablesWidget::closeResultFile()
 {
-  if (mModelicaMatReader.file) {
-    omc_free_matlab4_reader(&mModelicaMatReader);
-    mModelicaMatReader.file = 0;
-  }
-  if (mpCSVData) {
-    omc_free_csv_reader(mpCSVData);
-    mpCSVData = 0;
-  }
-  if (mPlotFileReader.isOpen()) {
-    mPlotFileReader.close();
-  }
+  mResultFileReader.close();
 }
 
 /*!
@@ -2085,35 +2209,47 @@ void VariablesWidget::openResultFile()
     // read filename
     QString fileName = QString("%1/%2").arg(mpVariablesTreeModel->getActiveVariablesTreeItem()->getFilePath())
                        .arg(mpVariablesTreeModel->getActiveVariablesTreeItem()->getFileName());
-    bool errorOpeningFile = false;
-    QString errorString = "";
-    if (mpVariablesTreeModel->getActiveVariablesTreeItem()->getFileName().endsWith(".mat")) {
-      const char *msg[] = {""};
-      if (0 != (msg[0] = omc_new_matlab4_reader(fileName.toStdString().c_str(), &mModelicaMatReader))) {
-        errorOpeningFile = true;
-        errorString = msg[0];
-      }
-    } else if (mpVariablesTreeModel->getActiveVariablesTreeItem()->getFileName().endsWith(".csv")) {
-      mpCSVData = read_csv(fileName.toStdString().c_str());
-      if (!mpCSVData) {
-        errorOpeningFile = true;
-      }
-    } else if (mpVariablesTreeModel->getActiveVariablesTreeItem()->getFileName().endsWith(".plt")) {
-      mPlotFileReader.setFileName(fileName);
-      if (!mPlotFileReader.open(QIODevice::ReadOnly)) {
-        errorOpeningFile = true;
-        errorString = mPlotFileReader.errorString();
-      }
-    }
-    // check file opening error
-    if (errorOpeningFile) {
+    // open the file and check file opening error
+    if (!mResultFileReader.open(fileName)) {
       MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
                                                             GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE)
-                                                            .arg(fileName, errorString), Helper::scriptingKind, Helper::errorLevel));
+                                                            .arg(fileName, mResultFileReader.getErrorString()), Helper::scriptingKind, Helper::errorLevel));
     }
   }
 }
 
+/*!
+ * \brief VariablesWidget::resultFileLoaded
+ * Slot activated when a ResultFileLoader is finished.\n
+ * Inserts the variables of the result file in the tree unless the loading is cancelled.
+ * \param pResultFileLoaderWidget
+ */
+void VariablesWidget::resultFileLoaded(ResultFileLoaderWidget *pResultFileLoaderWidget)
+{
+  ResultFileLoader *pResultFileLoader = pResultFileLoaderWidget->getResultFileLoader();
+  if (mResultFileLoaderWidgets.value(pResultFileLoader->getFileName()) == pResultFileLoaderWidget) {
+    mResultFileLoaderWidgets.remove(pResultFileLoader->getFileName());
+  }
+  mpResultFileLoadersLayout->removeWidget(pResultFileLoaderWidget);
+  pResultFileLoaderWidget->deleteLater();
+  if (pResultFileLoader->isCancelled()) {
+    return;
+  }
+  if (!pResultFileLoader->getErrorString().isEmpty()) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0,
+                                                          GUIMessages::getMessage(GUIMessages::ERROR_OPENING_FILE)
+                                                          .arg(pResultFileLoader->getFileName(), pResultFileLoader->getErrorString()),
+                                                          Helper::scriptingKind, Helper::errorLevel));
+    return;
+  }
+  QStringList variables = pResultFileLoader->getVariables();
+  if (variables.size() > 0) {
+    QFileInfo fileInfo(pResultFileLoader->getFileName());
+    insertVariablesItemsToTree(fileInfo.fileName(), fileInfo.absoluteDir().absolutePath(), variables, SimulationOptions(),
+                               &pResultFileLoader->getVariablesInformation());
+  }
+}
+
 /*!
  * \brief VariablesWidget::updateVisualization
  * Updates the visualization.
@@ -2158,10 +2294,11 @@ void VariablesWidget::timeUnitChanged(QString unit)
       OMCInterface::convertUnits_res convertUnit = MainWindow::instance()->getOMCProxy()->convertUnits(pPlotWindow->getTimeUnit(), unit);
       if (convertUnit.unitsCompatible) {
         foreach (PlotCurve *pPlotCurve, pPlotWindow->getPlot()->getPlotCurvesList()) {
-          for (int i = 0 ; i < pPlotCurve->mXAxisVector.size() ; i++) {
-            pPlotCurve->updateXAxisValue(i, Utilities::convertUnit(pPlotCurve->mXAxisVector.at(i), convertUnit.offset, convertUnit.scaleFactor));
-          }
+          convertPlotCurveValues(&pPlotCurve->mXAxisVector, convertUnit.offset, convertUnit.scaleFactor);
           pPlotCurve->setData(pPlotCurve->getXAxisVector(), pPlotCurve->getYAxisVector(), pPlotCurve->getSize());
+          if (pPlotWindow->getPlotType() == PlotWindow::PLOT) {
+            PlotCurveLevelOfDetail::attach(pPlotCurve, pPlotWindow->getPlot());
+          }
         }
         pPlotWindow->setXLabel(QString("time (%1)").arg(unit));
         pPlotWindow->setTimeUnit(unit);
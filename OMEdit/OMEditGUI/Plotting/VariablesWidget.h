@@ -38,12 +38,15 @@
 #include <QDomDocument>
 
 #include "Simulation/SimulationOptions.h"
+#include "Plotting/ResultFileReader.h"
+#include "Plotting/ResultFileLoader.h"
 #include "PlotWindow.h"
 #include "Animation/TimeManager.h"
 
 class OMCProxy;
 class TreeSearchFilters;
 class Label;
+class LiveResultReader;
 
 class VariablesTreeItem
 {
@@ -130,9 +133,8 @@ public:
   QModelIndex variablesTreeItemIndex(const VariablesTreeItem *pVariablesTreeItem) const;
   QModelIndex variablesTreeItemIndexHelper(const VariablesTreeItem *pVariablesTreeItem, const VariablesTreeItem *pParentVariablesTreeItem,
                                            const QModelIndex &parentIndex) const;
-  void parseInitXml(QXmlStreamReader &xmlReader);
-  QHash<QString, QString> parseScalarVariable(QXmlStreamReader &xmlReader);
-  void insertVariablesItems(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
+  void insertVariablesItems(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions,
+                            const ResultVariablesInformation *pVariablesInformation = 0);
   bool removeVariableTreeItem(QString variable);
   void unCheckVariables(VariablesTreeItem *pVariablesTreeItem);
   void plotAllVariables(VariablesTreeItem *pVariablesTreeItem, OMPlot::PlotWindow *pPlotWindow);
@@ -140,9 +142,8 @@ private:
   VariablesTreeView *mpVariablesTreeView;
   VariablesTreeItem *mpRootVariablesTreeItem;
   VariablesTreeItem *mpActiveVariablesTreeItem;
-  QHash<QString, QHash<QString,QString> > mScalarVariablesList;
-  void getVariableInformation(ModelicaMatReader *pMatReader, QString variableToFind, QString *value, bool *changeAble, QString *variability,
-                              QString *unit, QString *displayUnit, QString *description);
+  void getVariableInformation(const ResultVariablesInformation &variablesInformation, QString variableToFind, QString *value, bool *changeAble,
+                              QString *variability, QString *unit, QString *displayUnit, QString *description);
 signals:
   void itemChecked(const QModelIndex &index, qreal curveThickness, int curveStyle);
   void unitChanged(const QModelIndex &index);
@@ -182,12 +183,17 @@ class VariablesWidget : public QWidget
   Q_OBJECT
 public:
   VariablesWidget(QWidget *pParent = 0);
+  ~VariablesWidget();
   TreeSearchFilters* getTreeSearchFilters() {return mpTreeSearchFilters;}
   QComboBox* getSimulationTimeComboBox() {return mpSimulationTimeComboBox;}
   VariableTreeProxyModel* getVariableTreeProxyModel() {return mpVariableTreeProxyModel;}
   VariablesTreeModel* getVariablesTreeModel() {return mpVariablesTreeModel;}
   VariablesTreeView* getVariablesTreeView() {return mpVariablesTreeView;}
-  void insertVariablesItemsToTree(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions);
+  void insertVariablesItemsToTree(QString fileName, QString filePath, QStringList variablesList, SimulationOptions simulationOptions,
+                                  const ResultVariablesInformation *pVariablesInformation = 0);
+  void loadResultFile(const QString &fileName);
+  void addLiveResultReader(LiveResultReader *pLiveResultReader);
+  void removeLiveResultReader(LiveResultReader *pLiveResultReader);
   void addSelectedInteractiveVariables(const QString &modelName, const QList<QString> &selectedVariables);
   void variablesUpdated();
   void updateVariablesTreeHelper(QMdiSubWindow *pSubWindow);
@@ -199,6 +205,7 @@ public:
   void updateInitXmlFile(SimulationOptions simulationOptions);
   void initializeVisualization(SimulationOptions simulationOptions);
   double readVariableValue(QString variable, double time);
+  void addParameterSweep(const QString &resultFile, const QStringList &resultFiles);
 private:
   TreeSearchFilters *mpTreeSearchFilters;
   Label *mpSimulationTimeLabel;
@@ -216,17 +223,23 @@ private:
   VariableTreeProxyModel *mpVariableTreeProxyModel;
   VariablesTreeModel *mpVariablesTreeModel;
   VariablesTreeView *mpVariablesTreeView;
+  QVBoxLayout *mpResultFileLoadersLayout;
+  QHash<QString, ResultFileLoaderWidget*> mResultFileLoaderWidgets;
   QList<QStringList> mPlotParametricVariables;
   QHash<QString, QList<QString>> mSelectedInteractiveVariables;
   QString mFileName;
   QMdiSubWindow *mpLastActiveSubWindow;
-  ModelicaMatReader mModelicaMatReader;
-  csv_data *mpCSVData;
-  QFile mPlotFileReader;
+  ResultFileReader mResultFileReader;
+  QHash<QString, LiveResultReader*> mLiveResultReaders;
+  QHash<QString, QStringList> mParameterSweepResultFiles;
+  QHash<QString, ResultFileReader*> mParameterSweepResultFileReaders;
   void selectInteractivePlotWindow(VariablesTreeItem *pVariablesTreeItem);
   void closeResultFile();
   void openResultFile();
   void updateVisualization();
+  ResultFileReader* getParameterSweepResultFileReader(const QString &resultFile);
+  void plotParameterSweepVariable(VariablesTreeItem *pVariablesTreeItem, OMPlot::PlotWindow *pPlotWindow);
+  void removeParameterSweepVariable(VariablesTreeItem *pVariablesTreeItem, OMPlot::PlotWindow *pPlotWindow);
 public slots:
   void plotVariables(const QModelIndex &index, qreal curveThickness, int curveStyle,
                      OMPlot::PlotCurve *pPlotCurve = 0, OMPlot::PlotWindow *pPlotWindow = 0);
@@ -246,6 +259,7 @@ private slots:
   void visulizationTimeChanged();
   void visualizationSpeedChanged();
   void incrementVisualization();
+  void resultFileLoaded(ResultFileLoaderWidget *pResultFileLoaderWidget);
 signals:
   void updateDynamicSelect(double time);
 };
@@ -0,0 +1,238 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "Simulation/CompilationCache.h"
+#include "Options/OptionsDialog.h"
+#include "Util/Helper.h"
+#include "Util/Utilities.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMultiMap>
+
+QMutex CompilationCache::mMutex;
+
+/*!
+ * \brief CompilationCache::key
+ * Returns the hash of the generated C sources, the makefile and the compiler settings.\n
+ * Only the C target is cached since its build result is a single executable.
+ * \param simulationOptions
+ * \return an empty string if the compilation can't be cached.
+ */
+QString CompilationCache::key(SimulationOptions simulationOptions)
+{
+  if (maximumSize() <= 0 || simulationOptions.getTargetLanguage().compare("C") != 0) {
+    return "";
+  }
+  SimulationPage *pSimulationPage = OptionsDialog::instance()->getSimulationPage();
+  QByteArray settings;
+  settings.append(Helper::OpenModelicaVersion.toUtf8());
+  settings.append(Helper::OpenModelicaHome.toUtf8());
+  settings.append(pSimulationPage->getTargetBuildComboBox()->itemData(pSimulationPage->getTargetBuildComboBox()->currentIndex()).toString().toUtf8());
+  return key(simulationOptions.getWorkingDirectory(), simulationOptions.getOutputFileName(), settings);
+}
+
+/*!
+ * \brief CompilationCache::key
+ * Returns the hash of the compiler settings and of the generated C sources and the makefile of outputFileName in workingDirectory.
+ * \param workingDirectory
+ * \param outputFileName
+ * \param settings - the compiler settings.
+ * \return an empty string if there is no makefile.
+ */
+QString CompilationCache::key(const QString &workingDirectory, const QString &outputFileName, const QByteArray &settings)
+{
+  QDir directory(workingDirectory);
+  QStringList nameFilters;
+  nameFilters << outputFileName + ".makefile" << outputFileName + "*.c" << outputFileName + "*.h";
+  QStringList fileNames = directory.entryList(nameFilters, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
+  if (!fileNames.contains(outputFileName + ".makefile")) {
+    return "";
+  }
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(settings);
+  foreach (QString fileName, fileNames) {
+    QFile file(directory.absoluteFilePath(fileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+      return "";
+    }
+    hash.addData(fileName.toUtf8());
+    hash.addData(QByteArray::number(file.size()));
+    while (!file.atEnd()) {
+      hash.addData(file.read(1024 * 1024));
+    }
+    file.close();
+  }
+  return QString(hash.result().toHex());
+}
+
+/*!
+ * \brief CompilationCache::restore
+ * Copies the cached executable of the key into the working directory.
+ * \param key
+ * \param simulationOptions
+ * \return false if the key is not cached.
+ */
+bool CompilationCache::restore(const QString &key, SimulationOptions simulationOptions)
+{
+  QMutexLocker locker(&mMutex);
+  QString entryDirectory = directory() + key;
+  QString cachedFileName = entryDirectory + "/executable";
+  if (!QFile::exists(cachedFileName)) {
+    return false;
+  }
+  QString fileName = executableFileName(simulationOptions);
+  if (QFile::exists(fileName) && !QFile::remove(fileName)) {
+    return false;
+  }
+  if (!QFile::copy(cachedFileName, fileName)) {
+    return false;
+  }
+  QFile::setPermissions(fileName, QFile::permissions(cachedFileName));
+  // the modification time of lastUsed orders the entries for eviction.
+  QFile lastUsedFile(entryDirectory + "/lastUsed");
+  if (lastUsedFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    lastUsedFile.write(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8());
+    lastUsedFile.close();
+  }
+  return true;
+}
+
+/*!
+ * \brief CompilationCache::store
+ * Copies the built executable into the cache and evicts the least recently used entries when the cache is full.
+ * \param key
+ * \param simulationOptions
+ */
+void CompilationCache::store(const QString &key, SimulationOptions simulationOptions)
+{
+  QString fileName = executableFileName(simulationOptions);
+  if (key.isEmpty() || !QFile::exists(fileName)) {
+    return;
+  }
+  QMutexLocker locker(&mMutex);
+  QString entryDirectory = directory() + key;
+  if (!QDir().mkpath(entryDirectory)) {
+    return;
+  }
+  // copy to a temporary file first so another OMEdit never sees a partial executable.
+  QString cachedFileName = entryDirectory + "/executable";
+  QString temporaryFileName = cachedFileName + ".tmp";
+  QFile::remove(temporaryFileName);
+  if (!QFile::copy(fileName, temporaryFileName)) {
+    QFile::remove(temporaryFileName);
+    return;
+  }
+  QFile::setPermissions(temporaryFileName, QFile::permissions(fileName));
+  QFile::remove(cachedFileName);
+  QFile::rename(temporaryFileName, cachedFileName);
+  QFile lastUsedFile(entryDirectory + "/lastUsed");
+  if (lastUsedFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    lastUsedFile.write(QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8());
+    lastUsedFile.close();
+  }
+  evict(directory(), maximumSize());
+}
+
+/*!
+ * \brief CompilationCache::directory
+ * Returns the cache directory. It is inside the application cache directory so the executables survive a restart.
+ * \return
+ */
+QString CompilationCache::directory()
+{
+  return Utilities::cacheDirectory() + "compilation/";
+}
+
+/*!
+ * \brief CompilationCache::executableFileName
+ * Returns the path of the simulation executable in the working directory.
+ * \param simulationOptions
+ * \return
+ */
+QString CompilationCache::executableFileName(SimulationOptions simulationOptions)
+{
+  QString fileName = QString(simulationOptions.getWorkingDirectory()).append("/").append(simulationOptions.getOutputFileName());
+  fileName = fileName.replace("//", "/");
+#ifdef WIN32
+  fileName = fileName.append(".exe");
+#endif
+  return fileName;
+}
+
+/*!
+ * \brief CompilationCache::maximumSize
+ * Returns the maximum size of the cache in bytes. Zero disables the cache.
+ * \return
+ */
+qint64 CompilationCache::maximumSize()
+{
+  return (qint64)OptionsDialog::instance()->getSimulationPage()->getCompilationCacheSizeSpinBox()->value() * 1024 * 1024;
+}
+
+/*!
+ * \brief CompilationCache::evict
+ * Removes the least recently used entries of the cache directory until the cache fits into maximumSize.
+ * \param directory
+ * \param maximumSize
+ */
+void CompilationCache::evict(const QString &directory, qint64 maximumSize)
+{
+  QDir cacheDirectory(directory);
+  QMultiMap<qint64, QString> entries;
+  QHash<QString, qint64> entrySizes;
+  qint64 totalSize = 0;
+  foreach (QFileInfo entryInfo, cacheDirectory.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    QDir entryDirectory(entryInfo.absoluteFilePath());
+    qint64 entrySize = 0;
+    foreach (QFileInfo fileInfo, entryDirectory.entryInfoList(QDir::Files | QDir::NoDotAndDotDot)) {
+      entrySize += fileInfo.size();
+    }
+    QFileInfo lastUsedFileInfo(entryDirectory.absoluteFilePath("lastUsed"));
+    QDateTime lastUsed = lastUsedFileInfo.exists() ? lastUsedFileInfo.lastModified() : entryInfo.lastModified();
+    entries.insert(lastUsed.toMSecsSinceEpoch(), entryInfo.absoluteFilePath());
+    entrySizes.insert(entryInfo.absoluteFilePath(), entrySize);
+    totalSize += entrySize;
+  }
+  QMultiMap<qint64, QString>::const_iterator iterator = entries.constBegin();
+  while (totalSize > maximumSize && iterator != entries.constEnd()) {
+    Utilities::removeDirectoryRecursivly(iterator.value());
+    totalSize -= entrySizes.value(iterator.value());
+    ++iterator;
+  }
+}
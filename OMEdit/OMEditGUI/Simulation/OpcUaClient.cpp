@@ -159,6 +159,19 @@ void OpcUaClient::checkVariable(int nodeId, VariablesTreeItem *pVariablesTreeIte
   }
 }
 
+/*!
+  Moves the data sampled by the sample thread to the plot curves of the checked variables.
+  */
+void OpcUaClient::updateCheckedVariablesData()
+{
+  foreach (VariablesTreeItem *pVariablesTreeItem, mCheckedVariables) {
+    Variable *pVariable = mVariables.value(pVariablesTreeItem->getPlotVariable(), 0);
+    if (pVariable) {
+      pVariable->updateData();
+    }
+  }
+}
+
 /*!
   Called when a variable is unchecked in the variable tree.
   */
@@ -288,6 +301,51 @@ int OpcUaClient::readBool(int id)
   return res;
 }
 
+/*!
+  Read the current simulation time and the values of the variables with one read request.
+  The values of the nodes which can't be read are -1.
+  Returns false if the request failed.
+  */
+bool OpcUaClient::readValues(const QList<Variable*> &variables, double *pTime, QVector<double> *pValues)
+{
+  size_t nodesSize = variables.size() + 1;
+  UA_ReadRequest rReq;
+  UA_ReadRequest_init(&rReq);
+  rReq.nodesToRead = (UA_ReadValueId*)UA_Array_new(nodesSize, &UA_TYPES[UA_TYPES_READVALUEID]);
+  rReq.nodesToReadSize = nodesSize;
+  // the first node is the simulation time
+  rReq.nodesToRead[0].nodeId = UA_NODEID_NUMERIC(0, 10004);
+  rReq.nodesToRead[0].attributeId = UA_ATTRIBUTEID_VALUE;
+  for (int i = 0 ; i < variables.size() ; i++) {
+    rReq.nodesToRead[i + 1].nodeId = UA_NODEID_NUMERIC(1, variables.at(i)->getNodeId());
+    rReq.nodesToRead[i + 1].attributeId = UA_ATTRIBUTEID_VALUE;
+  }
+
+  UA_ReadResponse rResp = UA_Client_Service_read(mpClient, rReq);
+  bool result = rResp.responseHeader.serviceResult == UA_STATUSCODE_GOOD && rResp.resultsSize == nodesSize;
+  if (result) {
+    pValues->resize(variables.size());
+    for (size_t i = 0 ; i < nodesSize ; i++) {
+      double value = -1;
+      if (rResp.results[i].hasValue && UA_Variant_isScalar(&rResp.results[i].value)) {
+        if (rResp.results[i].value.type == &UA_TYPES[UA_TYPES_DOUBLE]) {
+          value = *(UA_Double*)rResp.results[i].value.data;
+        } else if (rResp.results[i].value.type == &UA_TYPES[UA_TYPES_BOOLEAN]) {
+          value = *(UA_Boolean*)rResp.results[i].value.data;
+        }
+      }
+      if (i == 0) {
+        *pTime = value;
+      } else {
+        (*pValues)[i - 1] = value;
+      }
+    }
+  }
+  UA_ReadRequest_deleteMembers(&rReq);
+  UA_ReadResponse_deleteMembers(&rResp);
+  return result;
+}
+
 /*!
   Called when a value is entered in the variable tree.
   Write the new value to the corresponding node.
@@ -308,8 +366,13 @@ void OpcUaClient::writeValue(const QVariant &value, const QString &name)
 double OpcUaClient::getCurrentSimulationTime()
 {
   UA_Variant *currentTime = UA_Variant_new();
-  UA_Client_readValueAttribute(mpClient, UA_NODEID_NUMERIC(0, 10004), currentTime);
-  return *(double*)currentTime->data;
+  double time = -1;
+  if (UA_Client_readValueAttribute(mpClient, UA_NODEID_NUMERIC(0, 10004), currentTime) == UA_STATUSCODE_GOOD
+      && UA_Variant_hasScalarType(currentTime, &UA_TYPES[UA_TYPES_DOUBLE])) {
+    time = *(double*)currentTime->data;
+  }
+  UA_Variant_delete(currentTime);
+  return time;
 }
 
 /*!
@@ -319,6 +382,11 @@ double OpcUaClient::getCurrentSimulationTime()
 OpcUaWorker::OpcUaWorker(OpcUaClient *pClient, bool simulateWithSteps)
  : mpParentClient(pClient), mSimulateWithSteps(simulateWithSteps), mSampleInterval(10), mSpeedValue(1.0), mServerSampleInterval(5)
 {
+  mIsRunning = false;
+  // the timer is a child so it moves to the sample thread with the worker.
+  mpSampleTimer = new QTimer(this);
+  mpSampleTimer->setTimerType(Qt::PreciseTimer);
+  connect(mpSampleTimer, SIGNAL(timeout()), SLOT(sample()));
   setInterval(mSampleInterval);
   if (!mSimulateWithSteps) {
     createSubscription();
@@ -332,53 +400,51 @@ OpcUaWorker::~OpcUaWorker()
 void OpcUaWorker::setInterval(double interval)
 {
   mInterval = interval;
+  if (mSimulateWithSteps) {
+    mpSampleTimer->setInterval(qMax(qRound(mInterval), 0));
+  } else {
+    mpSampleTimer->setInterval(qRound(mServerSampleInterval));
+  }
 }
 
+/*!
+  Starts sampling. The sample timer runs in the sample thread so the thread's event loop stays responsive between the samples.
+  */
 void OpcUaWorker::startInteractiveSimulation()
 {
-  mClock.start();
   mIsRunning = true;
 
   if (!mSimulateWithSteps) {
     writeReal(mpParentClient->getClient(), UA_NODEID_NUMERIC(0, 10002), mSpeedValue);
     writeBool(mpParentClient->getClient(), UA_NODEID_NUMERIC(0, 10001), true);
   }
-
-  while(mIsRunning) {
-    const double elapsed = mClock.elapsed();
-    sample();
-
-    if (mSimulateWithSteps) {
-      if (mInterval > 0.0) {
-        const double ms = mInterval - (mClock.elapsed() - elapsed);
-        if (ms > 0.0) {
-          QTime waitTime= QTime::currentTime().addMSecs(ms);
-          while (QTime::currentTime() < waitTime) {
-            QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
-          }
-        }
-      }
-    } else {
-      QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
-      Sleep::msleep(mServerSampleInterval);
-    }
-  }
+  mpSampleTimer->start();
 }
 
+/*!
+  Stops sampling. Can be called from any thread, the sample timer stops on its next timeout.
+  */
 void OpcUaWorker::pauseInteractiveSimulation()
 {
   mIsRunning = false;
+  if (QThread::currentThread() == thread()) {
+    mpSampleTimer->stop();
+  }
   if (!mSimulateWithSteps) {
     writeBool(mpParentClient->getClient(), UA_NODEID_NUMERIC(0, 10001), false);
   }
 }
 
 /*!
-  Called in intervals.
+  Called in intervals by the sample timer.
   setInterval(ms) can be usd to adjust the time between each call.
   */
 void OpcUaWorker::sample()
 {
+  if (!mIsRunning) {
+    mpSampleTimer->stop();
+    return;
+  }
   // draw selected curve lines
   emit sendUpdateCurves();
   if (mSimulateWithSteps) {
@@ -416,24 +482,32 @@ void OpcUaWorker::setSpeed(QString value)
 }
 
 /*!
-  Simulate with steps. For each checked variable, contact the remote and fetch the data.
+  Simulate with steps. Fetch the simulation time and the data of all checked variables with one read request.
   */
 void OpcUaWorker::appendVariableValues()
 {
   // fetch checked variables data only
+  QList<Variable*> variables;
   for (auto & p : mpParentClient->getCheckedVariables()) {
-    Variable *pVariable = mpParentClient->getVariables()->value(p->getPlotVariable());
-    int nodeId = pVariable->getNodeId();
-    double variableValue;
-    if (pVariable->isBool()) {
-      variableValue = mpParentClient->readBool(nodeId);
-    } else {
-      variableValue = mpParentClient->readReal(nodeId);
-    }
-
-    pVariable->insertData(mpParentClient->getCurrentSimulationTime(), variableValue);
-    pVariable->checkBounds(variableValue);
-    checkMinMaxValues(variableValue);
+    variables.append(mpParentClient->getVariables()->value(p->getPlotVariable()));
+  }
+  if (variables.isEmpty()) {
+    return;
+  }
+  double currentTime;
+  QVector<double> variableValues;
+  if (!mpParentClient->readValues(variables, &currentTime, &variableValues)) {
+    return;
+  }
+  bool minMaxValuesChanged = false;
+  for (int i = 0 ; i < variables.size() ; i++) {
+    double variableValue = variableValues.at(i);
+    variables.at(i)->insertData(currentTime, variableValue);
+    variables.at(i)->checkBounds(variableValue);
+    minMaxValuesChanged = checkMinMaxValues(variableValue) || minMaxValuesChanged;
+  }
+  if (minMaxValuesChanged) {
+    emit sendUpdateYAxis(mMinMaxValues.first, mMinMaxValues.second);
   }
 }
 
@@ -449,16 +523,18 @@ void OpcUaWorker::stepSimulation()
 
 /*!
   Called to catch the min max values. The information can be used useful to the plotting window.
+  Returns true if the min or max value changed. The caller informs the plotting window once per sample.
   */
-void OpcUaWorker::checkMinMaxValues(const double& value)
+bool OpcUaWorker::checkMinMaxValues(const double& value)
 {
   if (value < mMinMaxValues.first) {
     mMinMaxValues.first = value;
-    emit sendUpdateYAxis(mMinMaxValues.first, mMinMaxValues.second);
+    return true;
   } else if ( value > mMinMaxValues.second ) {
     mMinMaxValues.second = value;
-    emit sendUpdateYAxis(mMinMaxValues.first, mMinMaxValues.second);
+    return true;
   }
+  return false;
 }
 
 /*!
@@ -515,10 +591,15 @@ void OpcUaWorker::timeChanged(UA_UInt32 handle, UA_DataValue *pValue, void *pCli
   */
 void OpcUaWorker::insertValues()
 {
-  for (const auto &p : mMonitorIds.localData()) {
-    double value = mCurrentValues.localData().value(mMonitorIds.localData().key(p));
-    p->insertData(mCurrentTime.localData(), value);
-    checkMinMaxValues(value);
+  bool minMaxValuesChanged = false;
+  QMap<UA_UInt32, Variable*>::const_iterator iterator;
+  for (iterator = mMonitorIds.localData().constBegin() ; iterator != mMonitorIds.localData().constEnd() ; ++iterator) {
+    double value = mCurrentValues.localData().value(iterator.key());
+    iterator.value()->insertData(mCurrentTime.localData(), value);
+    minMaxValuesChanged = checkMinMaxValues(value) || minMaxValuesChanged;
+  }
+  if (minMaxValuesChanged) {
+    emit sendUpdateYAxis(mMinMaxValues.first, mMinMaxValues.second);
   }
 }
 
@@ -609,15 +690,44 @@ void Variable::setAxisVectors(QPair<QVector<double>*, QVector<double>*> axes)
 }
 
 /*!
-  Inserts new data in the vectors.
+  Inserts new data. Called by the sample thread.
+  The vectors of the plot curve are only used by the GUI thread so the data is kept in the pending vectors
+  until updateData() moves it to the plot curve. The pending vectors hold at most INTERACTIVE_SIMULATION_BUFFER_SIZE samples.
   */
 void Variable::insertData(const double& xValue, const double& yValue)
 {
-  if (mXAxisVector != 0 && mYAxisVector != 0)
-  {
-    mXAxisVector->push_back(xValue);
-    mYAxisVector->push_back(yValue);
+  QMutexLocker locker(&mPendingDataMutex);
+  if (mPendingXValues.size() >= INTERACTIVE_SIMULATION_BUFFER_SIZE) {
+    mPendingXValues.remove(0, INTERACTIVE_SIMULATION_BUFFER_SIZE / 4);
+    mPendingYValues.remove(0, INTERACTIVE_SIMULATION_BUFFER_SIZE / 4);
+  }
+  mPendingXValues.push_back(xValue);
+  mPendingYValues.push_back(yValue);
+}
+
+/*!
+  Moves the pending data to the vectors of the plot curve. Called by the GUI thread before the curves are updated.
+  The vectors hold at most INTERACTIVE_SIMULATION_BUFFER_SIZE samples. When they are full the oldest quarter is dropped at once,
+  so the cost per sample stays constant and the vectors stay in time order for the plot.
+  */
+void Variable::updateData()
+{
+  QVector<double> xValues, yValues;
+  mPendingDataMutex.lock();
+  xValues.swap(mPendingXValues);
+  yValues.swap(mPendingYValues);
+  mPendingDataMutex.unlock();
+  if (mXAxisVector == 0 || mYAxisVector == 0 || xValues.isEmpty()) {
+    return;
+  }
+  if (mXAxisVector->size() + xValues.size() > INTERACTIVE_SIMULATION_BUFFER_SIZE) {
+    int count = qMin(mXAxisVector->size(), qMax(INTERACTIVE_SIMULATION_BUFFER_SIZE / 4,
+                                                 mXAxisVector->size() + xValues.size() - INTERACTIVE_SIMULATION_BUFFER_SIZE));
+    mXAxisVector->remove(0, count);
+    mYAxisVector->remove(0, count);
   }
+  *mXAxisVector += xValues;
+  *mYAxisVector += yValues;
 }
 
 /*!
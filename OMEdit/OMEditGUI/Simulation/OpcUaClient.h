@@ -5,6 +5,12 @@
 #include "open62541.h"
 #include "SimulationOptions.h"
 
+#include <QTimer>
+#include <QMutex>
+
+/* Maximum number of samples kept per variable during an interactive simulation. */
+#define INTERACTIVE_SIMULATION_BUFFER_SIZE 50000
+
 class VariablesTreeItem;
 class OpcUaWorker;
 class Variable;
@@ -25,11 +31,13 @@ public:
   double readReal(int id);
   bool variableIsBool(int nodeId);
   int readBool(int id);
+  bool readValues(const QList<Variable*> &variables, double *pTime, QVector<double> *pValues);
   void writeValue(const QVariant &value, const QString &name);
   double getCurrentSimulationTime();
   QMap<int, VariablesTreeItem*> getCheckedVariables() {return mCheckedVariables;}
   void checkVariable(int nodeId, VariablesTreeItem *pVariablesTreeItem);
   void unCheckVariable(int nodeId, const QString &name);
+  void updateCheckedVariablesData();
   SimulationOptions getSimulationOptions() {return mSimulationOptions;}
   void setTargetPlotWindow(OMPlot::PlotWindow* pTargetPlotWindow) {mpTargetPlotWindow = pTargetPlotWindow;}
   OMPlot::PlotWindow* getTargetPlotWindow() {return mpTargetPlotWindow;}
@@ -54,7 +62,7 @@ public:
   ~OpcUaWorker();
   void stepSimulation();
   double getCurrentSimulationTime();
-  void checkMinMaxValues(const double& value);
+  bool checkMinMaxValues(const double& value);
   void setSampleInterval(double interval);
   double getSampleInterval() {return mSampleInterval;}
   void setVariablesTreeItemRoot(VariablesTreeItem * pVariablesTreeItemRoot);
@@ -69,7 +77,6 @@ public slots:
   void emitSendRemoveMonitoredItem(QString name) {emit sendRemoveMonitoredItem(name);}
 private slots:
   void setSpeed(QString value);
-protected:
   void sample();
 private:
   void appendVariableValues();
@@ -77,7 +84,7 @@ private:
   QPair<double, double> mMinMaxValues;
   OpcUaClient *mpParentClient;
   VariablesTreeItem *mpVariablesTreeItemRoot;
-  QTime mClock;
+  QTimer *mpSampleTimer;
   bool mSimulateWithSteps;
   const double mSampleInterval;
   double mInterval, mSpeedValue, mServerSampleInterval;
@@ -112,6 +119,7 @@ public:
   int getNodeId() {return mNodeId;}
   bool isWritable() {return mIsWritable;}
   void insertData(const double& xValue, const double& yValue);
+  void updateData();
   void setAxisVectors(QPair<QVector<double>*, QVector<double>*> axes);
   void setXBounds(const double &startBound, const double &stopBound);
   void setYBounds(const double &mixValue, const double &maxValue);
@@ -127,6 +135,9 @@ private:
   QPair<double, double> minMaxBounds;
   QVector<double> *mXAxisVector;
   QVector<double> *mYAxisVector;
+  QMutex mPendingDataMutex;
+  QVector<double> mPendingXValues;
+  QVector<double> mPendingYValues;
   QRectF mCurveBounds;
   int mNodeId;
   UA_UInt32 mMonitordItemId;
@@ -0,0 +1,438 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "Simulation/ParameterSweep.h"
+#include "Simulation/SimulationDialog.h"
+#include "Simulation/SimulationOutputWidget.h"
+#include "Simulation/SimulationJobScheduler.h"
+#include "MainWindow.h"
+#include "Options/OptionsDialog.h"
+#include "Util/Helper.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+
+/*!
+ * \class ParameterSweep
+ * \brief Samples the parameter space of a parameter sweep and keeps track of its runs.
+ * Every run gets an override file with its parameter values and its own result file.
+ * All runs use the same compiled executable.\n
+ * The first run is a SimulationOutputWidget which compiles the model. The other runs are lightweight ParameterSweepRun jobs
+ * which are started once the executable runs.\n
+ * When all runs are finished the index file <outputFileName>_sweep.csv maps each run to its parameter values and result file.
+ */
+/*!
+ * \brief ParameterSweep::ParameterSweep
+ * \param simulationOptions - the simulation options of the translated model.
+ * \param parameters
+ * \param sampling
+ * \param samples - the number of samples for Latin hypercube sampling.
+ */
+ParameterSweep::ParameterSweep(SimulationOptions simulationOptions, QList<ParameterSweepParameter> parameters, Sampling sampling, int samples)
+  : mSimulationOptions(simulationOptions), mParameters(parameters)
+{
+  if (sampling == ParameterSweep::LatinHypercube) {
+    mSamples = latinHypercubeSamples(mParameters, samples);
+  } else {
+    mSamples = gridSamples(mParameters);
+  }
+  for (int run = 0 ; run < mSamples.size() ; run++) {
+    mResultFiles.append(QString("%1_sweep%2_res.%3").arg(mSimulationOptions.getOutputFileName()).arg(run + 1)
+                        .arg(mSimulationOptions.getOutputFormat()));
+  }
+  mSuccessfulRuns.fill(false, mSamples.size());
+  mFinishedRuns = 0;
+  mCompilationRun = -1;
+  mRunsStarted = false;
+}
+
+ParameterSweep::~ParameterSweep()
+{
+  qDeleteAll(mRunsList);
+  mRunsList.clear();
+}
+
+/*!
+ * \brief ParameterSweep::gridSamplesCount
+ * Returns the number of samples of the full factorial grid of the parameters.\n
+ * Stops multiplying once the count exceeds PARAMETER_SWEEP_MAXIMUM_RUNS so the product can't overflow.
+ * \param parameters
+ * \return the number of samples or PARAMETER_SWEEP_MAXIMUM_RUNS + 1 if there are too many.
+ */
+qint64 ParameterSweep::gridSamplesCount(const QList<ParameterSweepParameter> &parameters)
+{
+  if (parameters.isEmpty()) {
+    return 0;
+  }
+  qint64 count = 1;
+  foreach (ParameterSweepParameter parameter, parameters) {
+    count *= qMax(parameter.mPoints, 1);
+    if (count > PARAMETER_SWEEP_MAXIMUM_RUNS) {
+      return PARAMETER_SWEEP_MAXIMUM_RUNS + 1;
+    }
+  }
+  return count;
+}
+
+/*!
+ * \brief ParameterSweep::gridSamples
+ * Returns the full factorial grid of the parameters. Each parameter takes mPoints equidistant values from mStart to mStop.
+ * \param parameters
+ * \return an empty list if the grid has more than PARAMETER_SWEEP_MAXIMUM_RUNS samples.
+ */
+QList<QVector<double> > ParameterSweep::gridSamples(const QList<ParameterSweepParameter> &parameters)
+{
+  QList<QVector<double> > samples;
+  qint64 count = gridSamplesCount(parameters);
+  if (count > PARAMETER_SWEEP_MAXIMUM_RUNS) {
+    return samples;
+  }
+  for (int i = 0 ; i < count ; i++) {
+    QVector<double> sample(parameters.size());
+    // the last parameter changes fastest
+    int index = i;
+    for (int j = parameters.size() - 1 ; j >= 0 ; j--) {
+      const ParameterSweepParameter &parameter = parameters.at(j);
+      int points = qMax(parameter.mPoints, 1);
+      int point = index % points;
+      index /= points;
+      if (points == 1) {
+        sample[j] = parameter.mStart;
+      } else {
+        sample[j] = parameter.mStart + (parameter.mStop - parameter.mStart) * point / (points - 1);
+      }
+    }
+    samples.append(sample);
+  }
+  return samples;
+}
+
+/*!
+ * \brief ParameterSweep::latinHypercubeSamples
+ * Returns samples Latin hypercube samples of the parameters.
+ * The range of each parameter is divided into samples strata and every stratum is sampled exactly once.
+ * \param parameters
+ * \param samples
+ * \return
+ */
+QList<QVector<double> > ParameterSweep::latinHypercubeSamples(const QList<ParameterSweepParameter> &parameters, int samples)
+{
+  QList<QVector<double> > samplesList;
+  if (parameters.isEmpty() || samples < 1) {
+    return samplesList;
+  }
+  for (int i = 0 ; i < samples ; i++) {
+    samplesList.append(QVector<double>(parameters.size()));
+  }
+  for (int j = 0 ; j < parameters.size() ; j++) {
+    const ParameterSweepParameter &parameter = parameters.at(j);
+    // random permutation of the strata
+    QVector<int> strata(samples);
+    for (int i = 0 ; i < samples ; i++) {
+      strata[i] = i;
+    }
+    for (int i = samples - 1 ; i > 0 ; i--) {
+      qSwap(strata[i], strata[qrand() % (i + 1)]);
+    }
+    for (int i = 0 ; i < samples ; i++) {
+      double random = (double)qrand() / ((double)RAND_MAX + 1.0);
+      samplesList[i][j] = parameter.mStart + (parameter.mStop - parameter.mStart) * (strata.at(i) + random) / samples;
+    }
+  }
+  return samplesList;
+}
+
+/*!
+ * \brief ParameterSweep::getFileName
+ * Returns the index file of the sweep. Also used to identify the sweep.
+ * \return
+ */
+QString ParameterSweep::getFileName() const
+{
+  return QString("%1/%2_sweep.csv").arg(mSimulationOptions.getWorkingDirectory(), mSimulationOptions.getOutputFileName());
+}
+
+/*!
+ * \brief ParameterSweep::createRunSimulationOptions
+ * Writes the override file of the run and creates its simulation options.
+ * \param run
+ * \param pSimulationOptions
+ * \return false if the override file can't be written.
+ */
+bool ParameterSweep::createRunSimulationOptions(int run, SimulationOptions *pSimulationOptions)
+{
+  QString workingDirectory = mSimulationOptions.getWorkingDirectory();
+  QString overrideFileName = QString("%1/%2_sweep%3_override.txt").arg(workingDirectory, mSimulationOptions.getOutputFileName()).arg(run + 1);
+  QFile overrideFile(overrideFileName);
+  if (!overrideFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+    return false;
+  }
+  QTextStream textStream(&overrideFile);
+  textStream.setCodec(Helper::utf8.toStdString().data());
+  const QVector<double> &sample = mSamples.at(run);
+  for (int j = 0 ; j < mParameters.size() ; j++) {
+    textStream << mParameters.at(j).mName << "=" << QString::number(sample.at(j), 'g', 17) << "\n";
+  }
+  overrideFile.close();
+  SimulationOptions simulationOptions = mSimulationOptions;
+  simulationOptions.setResultFileName(mResultFiles.at(run));
+  QStringList simulationFlags;
+  foreach (QString simulationFlag, mSimulationOptions.getSimulationFlags()) {
+    if (simulationFlag.startsWith("-r=")) {
+      simulationFlags.append(QString("-r=%1/%2").arg(workingDirectory, mResultFiles.at(run)));
+    } else {
+      simulationFlags.append(simulationFlag);
+    }
+  }
+  // the override file is applied in addition to the -override flag of the simulation options.
+  simulationFlags.append(QString("-overrideFile=%1").arg(overrideFileName));
+  simulationOptions.setSimulationFlags(simulationFlags);
+  simulationOptions.setShowGeneratedFiles(false);
+  simulationOptions.setPlotResultsWhileSimulating(false);
+  simulationOptions.setParameterSweep(getFileName(), run);
+  *pSimulationOptions = simulationOptions;
+  return true;
+}
+
+/*!
+ * \brief ParameterSweep::runFinished
+ * Marks the run as finished. The successful run with the lowest index is the one shown in the Variables Browser.
+ * \param simulationOptions - the simulation options of the run.
+ * \param resultFileLastModifiedDateTime
+ * \param successful
+ */
+void ParameterSweep::runFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, bool successful)
+{
+  int run = simulationOptions.getParameterSweepRun();
+  if (run < 0 || run >= mSamples.size()) {
+    return;
+  }
+  mFinishedRuns++;
+  mSuccessfulRuns[run] = successful && QFile::exists(QString("%1/%2").arg(simulationOptions.getWorkingDirectory(), mResultFiles.at(run)));
+  if (mSuccessfulRuns.at(run) && (mPlotSimulationOptions.getParameterSweepRun() < 0 || run < mPlotSimulationOptions.getParameterSweepRun())) {
+    mPlotSimulationOptions = simulationOptions;
+    mPlotResultFileLastModifiedDateTime = resultFileLastModifiedDateTime;
+  }
+}
+
+/*!
+ * \brief ParameterSweep::getResultFiles
+ * Returns the absolute paths of the result files.
+ * \param successfulOnly - if true only the result files of the successful runs are returned.
+ * \return
+ */
+QStringList ParameterSweep::getResultFiles(bool successfulOnly) const
+{
+  QStringList resultFiles;
+  for (int run = 0 ; run < mResultFiles.size() ; run++) {
+    if (!successfulOnly || mSuccessfulRuns.at(run)) {
+      resultFiles.append(QString("%1/%2").arg(mSimulationOptions.getWorkingDirectory(), mResultFiles.at(run)));
+    }
+  }
+  return resultFiles;
+}
+
+/*!
+ * \brief ParameterSweep::writeIndexFile
+ * Writes the index file of the sweep. One row per run with the run number, its status, its result file and its parameter values.
+ * \return
+ */
+bool ParameterSweep::writeIndexFile() const
+{
+  QFile indexFile(getFileName());
+  if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+    return false;
+  }
+  QTextStream textStream(&indexFile);
+  textStream.setCodec(Helper::utf8.toStdString().data());
+  textStream << "\"run\",\"successful\",\"resultFile\"";
+  foreach (ParameterSweepParameter parameter, mParameters) {
+    textStream << ",\"" << parameter.mName << "\"";
+  }
+  textStream << "\n";
+  for (int run = 0 ; run < mSamples.size() ; run++) {
+    textStream << run + 1 << "," << (mSuccessfulRuns.at(run) ? 1 : 0) << ",\"" << mResultFiles.at(run) << "\"";
+    foreach (double value, mSamples.at(run)) {
+      textStream << "," << QString::number(value, 'g', 17);
+    }
+    textStream << "\n";
+  }
+  indexFile.close();
+  return true;
+}
+
+/*!
+ * \class ParameterSweepRun
+ * \brief A run of a parameter sweep which runs the already compiled executable.\n
+ * Unlike SimulationOutputWidget it has no thread, progress socket or output parser.
+ * The output of the executable is written to a log file and the run reports its status in the output view of the sweep.
+ * The log file is only shown when the user opens the run from the archived simulations.
+ */
+/*!
+ * \brief ParameterSweepRun::ParameterSweepRun
+ * \param simulationOptions - the simulation options of the run.
+ * \param pSimulationOutputWidget - the output view of the sweep.
+ */
+ParameterSweepRun::ParameterSweepRun(SimulationOptions simulationOptions, SimulationOutputWidget *pSimulationOutputWidget)
+  : QObject(0), mSimulationOptions(simulationOptions), mpSimulationOutputWidget(pSimulationOutputWidget)
+{
+  mpSimulationProcess = 0;
+  mIsFinished = false;
+  mpArchivedSimulationItem = new ArchivedSimulationItem(mSimulationOptions, 0, getLogFileName());
+  mpArchivedSimulationItem->setStatus(Helper::queued);
+  MainWindow::instance()->getSimulationDialog()->getArchivedSimulationsTreeWidget()->addTopLevelItem(mpArchivedSimulationItem);
+}
+
+ParameterSweepRun::~ParameterSweepRun()
+{
+  MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->removeParameterSweepRun(this);
+  if (mpSimulationProcess) {
+    // don't report the run when its process is killed.
+    mpSimulationProcess->disconnect(this);
+    delete mpSimulationProcess;
+  }
+}
+
+/*!
+ * \brief ParameterSweepRun::getLogFileName
+ * Returns the file containing the output of the simulation executable of the run.
+ * \return
+ */
+QString ParameterSweepRun::getLogFileName() const
+{
+  return QString("%1/%2_sweep%3.log").arg(mSimulationOptions.getWorkingDirectory(), mSimulationOptions.getOutputFileName())
+      .arg(mSimulationOptions.getParameterSweepRun() + 1);
+}
+
+/*!
+ * \brief ParameterSweepRun::start
+ * Called by SimulationJobScheduler when a simulation slot is free.\n
+ * Runs the simulation executable.
+ */
+void ParameterSweepRun::start()
+{
+  mpArchivedSimulationItem->setStatus(Helper::running);
+  mpSimulationProcess = new QProcess;
+  /* Ticket:4583
+   * Use the OMEdit working directory so users can put their input files there.
+   */
+  mpSimulationProcess->setWorkingDirectory(OptionsDialog::instance()->getGeneralSettingsPage()->getWorkingDirectory());
+  mpSimulationProcess->setProcessChannelMode(QProcess::MergedChannels);
+  mpSimulationProcess->setStandardOutputFile(getLogFileName(), QIODevice::Truncate);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+  connect(mpSimulationProcess, SIGNAL(errorOccurred(QProcess::ProcessError)), SLOT(simulationProcessError(QProcess::ProcessError)));
+#else
+  connect(mpSimulationProcess, SIGNAL(error(QProcess::ProcessError)), SLOT(simulationProcessError(QProcess::ProcessError)));
+#endif
+  connect(mpSimulationProcess, SIGNAL(finished(int,QProcess::ExitStatus)), SLOT(simulationProcessFinished(int,QProcess::ExitStatus)));
+  QString fileName = QString(mSimulationOptions.getWorkingDirectory()).append("/").append(mSimulationOptions.getOutputFileName());
+  fileName = fileName.replace("//", "/");
+#ifdef WIN32
+  fileName = fileName.append(".exe");
+  QFileInfo fileInfo(mSimulationOptions.getFileName());
+  QProcessEnvironment processEnvironment = StringHandler::simulationProcessEnvironment();
+  processEnvironment.insert("PATH", fileInfo.absoluteDir().absolutePath() + ";" + processEnvironment.value("PATH"));
+  mpSimulationProcess->setProcessEnvironment(processEnvironment);
+#endif
+  mResultFileLastModifiedDateTime = QDateTime::currentDateTime();
+  mpSimulationProcess->start(fileName, mSimulationOptions.getSimulationFlags());
+}
+
+/*!
+ * \brief ParameterSweepRun::sharedCompilationFailed
+ * Called when the executable of the sweep is not available. The run fails without being started.
+ */
+void ParameterSweepRun::sharedCompilationFailed()
+{
+  finish(false, tr("Compilation of <b>%1</b> failed.").arg(mSimulationOptions.getClassName()));
+}
+
+/*!
+ * \brief ParameterSweepRun::finish
+ * Frees the simulation slot, reports the run in the output view of the sweep and marks the run as finished.
+ * \param successful
+ * \param exitCodeStr - the reason of the failure.
+ */
+void ParameterSweepRun::finish(bool successful, const QString &exitCodeStr)
+{
+  if (mIsFinished) {
+    return;
+  }
+  mIsFinished = true;
+  SimulationDialog *pSimulationDialog = MainWindow::instance()->getSimulationDialog();
+  pSimulationDialog->getSimulationJobScheduler()->parameterSweepRunFinished(this);
+  mpArchivedSimulationItem->setStatus(Helper::finished);
+  if (mpSimulationOutputWidget) {
+    int run = mSimulationOptions.getParameterSweepRun() + 1;
+    if (successful) {
+      mpSimulationOutputWidget->writeSimulationOutput(tr("Parameter sweep run %1 is finished. The output is in %2.").arg(run).arg(getLogFileName()),
+                                                      StringHandler::OMEditInfo, true);
+    } else {
+      mpSimulationOutputWidget->writeSimulationOutput(tr("Parameter sweep run %1 failed. %2").arg(run).arg(exitCodeStr),
+                                                      StringHandler::Error, true);
+    }
+  }
+  if (mpSimulationProcess) {
+    mpSimulationProcess->deleteLater();
+    mpSimulationProcess = 0;
+  }
+  pSimulationDialog->parameterSweepRunFinished(mSimulationOptions, mResultFileLastModifiedDateTime, successful);
+}
+
+/*!
+ * \brief ParameterSweepRun::simulationProcessError
+ * Slot activated when mpSimulationProcess errorOccurred signal is raised.\n
+ * The finished signal is not raised if the executable can't be started so the run is finished here.
+ * \param error
+ */
+void ParameterSweepRun::simulationProcessError(QProcess::ProcessError error)
+{
+  if (error == QProcess::FailedToStart) {
+    finish(false, mpSimulationProcess->errorString());
+  }
+}
+
+/*!
+ * \brief ParameterSweepRun::simulationProcessFinished
+ * Slot activated when mpSimulationProcess finished signal is raised.
+ * \param exitCode
+ * \param exitStatus
+ */
+void ParameterSweepRun::simulationProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+  finish(exitStatus == QProcess::NormalExit && exitCode == 0,
+         tr("Simulation process failed. Exited with code %1. The output is in %2.").arg(exitCode).arg(getLogFileName()));
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "Simulation/SimulationOptions.h"
+
+#include <QList>
+#include <QVector>
+#include <QDateTime>
+#include <QProcess>
+#include <QPointer>
+
+/* Maximum number of runs of a parameter sweep. */
+#define PARAMETER_SWEEP_MAXIMUM_RUNS 100000
+
+class SimulationOutputWidget;
+class ArchivedSimulationItem;
+class ParameterSweepRun;
+
+class ParameterSweepParameter
+{
+public:
+  ParameterSweepParameter(QString name, double start, double stop, int points)
+    : mName(name), mStart(start), mStop(stop), mPoints(points) {}
+  QString mName;
+  double mStart;
+  double mStop;
+  int mPoints;
+};
+
+class ParameterSweep
+{
+public:
+  enum Sampling {
+    Grid,
+    LatinHypercube
+  };
+  ParameterSweep(SimulationOptions simulationOptions, QList<ParameterSweepParameter> parameters, Sampling sampling, int samples);
+  ~ParameterSweep();
+  static qint64 gridSamplesCount(const QList<ParameterSweepParameter> &parameters);
+  static QList<QVector<double> > gridSamples(const QList<ParameterSweepParameter> &parameters);
+  static QList<QVector<double> > latinHypercubeSamples(const QList<ParameterSweepParameter> &parameters, int samples);
+  QString getFileName() const;
+  int getRunsCount() const {return mSamples.size();}
+  int getFinishedRunsCount() const {return mFinishedRuns;}
+  bool isFinished() const {return mFinishedRuns == mSamples.size();}
+  bool createRunSimulationOptions(int run, SimulationOptions *pSimulationOptions);
+  void runFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, bool successful);
+  SimulationOptions getPlotSimulationOptions() const {return mPlotSimulationOptions;}
+  QDateTime getPlotResultFileLastModifiedDateTime() const {return mPlotResultFileLastModifiedDateTime;}
+  QStringList getResultFiles(bool successfulOnly) const;
+  bool writeIndexFile() const;
+  void addRun(ParameterSweepRun *pParameterSweepRun) {mRunsList.append(pParameterSweepRun);}
+  QList<ParameterSweepRun*> getRuns() const {return mRunsList;}
+  void setCompilationRun(int run) {mCompilationRun = run;}
+  int getCompilationRun() const {return mCompilationRun;}
+  void setRunsStarted(bool runsStarted) {mRunsStarted = runsStarted;}
+  bool areRunsStarted() const {return mRunsStarted;}
+private:
+  SimulationOptions mSimulationOptions;
+  QList<ParameterSweepParameter> mParameters;
+  QList<QVector<double> > mSamples;
+  QStringList mResultFiles;
+  QVector<bool> mSuccessfulRuns;
+  int mFinishedRuns;
+  SimulationOptions mPlotSimulationOptions;
+  QDateTime mPlotResultFileLastModifiedDateTime;
+  QList<ParameterSweepRun*> mRunsList;
+  int mCompilationRun;
+  bool mRunsStarted;
+};
+
+class ParameterSweepRun : public QObject
+{
+  Q_OBJECT
+public:
+  ParameterSweepRun(SimulationOptions simulationOptions, SimulationOutputWidget *pSimulationOutputWidget);
+  ~ParameterSweepRun();
+  SimulationOptions getSimulationOptions() const {return mSimulationOptions;}
+  QString getLogFileName() const;
+  void start();
+  void sharedCompilationFailed();
+private:
+  SimulationOptions mSimulationOptions;
+  QPointer<SimulationOutputWidget> mpSimulationOutputWidget;
+  ArchivedSimulationItem *mpArchivedSimulationItem;
+  QProcess *mpSimulationProcess;
+  bool mIsFinished;
+  QDateTime mResultFileLastModifiedDateTime;
+
+  void finish(bool successful, const QString &exitCodeStr);
+private slots:
+  void simulationProcessError(QProcess::ProcessError error);
+  void simulationProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+};
+
+#endif // PARAMETERSWEEP_H
@@ -42,7 +42,10 @@
 #include "Plotting/VariablesWidget.h"
 #include "Plotting/PlotWindowContainer.h"
 #include "Modeling/Commands.h"
+#include "Editors/TextEditor.h"
 #include "SimulationProcessThread.h"
+#include "SimulationJobScheduler.h"
+#include "ParameterSweep.h"
 #if !defined(WITHOUT_OSG)
 #include "Animation/AnimationWindow.h"
 #endif
@@ -63,11 +66,15 @@ SimulationDialog::SimulationDialog(QWidget *pParent)
   : QDialog(pParent)
 {
   resize(550, 550);
+  mpSimulationJobScheduler = new SimulationJobScheduler(this);
+  connect(mpSimulationJobScheduler, SIGNAL(jobsChanged()), SLOT(updateSimulationJobsStatus()));
   setUpForm();
 }
 
 SimulationDialog::~SimulationDialog()
 {
+  // deleting the jobs below must not start the queued ones.
+  mpSimulationJobScheduler->shutdown();
   foreach (SimulationOutputWidget *pSimulationOutputWidget, mSimulationOutputWidgetsList) {
     SimulationProcessThread *pSimulationProcessThread = pSimulationOutputWidget->getSimulationProcessThread();
     /* If the SimulationProcessThread is running then we need to stop it i.e exit its event loop.
@@ -80,6 +87,7 @@ SimulationDialog::~SimulationDialog()
       if (pSimulationProcessThread->isSimulationProcessRunning() && pSimulationProcessThread->getSimulationProcess()) {
         pSimulationProcessThread->getSimulationProcess()->kill();
       }
+      pSimulationProcessThread->cancelQueuedSimulation();
       pSimulationProcessThread->exit();
       pSimulationProcessThread->wait();
       delete pSimulationOutputWidget;
@@ -91,6 +99,8 @@ SimulationDialog::~SimulationDialog()
   }
   mSimulationOutputWidgetsList.clear();
   mOpcUaClientsMap.clear();
+  qDeleteAll(mParameterSweepsHash);
+  mParameterSweepsHash.clear();
 }
 
 /*!
@@ -124,6 +134,7 @@ void SimulationDialog::directSimulate(LibraryTreeItem *pLibraryTreeItem, bool la
   mpLibraryTreeItem = pLibraryTreeItem;
   initializeFields(false, SimulationOptions());
   mpBuildOnlyCheckBox->setChecked(false);
+  mpParameterSweepCheckBox->setChecked(false);
   mpLaunchTransformationalDebuggerCheckBox->setChecked(launchTransformationalDebugger);
   mpLaunchAlgorithmicDebuggerCheckBox->setChecked(launchAlgorithmicDebugger);
 #if !defined(WITHOUT_OSG)
@@ -551,6 +562,10 @@ void SimulationDialog::setUpForm()
   mpStoreVariablesAtEventsCheckBox = new QCheckBox(tr("Store Variables at Events"));
   // show generated files checkbox
   mpShowGeneratedFilesCheckBox = new QCheckBox(tr("Show Generated Files"));
+  // plot results while simulating checkbox
+  mpPlotResultsWhileSimulatingCheckBox = new QCheckBox(tr("Plot Results While Simulating"));
+  mpPlotResultsWhileSimulatingCheckBox->setToolTip(tr("Follows the result file and plots the checked variables while the simulation is running.\n"
+                                                       "Only supported with the csv output format."));
   // set Output Tab Layout
   QGridLayout *pOutputTabLayout = new QGridLayout;
   pOutputTabLayout->setAlignment(Qt::AlignTop);
@@ -567,9 +582,71 @@ void SimulationDialog::setUpForm()
   pOutputTabLayout->addWidget(mpEquidistantTimeGridCheckBox, 6, 0, 1, 2);
   pOutputTabLayout->addWidget(mpStoreVariablesAtEventsCheckBox, 7, 0, 1, 2);
   pOutputTabLayout->addWidget(mpShowGeneratedFilesCheckBox, 8, 0, 1, 2);
+  pOutputTabLayout->addWidget(mpPlotResultsWhileSimulatingCheckBox, 9, 0, 1, 2);
   mpOutputTab->setLayout(pOutputTabLayout);
   // add Output Tab to Simulation TabWidget
   mpSimulationTabWidget->addTab(mpOutputTab, Helper::output);
+  // Parameter Sweep Tab
+  mpParameterSweepTab = new QWidget;
+  mpParameterSweepCheckBox = new QCheckBox(tr("Run Parameter Sweep"));
+  mpParameterSweepCheckBox->setToolTip(tr("Compiles the model once and runs the executable for every sample of the parameters.\n"
+                                          "The results of all runs are plotted together."));
+  // sweep parameters
+  mpSweepParametersTableWidget = new QTableWidget;
+  mpSweepParametersTableWidget->setTextElideMode(Qt::ElideMiddle);
+  mpSweepParametersTableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
+  mpSweepParametersTableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
+  mpSweepParametersTableWidget->setColumnCount(4);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+  mpSweepParametersTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+#else /* Qt4 */
+  mpSweepParametersTableWidget->horizontalHeader()->setResizeMode(QHeaderView::Stretch);
+#endif
+  mpSweepParametersTableWidget->horizontalHeader()->setDefaultAlignment(Qt::AlignLeft);
+  QStringList sweepHeaderLabels;
+  sweepHeaderLabels << tr("Parameter") << tr("Start") << tr("Stop") << tr("Points");
+  mpSweepParametersTableWidget->setHorizontalHeaderLabels(sweepHeaderLabels);
+  // sweep parameters manipulation buttons
+  mpAddSweepParameterButton = new QToolButton;
+  mpAddSweepParameterButton->setObjectName("ShapePointsButton");
+  mpAddSweepParameterButton->setIcon(QIcon(":/Resources/icons/add-icon.svg"));
+  mpAddSweepParameterButton->setToolTip(tr("Add parameter"));
+  connect(mpAddSweepParameterButton, SIGNAL(clicked()), SLOT(addSweepParameter()));
+  mpRemoveSweepParameterButton = new QToolButton;
+  mpRemoveSweepParameterButton->setObjectName("ShapePointsButton");
+  mpRemoveSweepParameterButton->setIcon(QIcon(":/Resources/icons/delete.svg"));
+  mpRemoveSweepParameterButton->setToolTip(tr("Remove parameter"));
+  connect(mpRemoveSweepParameterButton, SIGNAL(clicked()), SLOT(removeSweepParameter()));
+  mpSweepParametersButtonBox = new QDialogButtonBox(Qt::Vertical);
+  mpSweepParametersButtonBox->addButton(mpAddSweepParameterButton, QDialogButtonBox::ActionRole);
+  mpSweepParametersButtonBox->addButton(mpRemoveSweepParameterButton, QDialogButtonBox::ActionRole);
+  // sampling
+  mpSweepSamplingLabel = new Label(tr("Sampling:"));
+  mpSweepSamplingComboBox = new QComboBox;
+  mpSweepSamplingComboBox->addItem(tr("Grid"), ParameterSweep::Grid);
+  mpSweepSamplingComboBox->addItem(tr("Latin Hypercube"), ParameterSweep::LatinHypercube);
+  mpSweepSamplingComboBox->setToolTip(tr("Grid runs every combination of the parameter points.\n"
+                                         "Latin Hypercube runs the given number of samples and ignores the points."));
+  connect(mpSweepSamplingComboBox, SIGNAL(currentIndexChanged(int)), SLOT(sweepSamplingChanged(int)));
+  mpSweepSamplesLabel = new Label(tr("Samples:"));
+  mpSweepSamplesSpinBox = new QSpinBox;
+  mpSweepSamplesSpinBox->setRange(1, PARAMETER_SWEEP_MAXIMUM_RUNS);
+  mpSweepSamplesSpinBox->setValue(100);
+  sweepSamplingChanged(mpSweepSamplingComboBox->currentIndex());
+  // set Parameter Sweep Tab Layout
+  QGridLayout *pParameterSweepTabLayout = new QGridLayout;
+  pParameterSweepTabLayout->setAlignment(Qt::AlignTop);
+  pParameterSweepTabLayout->setColumnStretch(1, 1);
+  pParameterSweepTabLayout->addWidget(mpParameterSweepCheckBox, 0, 0, 1, 3);
+  pParameterSweepTabLayout->addWidget(mpSweepParametersTableWidget, 1, 0, 1, 2);
+  pParameterSweepTabLayout->addWidget(mpSweepParametersButtonBox, 1, 2);
+  pParameterSweepTabLayout->addWidget(mpSweepSamplingLabel, 2, 0);
+  pParameterSweepTabLayout->addWidget(mpSweepSamplingComboBox, 2, 1, 1, 2);
+  pParameterSweepTabLayout->addWidget(mpSweepSamplesLabel, 3, 0);
+  pParameterSweepTabLayout->addWidget(mpSweepSamplesSpinBox, 3, 1, 1, 2);
+  mpParameterSweepTab->setLayout(pParameterSweepTabLayout);
+  // add Parameter Sweep Tab to Simulation TabWidget
+  mpSimulationTabWidget->addTab(mpParameterSweepTab, tr("Parameter Sweep"));
   // Archived Simulations tab
   mpArchivedSimulationsTab = new QWidget;
   mpArchivedSimulationsTreeWidget = new QTreeWidget;
@@ -581,9 +658,16 @@ void SimulationDialog::setUpForm()
   mpArchivedSimulationsTreeWidget->setHeaderLabels(headers);
   mpArchivedSimulationsTreeWidget->setIndentation(0);
   connect(mpArchivedSimulationsTreeWidget, SIGNAL(itemDoubleClicked(QTreeWidgetItem*,int)), SLOT(showArchivedSimulation(QTreeWidgetItem*)));
+  // aggregate progress of the queued simulations
+  mpSimulationJobsStatusLabel = new Label;
+  mpSimulationJobsProgressBar = new QProgressBar;
+  mpSimulationJobsProgressBar->setAlignment(Qt::AlignHCenter);
+  updateSimulationJobsStatus();
   QGridLayout *pArchivedSimulationsTabLayout = new QGridLayout;
   pArchivedSimulationsTabLayout->setAlignment(Qt::AlignTop);
-  pArchivedSimulationsTabLayout->addWidget(mpArchivedSimulationsTreeWidget, 0, 0);
+  pArchivedSimulationsTabLayout->addWidget(mpSimulationJobsStatusLabel, 0, 0);
+  pArchivedSimulationsTabLayout->addWidget(mpSimulationJobsProgressBar, 1, 0);
+  pArchivedSimulationsTabLayout->addWidget(mpArchivedSimulationsTreeWidget, 2, 0);
   mpArchivedSimulationsTab->setLayout(pArchivedSimulationsTabLayout);
   // add Archived simulations Tab to Simulation TabWidget
   mpSimulationTabWidget->addTab(mpArchivedSimulationsTab, Helper::archivedSimulations);
@@ -645,6 +729,28 @@ bool SimulationDialog::validate()
                           GUIMessages::getMessage(GUIMessages::SIMULATION_STARTTIME_LESSTHAN_STOPTIME), Helper::ok);
     return false;
   }
+  if (mpParameterSweepCheckBox->isChecked()) {
+    if (mpBuildOnlyCheckBox->isChecked() || mpInteractiveSimulationGroupBox->isChecked() || mpLaunchAlgorithmicDebuggerCheckBox->isChecked()) {
+      QMessageBox::critical(MainWindow::instance(), QString(Helper::applicationName).append(" - ").append(Helper::error),
+                            tr("A parameter sweep can't be combined with build only, interactive simulation or the algorithmic debugger."),
+                            Helper::ok);
+      return false;
+    }
+    QList<ParameterSweepParameter> parameters;
+    if (!getSweepParameters(&parameters)) {
+      QMessageBox::critical(MainWindow::instance(), QString(Helper::applicationName).append(" - ").append(Helper::error),
+                            tr("Add at least one sweep parameter. Every sweep parameter needs a name, a numeric start and stop value "
+                               "and at least one point."), Helper::ok);
+      return false;
+    }
+    ParameterSweep::Sampling sampling = (ParameterSweep::Sampling)mpSweepSamplingComboBox->itemData(mpSweepSamplingComboBox->currentIndex()).toInt();
+    if (sampling == ParameterSweep::Grid && ParameterSweep::gridSamplesCount(parameters) > PARAMETER_SWEEP_MAXIMUM_RUNS) {
+      QMessageBox::critical(MainWindow::instance(), QString(Helper::applicationName).append(" - ").append(Helper::error),
+                            tr("The parameter sweep grid has more than %1 runs. Reduce the number of points or use Latin Hypercube sampling.")
+                            .arg(PARAMETER_SWEEP_MAXIMUM_RUNS), Helper::ok);
+      return false;
+    }
+  }
   return true;
 }
 
@@ -1017,6 +1123,9 @@ void SimulationDialog::applySimulationOptions(SimulationOptions simulationOption
   mpStoreVariablesAtEventsCheckBox->setChecked(simulationOptions.getStoreVariablesAtEvents());
   // show generated files checkbox
   mpShowGeneratedFilesCheckBox->setChecked(simulationOptions.getShowGeneratedFiles());
+  // plot results while simulating checkbox
+  mpPlotResultsWhileSimulatingCheckBox->setChecked(simulationOptions.getPlotResultsWhileSimulating());
+  mpPlotResultsWhileSimulatingCheckBox->setEnabled(mpOutputFormatComboBox->currentText().compare("csv") == 0);
 }
 
 /*!
@@ -1157,6 +1266,7 @@ SimulationOptions SimulationDialog::createSimulationOptions()
   simulationOptions.setEquidistantTimeGrid(mpEquidistantTimeGridCheckBox->isChecked());
   simulationOptions.setStoreVariablesAtEvents(mpStoreVariablesAtEventsCheckBox->isChecked());
   simulationOptions.setShowGeneratedFiles(mpShowGeneratedFilesCheckBox->isChecked());
+  simulationOptions.setPlotResultsWhileSimulating(mpPlotResultsWhileSimulatingCheckBox->isEnabled() && mpPlotResultsWhileSimulatingCheckBox->isChecked());
   // create a folder with model name to dump the files in it.
   QString modelDirectoryPath = QString("%1/%2").arg(OptionsDialog::instance()->getGeneralSettingsPage()->getWorkingDirectory(), mClassName);
   if (!QDir().exists(modelDirectoryPath)) {
@@ -1326,7 +1436,8 @@ void SimulationDialog::createAndShowSimulationOutputWidget(SimulationOptions sim
     if (OptionsDialog::instance()->getSimulationPage()->getCloseSimulationOutputWidgetsBeforeSimulationCheckBox()->isChecked()) {
       foreach (SimulationOutputWidget *pSimulationOutputWidget, mSimulationOutputWidgetsList) {
         if (!(pSimulationOutputWidget->getSimulationProcessThread()->isCompilationProcessRunning() ||
-              pSimulationOutputWidget->getSimulationProcessThread()->isSimulationProcessRunning())) {
+              pSimulationOutputWidget->getSimulationProcessThread()->isSimulationProcessRunning() ||
+              mpSimulationJobScheduler->isJobQueued(pSimulationOutputWidget))) {
           pSimulationOutputWidget->close();
         }
       }
@@ -1341,6 +1452,87 @@ void SimulationDialog::createAndShowSimulationOutputWidget(SimulationOptions sim
   }
 }
 
+/*!
+ * \brief SimulationDialog::getSweepParameters
+ * Reads the sweep parameters from the parameter sweep table.
+ * \param pParameters
+ * \return false if there is no parameter or a row is invalid.
+ */
+bool SimulationDialog::getSweepParameters(QList<ParameterSweepParameter> *pParameters)
+{
+  for (int row = 0 ; row < mpSweepParametersTableWidget->rowCount() ; row++) {
+    QStringList values;
+    for (int column = 0 ; column < mpSweepParametersTableWidget->columnCount() ; column++) {
+      QTableWidgetItem *pTableWidgetItem = mpSweepParametersTableWidget->item(row, column);
+      values.append(pTableWidgetItem ? pTableWidgetItem->text().trimmed() : "");
+    }
+    bool startOk, stopOk, pointsOk;
+    double start = values.at(1).toDouble(&startOk);
+    double stop = values.at(2).toDouble(&stopOk);
+    int points = values.at(3).toInt(&pointsOk);
+    if (values.at(0).isEmpty() || !startOk || !stopOk || !pointsOk || points < 1) {
+      return false;
+    }
+    pParameters->append(ParameterSweepParameter(values.at(0), start, stop, points));
+  }
+  return !pParameters->isEmpty();
+}
+
+/*!
+ * \brief SimulationDialog::createParameterSweep
+ * Creates a job for every sample of the parameter sweep. All jobs share one compilation of the model.\n
+ * The first job is a SimulationOutputWidget which compiles the model and is the output view of the whole sweep.
+ * The other jobs are lightweight ParameterSweepRun jobs which run the executable once it is built.
+ * They are listed in the archived simulations.
+ * \param simulationOptions
+ */
+void SimulationDialog::createParameterSweep(SimulationOptions simulationOptions)
+{
+  QList<ParameterSweepParameter> parameters;
+  if (!getSweepParameters(&parameters)) {
+    return;
+  }
+  ParameterSweep::Sampling sampling = (ParameterSweep::Sampling)mpSweepSamplingComboBox->itemData(mpSweepSamplingComboBox->currentIndex()).toInt();
+  ParameterSweep *pParameterSweep = new ParameterSweep(simulationOptions, parameters, sampling, mpSweepSamplesSpinBox->value());
+  ParameterSweep *pOldParameterSweep = mParameterSweepsHash.value(pParameterSweep->getFileName(), 0);
+  if (pOldParameterSweep) {
+    if (!pOldParameterSweep->isFinished()) {
+      QString msg = tr("A parameter sweep of <b>%1</b> is already running in %2.").arg(simulationOptions.getOutputFileName())
+          .arg(simulationOptions.getWorkingDirectory());
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                            Helper::errorLevel));
+      delete pParameterSweep;
+      return;
+    }
+    delete pOldParameterSweep;
+  }
+  mParameterSweepsHash.insert(pParameterSweep->getFileName(), pParameterSweep);
+  QString msg = tr("Running parameter sweep of <b>%1</b> with %2 runs.").arg(simulationOptions.getClassName())
+      .arg(pParameterSweep->getRunsCount());
+  MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                        Helper::notificationLevel));
+  SimulationOutputWidget *pSimulationOutputWidget = 0;
+  for (int run = 0 ; run < pParameterSweep->getRunsCount() ; run++) {
+    SimulationOptions runSimulationOptions;
+    if (pParameterSweep->createRunSimulationOptions(run, &runSimulationOptions)) {
+      if (!pSimulationOutputWidget) {
+        pParameterSweep->setCompilationRun(run);
+        pSimulationOutputWidget = new SimulationOutputWidget(runSimulationOptions);
+        mSimulationOutputWidgetsList.append(pSimulationOutputWidget);
+        int xPos = QApplication::desktop()->availableGeometry().width() - pSimulationOutputWidget->frameSize().width() - 20;
+        int yPos = QApplication::desktop()->availableGeometry().height() - pSimulationOutputWidget->frameSize().height() - 20;
+        pSimulationOutputWidget->setGeometry(xPos, yPos, pSimulationOutputWidget->width(), pSimulationOutputWidget->height());
+        pSimulationOutputWidget->show();
+      } else {
+        pParameterSweep->addRun(new ParameterSweepRun(runSimulationOptions, pSimulationOutputWidget));
+      }
+    } else {
+      runSimulationOptions.setParameterSweep(pParameterSweep->getFileName(), run);
+      parameterSweepRunFinished(runSimulationOptions, QDateTime(), false);
+    }
+  }
+}
+
 /*!
  * \brief SimulationDialog::saveSimulationSettings
  * Saves the experiment annotation in the model.
@@ -1593,7 +1785,27 @@ void SimulationDialog::performSimulation()
   MainWindow::instance()->getStatusBar()->showMessage(tr("Translating %1.").arg(mClassName));
   MainWindow::instance()->getProgressBar()->setRange(0, 0);
   MainWindow::instance()->showProgressBar();
-  bool isTranslationSuccessful = mIsReSimulate ? true : translateModel(simulationParameters);
+  /* Reuse the compilation of a queued or finished job when only the runtime flags are different.
+   * Translating another model into the directory of a queued compilation would overwrite its files.
+   */
+  bool reuseCompilation = false;
+  if (!mIsReSimulate) {
+    QString compilationKey = SimulationJobScheduler::compilationKey(simulationOptions);
+    simulationOptions.setCompilationKey(compilationKey);
+    if (mpSimulationJobScheduler->isCompilationDirectoryBusy(simulationOptions, compilationKey)) {
+      QString msg = tr("Another compilation of <b>%1</b> is queued in %2. Wait for it to finish or use a different output file name.")
+          .arg(simulationOptions.getOutputFileName()).arg(simulationOptions.getWorkingDirectory());
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                            Helper::errorLevel));
+      MainWindow::instance()->hideProgressBar();
+      MainWindow::instance()->getStatusBar()->clearMessage();
+      QApplication::restoreOverrideCursor();
+      return;
+    }
+    reuseCompilation = !simulationOptions.getBuildOnly() && !simulationOptions.getLaunchAlgorithmicDebugger()
+                       && mpSimulationJobScheduler->hasCompilation(compilationKey);
+  }
+  bool isTranslationSuccessful = (mIsReSimulate || reuseCompilation) ? true : translateModel(simulationParameters);
   MainWindow::instance()->getOMCProxy()->changeDirectory(OptionsDialog::instance()->getGeneralSettingsPage()->getWorkingDirectory());
   // hide the progress bar
   MainWindow::instance()->hideProgressBar();
@@ -1615,7 +1827,11 @@ void SimulationDialog::performSimulation()
     QString targetLanguage = pSimulationPage->getTargetLanguageComboBox()->currentText();
     // check if we can compile using the target language
     if ((targetLanguage.compare("C") == 0) || (targetLanguage.compare("Cpp") == 0)) {
-      createAndShowSimulationOutputWidget(simulationOptions);
+      if (mpParameterSweepCheckBox->isChecked()) {
+        createParameterSweep(simulationOptions);
+      } else {
+        createAndShowSimulationOutputWidget(simulationOptions);
+      }
     } else {
       QString msg = tr("Generated code for the target language <b>%1</b> at %2.").arg(targetLanguage)
           .arg(simulationOptions.getWorkingDirectory());
@@ -1689,6 +1905,10 @@ void SimulationDialog::simulationPaused()
 
 void SimulationDialog::updateInteractiveSimulationCurves()
 {
+  // the sample threads only write to the pending data of the variables. Move it to the curves in the GUI thread.
+  foreach (OpcUaClient *pOpcUaClient, mOpcUaClientsMap) {
+    pOpcUaClient->updateCheckedVariablesData();
+  }
   OMPlot::PlotWindow* window = MainWindow::instance()->getPlotWindowContainer()->getCurrentWindow();
   if (window) {
     window->updateCurves();
@@ -1739,6 +1959,7 @@ void SimulationDialog::terminateSimulationProcess(SimulationOutputWidget *pSimul
     if (pSimulationProcessThread->isSimulationProcessRunning() && pSimulationProcessThread->getSimulationProcess()) {
       pSimulationProcessThread->getSimulationProcess()->kill();
     }
+    pSimulationProcessThread->cancelQueuedSimulation();
     pSimulationProcessThread->exit();
     pSimulationProcessThread->wait();
   }
@@ -1918,6 +2139,69 @@ void SimulationDialog::simulationProcessFinished(SimulationOptions simulationOpt
   }
 }
 
+/*!
+ * \brief SimulationDialog::startParameterSweepRuns
+ * Called when the executable of the parameter sweep runs for the first time.
+ * Queues the other runs of the sweep which use the same executable.
+ * \param simulationOptions - the simulation options of the run which compiled the model.
+ */
+void SimulationDialog::startParameterSweepRuns(SimulationOptions simulationOptions)
+{
+  ParameterSweep *pParameterSweep = mParameterSweepsHash.value(simulationOptions.getParameterSweepFileName(), 0);
+  if (!pParameterSweep || pParameterSweep->areRunsStarted()) {
+    return;
+  }
+  pParameterSweep->setRunsStarted(true);
+  foreach (ParameterSweepRun *pParameterSweepRun, pParameterSweep->getRuns()) {
+    mpSimulationJobScheduler->addParameterSweepRun(pParameterSweepRun);
+  }
+}
+
+/*!
+ * \brief SimulationDialog::parameterSweepRunFinished
+ * \param simulationOptions - the simulation options of the run.
+ * \param resultFileLastModifiedDateTime
+ * \param successful
+ * Called when a run of a parameter sweep is finished.\n
+ * When all runs are finished writes the index file of the sweep, inserts the first successful run into the variables browser
+ * and overlays the other runs when its variables are plotted.
+ */
+void SimulationDialog::parameterSweepRunFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, bool successful)
+{
+  ParameterSweep *pParameterSweep = mParameterSweepsHash.value(simulationOptions.getParameterSweepFileName(), 0);
+  if (!pParameterSweep || pParameterSweep->isFinished()) {
+    return;
+  }
+  // the run compiling the model failed before its executable ran so the other runs fail as well.
+  if (simulationOptions.getParameterSweepRun() == pParameterSweep->getCompilationRun() && !pParameterSweep->areRunsStarted()) {
+    pParameterSweep->setRunsStarted(true);
+    foreach (ParameterSweepRun *pParameterSweepRun, pParameterSweep->getRuns()) {
+      pParameterSweepRun->sharedCompilationFailed();
+    }
+  }
+  pParameterSweep->runFinished(simulationOptions, resultFileLastModifiedDateTime, successful);
+  if (!pParameterSweep->isFinished()) {
+    return;
+  }
+  if (!pParameterSweep->writeIndexFile()) {
+    QString msg = tr("Failed to write the parameter sweep index file %1.").arg(pParameterSweep->getFileName());
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                          Helper::errorLevel));
+  }
+  QStringList resultFiles = pParameterSweep->getResultFiles(true);
+  QString msg = tr("Parameter sweep of <b>%1</b> is finished. %2 of %3 runs are successful. The runs are listed in %4.")
+      .arg(simulationOptions.getClassName()).arg(resultFiles.size()).arg(pParameterSweep->getRunsCount()).arg(pParameterSweep->getFileName());
+  MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, msg, Helper::scriptingKind,
+                                                        Helper::notificationLevel));
+  if (!resultFiles.isEmpty()) {
+    SimulationOptions plotSimulationOptions = pParameterSweep->getPlotSimulationOptions();
+    QString plotResultFile = QString("%1/%2").arg(plotSimulationOptions.getWorkingDirectory(), plotSimulationOptions.getFullResultFileName());
+    resultFiles.removeOne(plotResultFile);
+    MainWindow::instance()->getVariablesWidget()->addParameterSweep(plotResultFile, resultFiles);
+    simulationProcessFinished(plotSimulationOptions, pParameterSweep->getPlotResultFileLastModifiedDateTime());
+  }
+}
+
 /*!
  * \brief SimulationDialog::numberOfIntervalsRadioToggled
  * \param toggle
@@ -2078,17 +2362,34 @@ void SimulationDialog::showSimulationFlagsHelp()
 /*!
  * \brief SimulationDialog::showArchivedSimulation
  * Slot activated when mpArchivedSimulationsListWidget itemDoubleClicked signal is raised.\n
- * Shows the archived SimulationOutputWidget.
+ * Shows the archived SimulationOutputWidget.\n
+ * The parameter sweep runs have no SimulationOutputWidget. Their log file is shown in a new window.
  * \param pTreeWidgetItem
  */
 void SimulationDialog::showArchivedSimulation(QTreeWidgetItem *pTreeWidgetItem)
 {
   ArchivedSimulationItem *pArchivedSimulationItem = dynamic_cast<ArchivedSimulationItem*>(pTreeWidgetItem);
-  if (pArchivedSimulationItem) {
+  if (pArchivedSimulationItem && pArchivedSimulationItem->getSimulationOutputWidget()) {
     SimulationOutputWidget *pSimulationOutputWidget = pArchivedSimulationItem->getSimulationOutputWidget();
     pSimulationOutputWidget->show();
     pSimulationOutputWidget->raise();
     pSimulationOutputWidget->setWindowState(pSimulationOutputWidget->windowState() & (~Qt::WindowMinimized));
+  } else if (pArchivedSimulationItem && !pArchivedSimulationItem->getLogFileName().isEmpty()) {
+    QFile file(pArchivedSimulationItem->getLogFileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+      QString errorMessage = GUIMessages::getMessage(GUIMessages::UNABLE_TO_OPEN_FILE).arg(file.fileName());
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "", false, 0, 0, 0, 0, errorMessage,
+                                                            Helper::scriptingKind, Helper::errorLevel));
+      return;
+    }
+    TextEditor *pTextEditor = new TextEditor(MainWindow::instance());
+    pTextEditor->setWindowFlags(Qt::Window);
+    pTextEditor->setAttribute(Qt::WA_DeleteOnClose);
+    pTextEditor->setWindowTitle(QString("%1 - %2").arg(Helper::applicationName, QFileInfo(file.fileName()).fileName()));
+    pTextEditor->getPlainTextEdit()->setPlainText(QString(file.readAll()));
+    pTextEditor->getPlainTextEdit()->setReadOnly(true);
+    file.close();
+    pTextEditor->show();
   }
 }
 
@@ -2139,6 +2440,63 @@ void SimulationDialog::simulate()
   }
 }
 
+/*!
+ * \brief SimulationDialog::updateSimulationJobsStatus
+ * Slot activated when SimulationJobScheduler jobsChanged signal is raised.\n
+ * Shows the aggregate progress of the queued simulations.
+ */
+void SimulationDialog::updateSimulationJobsStatus()
+{
+  mpSimulationJobsStatusLabel->setText(mpSimulationJobScheduler->getStatusText());
+  mpSimulationJobsProgressBar->setRange(0, qMax(1, mpSimulationJobScheduler->getTotalJobs()));
+  mpSimulationJobsProgressBar->setValue(mpSimulationJobScheduler->getFinishedJobs());
+}
+
+/*!
+ * \brief SimulationDialog::addSweepParameter
+ * Slot activated when mpAddSweepParameterButton clicked signal is raised.\n
+ * Adds a row to the parameter sweep table.
+ */
+void SimulationDialog::addSweepParameter()
+{
+  int row = mpSweepParametersTableWidget->rowCount();
+  mpSweepParametersTableWidget->insertRow(row);
+  QStringList values;
+  values << "" << "0" << "1" << "10";
+  for (int column = 0 ; column < values.size() ; column++) {
+    QTableWidgetItem *pTableWidgetItem = new QTableWidgetItem(values.at(column));
+    pTableWidgetItem->setFlags(pTableWidgetItem->flags() | Qt::ItemIsEditable);
+    mpSweepParametersTableWidget->setItem(row, column, pTableWidgetItem);
+  }
+  mpSweepParametersTableWidget->setCurrentCell(row, 0);
+  mpSweepParametersTableWidget->editItem(mpSweepParametersTableWidget->item(row, 0));
+}
+
+/*!
+ * \brief SimulationDialog::removeSweepParameter
+ * Slot activated when mpRemoveSweepParameterButton clicked signal is raised.\n
+ * Removes the selected row from the parameter sweep table.
+ */
+void SimulationDialog::removeSweepParameter()
+{
+  if (mpSweepParametersTableWidget->selectedItems().size() > 0) {
+    mpSweepParametersTableWidget->removeRow(mpSweepParametersTableWidget->selectedItems().at(0)->row());
+  }
+}
+
+/*!
+ * \brief SimulationDialog::sweepSamplingChanged
+ * Slot activated when mpSweepSamplingComboBox currentIndexChanged signal is raised.\n
+ * The number of samples is only used by Latin hypercube sampling.
+ * \param index
+ */
+void SimulationDialog::sweepSamplingChanged(int index)
+{
+  bool latinHypercube = mpSweepSamplingComboBox->itemData(index).toInt() == ParameterSweep::LatinHypercube;
+  mpSweepSamplesLabel->setEnabled(latinHypercube);
+  mpSweepSamplesSpinBox->setEnabled(latinHypercube);
+}
+
 /*!
  * \brief SimulationDialog::resultFileNameChanged
  * Slot activated when mpOutputFormatComboBox currentIndexChanged signal is raised.
@@ -2150,6 +2508,7 @@ void SimulationDialog::resultFileNameChanged(QString text)
   QComboBox *pComboBoxSender = qobject_cast<QComboBox*>(sender());
   if (pComboBoxSender) {
     mpSinglePrecisionCheckBox->setEnabled(mpOutputFormatComboBox->currentText().compare("mat") == 0);
+    mpPlotResultsWhileSimulatingCheckBox->setEnabled(mpOutputFormatComboBox->currentText().compare("csv") == 0);
     mpResultFileNameTextBox->setPlaceholderText(QString("%1_res.%2").arg(mClassName).arg(mpOutputFormatComboBox->currentText()));
   }
 }
@@ -52,17 +52,23 @@
 #include <QDialogButtonBox>
 #include <QGridLayout>
 #include <QDateTime>
+#include <QProgressBar>
+#include <QTableWidget>
+#include <QHash>
 
 class Label;
 class SimulationOutputWidget;
 class LibraryTreeItem;
 class TranslationFlagsWidget;
+class SimulationJobScheduler;
+class ParameterSweep;
+class ParameterSweepParameter;
 
 class ArchivedSimulationItem : public QTreeWidgetItem
 {
 public:
-  ArchivedSimulationItem(SimulationOptions simulationOptions, SimulationOutputWidget *pSimulationOutputWidget)
-    : mpSimulationOutputWidget(pSimulationOutputWidget)
+  ArchivedSimulationItem(SimulationOptions simulationOptions, SimulationOutputWidget *pSimulationOutputWidget, QString logFileName = QString())
+    : mpSimulationOutputWidget(pSimulationOutputWidget), mLogFileName(logFileName)
   {
     setText(0, simulationOptions.getClassName());
     setToolTip(0, simulationOptions.getClassName());
@@ -75,12 +81,14 @@ public:
     setStatus(Helper::running);
   }
   SimulationOutputWidget* getSimulationOutputWidget() {return mpSimulationOutputWidget;}
+  QString getLogFileName() {return mLogFileName;}
   void setStatus(QString status) {
     setText(4, status);
     setToolTip(4, status);
   }
 private:
   SimulationOutputWidget *mpSimulationOutputWidget;
+  QString mLogFileName;
 };
 
 class SimulationDialog : public QDialog
@@ -90,6 +98,7 @@ public:
   SimulationDialog(QWidget *pParent = 0);
   ~SimulationDialog();
   QTreeWidget* getArchivedSimulationsTreeWidget() {return mpArchivedSimulationsTreeWidget;}
+  SimulationJobScheduler* getSimulationJobScheduler() {return mpSimulationJobScheduler;}
   void show(LibraryTreeItem *pLibraryTreeItem, bool isReSimulate, SimulationOptions simulationOptions);
   void directSimulate(LibraryTreeItem *pLibraryTreeItem, bool launchTransformationalDebugger, bool launchAlgorithmicDebugger,
                       bool launchAnimation);
@@ -197,8 +206,22 @@ private:
   QCheckBox *mpEquidistantTimeGridCheckBox;
   QCheckBox *mpStoreVariablesAtEventsCheckBox;
   QCheckBox *mpShowGeneratedFilesCheckBox;
+  QCheckBox *mpPlotResultsWhileSimulatingCheckBox;
+  // Parameter Sweep Tab
+  QWidget *mpParameterSweepTab;
+  QCheckBox *mpParameterSweepCheckBox;
+  QTableWidget *mpSweepParametersTableWidget;
+  QToolButton *mpAddSweepParameterButton;
+  QToolButton *mpRemoveSweepParameterButton;
+  QDialogButtonBox *mpSweepParametersButtonBox;
+  Label *mpSweepSamplingLabel;
+  QComboBox *mpSweepSamplingComboBox;
+  Label *mpSweepSamplesLabel;
+  QSpinBox *mpSweepSamplesSpinBox;
   // Archived Simulation Flags Tab
   QWidget *mpArchivedSimulationsTab;
+  Label *mpSimulationJobsStatusLabel;
+  QProgressBar *mpSimulationJobsProgressBar;
   QTreeWidget *mpArchivedSimulationsTreeWidget;
   // checkboxes
   QCheckBox *mpSaveExperimentAnnotationCheckBox;
@@ -214,6 +237,8 @@ private:
   QString mClassName;
   QString mFileName;
   bool mIsReSimulate;
+  SimulationJobScheduler *mpSimulationJobScheduler;
+  QHash<QString, ParameterSweep*> mParameterSweepsHash;
   // interactive simulation
   QMap<int, OpcUaClient*> mOpcUaClientsMap;
 
@@ -224,6 +249,8 @@ private:
   bool translateModel(QString simulationParameters);
   SimulationOptions createSimulationOptions();
   void createAndShowSimulationOutputWidget(SimulationOptions simulationOptions);
+  bool getSweepParameters(QList<ParameterSweepParameter> *pParameters);
+  void createParameterSweep(SimulationOptions simulationOptions);
   void showSimulationOutputWidget(SimulationOutputWidget *pSimulationOutputWidget);
   void saveExperimentAnnotation();
   void saveSimulationFlagsAnnotation();
@@ -238,6 +265,8 @@ public:
   void reSimulate(SimulationOptions simulationOptions);
   void showAlgorithmicDebugger(SimulationOptions simulationOptions);
   void simulationProcessFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime);
+  void startParameterSweepRuns(SimulationOptions simulationOptions);
+  void parameterSweepRunFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, bool successful);
   void createOpcUaClient(SimulationOptions simulationOptions);
 public slots:
   void numberOfIntervalsRadioToggled(bool toggle);
@@ -256,6 +285,10 @@ public slots:
   void updateInteractiveSimulationCurves();
   void updateYAxis(double min, double max);
 private slots:
+  void updateSimulationJobsStatus();
+  void addSweepParameter();
+  void removeSweepParameter();
+  void sweepSamplingChanged(int index);
   void resultFileNameChanged(QString text);
   void simulationStarted();
   void simulationPaused();
@@ -0,0 +1,507 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include "Simulation/SimulationJobScheduler.h"
+#include "Simulation/SimulationOutputWidget.h"
+#include "Simulation/ParameterSweep.h"
+#include "MainWindow.h"
+#include "OMC/OMCProxy.h"
+#include "Options/OptionsDialog.h"
+
+#include <QThread>
+#include <QFileInfo>
+#include <QCryptographicHash>
+
+/*!
+ * \class SimulationJobScheduler
+ * \brief Queues the simulation jobs and limits the number of compilations and simulation executables running at the same time.
+ * Every SimulationOutputWidget is a job. The compilation of a job is started when a compilation slot is free and
+ * the executable is started when a simulation slot is free.\n
+ * Jobs which only differ in the runtime flags share one compilation. A job whose model is already compiled or is being compiled
+ * runs the existing executable.\n
+ * The runs of a parameter sweep after the first one are lightweight ParameterSweepRun jobs sharing the simulation slots.
+ */
+/*!
+ * \brief SimulationJobScheduler::SimulationJobScheduler
+ * \param pParent
+ */
+SimulationJobScheduler::SimulationJobScheduler(QObject *pParent)
+  : QObject(pParent)
+{
+  mTotalJobs = 0;
+  mFinishedJobs = 0;
+  mShutdown = false;
+}
+
+/*!
+ * \brief SimulationJobScheduler::compilationKey
+ * Returns the key identifying the compilation of the simulation options.\n
+ * The key covers the model text and the options that are used by the translation and compilation.
+ * The runtime flags are not part of it.\n
+ * The model also depends on the classes it uses so the key includes the number of changes made to the loaded classes.
+ * Any change to a loaded class gives a new key and the model is compiled again.
+ * \param simulationOptions
+ * \return
+ */
+QString SimulationJobScheduler::compilationKey(SimulationOptions simulationOptions)
+{
+  SimulationPage *pSimulationPage = OptionsDialog::instance()->getSimulationPage();
+  QStringList options;
+  options << simulationOptions.getClassName()
+          << simulationOptions.getWorkingDirectory()
+          << simulationOptions.getOutputFileName()
+          << simulationOptions.getTargetLanguage()
+          << simulationOptions.getCflags()
+          << simulationOptions.getOutputFormat()
+          << simulationOptions.getVariableFilter()
+          << simulationOptions.getMatchingAlgorithm()
+          << simulationOptions.getIndexReductionMethod()
+          << QString::number(simulationOptions.getInitialization())
+          << QString::number(simulationOptions.getEvaluateAllParameters())
+          << QString::number(simulationOptions.getNLSanalyticJacobian())
+          << QString::number(simulationOptions.getPedantic())
+          << QString::number(simulationOptions.getParmodauto())
+          << QString::number(simulationOptions.getNewInstantiation())
+          << simulationOptions.getAdditionalTranslationFlags()
+          << simulationOptions.getProfiling()
+          << QString::number(simulationOptions.getLaunchAlgorithmicDebugger())
+          << QString::number(simulationOptions.getSimulateWithAnimation())
+          << pSimulationPage->getTargetBuildComboBox()->currentText()
+          << pSimulationPage->getCompilerComboBox()->currentText()
+          << pSimulationPage->getCXXCompilerComboBox()->currentText();
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(options.join("\n").toUtf8());
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  hash.addData(pOMCProxy->list(simulationOptions.getClassName()).toUtf8());
+  hash.addData(QByteArray::number(pOMCProxy->getLoadedClassesChangeCount()));
+  return QString(hash.result().toHex());
+}
+
+/*!
+ * \brief SimulationJobScheduler::getMaximumCompilations
+ * Returns the number of compilations allowed to run at the same time.
+ * \return
+ */
+int SimulationJobScheduler::getMaximumCompilations() const
+{
+  int maximumCompilations = OptionsDialog::instance()->getSimulationPage()->getParallelCompilationsSpinBox()->value();
+  if (maximumCompilations > 0) {
+    return maximumCompilations;
+  }
+  // each compilation runs make in parallel so only a few of them share the cores.
+  return qMax(1, QThread::idealThreadCount() / 4);
+}
+
+/*!
+ * \brief SimulationJobScheduler::getMaximumSimulations
+ * Returns the number of simulation executables allowed to run at the same time.
+ * \return
+ */
+int SimulationJobScheduler::getMaximumSimulations() const
+{
+  int maximumSimulations = OptionsDialog::instance()->getSimulationPage()->getParallelSimulationsSpinBox()->value();
+  if (maximumSimulations > 0) {
+    return maximumSimulations;
+  }
+  return qMax(1, QThread::idealThreadCount());
+}
+
+/*!
+ * \brief SimulationJobScheduler::getCompilationProcessors
+ * Returns the number of processors a compilation may use so the parallel compilations do not oversubscribe the cores.\n
+ * The processors are shared by the compilations that are running, not by the maximum number of compilations,
+ * so a single compilation gets all the requested processors.
+ * \param numberOfProcessors - the number of processors requested by the simulation options.
+ * \param runningCompilations - the number of running compilations including the one being started.
+ * \return
+ */
+int SimulationJobScheduler::getCompilationProcessors(int numberOfProcessors, int runningCompilations)
+{
+  return qMax(1, numberOfProcessors / qMax(1, runningCompilations));
+}
+
+/*!
+ * \brief SimulationJobScheduler::hasCompilation
+ * Returns true if the compilation is done or queued so a new job can reuse its executable.
+ * \param compilationKey
+ * \return
+ */
+bool SimulationJobScheduler::hasCompilation(const QString &compilationKey) const
+{
+  return isCompiled(compilationKey) || isCompiling(compilationKey);
+}
+
+/*!
+ * \brief SimulationJobScheduler::isCompilationDirectoryBusy
+ * Returns true if another model is queued or compiled in the same directory with the same output file name.
+ * Translating the new model there would overwrite the files of the queued compilation.
+ * \param simulationOptions
+ * \param compilationKey
+ * \return
+ */
+bool SimulationJobScheduler::isCompilationDirectoryBusy(SimulationOptions simulationOptions, const QString &compilationKey) const
+{
+  QList<SimulationOutputWidget*> compilations = mPendingCompilationsList + mRunningCompilationsList;
+  foreach (SimulationOutputWidget *pSimulationOutputWidget, compilations) {
+    SimulationOptions jobSimulationOptions = pSimulationOutputWidget->getSimulationOptions();
+    if (jobSimulationOptions.getWorkingDirectory().compare(simulationOptions.getWorkingDirectory()) == 0
+        && jobSimulationOptions.getOutputFileName().compare(simulationOptions.getOutputFileName()) == 0
+        && mCompilationKeysHash.value(pSimulationOutputWidget).compare(compilationKey) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief SimulationJobScheduler::addJob
+ * Adds the job to the queue and starts it if a slot is free.
+ * \param pSimulationOutputWidget
+ */
+void SimulationJobScheduler::addJob(SimulationOutputWidget *pSimulationOutputWidget)
+{
+  jobAdded();
+  SimulationOptions simulationOptions = pSimulationOutputWidget->getSimulationOptions();
+  if (simulationOptions.isReSimulate()) {
+    mPendingSimulationsList.append(pSimulationOutputWidget);
+  } else {
+    QString key = simulationOptions.getCompilationKey().isEmpty() ? compilationKey(simulationOptions) : simulationOptions.getCompilationKey();
+    mCompilationKeysHash.insert(pSimulationOutputWidget, key);
+    bool reuse = !simulationOptions.getBuildOnly() && !simulationOptions.getLaunchAlgorithmicDebugger();
+    if (reuse && isCompiled(key)) {
+      mPendingSimulationsList.append(pSimulationOutputWidget);
+    } else if (reuse && isCompiling(key)) {
+      mWaitingJobsHash[key].append(pSimulationOutputWidget);
+    } else {
+      mPendingCompilationsList.append(pSimulationOutputWidget);
+    }
+  }
+  startJobs();
+  emit jobsChanged();
+}
+
+/*!
+ * \brief SimulationJobScheduler::removeJob
+ * Removes the job from the scheduler. Called when the job is cancelled or its SimulationOutputWidget is deleted.
+ * \param pSimulationOutputWidget
+ */
+void SimulationJobScheduler::removeJob(SimulationOutputWidget *pSimulationOutputWidget)
+{
+  bool removed = mPendingCompilationsList.removeOne(pSimulationOutputWidget);
+  removed = mPendingSimulationsList.removeOne(pSimulationOutputWidget) || removed;
+  removed = mRunningSimulationsList.removeOne(pSimulationOutputWidget) || removed;
+  QMutableHashIterator<QString, QList<SimulationOutputWidget*> > waitingJobsIterator(mWaitingJobsHash);
+  while (waitingJobsIterator.hasNext()) {
+    waitingJobsIterator.next();
+    removed = waitingJobsIterator.value().removeOne(pSimulationOutputWidget) || removed;
+    if (waitingJobsIterator.value().isEmpty()) {
+      waitingJobsIterator.remove();
+    }
+  }
+  if (mRunningCompilationsList.removeOne(pSimulationOutputWidget)) {
+    compileWaitingJobs(mCompilationKeysHash.value(pSimulationOutputWidget));
+    removed = true;
+  }
+  if (removed) {
+    jobFinished(pSimulationOutputWidget);
+  }
+  mCompilationKeysHash.remove(pSimulationOutputWidget);
+  startJobs();
+  emit jobsChanged();
+}
+
+/*!
+ * \brief SimulationJobScheduler::isJobQueued
+ * Returns true if the job is waiting for a compilation or simulation slot.
+ * \param pSimulationOutputWidget
+ * \return
+ */
+bool SimulationJobScheduler::isJobQueued(SimulationOutputWidget *pSimulationOutputWidget) const
+{
+  if (mPendingCompilationsList.contains(pSimulationOutputWidget) || mPendingSimulationsList.contains(pSimulationOutputWidget)) {
+    return true;
+  }
+  foreach (QList<SimulationOutputWidget*> waitingJobs, mWaitingJobsHash) {
+    if (waitingJobs.contains(pSimulationOutputWidget)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief SimulationJobScheduler::compilationFinished
+ * Frees the compilation slot of the job and queues its simulation.\n
+ * The jobs waiting for the same compilation are queued for simulation as well or fail if the compilation failed.
+ * \param pSimulationOutputWidget
+ * \param successful - true if the compilation is successful.
+ * \param simulate - true if the job runs the executable after the compilation.
+ */
+void SimulationJobScheduler::compilationFinished(SimulationOutputWidget *pSimulationOutputWidget, bool successful, bool simulate)
+{
+  if (!mRunningCompilationsList.removeOne(pSimulationOutputWidget)) {
+    return;
+  }
+  QString key = mCompilationKeysHash.value(pSimulationOutputWidget);
+  if (successful) {
+    QString fileName = executableFileName(pSimulationOutputWidget->getSimulationOptions());
+    mCompiledExecutablesHash.insert(key, qMakePair(fileName, QFileInfo(fileName).lastModified()));
+    if (simulate) {
+      mPendingSimulationsList.append(pSimulationOutputWidget);
+    } else {
+      jobFinished(pSimulationOutputWidget);
+    }
+    mPendingSimulationsList.append(mWaitingJobsHash.take(key));
+  } else {
+    jobFinished(pSimulationOutputWidget);
+    // the jobs waiting for this compilation would fail the same way.
+    foreach (SimulationOutputWidget *pWaitingSimulationOutputWidget, mWaitingJobsHash.take(key)) {
+      jobFinished(pWaitingSimulationOutputWidget);
+      pWaitingSimulationOutputWidget->sharedCompilationFailed();
+    }
+  }
+  startJobs();
+  emit jobsChanged();
+}
+
+/*!
+ * \brief SimulationJobScheduler::simulationFinished
+ * Frees the simulation slot of the job.
+ * \param pSimulationOutputWidget
+ */
+void SimulationJobScheduler::simulationFinished(SimulationOutputWidget *pSimulationOutputWidget)
+{
+  mRunningSimulationsList.removeOne(pSimulationOutputWidget);
+  jobFinished(pSimulationOutputWidget);
+  startJobs();
+  emit jobsChanged();
+}
+
+/*!
+ * \brief SimulationJobScheduler::addParameterSweepRun
+ * Adds the parameter sweep run to the queue and starts it if a simulation slot is free.
+ * \param pParameterSweepRun
+ */
+void SimulationJobScheduler::addParameterSweepRun(ParameterSweepRun *pParameterSweepRun)
+{
+  jobAdded();
+  mPendingParameterSweepRunsList.append(pParameterSweepRun);
+  startJobs();
+  emit jobsChanged();
+}
+
+/*!
+ * \brief SimulationJobScheduler::removeParameterSweepRun
+ * Removes the parameter sweep run from the scheduler. Called when the run is finished or deleted.
+ * \param pParameterSweepRun
+ */
+void SimulationJobScheduler::removeParameterSweepRun(ParameterSweepRun *pParameterSweepRun)
+{
+  bool removed = mPendingParameterSweepRunsList.removeOne(pParameterSweepRun);
+  removed = mRunningParameterSweepRunsList.removeOne(pParameterSweepRun) || removed;
+  if (removed) {
+    mFinishedJobs = qMin(mFinishedJobs + 1, mTotalJobs);
+    startJobs();
+    emit jobsChanged();
+  }
+}
+
+/*!
+ * \brief SimulationJobScheduler::parameterSweepRunFinished
+ * Frees the simulation slot of the parameter sweep run.
+ * \param pParameterSweepRun
+ */
+void SimulationJobScheduler::parameterSweepRunFinished(ParameterSweepRun *pParameterSweepRun)
+{
+  removeParameterSweepRun(pParameterSweepRun);
+}
+
+/*!
+ * \brief SimulationJobScheduler::shutdown
+ * Drops the queued jobs and stops starting new ones.\n
+ * Called before the jobs are deleted on exit since removing a job frees a slot which would otherwise start the next one.
+ */
+void SimulationJobScheduler::shutdown()
+{
+  mShutdown = true;
+  mPendingCompilationsList.clear();
+  mPendingSimulationsList.clear();
+  mWaitingJobsHash.clear();
+  mPendingParameterSweepRunsList.clear();
+}
+
+/*!
+ * \brief SimulationJobScheduler::getStatusText
+ * Returns the aggregate progress and throughput of the current batch of jobs.
+ * \return
+ */
+QString SimulationJobScheduler::getStatusText() const
+{
+  int queuedJobs = mPendingCompilationsList.size() + mPendingSimulationsList.size() + mPendingParameterSweepRunsList.size();
+  foreach (QList<SimulationOutputWidget*> waitingJobs, mWaitingJobsHash) {
+    queuedJobs += waitingJobs.size();
+  }
+  double minutes = mBatchElapsedTimer.isValid() ? mBatchElapsedTimer.elapsed() / 60000.0 : 0;
+  double throughput = minutes > 0 ? mFinishedJobs / minutes : 0;
+  return tr("Compiling: %1, Simulating: %2, Queued: %3, Finished: %4 of %5 (%6 per minute)")
+      .arg(mRunningCompilationsList.size()).arg(getRunningSimulations()).arg(queuedJobs)
+      .arg(mFinishedJobs).arg(mTotalJobs).arg(QString::number(throughput, 'f', 1));
+}
+
+/*!
+ * \brief SimulationJobScheduler::executableFileName
+ * Returns the file name of the simulation executable.
+ * \param simulationOptions
+ * \return
+ */
+QString SimulationJobScheduler::executableFileName(SimulationOptions simulationOptions)
+{
+  QString fileName = QString("%1/%2").arg(simulationOptions.getWorkingDirectory(), simulationOptions.getOutputFileName());
+#ifdef WIN32
+  fileName.append(".exe");
+#endif
+  return fileName;
+}
+
+/*!
+ * \brief SimulationJobScheduler::isCompiled
+ * Returns true if the executable of the compilation exists and is not changed since the compilation.
+ * \param compilationKey
+ * \return
+ */
+bool SimulationJobScheduler::isCompiled(const QString &compilationKey) const
+{
+  if (!mCompiledExecutablesHash.contains(compilationKey)) {
+    return false;
+  }
+  QPair<QString, QDateTime> executable = mCompiledExecutablesHash.value(compilationKey);
+  QFileInfo fileInfo(executable.first);
+  return fileInfo.exists() && fileInfo.lastModified() == executable.second;
+}
+
+/*!
+ * \brief SimulationJobScheduler::isCompiling
+ * Returns true if a job with the compilation key is queued for compilation or is being compiled.
+ * \param compilationKey
+ * \return
+ */
+bool SimulationJobScheduler::isCompiling(const QString &compilationKey) const
+{
+  QList<SimulationOutputWidget*> compilations = mPendingCompilationsList + mRunningCompilationsList;
+  foreach (SimulationOutputWidget *pSimulationOutputWidget, compilations) {
+    if (mCompilationKeysHash.value(pSimulationOutputWidget).compare(compilationKey) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief SimulationJobScheduler::jobAdded
+ * Counts the added job. Starts a new batch when all the previous jobs are finished.
+ */
+void SimulationJobScheduler::jobAdded()
+{
+  if (mTotalJobs == mFinishedJobs) {
+    mTotalJobs = 0;
+    mFinishedJobs = 0;
+    mBatchElapsedTimer.start();
+  }
+  mTotalJobs++;
+}
+
+/*!
+ * \brief SimulationJobScheduler::jobFinished
+ * Counts the finished job.
+ * \param pSimulationOutputWidget
+ */
+void SimulationJobScheduler::jobFinished(SimulationOutputWidget *pSimulationOutputWidget)
+{
+  Q_UNUSED(pSimulationOutputWidget);
+  mFinishedJobs = qMin(mFinishedJobs + 1, mTotalJobs);
+}
+
+/*!
+ * \brief SimulationJobScheduler::compileWaitingJobs
+ * The job compiling for the waiting jobs is removed.
+ * The first waiting job is compiled and the others wait for it.
+ * \param compilationKey
+ */
+void SimulationJobScheduler::compileWaitingJobs(const QString &compilationKey)
+{
+  QList<SimulationOutputWidget*> waitingJobs = mWaitingJobsHash.take(compilationKey);
+  if (!waitingJobs.isEmpty()) {
+    mPendingCompilationsList.prepend(waitingJobs.takeFirst());
+    if (!waitingJobs.isEmpty()) {
+      mWaitingJobsHash.insert(compilationKey, waitingJobs);
+    }
+  }
+}
+
+/*!
+ * \brief SimulationJobScheduler::startJobs
+ * Starts the queued jobs as long as there are free compilation and simulation slots.\n
+ * Interactive simulations wait for the user and are not limited. Nothing is started after SimulationJobScheduler::shutdown.
+ */
+void SimulationJobScheduler::startJobs()
+{
+  if (mShutdown) {
+    return;
+  }
+  while (!mPendingCompilationsList.isEmpty() && mRunningCompilationsList.size() < getMaximumCompilations()) {
+    SimulationOutputWidget *pSimulationOutputWidget = mPendingCompilationsList.takeFirst();
+    mRunningCompilationsList.append(pSimulationOutputWidget);
+    pSimulationOutputWidget->startCompilation(getCompilationProcessors(pSimulationOutputWidget->getSimulationOptions().getNumberOfProcessors(),
+                                                                       mRunningCompilationsList.size()));
+  }
+  int i = 0;
+  while (i < mPendingSimulationsList.size()) {
+    SimulationOutputWidget *pSimulationOutputWidget = mPendingSimulationsList.at(i);
+    if (pSimulationOutputWidget->getSimulationOptions().isInteractiveSimulation()) {
+      mPendingSimulationsList.removeAt(i);
+      pSimulationOutputWidget->startSimulation();
+    } else if (getRunningSimulations() < getMaximumSimulations()) {
+      mPendingSimulationsList.removeAt(i);
+      mRunningSimulationsList.append(pSimulationOutputWidget);
+      pSimulationOutputWidget->startSimulation();
+    } else {
+      i++;
+    }
+  }
+  while (!mPendingParameterSweepRunsList.isEmpty() && getRunningSimulations() < getMaximumSimulations()) {
+    ParameterSweepRun *pParameterSweepRun = mPendingParameterSweepRunsList.takeFirst();
+    mRunningParameterSweepRunsList.append(pParameterSweepRun);
+    pParameterSweepRun->start();
+  }
+}
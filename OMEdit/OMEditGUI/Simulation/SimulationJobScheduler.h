@@ -0,0 +1,98 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef SIMULATIONJOBSCHEDULER_H
+#define SIMULATIONJOBSCHEDULER_H
+
+#include "Simulation/SimulationOptions.h"
+
+#include <QObject>
+#include <QHash>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+class SimulationOutputWidget;
+class ParameterSweepRun;
+
+class SimulationJobScheduler : public QObject
+{
+  Q_OBJECT
+public:
+  SimulationJobScheduler(QObject *pParent = 0);
+  static QString compilationKey(SimulationOptions simulationOptions);
+  int getMaximumCompilations() const;
+  int getMaximumSimulations() const;
+  static int getCompilationProcessors(int numberOfProcessors, int runningCompilations);
+  bool hasCompilation(const QString &compilationKey) const;
+  bool isCompilationDirectoryBusy(SimulationOptions simulationOptions, const QString &compilationKey) const;
+  void addJob(SimulationOutputWidget *pSimulationOutputWidget);
+  void removeJob(SimulationOutputWidget *pSimulationOutputWidget);
+  bool isJobQueued(SimulationOutputWidget *pSimulationOutputWidget) const;
+  void compilationFinished(SimulationOutputWidget *pSimulationOutputWidget, bool successful, bool simulate);
+  void simulationFinished(SimulationOutputWidget *pSimulationOutputWidget);
+  void addParameterSweepRun(ParameterSweepRun *pParameterSweepRun);
+  void removeParameterSweepRun(ParameterSweepRun *pParameterSweepRun);
+  void parameterSweepRunFinished(ParameterSweepRun *pParameterSweepRun);
+  void shutdown();
+  QString getStatusText() const;
+  int getTotalJobs() const {return mTotalJobs;}
+  int getFinishedJobs() const {return mFinishedJobs;}
+private:
+  QHash<SimulationOutputWidget*, QString> mCompilationKeysHash;
+  QList<SimulationOutputWidget*> mPendingCompilationsList;
+  QList<SimulationOutputWidget*> mRunningCompilationsList;
+  QList<SimulationOutputWidget*> mPendingSimulationsList;
+  QList<SimulationOutputWidget*> mRunningSimulationsList;
+  QHash<QString, QList<SimulationOutputWidget*> > mWaitingJobsHash;
+  QHash<QString, QPair<QString, QDateTime> > mCompiledExecutablesHash;
+  QList<ParameterSweepRun*> mPendingParameterSweepRunsList;
+  QList<ParameterSweepRun*> mRunningParameterSweepRunsList;
+  int mTotalJobs;
+  int mFinishedJobs;
+  bool mShutdown;
+  QElapsedTimer mBatchElapsedTimer;
+
+  static QString executableFileName(SimulationOptions simulationOptions);
+  bool isCompiled(const QString &compilationKey) const;
+  bool isCompiling(const QString &compilationKey) const;
+  int getRunningSimulations() const {return mRunningSimulationsList.size() + mRunningParameterSweepRunsList.size();}
+  void jobAdded();
+  void jobFinished(SimulationOutputWidget *pSimulationOutputWidget);
+  void compileWaitingJobs(const QString &compilationKey);
+  void startJobs();
+signals:
+  void jobsChanged();
+};
+
+#endif // SIMULATIONJOBSCHEDULER_H
@@ -104,6 +104,7 @@ public:
     setEquidistantTimeGrid(true);
     setStoreVariablesAtEvents(true);
     setShowGeneratedFiles(false);
+    setPlotResultsWhileSimulating(false);
 
     setSimulationFlags(QStringList());
     setIsValid(false);
@@ -111,6 +112,8 @@ public:
     setWorkingDirectory("");
     setFileName("");
     setTargetLanguage("C");
+    setCompilationKey("");
+    setParameterSweep("", -1);
   }
 
   void setClassName(QString className) {mClassName = className;}
@@ -226,6 +229,8 @@ public:
   bool getStoreVariablesAtEvents() {return mStoreVariablesAtEvents;}
   void setShowGeneratedFiles(bool showGeneratedFiles) {mShowGeneratedFiles = showGeneratedFiles;}
   bool getShowGeneratedFiles() {return mShowGeneratedFiles;}
+  void setPlotResultsWhileSimulating(bool plotResultsWhileSimulating) {mPlotResultsWhileSimulating = plotResultsWhileSimulating;}
+  bool getPlotResultsWhileSimulating() {return mPlotResultsWhileSimulating;}
 
   void setSimulationFlags(QStringList simulationFlags) {mSimulationFlags = simulationFlags;}
   QStringList getSimulationFlags() {return mSimulationFlags;}
@@ -239,6 +244,16 @@ public:
   QString getFileName() const {return mFileName;}
   void setTargetLanguage(QString targetLanguage) {mTargetLanguage = targetLanguage;}
   QString getTargetLanguage() const {return mTargetLanguage;}
+  void setCompilationKey(QString compilationKey) {mCompilationKey = compilationKey;}
+  QString getCompilationKey() const {return mCompilationKey;}
+  void setParameterSweep(QString parameterSweepFileName, int parameterSweepRun)
+  {
+    mParameterSweepFileName = parameterSweepFileName;
+    mParameterSweepRun = parameterSweepRun;
+  }
+  QString getParameterSweepFileName() const {return mParameterSweepFileName;}
+  int getParameterSweepRun() const {return mParameterSweepRun;}
+  bool isParameterSweepRun() const {return !mParameterSweepFileName.isEmpty();}
 private:
   QString mClassName;
   QString mStartTime;
@@ -297,6 +312,7 @@ private:
   bool mEquidistantTimeGrid;
   bool mStoreVariablesAtEvents;
   bool mShowGeneratedFiles;
+  bool mPlotResultsWhileSimulating;
 
   QStringList mSimulationFlags;
   bool mValid;
@@ -304,6 +320,9 @@ private:
   QString mWorkingDirectory;
   QString mFileName;
   QString mTargetLanguage;
+  QString mCompilationKey;
+  QString mParameterSweepFileName;
+  int mParameterSweepRun;
 };
 
 #endif // SIMULATIONOPTIONS_H
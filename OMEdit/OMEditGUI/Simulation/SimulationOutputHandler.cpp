@@ -32,6 +32,16 @@
  */
 
 #include "SimulationOutputHandler.h"
+#include "Options/OptionsDialog.h"
+
+#include <QTextDocumentFragment>
+#include <algorithm>
+#include <string.h>
+
+/* The interval in milliseconds at which the parsed messages are handed to the view, so a chatty simulation
+ * updates the output window once per frame instead of once per message.
+ */
+#define SIMULATION_OUTPUT_FLUSH_INTERVAL 40
 
 /*!
   \class SimulationMessageModel
@@ -197,6 +207,39 @@ void SimulationMessageModel::insertSimulationMessage(SimulationMessage *pSimulat
   }
 }
 
+/*!
+  Inserts the simulation messages in the data with a single row insertion.
+  \param simulationMessages - the simulation messages to insert.
+  */
+void SimulationMessageModel::insertSimulationMessages(QList<SimulationMessage*> simulationMessages)
+{
+  if (!simulationMessages.isEmpty()) {
+    int row = mpRootSimulationMessage->children().size();
+    beginInsertRows(QModelIndex(), row, row + simulationMessages.size() - 1);
+    mpRootSimulationMessage->mChildren.append(simulationMessages);
+    endInsertRows();
+  }
+}
+
+/*!
+  Removes the oldest top level simulation messages from the data.\n
+  The caller takes the ownership of the removed messages.
+  \param count - the number of messages to remove.
+  \return the removed messages.
+  */
+QList<SimulationMessage*> SimulationMessageModel::removeSimulationMessages(int count)
+{
+  QList<SimulationMessage*> simulationMessages;
+  count = qMin(count, mpRootSimulationMessage->children().size());
+  if (count > 0) {
+    beginRemoveRows(QModelIndex(), 0, count - 1);
+    simulationMessages = mpRootSimulationMessage->mChildren.mid(0, count);
+    mpRootSimulationMessage->mChildren.erase(mpRootSimulationMessage->mChildren.begin(), mpRootSimulationMessage->mChildren.begin() + count);
+    endRemoveRows();
+  }
+  return simulationMessages;
+}
+
 /*!
   Emits the QAbstractItemModel::layoutChanged which calls the ItemDelegate::sizeHint.\n
   This is needed for views which shows rich text using QTextDocument.\n
@@ -269,77 +312,209 @@ QModelIndex SimulationMessageModel::simulationMessageIndexHelper(const Simulatio
 }
 
 /*!
-  \class SimulationOutputHandler
-  \brief Parses the xml output of simulation executable.
-  */
-/*
-  <message stream="LOG_STATS" type="info" text="events">
-    <message stream="LOG_STATS" type="info" text="    0 state events" />
-    <message stream="LOG_STATS" type="info" text="    0 time events" />
-  </message>
-  <message stream="stdout" type="info" text="output text">
-    <used index="2" />
-  </message>
-  */
+ * \brief isXmlSpace
+ * Returns true if the character is a xml white space.
+ * \param character
+ * \return
+ */
+static inline bool isXmlSpace(char character)
+{
+  return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
 /*!
-  \param pSimulationOutputWidget - a pointer to SimulationOutputWidget.
-  \param simulationOutput - the simulation output
+ * \brief decodeAttributeValue
+ * Decodes the attribute value bytes. Values without entity references and line breaks are converted directly.
+ * \param pBegin
+ * \param pEnd
+ * \return
+ */
+static QString decodeAttributeValue(const char *pBegin, const char *pEnd)
+{
+  const char *p = pBegin;
+  while (p < pEnd && *p != '&' && *p != '\t' && *p != '\r' && *p != '\n') {
+    ++p;
+  }
+  if (p == pEnd) {
+    return QString::fromUtf8(pBegin, pEnd - pBegin);
+  }
+  QByteArray value;
+  value.reserve(pEnd - pBegin);
+  value.append(pBegin, p - pBegin);
+  while (p < pEnd) {
+    if (*p != '&') {
+      // attribute value normalization, literal white spaces are replaced with a space.
+      value.append(isXmlSpace(*p) ? ' ' : *p);
+      ++p;
+      continue;
+    }
+    const char *pSemicolon = static_cast<const char*>(memchr(p, ';', pEnd - p));
+    if (!pSemicolon) {
+      value.append(p, pEnd - p);
+      break;
+    }
+    const QByteArray entity = QByteArray::fromRawData(p + 1, pSemicolon - p - 1);
+    if (entity == "lt") {
+      value.append('<');
+    } else if (entity == "gt") {
+      value.append('>');
+    } else if (entity == "amp") {
+      value.append('&');
+    } else if (entity == "quot") {
+      value.append('"');
+    } else if (entity == "apos") {
+      value.append('\'');
+    } else if (entity.startsWith('#')) {
+      bool ok;
+      uint code = entity.startsWith("#x") ? entity.mid(2).toUInt(&ok, 16) : entity.mid(1).toUInt(&ok, 10);
+      if (ok) {
+        value.append(QString::fromUcs4(&code, 1).toUtf8());
+      } else {
+        value.append(p, pSemicolon - p + 1);
+      }
+    } else {
+      value.append(p, pSemicolon - p + 1);
+    }
+    p = pSemicolon + 1;
+  }
+  return QString::fromUtf8(value.constData(), value.size());
+}
+
+/*!
+ * \brief attributeValue
+ * Finds the attribute in the attributes bytes of a tag and returns its decoded value.
+ * \param pAttributes
+ * \param pEnd
+ * \param pName
+ * \return
+ */
+static QString attributeValue(const char *pAttributes, const char *pEnd, const char *pName)
+{
+  const int nameLength = qstrlen(pName);
+  const char *p = pAttributes;
+  while (p < pEnd) {
+    while (p < pEnd && isXmlSpace(*p)) {
+      ++p;
+    }
+    const char *pAttributeName = p;
+    while (p < pEnd && *p != '=' && !isXmlSpace(*p)) {
+      ++p;
+    }
+    const int attributeNameLength = p - pAttributeName;
+    while (p < pEnd && (*p == '=' || isXmlSpace(*p))) {
+      ++p;
+    }
+    if (p >= pEnd || (*p != '"' && *p != '\'')) {
+      break;
+    }
+    const char quote = *p++;
+    const char *pValue = p;
+    while (p < pEnd && *p != quote) {
+      ++p;
+    }
+    if (attributeNameLength == nameLength && qstrncmp(pAttributeName, pName, nameLength) == 0) {
+      return decodeAttributeValue(pValue, p);
+    }
+    ++p;
+  }
+  return QString();
+}
+
+/*!
+ * \brief isElementName
+ * Returns true if the element name bytes are equal to name.
+ * \param pName
+ * \param nameLength
+ * \param name
+ * \return
+ */
+static inline bool isElementName(const char *pName, int nameLength, const char *name)
+{
+  return nameLength == (int)qstrlen(name) && qstrncmp(pName, name, nameLength) == 0;
+}
+
+/*!
+  \class SimulationOutputParser
+  \brief Incremental parser for the xml output of simulation executable.
+  Runs in a worker thread. The received bytes are scanned in place and only the tags that are not complete yet are kept for the next chunk.
+  The completed top level messages are collected until SimulationOutputHandler takes them.
   */
-SimulationOutputHandler::SimulationOutputHandler(SimulationOutputWidget *pSimulationOutputWidget, QString simulationOutput)
+/*!
+ * \brief SimulationOutputParser::SimulationOutputParser
+ * \param structured - true if the messages are shown in the tree view.
+ * \param pRootSimulationMessage - the parent of the top level messages.
+ */
+SimulationOutputParser::SimulationOutputParser(bool structured, SimulationMessage *pRootSimulationMessage)
+  : QObject(0), mProgress(-1)
 {
-  mpSimulationOutputWidget = pSimulationOutputWidget;
+  mStructured = structured;
+  mpRootSimulationMessage = pRootSimulationMessage;
+  mLineNumber = 1;
+  mFatalError = false;
   mLevel = 0;
   mpSimulationMessage = 0;
-  if (mpSimulationOutputWidget->isOutputStructured()) {
-    mpSimulationMessageModel = new SimulationMessageModel(mpSimulationOutputWidget);
-  } else {
-    mpSimulationMessageModel = 0;
-  }
-  mXmlSimpleReader.setContentHandler(this);
-  mXmlSimpleReader.setErrorHandler(this);
-  mpXmlInputSource = new QXmlInputSource;
-  mpXmlInputSource->setData(simulationOutput.prepend("<root>"));
-  mXmlSimpleReader.parse(mpXmlInputSource, true);
+  mEmbeddedServerInitialized = false;
 }
 
-SimulationOutputHandler::~SimulationOutputHandler()
+/*!
+ * \brief SimulationOutputParser::~SimulationOutputParser
+ * Deletes the messages that are not taken yet and the incomplete message.
+ */
+SimulationOutputParser::~SimulationOutputParser()
 {
-  delete mpXmlInputSource;
+  SimulationMessage *pSimulationMessage = mSimulationMessagesLevelMap.value(0, 0);
+  if (mLevel > 0 && pSimulationMessage) {
+    mSimulationMessages.append(pSimulationMessage);
+  }
+  while (!mSimulationMessages.isEmpty()) {
+    SimulationMessage *pSimulationMessage = mSimulationMessages.takeLast();
+    mSimulationMessages.append(pSimulationMessage->mChildren);
+    delete pSimulationMessage;
+  }
 }
 
 /*!
-  Sets the new simulation output data and continues the parsing.
-  */
-void SimulationOutputHandler::parseSimulationOutput(QString output)
+ * \brief SimulationOutputParser::takeSimulationMessages
+ * Returns the completed top level messages and removes them from the parser.
+ * \param pEmbeddedServerInitialized - set to true if the embedded server initialized message is parsed since the last call.
+ * \return
+ */
+QList<SimulationMessage*> SimulationOutputParser::takeSimulationMessages(bool *pEmbeddedServerInitialized)
 {
-  mpXmlInputSource->setData(output);
-  mXmlSimpleReader.parseContinue();
+  QMutexLocker locker(&mSimulationMessagesMutex);
+  QList<SimulationMessage*> simulationMessages;
+  simulationMessages.swap(mSimulationMessages);
+  *pEmbeddedServerInitialized = mEmbeddedServerInitialized;
+  mEmbeddedServerInitialized = false;
+  return simulationMessages;
 }
 
 /*!
-  The reader calls this function when it has parsed a start element tag.
-  */
-bool SimulationOutputHandler::startElement(const QString &namespaceURI, const QString &localName, const QString &qName,
-                                           const QXmlAttributes &atts)
-{
-  Q_UNUSED(namespaceURI);
-  Q_UNUSED(localName);
-  if (qName == "message") {
-    if (mpSimulationOutputWidget->isOutputStructured()) {
-      mpSimulationMessage = new SimulationMessage(mpSimulationMessageModel->getRootSimulationMessage());
-    } else {
-      mpSimulationMessage = new SimulationMessage;
-    }
-    mpSimulationMessage->mStream = atts.value("stream");
-    mpSimulationMessage->mType = StringHandler::getSimulationMessageType(atts.value("type"));
+ * \brief SimulationOutputParser::startElement
+ * Called when a start element tag is parsed.
+ * \param pName
+ * \param nameLength
+ * \param pAttributes
+ * \param pEnd
+ * \param emptyElement
+ */
+void SimulationOutputParser::startElement(const char *pName, int nameLength, const char *pAttributes, const char *pEnd, bool emptyElement)
+{
+  Q_UNUSED(emptyElement);
+  if (isElementName(pName, nameLength, "message")) {
+    mpSimulationMessage = new SimulationMessage(mStructured ? mpRootSimulationMessage : 0);
+    mpSimulationMessage->mStream = attributeValue(pAttributes, pEnd, "stream");
+    mpSimulationMessage->mType = StringHandler::getSimulationMessageType(attributeValue(pAttributes, pEnd, "type"));
+    QString text = attributeValue(pAttributes, pEnd, "text");
     // check if we get the message about embedded opc-ua server initialized.
-    if (atts.value("text").compare("The embedded server is initialized.") == 0) {
-      mpSimulationOutputWidget->embeddedServerInitialized();
+    if (text.compare("The embedded server is initialized.") == 0) {
+      QMutexLocker locker(&mSimulationMessagesMutex);
+      mEmbeddedServerInitialized = true;
     }
-    if (mpSimulationOutputWidget->isOutputStructured()) {
-      mpSimulationMessage->mText = Qt::convertFromPlainText(atts.value("text"));
+    if (mStructured) {
+      mpSimulationMessage->mText = Qt::convertFromPlainText(text);
     } else {
-      mpSimulationMessage->mText = atts.value("text");
+      mpSimulationMessage->mText = text;
     }
     mpSimulationMessage->mLevel = mLevel;
     mSimulationMessagesLevelMap.insert(mLevel, mpSimulationMessage);
@@ -351,63 +526,308 @@ bool SimulationOutputHandler::startElement(const QString &namespaceURI, const QS
       }
     }
     mLevel++;
-  } else if (qName == "used") {
+  } else if (isElementName(pName, nameLength, "used")) {
     if (mpSimulationMessage) {
-      mpSimulationMessage->mIndex = atts.value("index");
+      mpSimulationMessage->mIndex = attributeValue(pAttributes, pEnd, "index");
     }
-  } else if (qName == "status") {
-    int progress = atts.value("progress").toInt();
-    mpSimulationOutputWidget->getProgressBar()->setValue(progress/100);
+  } else if (isElementName(pName, nameLength, "status")) {
+    mProgress.fetchAndStoreOrdered(attributeValue(pAttributes, pEnd, "progress").toInt());
   }
-  return true;
 }
 
 /*!
-  The reader calls this function when it has parsed a end element tag.
-  */
-bool SimulationOutputHandler::endElement(const QString &namespaceURI, const QString &localName, const QString &qName)
+ * \brief SimulationOutputParser::endElement
+ * Called when an end element tag is parsed.
+ * \param pName
+ * \param nameLength
+ */
+void SimulationOutputParser::endElement(const char *pName, int nameLength)
 {
-  Q_UNUSED(namespaceURI);
-  Q_UNUSED(localName);
-  if (qName == "message") {
+  if (isElementName(pName, nameLength, "message")) {
+    if (mLevel == 0) {
+      fatalError(tr("unexpected end tag %1").arg(QString::fromUtf8(pName, nameLength)));
+      return;
+    }
     mLevel--;
-    // if mLevel is 0 then we have finished the one complete top level message tag. Add it to SimulationMessageModel now.
+    // if mLevel is 0 then we have finished the one complete top level message tag.
     if (mLevel == 0) {
-      if (mpSimulationOutputWidget->isOutputStructured()) {
-        mpSimulationMessageModel->insertSimulationMessage(mSimulationMessagesLevelMap.value(0, 0));
-      } else {
-        mpSimulationOutputWidget->writeSimulationMessage(mSimulationMessagesLevelMap.value(0, 0));
-      }
+      appendSimulationMessage(mSimulationMessagesLevelMap.value(0, 0));
+      mpSimulationMessage = 0;
     }
   }
-  return true;
 }
 
 /*!
-  Reports a non-recoverable error. Details of the error are stored in exception.
-  */
-bool SimulationOutputHandler::fatalError(const QXmlParseException &exception)
-{
-  // read the error message
-  QString error = QString("Fatal error on line %1, column %2: %3")
-      .arg(exception.lineNumber())
-      .arg(exception.columnNumber())
-      .arg(exception.message());
-  // construct the SimulationMessage object with error
-  SimulationMessage *pSimulationMessage;
-  if (mpSimulationOutputWidget->isOutputStructured()) {
-    pSimulationMessage = new SimulationMessage(mpSimulationMessageModel->getRootSimulationMessage());
-  } else {
-    pSimulationMessage = new SimulationMessage;
-  }
+ * \brief SimulationOutputParser::fatalError
+ * Reports a non-recoverable error and stops parsing.
+ * \param message
+ */
+void SimulationOutputParser::fatalError(const QString &message)
+{
+  mFatalError = true;
+  SimulationMessage *pSimulationMessage = new SimulationMessage(mStructured ? mpRootSimulationMessage : 0);
   pSimulationMessage->mStream = "stderr";
   pSimulationMessage->mType = StringHandler::getSimulationMessageType("error");
-  pSimulationMessage->mText = error;
+  pSimulationMessage->mText = QString("Fatal error on line %1: %2").arg(mLineNumber).arg(message);
   pSimulationMessage->mLevel = 0;
+  appendSimulationMessage(pSimulationMessage);
+}
+
+/*!
+ * \brief SimulationOutputParser::appendSimulationMessage
+ * Adds the complete top level message to the list of messages waiting for the view.
+ * \param pSimulationMessage
+ */
+void SimulationOutputParser::appendSimulationMessage(SimulationMessage *pSimulationMessage)
+{
+  if (pSimulationMessage) {
+    QMutexLocker locker(&mSimulationMessagesMutex);
+    mSimulationMessages.append(pSimulationMessage);
+  }
+}
+
+/*!
+ * \brief SimulationOutputParser::parseSimulationOutput
+ * Slot activated when SimulationOutputHandler sendSimulationOutput signal is raised.\n
+ * Parses all the complete tags of the received output.
+ * \param output
+ */
+void SimulationOutputParser::parseSimulationOutput(QByteArray output)
+{
+  if (mFatalError) {
+    return;
+  }
+  if (mBuffer.isEmpty()) {
+    mBuffer = output;
+  } else {
+    mBuffer.append(output);
+  }
+  const char *pData = mBuffer.constData();
+  const char *pEnd = pData + mBuffer.size();
+  const char *p = pData;
+  while (p < pEnd && !mFatalError) {
+    const char *pTagStart = static_cast<const char*>(memchr(p, '<', pEnd - p));
+    if (!pTagStart) {
+      mLineNumber += std::count(p, pEnd, '\n');
+      p = pEnd;
+      break;
+    }
+    mLineNumber += std::count(p, pTagStart, '\n');
+    p = pTagStart;
+    // skip the comments
+    if (pEnd - pTagStart >= 4 && qstrncmp(pTagStart, "<!--", 4) == 0) {
+      static const char commentEnd[] = "-->";
+      const char *pCommentEnd = std::search(pTagStart + 4, pEnd, commentEnd, commentEnd + 3);
+      if (pCommentEnd == pEnd) {
+        break;
+      }
+      mLineNumber += std::count(pTagStart, pCommentEnd, '\n');
+      p = pCommentEnd + 3;
+      continue;
+    }
+    // find the end of tag, the attribute values may contain >.
+    const char *pTagEnd = 0;
+    char quote = 0;
+    for (const char *q = pTagStart + 1 ; q < pEnd ; ++q) {
+      if (quote) {
+        if (*q == quote) {
+          quote = 0;
+        }
+      } else if (*q == '"' || *q == '\'') {
+        quote = *q;
+      } else if (*q == '>') {
+        pTagEnd = q;
+        break;
+      }
+    }
+    // the tag is not complete yet. Wait for more output.
+    if (!pTagEnd) {
+      break;
+    }
+    const char *pName = pTagStart + 1;
+    if (*pName == '/') {
+      pName++;
+      const char *pNameEnd = pName;
+      while (pNameEnd < pTagEnd && !isXmlSpace(*pNameEnd)) {
+        ++pNameEnd;
+      }
+      endElement(pName, pNameEnd - pName);
+    } else if (*pName != '?' && *pName != '!') {
+      const bool emptyElement = *(pTagEnd - 1) == '/';
+      const char *pAttributesEnd = emptyElement ? pTagEnd - 1 : pTagEnd;
+      const char *pNameEnd = pName;
+      while (pNameEnd < pAttributesEnd && !isXmlSpace(*pNameEnd)) {
+        ++pNameEnd;
+      }
+      startElement(pName, pNameEnd - pName, pNameEnd, pAttributesEnd, emptyElement);
+      if (emptyElement) {
+        endElement(pName, pNameEnd - pName);
+      }
+    }
+    mLineNumber += std::count(pTagStart, pTagEnd, '\n');
+    p = pTagEnd + 1;
+  }
+  // keep only the incomplete tag
+  if (p == pEnd || mFatalError) {
+    mBuffer.clear();
+  } else {
+    mBuffer.remove(0, p - pData);
+  }
+  emit simulationMessagesParsed();
+}
+
+/*!
+  \class SimulationOutputHandler
+  \brief Parses the xml output of simulation executable.
+  The parsing is done by SimulationOutputParser in a worker thread and the parsed messages are added to the view in batches.
+  */
+/*
+  <message stream="LOG_STATS" type="info" text="events">
+    <message stream="LOG_STATS" type="info" text="    0 state events" />
+    <message stream="LOG_STATS" type="info" text="    0 time events" />
+  </message>
+  <message stream="stdout" type="info" text="output text">
+    <used index="2" />
+  </message>
+  */
+/*!
+  \param pSimulationOutputWidget - a pointer to SimulationOutputWidget.
+  */
+SimulationOutputHandler::SimulationOutputHandler(SimulationOutputWidget *pSimulationOutputWidget)
+  : QObject(0)
+{
+  mpSimulationOutputWidget = pSimulationOutputWidget;
   if (mpSimulationOutputWidget->isOutputStructured()) {
-    mpSimulationMessageModel->insertSimulationMessage(pSimulationMessage);
+    mpSimulationMessageModel = new SimulationMessageModel(mpSimulationOutputWidget);
   } else {
-    mpSimulationOutputWidget->writeSimulationMessage(pSimulationMessage);
+    mpSimulationMessageModel = 0;
+  }
+  mOutputSize = OptionsDialog::instance()->getSimulationPage()->getOutputSizeSpinBox()->value();
+  mSaveRemovedOutput = OptionsDialog::instance()->getSimulationPage()->getSaveRemovedOutputCheckBox()->isChecked();
+  mpSimulationOutputParser = new SimulationOutputParser(mpSimulationOutputWidget->isOutputStructured(),
+                                                        mpSimulationMessageModel ? mpSimulationMessageModel->getRootSimulationMessage() : 0);
+  mpSimulationOutputParser->moveToThread(&mParserThread);
+  connect(this, SIGNAL(sendSimulationOutput(QByteArray)), mpSimulationOutputParser, SLOT(parseSimulationOutput(QByteArray)));
+  connect(mpSimulationOutputParser, SIGNAL(simulationMessagesParsed()), SLOT(simulationMessagesParsed()));
+  mFlushTimer.setSingleShot(true);
+  mFlushTimer.setInterval(SIMULATION_OUTPUT_FLUSH_INTERVAL);
+  connect(&mFlushTimer, SIGNAL(timeout()), SLOT(flushSimulationMessages()));
+  mParserThread.start();
+}
+
+SimulationOutputHandler::~SimulationOutputHandler()
+{
+  mParserThread.quit();
+  mParserThread.wait();
+  delete mpSimulationOutputParser;
+}
+
+/*!
+ * \brief SimulationOutputHandler::parseSimulationOutput
+ * Sends the simulation output to the parser thread.
+ * \param output
+ */
+void SimulationOutputHandler::parseSimulationOutput(const QByteArray &output)
+{
+  emit sendSimulationOutput(output);
+}
+
+/*!
+ * \brief SimulationOutputHandler::saveRemovedSimulationMessages
+ * Appends the messages removed from the output window to the <outputFileName>_output.log in the simulation directory.
+ * \param simulationMessages
+ */
+void SimulationOutputHandler::saveRemovedSimulationMessages(const QList<SimulationMessage*> &simulationMessages)
+{
+  SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+  QFile file(QString("%1/%2_output.log").arg(simulationOptions.getWorkingDirectory()).arg(simulationOptions.getOutputFileName()));
+  if (file.open(QIODevice::Append | QIODevice::Text)) {
+    QTextStream textStream(&file);
+    textStream.setCodec(Helper::utf8.toStdString().data());
+    foreach (SimulationMessage *pSimulationMessage, simulationMessages) {
+      saveRemovedSimulationMessage(textStream, pSimulationMessage);
+    }
+    file.close();
+  }
+}
+
+/*!
+ * \brief SimulationOutputHandler::saveRemovedSimulationMessage
+ * Writes the message and its children to the text stream.
+ * \param textStream
+ * \param pSimulationMessage
+ */
+void SimulationOutputHandler::saveRemovedSimulationMessage(QTextStream &textStream, SimulationMessage *pSimulationMessage)
+{
+  textStream << pSimulationMessage->mStream << "\t| " << StringHandler::getSimulationMessageTypeString(pSimulationMessage->mType) << "\t| ";
+  for (int i = 0 ; i < pSimulationMessage->mLevel ; ++i) {
+    textStream << "| ";
+  }
+  textStream << QTextDocumentFragment::fromHtml(pSimulationMessage->mText).toPlainText() << "\n";
+  foreach (SimulationMessage *pChildSimulationMessage, pSimulationMessage->mChildren) {
+    saveRemovedSimulationMessage(textStream, pChildSimulationMessage);
+  }
+}
+
+/*!
+ * \brief SimulationOutputHandler::deleteSimulationMessage
+ * Deletes the message and its children.
+ * \param pSimulationMessage
+ */
+void SimulationOutputHandler::deleteSimulationMessage(SimulationMessage *pSimulationMessage)
+{
+  foreach (SimulationMessage *pChildSimulationMessage, pSimulationMessage->mChildren) {
+    deleteSimulationMessage(pChildSimulationMessage);
+  }
+  delete pSimulationMessage;
+}
+
+/*!
+ * \brief SimulationOutputHandler::simulationMessagesParsed
+ * Slot activated when SimulationOutputParser simulationMessagesParsed signal is raised.\n
+ * Schedules the update of the view.
+ */
+void SimulationOutputHandler::simulationMessagesParsed()
+{
+  if (!mFlushTimer.isActive()) {
+    mFlushTimer.start();
+  }
+}
+
+/*!
+ * \brief SimulationOutputHandler::flushSimulationMessages
+ * Slot activated when mFlushTimer timeout signal is raised.\n
+ * Adds the parsed messages to the view in one batch and removes the oldest messages when the output size is limited.
+ */
+void SimulationOutputHandler::flushSimulationMessages()
+{
+  bool embeddedServerInitialized = false;
+  QList<SimulationMessage*> simulationMessages = mpSimulationOutputParser->takeSimulationMessages(&embeddedServerInitialized);
+  int progress = mpSimulationOutputParser->takeProgress();
+  if (progress >= 0) {
+    mpSimulationOutputWidget->getProgressBar()->setValue(progress/100);
+  }
+  if (!simulationMessages.isEmpty()) {
+    if (mpSimulationMessageModel) {
+      mpSimulationMessageModel->insertSimulationMessages(simulationMessages);
+      int count = mpSimulationMessageModel->getRootSimulationMessage()->children().size();
+      if (mOutputSize > 0 && count > mOutputSize) {
+        QList<SimulationMessage*> removedSimulationMessages = mpSimulationMessageModel->removeSimulationMessages(count - mOutputSize);
+        if (mSaveRemovedOutput) {
+          saveRemovedSimulationMessages(removedSimulationMessages);
+        }
+        foreach (SimulationMessage *pSimulationMessage, removedSimulationMessages) {
+          deleteSimulationMessage(pSimulationMessage);
+        }
+      }
+    } else {
+      foreach (SimulationMessage *pSimulationMessage, simulationMessages) {
+        mpSimulationOutputWidget->writeSimulationMessage(pSimulationMessage);
+        deleteSimulationMessage(pSimulationMessage);
+      }
+    }
+  }
+  if (embeddedServerInitialized) {
+    mpSimulationOutputWidget->embeddedServerInitialized();
   }
-  return false;
 }
@@ -36,7 +36,9 @@
 
 #include "Simulation/SimulationOutputWidget.h"
 
-#include <QXmlDefaultHandler>
+#include <QThread>
+#include <QMutex>
+#include <QTimer>
 
 class SimulationMessage
 {
@@ -80,6 +82,8 @@ public:
   SimulationMessage* getRootSimulationMessage() {return mpRootSimulationMessage;}
   int getDepth(const QModelIndex &index) const;
   void insertSimulationMessage(SimulationMessage *pSimulationMessage);
+  void insertSimulationMessages(QList<SimulationMessage*> simulationMessages);
+  QList<SimulationMessage*> removeSimulationMessages(int count);
   void callLayoutChanged();
   QModelIndexList selectedRows();
   QModelIndex simulationMessageIndex(const SimulationMessage *pSimulationMessage) const;
@@ -93,25 +97,63 @@ private:
                                            const QModelIndex &parentIndex) const;
 };
 
-class SimulationOutputHandler : private QXmlDefaultHandler
+class SimulationOutputParser : public QObject
 {
+  Q_OBJECT
+public:
+  SimulationOutputParser(bool structured, SimulationMessage *pRootSimulationMessage);
+  ~SimulationOutputParser();
+  QList<SimulationMessage*> takeSimulationMessages(bool *pEmbeddedServerInitialized);
+  int takeProgress() {return mProgress.fetchAndStoreOrdered(-1);}
 private:
-  SimulationOutputWidget *mpSimulationOutputWidget;
+  bool mStructured;
+  SimulationMessage *mpRootSimulationMessage;
+  QByteArray mBuffer;
+  int mLineNumber;
+  bool mFatalError;
   int mLevel;
-  SimulationMessage* mpSimulationMessage;
+  SimulationMessage *mpSimulationMessage;
   QMap<int, SimulationMessage*> mSimulationMessagesLevelMap;
-  SimulationMessageModel *mpSimulationMessageModel;
-  QXmlSimpleReader mXmlSimpleReader;
-  QXmlInputSource *mpXmlInputSource;
+  QMutex mSimulationMessagesMutex;
+  QList<SimulationMessage*> mSimulationMessages;
+  bool mEmbeddedServerInitialized;
+  QAtomicInt mProgress;
+
+  void startElement(const char *pName, int nameLength, const char *pAttributes, const char *pEnd, bool emptyElement);
+  void endElement(const char *pName, int nameLength);
+  void fatalError(const QString &message);
+  void appendSimulationMessage(SimulationMessage *pSimulationMessage);
+public slots:
+  void parseSimulationOutput(QByteArray output);
+signals:
+  void simulationMessagesParsed();
+};
 
-  bool startElement(const QString &namespaceURI, const QString &localName, const QString &qName, const QXmlAttributes &atts);
-  bool endElement(const QString &namespaceURI, const QString &localName, const QString &qName);
-  bool fatalError(const QXmlParseException &exception);
+class SimulationOutputHandler : public QObject
+{
+  Q_OBJECT
 public:
-  SimulationOutputHandler(SimulationOutputWidget *pSimulationOutputWidget, QString simulationOutput);
+  SimulationOutputHandler(SimulationOutputWidget *pSimulationOutputWidget);
   ~SimulationOutputHandler();
   SimulationMessageModel* getSimulationMessageModel() {return mpSimulationMessageModel;}
-  void parseSimulationOutput(QString output);
+  void parseSimulationOutput(const QByteArray &output);
+private:
+  SimulationOutputWidget *mpSimulationOutputWidget;
+  SimulationMessageModel *mpSimulationMessageModel;
+  QThread mParserThread;
+  SimulationOutputParser *mpSimulationOutputParser;
+  QTimer mFlushTimer;
+  int mOutputSize;
+  bool mSaveRemovedOutput;
+
+  void saveRemovedSimulationMessages(const QList<SimulationMessage*> &simulationMessages);
+  void saveRemovedSimulationMessage(QTextStream &textStream, SimulationMessage *pSimulationMessage);
+  void deleteSimulationMessage(SimulationMessage *pSimulationMessage);
+signals:
+  void sendSimulationOutput(QByteArray output);
+public slots:
+  void simulationMessagesParsed();
+  void flushSimulationMessages();
 };
 
 #endif // SIMULATIONOUTPUTHANDLER_H
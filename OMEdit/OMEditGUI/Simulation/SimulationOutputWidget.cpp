@@ -41,7 +41,11 @@
 #include "Editors/TextEditor.h"
 #include "SimulationProcessThread.h"
 #include "SimulationDialog.h"
+#include "SimulationJobScheduler.h"
 #include "TransformationalDebugger/TransformationsWidget.h"
+#include "Plotting/LiveResultReader.h"
+#include "Plotting/VariablesWidget.h"
+#include "Plotting/PlotWindowContainer.h"
 
 #include <QApplication>
 #include <QObject>
@@ -231,6 +235,8 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
     mpSimulationOutputTextBrowser->setOpenLinks(false);
     mpSimulationOutputTextBrowser->setOpenExternalLinks(false);
     connect(mpSimulationOutputTextBrowser, SIGNAL(anchorClicked(QUrl)), SLOT(openTransformationBrowser(QUrl)));
+    // limit the number of lines kept in the formatted text output
+    mpSimulationOutputTextBrowser->document()->setMaximumBlockCount(OptionsDialog::instance()->getSimulationPage()->getOutputSizeSpinBox()->value());
     // simulation output tree
     mpSimulationOutputTree = 0;
     mpGeneratedFilesTabWidget->addTab(mpSimulationOutputTextBrowser, Helper::output);
@@ -361,10 +367,10 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
   // create the ArchivedSimulationItem
   mpArchivedSimulationItem = new ArchivedSimulationItem(mSimulationOptions, this);
   MainWindow::instance()->getSimulationDialog()->getArchivedSimulationsTreeWidget()->addTopLevelItem(mpArchivedSimulationItem);
-  // start the tcp server
+  // create the tcp server. It starts listening when the job is started so queued jobs don't hold the sockets.
   mpTcpServer = new QTcpServer;
   mSocketDisconnected = true;
-  mpTcpServer->listen(QHostAddress(QHostAddress::LocalHost));
+  mpLiveResultReader = 0;
   connect(mpTcpServer, SIGNAL(newConnection()), SLOT(createSimulationProgressSocket()));
   // create the thread
   mpSimulationProcessThread = new SimulationProcessThread(this);
@@ -377,7 +383,11 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
           SLOT(writeSimulationOutput(QString,StringHandler::SimulationMessageType,bool)));
   connect(mpSimulationProcessThread, SIGNAL(sendSimulationFinished(int,QProcess::ExitStatus)),
           SLOT(simulationProcessFinished(int,QProcess::ExitStatus)));
-  mpSimulationProcessThread->start();
+  // queue the job. SimulationJobScheduler starts it when a slot is free.
+  mpProgressLabel->setText(tr("<b>%1</b> is queued. Waiting for the running simulations to finish.").arg(mSimulationOptions.getClassName()));
+  mpCancelButton->setEnabled(true);
+  mpArchivedSimulationItem->setStatus(Helper::queued);
+  MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->addJob(this);
 }
 
 SimulationOutputWidget::~SimulationOutputWidget()
@@ -386,6 +396,7 @@ SimulationOutputWidget::~SimulationOutputWidget()
   if (OptionsDialog::instance()->getSimulationPage()->getDeleteEntireSimulationDirectoryCheckBox()->isChecked()) {
     Utilities::removeDirectoryRecursivly(mSimulationOptions.getWorkingDirectory());
   }
+  MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->removeJob(this);
   if (mpSimulationOutputHandler) {
     delete mpSimulationOutputHandler;
   }
@@ -465,6 +476,57 @@ void SimulationOutputWidget::embeddedServerInitialized()
   MainWindow::instance()->getSimulationDialog()->createOpcUaClient(mSimulationOptions);
 }
 
+/*!
+ * \brief SimulationOutputWidget::startCompilation
+ * Called by SimulationJobScheduler when a compilation slot is free.\n
+ * Starts the SimulationProcessThread which compiles the model.
+ * \param numberOfProcessors - the number of processors used by the compilation.
+ */
+void SimulationOutputWidget::startCompilation(int numberOfProcessors)
+{
+  mpSimulationProcessThread->setNumberOfProcessors(numberOfProcessors);
+  mpArchivedSimulationItem->setStatus(Helper::running);
+  if (!mpTcpServer->isListening()) {
+    mpTcpServer->listen(QHostAddress(QHostAddress::LocalHost));
+  }
+  mpSimulationProcessThread->start();
+}
+
+/*!
+ * \brief SimulationOutputWidget::startSimulation
+ * Called by SimulationJobScheduler when a simulation slot is free.\n
+ * Runs the simulation executable. The executable is reused when the model is not compiled by this job.
+ */
+void SimulationOutputWidget::startSimulation()
+{
+  mpArchivedSimulationItem->setStatus(Helper::running);
+  if (!mpTcpServer->isListening()) {
+    mpTcpServer->listen(QHostAddress(QHostAddress::LocalHost));
+  }
+  if (mpSimulationProcessThread->isRunning()) {
+    mpSimulationProcessThread->startQueuedSimulation();
+  } else {
+    mpSimulationProcessThread->setRunExecutableOnly(true);
+    mpSimulationProcessThread->start();
+  }
+}
+
+/*!
+ * \brief SimulationOutputWidget::sharedCompilationFailed
+ * Called by SimulationJobScheduler when the compilation this job was waiting for failed.
+ */
+void SimulationOutputWidget::sharedCompilationFailed()
+{
+  mpProgressLabel->setText(tr("Compilation of <b>%1</b> failed.").arg(mSimulationOptions.getClassName()));
+  mpProgressBar->setRange(0, 1);
+  mpProgressBar->setValue(1);
+  mpCancelButton->setEnabled(false);
+  mpArchivedSimulationItem->setStatus(Helper::finished);
+  if (mSimulationOptions.isParameterSweepRun()) {
+    MainWindow::instance()->getSimulationDialog()->parameterSweepRunFinished(mSimulationOptions, mResultFileLastModifiedDateTime, false);
+  }
+}
+
 /*!
  * \brief SimulationOutputWidget::deleteIntermediateCompilationFiles
  * Deletes the intermediate compilation files
@@ -492,6 +554,22 @@ void SimulationOutputWidget::deleteIntermediateCompilationFiles()
   }
 }
 
+/*!
+ * \brief SimulationOutputWidget::parseSimulationOutput
+ * Sends the xml simulation output to the SimulationOutputHandler. Creates the handler on first output.
+ * \param output
+ */
+void SimulationOutputWidget::parseSimulationOutput(const QByteArray &output)
+{
+  if (!mpSimulationOutputHandler) {
+    mpSimulationOutputHandler = new SimulationOutputHandler(this);
+    if (isOutputStructured()) {
+      mpSimulationOutputTree->setModel(mpSimulationOutputHandler->getSimulationMessageModel());
+    }
+  }
+  mpSimulationOutputHandler->parseSimulationOutput(output);
+}
+
 /*!
  * \brief SimulationOutputWidget::createSimulationProgressSocket
  * Slot activated when QTcpServer newConnection SIGNAL is raised.\n
@@ -521,9 +599,11 @@ void SimulationOutputWidget::readSimulationProgress()
   if (sender()) {
     QTcpSocket *pTcpSocket = qobject_cast<QTcpSocket*>(const_cast<QObject*>(sender()));
     if (pTcpSocket) {
-      QString output = QString(pTcpSocket->readAll());
+      QByteArray output = pTcpSocket->readAll();
       if (!output.isEmpty()) {
-        writeSimulationOutput(output, StringHandler::Unknown, false);
+        mpGeneratedFilesTabWidget->setTabEnabled(0, true);
+        parseSimulationOutput(output);
+        mpGeneratedFilesTabWidget->setCurrentIndex(0);
       }
     }
   }
@@ -592,6 +672,20 @@ void SimulationOutputWidget::compilationProcessFinished(int exitCode, QProcess::
     MainWindow::instance()->getSimulationDialog()->showAlgorithmicDebugger(mSimulationOptions);
   }
   mpArchivedSimulationItem->setStatus(Helper::finished);
+  // free the compilation slot and queue the simulation
+  bool successful = exitStatus == QProcess::NormalExit && exitCode == 0;
+  SimulationJobScheduler *pSimulationJobScheduler = MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler();
+  pSimulationJobScheduler->compilationFinished(this, successful, successful && !mSimulationOptions.getBuildOnly()
+                                               && !mSimulationOptions.getLaunchAlgorithmicDebugger());
+  if (!successful && mSimulationOptions.isParameterSweepRun()) {
+    MainWindow::instance()->getSimulationDialog()->parameterSweepRunFinished(mSimulationOptions, mResultFileLastModifiedDateTime, false);
+  }
+  if (pSimulationJobScheduler->isJobQueued(this)) {
+    mpProgressLabel->setText(tr("<b>%1</b> is queued. Waiting for the running simulations to finish.").arg(mSimulationOptions.getClassName()));
+    mpCancelButton->setText(Helper::cancelSimulation);
+    mpCancelButton->setEnabled(true);
+    mpArchivedSimulationItem->setStatus(Helper::queued);
+  }
   // remove the generated files
   if (mSimulationOptions.getBuildOnly()) {
     deleteIntermediateCompilationFiles();
@@ -617,6 +711,14 @@ void SimulationOutputWidget::simulationProcessStarted()
   // save the current datetime as last modified datetime for result file.
   mResultFileLastModifiedDateTime = QDateTime::currentDateTime();
   mpArchivedSimulationItem->setStatus(Helper::running);
+  // follow the result file and plot the checked variables while simulating.
+  if (mSimulationOptions.getPlotResultsWhileSimulating() && mSimulationOptions.getFullResultFileName().endsWith(".csv")) {
+    mpLiveResultReader = new LiveResultReader(mSimulationOptions, this);
+  }
+  // the executable is built so the other runs of the parameter sweep can use it.
+  if (mSimulationOptions.isParameterSweepRun()) {
+    MainWindow::instance()->getSimulationDialog()->startParameterSweepRuns(mSimulationOptions);
+  }
 }
 
 /*!
@@ -641,12 +743,7 @@ void SimulationOutputWidget::writeSimulationOutput(QString output, StringHandler
           .arg(StringHandler::getSimulationMessageTypeString(type))
           .arg(escaped);
     }
-    if (!mpSimulationOutputHandler) {
-      mpSimulationOutputHandler = new SimulationOutputHandler(this, output);
-      mpSimulationOutputTree->setModel(mpSimulationOutputHandler->getSimulationMessageModel());
-    } else {
-      mpSimulationOutputHandler->parseSimulationOutput(output);
-    }
+    parseSimulationOutput(output.toUtf8());
   } else {
     /* move the cursor down before adding to the logger. */
     QTextCursor textCursor = mpSimulationOutputTextBrowser->textCursor();
@@ -659,10 +756,8 @@ void SimulationOutputWidget::writeSimulationOutput(QString output, StringHandler
     /* append the output */
     if (textFormat) {
       mpSimulationOutputTextBrowser->insertPlainText(output + "\n");
-    } else if (!mpSimulationOutputHandler) {
-      mpSimulationOutputHandler = new SimulationOutputHandler(this, output);
     } else {
-      mpSimulationOutputHandler->parseSimulationOutput(output);
+      parseSimulationOutput(output.toUtf8());
     }
     /* move the cursor */
     textCursor.movePosition(QTextCursor::End);
@@ -681,12 +776,36 @@ void SimulationOutputWidget::writeSimulationOutput(QString output, StringHandler
  */
 void SimulationOutputWidget::simulationProcessFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
-  Q_UNUSED(exitCode);
-  Q_UNUSED(exitStatus);
+  MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->simulationFinished(this);
   mpProgressLabel->setText(tr("Simulation of <b>%1</b> is finished.").arg(mSimulationOptions.getClassName()));
   mpProgressBar->setValue(mpProgressBar->maximum());
   mpCancelButton->setEnabled(false);
+  // the runs of a parameter sweep are collected by the sweep and loaded together once all runs are finished.
+  if (mSimulationOptions.isParameterSweepRun()) {
+    mpArchivedSimulationItem->setStatus(Helper::finished);
+    MainWindow::instance()->getSimulationDialog()->parameterSweepRunFinished(mSimulationOptions, mResultFileLastModifiedDateTime,
+                                                                             exitStatus == QProcess::NormalExit && exitCode == 0);
+    return;
+  }
+  // stop following the result file and plot the variables checked during the simulation from the complete result file.
+  QStringList livePlottedVariables;
+  if (mpLiveResultReader) {
+    livePlottedVariables = mpLiveResultReader->getPlottedVariables();
+    delete mpLiveResultReader;
+    mpLiveResultReader = 0;
+  }
   MainWindow::instance()->getSimulationDialog()->simulationProcessFinished(mSimulationOptions, mResultFileLastModifiedDateTime);
+  if (!livePlottedVariables.isEmpty()) {
+    VariablesTreeModel *pVariablesTreeModel = MainWindow::instance()->getVariablesWidget()->getVariablesTreeModel();
+    MainWindow::instance()->getPlotWindowContainer()->addPlotWindow();
+    foreach (QString variable, livePlottedVariables) {
+      VariablesTreeItem *pVariablesTreeItem = pVariablesTreeModel->findVariablesTreeItem(mSimulationOptions.getFullResultFileName() + "." + variable,
+                                                                                         pVariablesTreeModel->getRootVariablesTreeItem());
+      if (pVariablesTreeItem) {
+        pVariablesTreeModel->setData(pVariablesTreeModel->variablesTreeItemIndex(pVariablesTreeItem), Qt::Checked, Qt::CheckStateRole);
+      }
+    }
+  }
   mpArchivedSimulationItem->setStatus(Helper::finished);
   // remove the generated files
   if (!mSimulationOptions.getBuildOnly()) {
@@ -716,6 +835,17 @@ void SimulationOutputWidget::cancelCompilationOrSimulation()
     mpProgressBar->setValue(mpProgressBar->maximum());
     mpCancelButton->setEnabled(false);
     mpArchivedSimulationItem->setStatus(Helper::finished);
+  } else if (MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->isJobQueued(this)) {
+    MainWindow::instance()->getSimulationDialog()->getSimulationJobScheduler()->removeJob(this);
+    mpSimulationProcessThread->cancelQueuedSimulation();
+    mpProgressLabel->setText(tr("Simulation of <b>%1</b> is cancelled.").arg(mSimulationOptions.getClassName()));
+    mpProgressBar->setRange(0, 1);
+    mpProgressBar->setValue(1);
+    mpCancelButton->setEnabled(false);
+    mpArchivedSimulationItem->setStatus(Helper::finished);
+    if (mSimulationOptions.isParameterSweepRun()) {
+      MainWindow::instance()->getSimulationDialog()->parameterSweepRunFinished(mSimulationOptions, mResultFileLastModifiedDateTime, false);
+    }
   }
 }
 
@@ -52,6 +52,7 @@ class SimulationOutputHandler;
 class SimulationOutputWidget;
 class SimulationMessage;
 class ArchivedSimulationItem;
+class LiveResultReader;
 
 class SimulationOutputTree : public QTreeView
 {
@@ -93,6 +94,9 @@ public:
   void addGeneratedFileTab(QString fileName);
   void writeSimulationMessage(SimulationMessage *pSimulationMessage);
   void embeddedServerInitialized();
+  void startCompilation(int numberOfProcessors);
+  void startSimulation();
+  void sharedCompilationFailed();
 private:
   SimulationOptions mSimulationOptions;
   Label *mpProgressLabel;
@@ -112,8 +116,10 @@ private:
   bool mSocketDisconnected;
   SimulationProcessThread *mpSimulationProcessThread;
   QDateTime mResultFileLastModifiedDateTime;
+  LiveResultReader *mpLiveResultReader;
 
   void deleteIntermediateCompilationFiles();
+  void parseSimulationOutput(const QByteArray &output);
 public slots:
   void createSimulationProgressSocket();
   void readSimulationProgress();
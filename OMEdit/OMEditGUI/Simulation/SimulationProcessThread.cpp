@@ -33,6 +33,7 @@
 
 #include "SimulationProcessThread.h"
 #include "Options/OptionsDialog.h"
+#include "Simulation/CompilationCache.h"
 
 #include <QDir>
 
@@ -45,6 +46,18 @@ SimulationProcessThread::SimulationProcessThread(SimulationOutputWidget *pSimula
   mpSimulationProcess = 0;
   setSimulationProcessKilled(false);
   mIsSimulationProcessRunning = false;
+  mNumberOfProcessors = 0;
+  mRunExecutableOnly = false;
+}
+
+/*!
+ * \brief SimulationProcessThread::cancelQueuedSimulation
+ * Wakes up the thread waiting for a simulation slot without running the simulation executable.
+ */
+void SimulationProcessThread::cancelQueuedSimulation()
+{
+  setSimulationProcessKilled(true);
+  mSimulationSemaphore.release();
 }
 
 /*!
@@ -53,7 +66,7 @@ SimulationProcessThread::SimulationProcessThread(SimulationOutputWidget *pSimula
  */
 void SimulationProcessThread::run()
 {
-  if (!mpSimulationOutputWidget->getSimulationOptions().isReSimulate()) {
+  if (!mpSimulationOutputWidget->getSimulationOptions().isReSimulate() && !mRunExecutableOnly) {
     compileModel();
   } else {
     runSimulationExecutable();
@@ -82,12 +95,21 @@ void SimulationProcessThread::compileModel()
 #endif
   connect(mpCompilationProcess, SIGNAL(finished(int,QProcess::ExitStatus)), SLOT(compilationProcessFinished(int,QProcess::ExitStatus)), Qt::DirectConnection);
   QString numProcs;
-  if (simulationOptions.getNumberOfProcessors() == 0) {
-    numProcs = QString::number(simulationOptions.getNumberOfProcessors());
+  if (mNumberOfProcessors > 0) {
+    numProcs = QString::number(mNumberOfProcessors);
   } else {
     numProcs = QString::number(simulationOptions.getNumberOfProcessors());
   }
   SimulationPage *pSimulationPage = OptionsDialog::instance()->getSimulationPage();
+  // skip the compilation if the same generated code is already built.
+  QString compilationCacheKey = CompilationCache::key(simulationOptions);
+  if (!compilationCacheKey.isEmpty() && CompilationCache::restore(compilationCacheKey, simulationOptions)) {
+    emit sendCompilationStarted();
+    emit sendCompilationOutput(tr("The generated code is unchanged. Using the cached executable.\n"), Qt::blue);
+    compilationProcessFinished(0, QProcess::NormalExit);
+    return;
+  }
+  mCompilationCacheKey = compilationCacheKey;
   QStringList args;
 #ifdef WIN32
 #if defined(__MINGW32__) && defined(__MINGW64__) /* on 64 bit */
@@ -214,11 +236,16 @@ void SimulationProcessThread::compilationProcessFinished(int exitCode, QProcess:
   QString exitCodeStr = tr("Compilation process failed. Exited with code %1.").arg(exitCode);
   if (exitStatus == QProcess::NormalExit && exitCode == 0) {
     emit sendCompilationOutput(tr("Compilation process finished successfully."), Qt::blue);
+    CompilationCache::store(mCompilationCacheKey, mpSimulationOutputWidget->getSimulationOptions());
     emit sendCompilationFinished(exitCode, exitStatus);
     // if not build only and launch the algorithmic debugger is false then run the simulation process.
     SimulationOptions simulationOptions = mpSimulationOutputWidget->getSimulationOptions();
+    // wait until SimulationJobScheduler gives a simulation slot.
     if (!simulationOptions.getBuildOnly() && !simulationOptions.getLaunchAlgorithmicDebugger()) {
-      runSimulationExecutable();
+      mSimulationSemaphore.acquire();
+      if (!isSimulationProcessKilled()) {
+        runSimulationExecutable();
+      }
     }
   } else if (mpCompilationProcess->error() == QProcess::UnknownError) {
     emit sendCompilationOutput(exitCodeStr, Qt::red);
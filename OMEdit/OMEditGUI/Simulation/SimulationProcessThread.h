@@ -38,6 +38,7 @@
 #include "Util/StringHandler.h"
 
 #include <QThread>
+#include <QSemaphore>
 
 class SimulationOutputWidget;
 class SimulationProcessThread : public QThread
@@ -53,6 +54,10 @@ public:
   void setSimulationProcessKilled(bool killed) {mIsSimulationProcessKilled = killed;}
   bool isSimulationProcessKilled() {return mIsSimulationProcessKilled;}
   bool isSimulationProcessRunning() {return mIsSimulationProcessRunning;}
+  void setNumberOfProcessors(int numberOfProcessors) {mNumberOfProcessors = numberOfProcessors;}
+  void setRunExecutableOnly(bool runExecutableOnly) {mRunExecutableOnly = runExecutableOnly;}
+  void startQueuedSimulation() {mSimulationSemaphore.release();}
+  void cancelQueuedSimulation();
 protected:
   virtual void run();
 private:
@@ -63,6 +68,10 @@ private:
   QProcess *mpSimulationProcess;
   bool mIsSimulationProcessKilled;
   bool mIsSimulationProcessRunning;
+  int mNumberOfProcessors;
+  bool mRunExecutableOnly;
+  QSemaphore mSimulationSemaphore;
+  QString mCompilationCacheKey;
 
   void compileModel();
   void runSimulationExecutable();
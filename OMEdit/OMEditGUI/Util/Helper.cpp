@@ -62,6 +62,8 @@ QString Helper::exeFileTypes = "EXE Files (*.exe)";
 QString Helper::exeFileTypes = "Executable files (*)";
 #endif
 QString Helper::txtFileTypes = "TXT Files (*.txt)";
+QString Helper::csvFileTypes = "CSV Files (*.csv)";
+QString Helper::jsonFileTypes = "JSON Files (*.json)";
 QString Helper::figaroFileTypes = "Figaro Files (*.fi)";
 QString Helper::visualizationFileTypes = "Visualization Files (*.mat *.csv *.fmu);;Visualization MAT(*.mat);;Visualization CSV(*.csv);;Visualization FMU(*.fmu)";
 QString Helper::omsFileTypes = "Composite Model Files (*.ssp)";
@@ -375,6 +377,7 @@ QString Helper::addBusConnection;
 QString Helper::editBusConnection;
 QString Helper::addTLMConnection;
 QString Helper::editTLMConnection;
+QString Helper::queued;
 QString Helper::running;
 QString Helper::finished;
 QString Helper::newVariable;
@@ -667,6 +670,7 @@ void Helper::initHelperVariables()
   Helper::editBusConnection = tr("Edit Bus Connection");
   Helper::addTLMConnection = tr("Add TLM Connection");
   Helper::editTLMConnection = tr("Edit TLM Connection");
+  Helper::queued = tr("Queued");
   Helper::running = tr("Running");
   Helper::finished = tr("Finished");
   Helper::newVariable = tr("<New Variable>");
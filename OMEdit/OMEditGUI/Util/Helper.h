@@ -68,6 +68,8 @@ public:
   static QString omResultFileTypes;
   static QString exeFileTypes;
   static QString txtFileTypes;
+  static QString csvFileTypes;
+  static QString jsonFileTypes;
   static QString figaroFileTypes;
   static QString visualizationFileTypes;
   static QString omsFileTypes;
@@ -377,6 +379,7 @@ public:
   static QString editBusConnection;
   static QString addTLMConnection;
   static QString editTLMConnection;
+  static QString queued;
   static QString running;
   static QString finished;
   static QString newVariable;
@@ -853,75 +853,119 @@ QString StringHandler::removeFirstLastSingleQuotes(QString value)
   return value;
 }
 
-QStringList StringHandler::getStrings(QString value)
+QStringList StringHandler::getStrings(const QString &value)
 {
   return getStrings(value, '{', '}');
 }
 
-QStringList StringHandler::getStrings(QString value, char start, char end)
+/*!
+ * \brief appendTrimmedString
+ * Helper for StringHandler::getStrings() and StringHandler::unparseArrays().
+ * Appends the characters between begin and end without the surrounding spaces. Only the appended string is allocated.
+ * \param pList
+ * \param pData
+ * \param begin
+ * \param end
+ */
+static inline void appendTrimmedString(QStringList *pList, const QChar *pData, int begin, int end)
+{
+  while (begin < end && pData[begin].isSpace()) {
+    begin++;
+  }
+  while (end > begin && pData[end - 1].isSpace()) {
+    end--;
+  }
+  pList->append(QString(pData + begin, end - begin));
+}
+
+/*!
+ * \brief splitStrings
+ * Helper for StringHandler::getStrings() and StringHandler::getStringsInCurlBrackets().
+ * Splits the characters between begin and length at the commas which are not inside the start and end brackets or inside a string.
+ * \param pData
+ * \param begin
+ * \param length
+ * \param start
+ * \param end
+ * \return
+ */
+static QStringList splitStrings(const QChar *pData, int begin, int length, char start, char end)
 {
   QStringList list;
   bool mask = false;
   bool inString = false;
-  char StringEnd = '\0';
-  int begin = 0;
+  ushort stringEnd = 0;
   int ele = 0;
 
-  for (int i = 0 ; i < value.length() ; i++)
-  {
-    if (inString)
-    {
-      if (mask)
-      {
+  for (int i = begin ; i < length ; i++) {
+    const ushort c = pData[i].unicode();
+    if (inString) {
+      if (mask) {
         mask = false;
+      } else if (c == '\\') {
+        mask = true;
+      } else if (c == stringEnd) {
+        inString = false;
       }
-      else
-      {
-        if (value.at(i) == '\\')
-        {
-          mask = true;
-        }
-        else if (value.at(i) == StringEnd)
-        {
-          inString = false;
-        }
-      }
-    }
-    else
-    {
-      if (value.at(i) == '"')
-      {
-          StringEnd = '"';
-          inString = true;
-      }
-      else if (value.at(i) == '\'')
-      {
-          StringEnd = '\'';
-          inString = true;
-      }
-      else if (value.at(i) == ',')
-      {
-        if (ele == 0)
-        {
-          list.append(value.mid(begin,i-begin).trimmed());
-          begin = i+1;
-        }
-      }
-      else if (value.at(i) == start)
-      {
-        ele++;
-      }
-      else if (value.at(i) == end)
-      {
-        ele--;
+    } else if (c == '"' || c == '\'') {
+      stringEnd = c;
+      inString = true;
+    } else if (c == ',') {
+      if (ele == 0) {
+        appendTrimmedString(&list, pData, begin, i);
+        begin = i + 1;
       }
+    } else if (c == (ushort)start) {
+      ele++;
+    } else if (c == (ushort)end) {
+      ele--;
     }
   }
-  list.append(value.mid(begin,value.length()-begin).trimmed());
+  appendTrimmedString(&list, pData, begin, length);
 
   return list;
 }
 
+/*!
+ * \brief StringHandler::getStrings
+ * Splits the value at the commas which are not inside the start and end brackets or inside a string.\n
+ * The value is scanned once and each item is copied once.
+ * \param value
+ * \param start
+ * \param end
+ * \return
+ */
+QStringList StringHandler::getStrings(const QString &value, char start, char end)
+{
+  return splitStrings(value.constData(), 0, value.length(), start, end);
+}
+
+/*!
+ * \brief StringHandler::getStringsInCurlBrackets
+ * Same as getStrings(removeFirstLastCurlBrackets(value), start, end) but without copying the value.
+ * \param value
+ * \param start
+ * \param end
+ * \return
+ */
+QStringList StringHandler::getStringsInCurlBrackets(const QString &value, char start, char end)
+{
+  const QChar *pData = value.constData();
+  int begin = 0;
+  int length = value.length();
+  while (begin < length && pData[begin].isSpace()) {
+    begin++;
+  }
+  while (length > begin && pData[length - 1].isSpace()) {
+    length--;
+  }
+  if (length - begin > 1 && pData[begin] == '{' && pData[length - 1] == '}') {
+    begin++;
+    length--;
+  }
+  return splitStrings(pData, begin, length, start, end);
+}
+
 /*!
  * \brief wordsBeforeAfterLastDot
  * Helper for StringHandler::getLastWordAfterDot() and StringHandler::removeLastWordAfterDot()
@@ -1110,89 +1154,191 @@ QString StringHandler::unparse(QString value)
   }
 }
 
-QStringList StringHandler::unparseStrings(QString value)
+/*!
+ * \brief appendUnescapedString
+ * Helper for StringHandler::unparseStrings().
+ * Appends the characters between begin and end and replaces the escape sequences like CONSUME_CHAR does.
+ * A string without escape sequences is copied at once.
+ * \param pList
+ * \param pData
+ * \param begin
+ * \param end
+ * \param escaped - true if the string contains escape sequences.
+ */
+static inline void appendUnescapedString(QStringList *pList, const QChar *pData, int begin, int end, bool escaped)
 {
-  QStringList lst;
-  value = value.trimmed();
-  if (value[0] != '{') return lst; // ERROR?
-  int i=1;
+  if (!escaped) {
+    pList->append(QString(pData + begin, end - begin));
+    return;
+  }
   QString res;
-  while (value[i] == '"') {
+  res.reserve(end - begin);
+  for (int i = begin ; i < end ; i++) {
+    if (pData[i] == '\\') {
+      i++;
+      switch (i < end ? pData[i].unicode() : 0) {
+        case '\'': res.append('\''); break;
+        case '"':  res.append('\"'); break;
+        case '?':  res.append('\?'); break;
+        case '\\': res.append('\\'); break;
+        case 'a':  res.append('\a'); break;
+        case 'b':  res.append('\b'); break;
+        case 'f':  res.append('\f'); break;
+        case 'n':  res.append('\n'); break;
+        case 'r':  res.append('\r'); break;
+        case 't':  res.append('\t'); break;
+        case 'v':  res.append('\v'); break;
+      }
+    } else {
+      res.append(pData[i]);
+    }
+  }
+  pList->append(res);
+}
+
+/*!
+ * \brief StringHandler::unparseStrings
+ * Unparses a list of strings e.g., {"x", "y", "z"}.\n
+ * The value is scanned once without copying it and each string is copied once.
+ * \param value
+ * \return
+ */
+QStringList StringHandler::unparseStrings(const QString &value)
+{
+  return unparseStrings(value, 0, value.length());
+}
+
+/*!
+ * \brief StringHandler::unparseStrings
+ * Unparses the list of strings of n characters at position in value. Used with the ranges of StringHandler::unparseArraysRanges().
+ * \param value
+ * \param position
+ * \param n
+ * \return
+ */
+QStringList StringHandler::unparseStrings(const QString &value, int position, int n)
+{
+  QStringList lst;
+  const QChar *pData = value.constData();
+  int i = position;
+  int length = position + n;
+  while (i < length && pData[i].isSpace()) {
     i++;
-    while (value.at(i) != '"') {
-      CONSUME_CHAR(value,res,i);
+  }
+  while (length > i && pData[length - 1].isSpace()) {
+    length--;
+  }
+  if (i >= length || pData[i] != '{') return lst; // ERROR?
+  i++;
+  while (i < length && pData[i] == '"') {
+    i++;
+    int begin = i;
+    bool escaped = false;
+    while (i < length && pData[i] != '"') {
+      if (pData[i] == '\\') {
+        escaped = true;
+        i++;
+      }
       i++;
       /* if we have unexpected double quotes then, however omc should return \" */
       /* remove this block once fixed in omc */
-      if (value[i] == '"' && value[i+1] != ',') {
-        if (value[i+1] != '}') {
-          CONSUME_CHAR(value,res,i);
-          i++;
-        }
+      if (i + 1 < length && pData[i] == '"' && pData[i + 1] != ',' && pData[i + 1] != '}') {
+        i++;
       }
       /* remove this block once fixed in omc */
     }
+    int end = qMin(i, length);
     i++;
-    if (value[i] == '}') {
-      lst.append(res);
+    if (i >= length) {
+      return lst; // ERROR?
+    }
+    if (pData[i] == '}') {
+      appendUnescapedString(&lst, pData, begin, end, escaped);
       return lst;
     }
-    if (value[i] == ',') {
-      lst.append(res);
+    if (pData[i] == ',') {
+      appendUnescapedString(&lst, pData, begin, end, escaped);
       i++;
-      res = "";
-      while (value[i] == ' ')     // if we have space before next value e.g {"x", "y", "z"}
+      while (i < length && pData[i] == ' ') {    // if we have space before next value e.g {"x", "y", "z"}
         i++;
+      }
       continue;
     }
-    while (value[i] != '"' && !value[i].isNull()) {
+    while (i < length && pData[i] != '"') {
+      fprintf(stderr, "error? malformed string-list. skipping: %c\n", pData[i].toAscii());
       i++;
-      fprintf(stderr, "error? malformed string-list. skipping: %c\n", value[i].toAscii());
     }
   }
   return lst; // ERROR?
 }
 
-QStringList StringHandler::unparseArrays(QString value)
+QStringList StringHandler::unparseArrays(const QString &value)
 {
   QStringList lst;
-  size_t braceopen = 0;
-  size_t mainbraceopen = 0;
-  size_t i = 0;
-  value = StringHandler::removeFirstLastCurlBrackets(value);
-  size_t length = value.size();
-  int subbraceopen = 0;
+  const QChar *pData = value.constData();
+  QList<QPair<int, int> > ranges = unparseArraysRanges(value);
+  lst.reserve(ranges.size());
+  for (int i = 0 ; i < ranges.size() ; i++) {
+    lst.append(QString(pData + ranges.at(i).first, ranges.at(i).second));
+  }
+  return lst;
+}
+
+/*!
+ * \brief StringHandler::unparseArraysRanges
+ * Returns the position and length of each array that StringHandler::unparseArrays() returns without copying them.
+ * \param value
+ * \return
+ */
+QList<QPair<int, int> > StringHandler::unparseArraysRanges(const QString &value)
+{
+  QList<QPair<int, int> > lst;
+  const QChar *pData = value.constData();
+  int i = 0;
+  int length = value.length();
+  // remove the first and last curly brackets without copying the value.
+  while (i < length && pData[i].isSpace()) {
+    i++;
+  }
+  while (length > i && pData[length - 1].isSpace()) {
+    length--;
+  }
+  if (length - i > 1 && pData[i] == '{' && pData[length - 1] == '}') {
+    i++;
+    length--;
+  }
+  bool braceopen = false;
+  bool subbraceopen = false;
+  int mainbraceopen = 0;
   for (; i < length ; i++) {
-    if (value.at(i) == ' ' || value.at(i) == ',') {
+    const ushort c = pData[i].unicode();
+    if (c == ' ' || c == ',') {
       continue; // ignore any kind of space
     }
-    if (value.at(i) == '{' && braceopen == 0) {
-      braceopen = 1;
+    if (c == '{' && !braceopen) {
+      braceopen = true;
       mainbraceopen = i;
       continue;
     }
-    if (value.at(i) == '{') {
-      subbraceopen = 1;
+    if (c == '{') {
+      subbraceopen = true;
     }
-
-    if (value.at(i) == '}' && braceopen == 1 && subbraceopen == 0) {
+    if (c == '}' && braceopen && !subbraceopen) {
       //closing of a group
-      int copylength = i- mainbraceopen+1;
-      braceopen = 0;
-      lst.append(value.mid(mainbraceopen, copylength));
+      braceopen = false;
+      lst.append(qMakePair(mainbraceopen, i - mainbraceopen + 1));
       continue;
     }
-    if (value.at(i) == '}') {
-      subbraceopen = 0;
+    if (c == '}') {
+      subbraceopen = false;
     }
-
     /* skip the whole quotes section */
-    if (value.at(i) == '"') {
+    if (c == '"') {
       i++;
-      while (value.at(i) != '"') {
+      while (i < length && pData[i] != '"') {
         i++;
-        if (value.at(i-1) == '\\' && value.at(i) == '"') {
-            i+=1;
+        if (i < length && pData[i - 1] == '\\' && pData[i] == '"') {
+          i++;
         }
       }
     }
@@ -38,6 +38,7 @@
 #include <QObject>
 #include <QComboBox>
 #include <QProcessEnvironment>
+#include <QPair>
 
 class StringHandler : public QObject
 {
@@ -111,8 +112,9 @@ public:
   static QString removeFirstLastSquareBrackets(QString value);
   static QString removeFirstLastQuotes(QString value);
   static QString removeFirstLastSingleQuotes(QString value);
-  static QStringList getStrings(QString value);
-  static QStringList getStrings(QString value, char start, char end);
+  static QStringList getStrings(const QString &value);
+  static QStringList getStrings(const QString &value, char start, char end);
+  static QStringList getStringsInCurlBrackets(const QString &value, char start = '{', char end = '}');
   /* Handles quoted identifiers A.B.'C.D' -> A.B, A.B.C.D -> A.B.C */
   static QString getLastWordAfterDot(QString value);
   static QString removeLastWordAfterDot(QString value);
@@ -123,9 +125,11 @@ public:
   // Returns "" if the string is not a standard Modelica string. Else it unparses it into normal form.
   static QString unparse(QString value);
   // Returns empty list if the string is not a standard Modelica string-array. Else it unparses it into normal form.
-  static QStringList unparseStrings(QString value);
+  static QStringList unparseStrings(const QString &value);
+  static QStringList unparseStrings(const QString &value, int position, int n);
   // Returns empty list if the string is not a standard Modelica array. Else it unparses it into normal form.
-  static QStringList unparseArrays(QString value);
+  static QStringList unparseArrays(const QString &value);
+  static QList<QPair<int, int> > unparseArraysRanges(const QString &value);
   // Returns false on failure
   static bool unparseBool(QString value);
   static QString getSaveFileName(QWidget* parent = 0, const QString &caption = "", QString * dir = 0, const QString & filter = "",
@@ -452,6 +452,24 @@ QString& Utilities::tempDirectory()
   return tmpPath;
 }
 
+/*!
+ * \brief Utilities::cacheDirectory
+ * Returns the application cache directory. It is located next to the settings file so it persists between sessions.
+ * \return
+ */
+QString& Utilities::cacheDirectory()
+{
+  static int init = 0;
+  static QString cachePath;
+  if (!init) {
+    init = 1;
+    cachePath = QFileInfo(getApplicationSettings()->fileName()).absolutePath() + "/OMEditCache/";
+    if (!QDir().exists(cachePath))
+      QDir().mkpath(cachePath);
+  }
+  return cachePath;
+}
+
 /*!
  * \brief Utilities::getApplicationSettings
  * Returns the application settings object.
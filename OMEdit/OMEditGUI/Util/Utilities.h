@@ -436,6 +436,7 @@ namespace Utilities {
 
   QString escapeForHtmlNonSecure(const QString &str);
   QString& tempDirectory();
+  QString& cacheDirectory();
   QSettings* getApplicationSettings();
   void parseCompositeModelText(MessageHandler *pMessageHandler, QString contents);
   qreal convertUnit(qreal value, qreal offset, qreal scaleFactor);
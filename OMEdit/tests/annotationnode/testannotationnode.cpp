@@ -0,0 +1,171 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+
+#include "Annotations/AnnotationNode.h"
+
+/*!
+ * \class TestAnnotationNode
+ * \brief Tests the parsing of the annotations returned by OMC into AnnotationNode trees.
+ */
+class TestAnnotationNode: public QObject
+{
+  Q_OBJECT
+private slots:
+  void parseEmpty();
+  void parseValues();
+  void parseRecords();
+  void parseStrings();
+  void parseExpressions();
+  void parseTrailingComma();
+  void parseOutOfRange();
+  void parseCached();
+  void internArguments();
+};
+
+void TestAnnotationNode::parseEmpty()
+{
+  QCOMPARE(AnnotationNode::parse("").size(), 0);
+  QCOMPARE(AnnotationNode::parse("   ").size(), 0);
+  QVERIFY(AnnotationNode::parse("").isArray());
+}
+
+void TestAnnotationNode::parseValues()
+{
+  AnnotationNode node = AnnotationNode::parse("true, {0, 0}, 0, {{-100, -100}, {100, 100}}");
+  QCOMPARE(node.size(), 4);
+  QCOMPARE(node.at(0).getType(), AnnotationNode::Atom);
+  QVERIFY(node.at(0).toBool());
+  QVERIFY(node.at(1).isArray());
+  QCOMPARE(node.at(1).toPoint(), QPointF(0, 0));
+  QCOMPARE(node.at(2).toInt(), 0);
+  QList<QPointF> extent;
+  extent << QPointF(-100, -100) << QPointF(100, 100);
+  QCOMPARE(node.at(3).toPoints(), extent);
+  QCOMPARE(node.at(3).getSource(), QString("{{-100, -100}, {100, 100}}"));
+}
+
+void TestAnnotationNode::parseRecords()
+{
+  AnnotationNode node = AnnotationNode::parse("Rectangle(true, {0, 0}, 0, {0, 0, 255}), Line(true, {{0, 0}, {10, 5.5}})");
+  QCOMPARE(node.size(), 2);
+  QVERIFY(node.at(0).isRecord());
+  QCOMPARE(node.at(0).getName(), QString("Rectangle"));
+  AnnotationNode arguments = node.at(0).getArguments();
+  QVERIFY(arguments.isArray());
+  QCOMPARE(arguments.size(), 4);
+  QCOMPARE(arguments.getSource(), QString("true, {0, 0}, 0, {0, 0, 255}"));
+  QCOMPARE(arguments.at(3).toColor(), QColor(0, 0, 255));
+  QCOMPARE(node.at(1).getName(), QString("Line"));
+  QList<QPointF> points;
+  points << QPointF(0, 0) << QPointF(10, 5.5);
+  QCOMPARE(node.at(1).getArguments().at(1).toPoints(), points);
+  // an Atom is not a record.
+  QCOMPARE(node.at(0).getArguments().at(0).getName(), QString(""));
+}
+
+void TestAnnotationNode::parseStrings()
+{
+  AnnotationNode node = AnnotationNode::parse("Text(\"a, {b}\", \"x\\\"y\"), 'q.r'");
+  QCOMPARE(node.size(), 2);
+  AnnotationNode arguments = node.at(0).getArguments();
+  QCOMPARE(arguments.size(), 2);
+  QCOMPARE(arguments.at(0).getType(), AnnotationNode::String);
+  QCOMPARE(arguments.at(0).toUnquotedString(), QString("a, {b}"));
+  QCOMPARE(arguments.at(1).getSource(), QString("\"x\\\"y\""));
+  QCOMPARE(node.at(1).getType(), AnnotationNode::String);
+  QCOMPARE(node.at(1).getSource(), QString("'q.r'"));
+}
+
+void TestAnnotationNode::parseExpressions()
+{
+  AnnotationNode node = AnnotationNode::parse("\"a\" + \"b\", {1, 2} * 2, x");
+  QCOMPARE(node.size(), 3);
+  QCOMPARE(node.at(0).getType(), AnnotationNode::Atom);
+  QCOMPARE(node.at(0).getSource(), QString("\"a\" + \"b\""));
+  QCOMPARE(node.at(1).getType(), AnnotationNode::Atom);
+  QCOMPARE(node.at(1).size(), 0);
+  QCOMPARE(node.at(1).getSource(), QString("{1, 2} * 2"));
+  QCOMPARE(node.at(2).getSource(), QString("x"));
+}
+
+void TestAnnotationNode::parseTrailingComma()
+{
+  AnnotationNode node = AnnotationNode::parse("1, ");
+  QCOMPARE(node.size(), 2);
+  QCOMPARE(node.at(1).getSource(), QString(""));
+  node = AnnotationNode::parse("1,");
+  QCOMPARE(node.size(), 2);
+  // OMC ends the Placement arguments with a comma.
+  AnnotationNode placement = AnnotationNode::parse("Placement(true, -, -, -10.0, -10.0, 10.0, 10.0, 0.0, -, -, -, -, -, -,)");
+  QCOMPARE(placement.size(), 1);
+  QCOMPARE(placement.at(0).getArguments().size(), 15);
+  QCOMPARE(placement.at(0).getArguments().at(3).toReal(), -10.0);
+  QCOMPARE(placement.at(0).getArguments().at(14).getSource(), QString(""));
+}
+
+void TestAnnotationNode::parseOutOfRange()
+{
+  AnnotationNode node = AnnotationNode::parse("{1, 2}");
+  QCOMPARE(node.at(-1).getSource(), QString(""));
+  QCOMPARE(node.at(1).getSource(), QString(""));
+  QCOMPARE(node.at(0).at(5).getSource(), QString(""));
+  QCOMPARE(node.at(0).at(0).toPoint(), QPointF());
+  QVERIFY(!node.at(0).at(0).toColor().isValid());
+}
+
+void TestAnnotationNode::parseCached()
+{
+  QString annotation = "Ellipse(true, {1, 2}, 0, {{-10, -10}, {10, 10}})";
+  AnnotationNode first = AnnotationNode::parse(annotation);
+  AnnotationNode second = AnnotationNode::parse(annotation);
+  QCOMPARE(second.size(), first.size());
+  QCOMPARE(second.at(0).getName(), first.at(0).getName());
+  QCOMPARE(second.at(0).getArguments().getSource(), first.at(0).getArguments().getSource());
+}
+
+void TestAnnotationNode::internArguments()
+{
+  AnnotationNode node = AnnotationNode::parse("Polygon(true, {0, 0}, 0, {{0, 0}, {1, 1}, {2, 0}})");
+  QString arguments = node.at(0).internArguments();
+  QCOMPARE(arguments, QString("true, {0, 0}, 0, {{0, 0}, {1, 1}, {2, 0}}"));
+  AnnotationNode parsed = AnnotationNode::parse(arguments);
+  QCOMPARE(parsed.size(), 4);
+  QCOMPARE(parsed.at(3).toPoints().size(), 3);
+}
+
+QTEST_MAIN(TestAnnotationNode)
+
+#include "testannotationnode.moc"
@@ -0,0 +1,161 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+
+#include "Util/StringHandler.h"
+#include "Component/Component.h"
+#include "oldstringhandler.h"
+#include "omcreplies.h"
+
+/*!
+ * \class StringHandlerBenchmark
+ * \brief Compares the StringHandler splitters with the old splitters on large getComponents and annotation replies.\n
+ * The replies grow tenfold per row so a quadratic splitter shows up as a hundredfold slower row.
+ */
+class StringHandlerBenchmark: public QObject
+{
+  Q_OBJECT
+private slots:
+  void parseComponents_data();
+  void parseComponents();
+  void getStringsInCurlBrackets_data();
+  void getStringsInCurlBrackets();
+  void getStrings_data();
+  void getStrings();
+private:
+  static void addRows();
+};
+
+/*!
+ * \brief StringHandlerBenchmark::addRows
+ * Adds the old and new rows of 100, 1000 and 10000 elements.
+ */
+void StringHandlerBenchmark::addRows()
+{
+  QTest::addColumn<bool>("old");
+  QTest::addColumn<int>("count");
+
+  for (int count = 100 ; count <= 10000 ; count *= 10) {
+    QTest::newRow(QString("old %1").arg(count).toLatin1().constData()) << true << count;
+    QTest::newRow(QString("new %1").arg(count).toLatin1().constData()) << false << count;
+  }
+}
+
+void StringHandlerBenchmark::parseComponents_data()
+{
+  addRows();
+}
+
+/*!
+ * \brief StringHandlerBenchmark::parseComponents
+ * Parses a getComponents reply like OMCProxy::parseComponents() does.
+ */
+void StringHandlerBenchmark::parseComponents()
+{
+  QFETCH(bool, old);
+  QFETCH(int, count);
+
+  QString reply = OMCReplies::components(count);
+  QBENCHMARK {
+    ComponentInfo componentInfo;
+    if (old) {
+      QStringList list = OldStringHandler::unparseArrays(reply);
+      for (int i = 0 ; i < list.size() ; i++) {
+        componentInfo.parseComponentInfo(OldStringHandler::unparseStrings(list.at(i)));
+      }
+    } else {
+      QList<QPair<int, int> > ranges = StringHandler::unparseArraysRanges(reply);
+      for (int i = 0 ; i < ranges.size() ; i++) {
+        componentInfo.parseComponentInfo(StringHandler::unparseStrings(reply, ranges.at(i).first, ranges.at(i).second));
+      }
+    }
+  }
+}
+
+void StringHandlerBenchmark::getStringsInCurlBrackets_data()
+{
+  addRows();
+}
+
+/*!
+ * \brief StringHandlerBenchmark::getStringsInCurlBrackets
+ * Splits a getComponentAnnotations reply like OMCProxy::getComponentAnnotations() does.
+ */
+void StringHandlerBenchmark::getStringsInCurlBrackets()
+{
+  QFETCH(bool, old);
+  QFETCH(int, count);
+
+  QString reply = OMCReplies::annotations(count);
+  QStringList list;
+  QBENCHMARK {
+    if (old) {
+      list = OldStringHandler::getStrings(OldStringHandler::removeFirstLastCurlBrackets(reply));
+    } else {
+      list = StringHandler::getStringsInCurlBrackets(reply);
+    }
+  }
+  QCOMPARE(list.size(), count);
+}
+
+void StringHandlerBenchmark::getStrings_data()
+{
+  addRows();
+}
+
+/*!
+ * \brief StringHandlerBenchmark::getStrings
+ * Splits the shapes of a connection annotation with many points.
+ */
+void StringHandlerBenchmark::getStrings()
+{
+  QFETCH(bool, old);
+  QFETCH(int, count);
+
+  QString reply = OMCReplies::shapes(count);
+  QStringList list;
+  QBENCHMARK {
+    if (old) {
+      list = OldStringHandler::getStrings(OldStringHandler::removeFirstLastCurlBrackets(reply), '(', ')');
+    } else {
+      list = StringHandler::getStringsInCurlBrackets(reply, '(', ')');
+    }
+  }
+  QCOMPARE(list.size(), 2);
+}
+
+QTEST_MAIN(StringHandlerBenchmark)
+
+#include "stringhandlerbenchmark.moc"
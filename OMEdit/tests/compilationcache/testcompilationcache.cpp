@@ -0,0 +1,170 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "Simulation/CompilationCache.h"
+
+/*!
+ * \class TestCompilationCache
+ * \brief Tests the compilation key and the least recently used eviction of CompilationCache.
+ */
+class TestCompilationCache: public QObject
+{
+  Q_OBJECT
+private slots:
+  void keyWithoutMakefile();
+  void keyIsStable();
+  void keyChangesWithSources();
+  void keyChangesWithSettings();
+  void keyIgnoresOtherModels();
+  void evictLeastRecentlyUsed();
+  void evictNothingWhenFits();
+private:
+  static void writeFile(const QString &fileName, const QByteArray &contents);
+  static void writeModel(const QString &directory, const QString &outputFileName);
+  static void writeEntry(const QString &directory, const QString &key, int size);
+};
+
+void TestCompilationCache::writeFile(const QString &fileName, const QByteArray &contents)
+{
+  QFile file(fileName);
+  QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  file.write(contents);
+  file.close();
+}
+
+void TestCompilationCache::writeModel(const QString &directory, const QString &outputFileName)
+{
+  writeFile(directory + "/" + outputFileName + ".makefile", "all:\n\tcc -o model model.c\n");
+  writeFile(directory + "/" + outputFileName + ".c", "int main() {return 0;}\n");
+  writeFile(directory + "/" + outputFileName + "_functions.h", "#define N 1\n");
+}
+
+void TestCompilationCache::writeEntry(const QString &directory, const QString &key, int size)
+{
+  QVERIFY(QDir().mkpath(directory + "/" + key));
+  writeFile(directory + "/" + key + "/executable", QByteArray(size, 'x'));
+  writeFile(directory + "/" + key + "/lastUsed", QDateTime::currentDateTime().toString(Qt::ISODate).toUtf8());
+}
+
+void TestCompilationCache::keyWithoutMakefile()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  writeFile(temporaryDir.path() + "/M.c", "int main() {return 0;}\n");
+  QVERIFY(CompilationCache::key(temporaryDir.path(), "M", "settings").isEmpty());
+}
+
+void TestCompilationCache::keyIsStable()
+{
+  QTemporaryDir firstDir, secondDir;
+  QVERIFY(firstDir.isValid() && secondDir.isValid());
+  writeModel(firstDir.path(), "M");
+  writeModel(secondDir.path(), "M");
+  QString key = CompilationCache::key(firstDir.path(), "M", "settings");
+  QVERIFY(!key.isEmpty());
+  QCOMPARE(CompilationCache::key(firstDir.path(), "M", "settings"), key);
+  // the same generated code in another working directory builds the same executable.
+  QCOMPARE(CompilationCache::key(secondDir.path(), "M", "settings"), key);
+}
+
+void TestCompilationCache::keyChangesWithSources()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  writeModel(temporaryDir.path(), "M");
+  QString key = CompilationCache::key(temporaryDir.path(), "M", "settings");
+  writeFile(temporaryDir.path() + "/M_functions.h", "#define N 2\n");
+  QVERIFY(CompilationCache::key(temporaryDir.path(), "M", "settings") != key);
+  writeFile(temporaryDir.path() + "/M_functions.h", "#define N 1\n");
+  QCOMPARE(CompilationCache::key(temporaryDir.path(), "M", "settings"), key);
+  writeFile(temporaryDir.path() + "/M_extra.c", "int f() {return 1;}\n");
+  QVERIFY(CompilationCache::key(temporaryDir.path(), "M", "settings") != key);
+}
+
+void TestCompilationCache::keyChangesWithSettings()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  writeModel(temporaryDir.path(), "M");
+  QVERIFY(CompilationCache::key(temporaryDir.path(), "M", "gcc") != CompilationCache::key(temporaryDir.path(), "M", "clang"));
+}
+
+void TestCompilationCache::keyIgnoresOtherModels()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  writeModel(temporaryDir.path(), "M");
+  QString key = CompilationCache::key(temporaryDir.path(), "M", "settings");
+  writeModel(temporaryDir.path(), "N");
+  QCOMPARE(CompilationCache::key(temporaryDir.path(), "M", "settings"), key);
+}
+
+void TestCompilationCache::evictLeastRecentlyUsed()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  // the entries are ordered by the modification time of their lastUsed file.
+  writeEntry(temporaryDir.path(), "oldest", 1000);
+  QTest::qSleep(1100);
+  writeEntry(temporaryDir.path(), "older", 1000);
+  QTest::qSleep(1100);
+  writeEntry(temporaryDir.path(), "newest", 1000);
+  // each entry is the executable and its lastUsed file.
+  qint64 entrySize = 1000 + QFileInfo(temporaryDir.path() + "/newest/lastUsed").size();
+  CompilationCache::evict(temporaryDir.path(), 2 * entrySize);
+  QVERIFY(!QFileInfo(temporaryDir.path() + "/oldest").exists());
+  QVERIFY(QFileInfo(temporaryDir.path() + "/older").exists());
+  QVERIFY(QFileInfo(temporaryDir.path() + "/newest").exists());
+  CompilationCache::evict(temporaryDir.path(), entrySize);
+  QVERIFY(!QFileInfo(temporaryDir.path() + "/older").exists());
+  QVERIFY(QFileInfo(temporaryDir.path() + "/newest").exists());
+}
+
+void TestCompilationCache::evictNothingWhenFits()
+{
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  writeEntry(temporaryDir.path(), "first", 1000);
+  writeEntry(temporaryDir.path(), "second", 1000);
+  CompilationCache::evict(temporaryDir.path(), 1024 * 1024);
+  QVERIFY(QFileInfo(temporaryDir.path() + "/first").exists());
+  QVERIFY(QFileInfo(temporaryDir.path() + "/second").exists());
+}
+
+QTEST_MAIN(TestCompilationCache)
+
+#include "testcompilationcache.moc"
@@ -0,0 +1,269 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QDataStream>
+
+#include "Plotting/ResultFileReader.h"
+
+/*!
+ * \class TestResultFileReader
+ * \brief Tests the final values and the column decoding of ResultFileReader for .mat and .csv result files.
+ */
+class TestResultFileReader: public QObject
+{
+  Q_OBJECT
+private slots:
+  void initTestCase();
+  void readMatFinalValues();
+  void readMatColumns();
+  void readCSVFinalValues();
+  void readCSVColumns();
+  void readCSVWideColumns();
+  void readCSVInvalidFinalValue();
+private:
+  QTemporaryDir mTemporaryDir;
+  QString writeFile(const QString &fileName, const QByteArray &contents);
+  static void writeMatrix(QDataStream &out, const char *name, qint32 type, qint32 rows, qint32 columns, const QByteArray &data);
+  static QByteArray charMatrix(const QStringList &strings, int length);
+  QString writeMatFile();
+};
+
+void TestResultFileReader::initTestCase()
+{
+  QVERIFY(mTemporaryDir.isValid());
+}
+
+QString TestResultFileReader::writeFile(const QString &fileName, const QByteArray &contents)
+{
+  QString path = mTemporaryDir.path() + "/" + fileName;
+  QFile file(path);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    file.write(contents);
+    file.close();
+  }
+  return path;
+}
+
+/*!
+ * \brief TestResultFileReader::writeMatrix
+ * Writes a MAT version 4 matrix. The data is stored column by column.
+ */
+void TestResultFileReader::writeMatrix(QDataStream &out, const char *name, qint32 type, qint32 rows, qint32 columns, const QByteArray &data)
+{
+  qint32 nameLength = strlen(name) + 1;
+  out << type << rows << columns << (qint32)0 << nameLength;
+  out.writeRawData(name, nameLength);
+  out.writeRawData(data.constData(), data.size());
+}
+
+/*!
+ * \brief TestResultFileReader::charMatrix
+ * Returns the strings as the columns of a text matrix padded with NUL characters.
+ */
+QByteArray TestResultFileReader::charMatrix(const QStringList &strings, int length)
+{
+  QByteArray data;
+  foreach (QString string, strings) {
+    data.append(string.toLatin1().leftJustified(length, '\0'));
+  }
+  return data;
+}
+
+/*!
+ * \brief TestResultFileReader::writeMatFile
+ * Writes a transposed OpenModelica result file with the parameter p = 5 and the variable x = 10, 20, 30 at time 0, 0.5, 1.
+ */
+QString TestResultFileReader::writeMatFile()
+{
+  QByteArray contents;
+  QDataStream out(&contents, QIODevice::WriteOnly);
+  out.setByteOrder(QDataStream::LittleEndian);
+  out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+  // the Aclass rows stored column by column.
+  QStringList aclass;
+  aclass << "Atrajectory" << "1.1" << "" << "binTrans";
+  QByteArray aclassData;
+  for (int column = 0 ; column < 11 ; column++) {
+    foreach (QString row, aclass) {
+      aclassData.append(row.leftJustified(11, ' ').at(column).toLatin1());
+    }
+  }
+  writeMatrix(out, "Aclass", 51, 4, 11, aclassData);
+  QStringList names;
+  names << "time" << "x" << "p";
+  writeMatrix(out, "name", 51, 5, names.size(), charMatrix(names, 5));
+  QStringList descriptions;
+  descriptions << "Time" << "state" << "parameter";
+  writeMatrix(out, "description", 51, 10, descriptions.size(), charMatrix(descriptions, 10));
+  // data set, index, interpolation and extrapolation of each variable.
+  QByteArray dataInfo;
+  QDataStream dataInfoOut(&dataInfo, QIODevice::WriteOnly);
+  dataInfoOut.setByteOrder(QDataStream::LittleEndian);
+  dataInfoOut << (qint32)0 << (qint32)1 << (qint32)0 << (qint32)-1
+              << (qint32)2 << (qint32)2 << (qint32)0 << (qint32)-1
+              << (qint32)1 << (qint32)2 << (qint32)0 << (qint32)0;
+  writeMatrix(out, "dataInfo", 20, 4, names.size(), dataInfo);
+  QByteArray data1;
+  QDataStream data1Out(&data1, QIODevice::WriteOnly);
+  data1Out.setByteOrder(QDataStream::LittleEndian);
+  data1Out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+  data1Out << 0.0 << 5.0 << 1.0 << 5.0;
+  writeMatrix(out, "data_1", 0, 2, 2, data1);
+  QByteArray data2;
+  QDataStream data2Out(&data2, QIODevice::WriteOnly);
+  data2Out.setByteOrder(QDataStream::LittleEndian);
+  data2Out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+  data2Out << 0.0 << 10.0 << 0.5 << 20.0 << 1.0 << 30.0;
+  writeMatrix(out, "data_2", 0, 2, 3, data2);
+  return writeFile("model_res.mat", contents);
+}
+
+void TestResultFileReader::readMatFinalValues()
+{
+  ResultFileReader reader;
+  QVERIFY2(reader.open(writeMatFile()), qPrintable(reader.getErrorString()));
+  double value = 0;
+  QVERIFY(reader.readVariableFinalValue("x", &value));
+  QCOMPARE(value, 30.0);
+  QVERIFY(reader.readVariableFinalValue("p", &value));
+  QCOMPARE(value, 5.0);
+  QVERIFY(reader.readVariableFinalValue("time", &value));
+  QCOMPARE(value, 1.0);
+  QVERIFY(!reader.readVariableFinalValue("y", &value));
+}
+
+void TestResultFileReader::readMatColumns()
+{
+  ResultFileReader reader;
+  QVERIFY2(reader.open(writeMatFile()), qPrintable(reader.getErrorString()));
+  QVector<double> time;
+  time << 0.0 << 0.5 << 1.0;
+  QCOMPARE(reader.readTimeColumn(), time);
+  bool ok = false;
+  QVector<double> x;
+  x << 10.0 << 20.0 << 30.0;
+  QCOMPARE(reader.readVariableColumn("x", &ok), x);
+  QVERIFY(ok);
+  QVector<double> p;
+  p << 5.0 << 5.0 << 5.0;
+  QCOMPARE(reader.readVariableColumn("p", &ok), p);
+  QVERIFY(ok);
+  double value = 0;
+  QVERIFY(reader.readVariableValue("x", 0.25, &value));
+  QCOMPARE(value, 15.0);
+  // the final value is read from the cached column once it is decoded.
+  QVERIFY(reader.readVariableFinalValue("x", &value));
+  QCOMPARE(value, 30.0);
+}
+
+void TestResultFileReader::readCSVFinalValues()
+{
+  ResultFileReader reader;
+  QVERIFY(reader.open(writeFile("model_res.csv", "\"time\",\"x\",\"y[1,2]\",\n0,1,2,\n0.5,3,4,\n1,5,6,\n\n")));
+  QCOMPARE(reader.getVariables(), QStringList() << "time" << "x" << "y[1,2]");
+  double value = 0;
+  QVERIFY(reader.readVariableFinalValue("x", &value));
+  QCOMPARE(value, 5.0);
+  QVERIFY(reader.readVariableFinalValue("y[1,2]", &value));
+  QCOMPARE(value, 6.0);
+  QVERIFY(reader.readVariableFinalValue("time", &value));
+  QCOMPARE(value, 1.0);
+  QVERIFY(!reader.readVariableFinalValue("z", &value));
+}
+
+void TestResultFileReader::readCSVColumns()
+{
+  ResultFileReader reader;
+  QVERIFY(reader.open(writeFile("model_res.csv", "\"time\",\"x\",\"y[1,2]\",\r\n0,1,2,\r\n0.5,3,4,\r\n1,5,6,\r\n")));
+  QVector<double> time;
+  time << 0.0 << 0.5 << 1.0;
+  QCOMPARE(reader.readTimeColumn(), time);
+  bool ok = false;
+  QVector<double> y;
+  y << 2.0 << 4.0 << 6.0;
+  QCOMPARE(reader.readVariableColumn("y[1,2]", &ok), y);
+  QVERIFY(ok);
+  double value = 0;
+  QVERIFY(reader.readVariableValue("x", 0.75, &value));
+  QCOMPARE(value, 4.0);
+}
+
+void TestResultFileReader::readCSVWideColumns()
+{
+  // more columns than RESULT_FILE_READER_CSV_FIELDS_STRIDE so the columns are decoded from the indexed fields.
+  const int columns = 100;
+  const int rows = 50;
+  QByteArray contents = "\"time\",";
+  for (int column = 1 ; column < columns ; column++) {
+    contents.append(QString("\"v%1\",").arg(column).toLatin1());
+  }
+  contents.append("\n");
+  for (int row = 0 ; row < rows ; row++) {
+    contents.append(QByteArray::number(row));
+    for (int column = 1 ; column < columns ; column++) {
+      contents.append(",").append(QByteArray::number(row * 1000 + column));
+    }
+    contents.append(",\n");
+  }
+  ResultFileReader reader;
+  QVERIFY(reader.open(writeFile("wide_res.csv", contents)));
+  for (int column = 1 ; column < columns ; column += 7) {
+    bool ok = false;
+    QVector<double> values = reader.readVariableColumn(QString("v%1").arg(column), &ok);
+    QVERIFY(ok);
+    QCOMPARE(values.size(), rows);
+    for (int row = 0 ; row < rows ; row++) {
+      QCOMPARE(values.at(row), (double)(row * 1000 + column));
+    }
+  }
+  double value = 0;
+  QVERIFY(reader.readVariableFinalValue("v99", &value));
+  QCOMPARE(value, (double)((rows - 1) * 1000 + 99));
+}
+
+void TestResultFileReader::readCSVInvalidFinalValue()
+{
+  ResultFileReader reader;
+  QVERIFY(reader.open(writeFile("invalid_res.csv", "\"time\",\"x\",\n0,1,\n1,abc,\n")));
+  double value = 0;
+  QVERIFY(!reader.readVariableFinalValue("x", &value));
+  QVERIFY(reader.readVariableFinalValue("time", &value));
+  QCOMPARE(value, 1.0);
+}
+
+QTEST_MAIN(TestResultFileReader)
+
+#include "testresultfilereader.moc"
@@ -0,0 +1,77 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+
+#include "Simulation/SimulationJobScheduler.h"
+
+/*!
+ * \class TestSimulationJobScheduler
+ * \brief Tests how SimulationJobScheduler divides the processors between the running compilations.
+ */
+class TestSimulationJobScheduler: public QObject
+{
+  Q_OBJECT
+private slots:
+  void compilationProcessors();
+  void compilationProcessors_data();
+};
+
+void TestSimulationJobScheduler::compilationProcessors_data()
+{
+  QTest::addColumn<int>("numberOfProcessors");
+  QTest::addColumn<int>("runningCompilations");
+  QTest::addColumn<int>("expected");
+
+  QTest::newRow("single compilation gets all processors") << 8 << 1 << 8;
+  QTest::newRow("two compilations") << 8 << 2 << 4;
+  QTest::newRow("uneven split") << 8 << 3 << 2;
+  QTest::newRow("more compilations than processors") << 4 << 6 << 1;
+  QTest::newRow("one processor") << 1 << 4 << 1;
+  QTest::newRow("no running compilations") << 8 << 0 << 8;
+  QTest::newRow("no processors") << 0 << 2 << 1;
+}
+
+void TestSimulationJobScheduler::compilationProcessors()
+{
+  QFETCH(int, numberOfProcessors);
+  QFETCH(int, runningCompilations);
+  QFETCH(int, expected);
+
+  QCOMPARE(SimulationJobScheduler::getCompilationProcessors(numberOfProcessors, runningCompilations), expected);
+}
+
+QTEST_MAIN(TestSimulationJobScheduler)
+
+#include "testsimulationjobscheduler.moc"
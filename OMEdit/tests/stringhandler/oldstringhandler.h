@@ -0,0 +1,215 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OLDSTRINGHANDLER_H
+#define OLDSTRINGHANDLER_H
+
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \namespace OldStringHandler
+ * \brief Copy of the StringHandler splitters before they were rewritten to scan the raw characters.\n
+ * The tests check that the current StringHandler returns the same lists and the benchmarks compare both.
+ */
+namespace OldStringHandler
+{
+
+#define OLD_CONSUME_CHAR(value,res,i) \
+  if (value.at(i) == '\\') { \
+  i++; \
+  switch (value[i].toLatin1()) { \
+  case '\'': res.append('\''); break; \
+  case '"':  res.append('\"'); break; \
+  case '?':  res.append('\?'); break; \
+  case '\\': res.append('\\'); break; \
+  case 'a':  res.append('\a'); break; \
+  case 'b':  res.append('\b'); break; \
+  case 'f':  res.append('\f'); break; \
+  case 'n':  res.append('\n'); break; \
+  case 'r':  res.append('\r'); break; \
+  case 't':  res.append('\t'); break; \
+  case 'v':  res.append('\v'); break; \
+  } \
+  } else { \
+  res.append(value[i]); \
+  }
+
+inline QString removeFirstLastCurlBrackets(QString value)
+{
+  value = value.trimmed();
+  if (value.length() > 1 && value.at(0) == '{' && value.at(value.length() - 1) == '}') {
+    value = value.mid(1, (value.length() - 2));
+  }
+  return value;
+}
+
+inline QStringList getStrings(QString value, char start = '{', char end = '}')
+{
+  QStringList list;
+  bool mask = false;
+  bool inString = false;
+  char StringEnd = '\0';
+  int begin = 0;
+  int ele = 0;
+
+  for (int i = 0 ; i < value.length() ; i++) {
+    if (inString) {
+      if (mask) {
+        mask = false;
+      } else {
+        if (value.at(i) == '\\') {
+          mask = true;
+        } else if (value.at(i) == StringEnd) {
+          inString = false;
+        }
+      }
+    } else {
+      if (value.at(i) == '"') {
+        StringEnd = '"';
+        inString = true;
+      } else if (value.at(i) == '\'') {
+        StringEnd = '\'';
+        inString = true;
+      } else if (value.at(i) == ',') {
+        if (ele == 0) {
+          list.append(value.mid(begin,i-begin).trimmed());
+          begin = i+1;
+        }
+      } else if (value.at(i) == start) {
+        ele++;
+      } else if (value.at(i) == end) {
+        ele--;
+      }
+    }
+  }
+  list.append(value.mid(begin,value.length()-begin).trimmed());
+
+  return list;
+}
+
+inline QStringList unparseStrings(QString value)
+{
+  QStringList lst;
+  value = value.trimmed();
+  if (value[0] != '{') return lst; // ERROR?
+  int i=1;
+  QString res;
+  while (value[i] == '"') {
+    i++;
+    while (value.at(i) != '"') {
+      OLD_CONSUME_CHAR(value,res,i);
+      i++;
+      /* if we have unexpected double quotes then, however omc should return \" */
+      /* remove this block once fixed in omc */
+      if (value[i] == '"' && value[i+1] != ',') {
+        if (value[i+1] != '}') {
+          OLD_CONSUME_CHAR(value,res,i);
+          i++;
+        }
+      }
+      /* remove this block once fixed in omc */
+    }
+    i++;
+    if (value[i] == '}') {
+      lst.append(res);
+      return lst;
+    }
+    if (value[i] == ',') {
+      lst.append(res);
+      i++;
+      res = "";
+      while (value[i] == ' ')     // if we have space before next value e.g {"x", "y", "z"}
+        i++;
+      continue;
+    }
+    while (value[i] != '"' && !value[i].isNull()) {
+      i++;
+    }
+  }
+  return lst; // ERROR?
+}
+
+inline QStringList unparseArrays(QString value)
+{
+  QStringList lst;
+  int braceopen = 0;
+  int mainbraceopen = 0;
+  int i = 0;
+  value = removeFirstLastCurlBrackets(value);
+  int length = value.size();
+  int subbraceopen = 0;
+  for (; i < length ; i++) {
+    if (value.at(i) == ' ' || value.at(i) == ',') {
+      continue; // ignore any kind of space
+    }
+    if (value.at(i) == '{' && braceopen == 0) {
+      braceopen = 1;
+      mainbraceopen = i;
+      continue;
+    }
+    if (value.at(i) == '{') {
+      subbraceopen = 1;
+    }
+
+    if (value.at(i) == '}' && braceopen == 1 && subbraceopen == 0) {
+      //closing of a group
+      int copylength = i- mainbraceopen+1;
+      braceopen = 0;
+      lst.append(value.mid(mainbraceopen, copylength));
+      continue;
+    }
+    if (value.at(i) == '}') {
+      subbraceopen = 0;
+    }
+
+    /* skip the whole quotes section */
+    if (value.at(i) == '"') {
+      i++;
+      while (value.at(i) != '"') {
+        i++;
+        if (value.at(i-1) == '\\' && value.at(i) == '"') {
+            i+=1;
+        }
+      }
+    }
+  }
+  return lst;
+}
+
+#undef OLD_CONSUME_CHAR
+
+} // namespace OldStringHandler
+
+#endif // OLDSTRINGHANDLER_H
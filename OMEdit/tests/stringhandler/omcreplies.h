@@ -0,0 +1,113 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#ifndef OMCREPLIES_H
+#define OMCREPLIES_H
+
+#include <QString>
+#include <QStringList>
+
+/*!
+ * \namespace OMCReplies
+ * \brief Generates large OMC replies for the StringHandler tests and benchmarks.
+ */
+namespace OMCReplies
+{
+
+/*!
+ * \brief components
+ * Returns a getComponents(className, useQuotes = true) reply with count components.\n
+ * The comments contain escaped quotes, commas, brackets and non ASCII characters and some components are arrays.
+ * \param count
+ * \return
+ */
+inline QString components(int count)
+{
+  QStringList components;
+  components.reserve(count);
+  for (int i = 0 ; i < count ; i++) {
+    QString dimensions = (i % 3 == 0) ? QString("{\"%1\"}").arg(i % 7 + 1) : QString("{}");
+    QString variability = (i % 4 == 0) ? "parameter" : "unspecified";
+    QString causality = (i % 2 == 0) ? "input" : "output";
+    components.append(QString("{\"Modelica.Blocks.Interfaces.RealInput\", \"u%1\", \"Connector of \\\"Real\\\" input, {signal} %1 \xC2\xB5m\", "
+                              "\"%2\", \"false\", \"false\", \"false\", \"%3\", \"%4\", \"%5\", \"%6\", %7}")
+                      .arg(i).arg(i % 5 == 0 ? "protected" : "public").arg(i % 6 == 0 ? "true" : "false")
+                      .arg(variability).arg(i % 8 == 0 ? "inner" : "none").arg(causality).arg(dimensions));
+  }
+  return QString("{%1}").arg(components.join(","));
+}
+
+/*!
+ * \brief annotations
+ * Returns a getComponentAnnotations(className) reply with count annotations.
+ * \param count
+ * \return
+ */
+inline QString annotations(int count)
+{
+  QStringList annotations;
+  annotations.reserve(count);
+  for (int i = 0 ; i < count ; i++) {
+    if (i % 10 == 9) {
+      annotations.append("{}");
+      continue;
+    }
+    annotations.append(QString("{Placement(true, -, -, %1.0, -10.0, %2.0, 10.0, 0.0, -, -, -, -, -, -,), "
+                               "Dialog(\"General\", \"Parameters, {all}\", true, false, false, -, -, \"\", \"'%1'\", false)}")
+                       .arg(i * 20 - 10).arg(i * 20 + 10));
+  }
+  return QString("{%1}").arg(annotations.join(","));
+}
+
+/*!
+ * \brief shapes
+ * Returns the shapes of a connection annotation with count line segments.
+ * \param count
+ * \return
+ */
+inline QString shapes(int count)
+{
+  QStringList points;
+  points.reserve(count);
+  for (int i = 0 ; i < count ; i++) {
+    points.append(QString("{%1, %2}").arg(i).arg(i % 2 == 0 ? -i : i));
+  }
+  return QString("{Line(true, {0.0, 0.0}, 0, {%1}, {0, 0, 127}, LinePattern.Solid, 0.25, {Arrow.None, Arrow.None}, 3, Smooth.None), "
+                 "Text(true, {0, 0}, 0, {{-100, 20}, {100, -20}}, {0, 0, 255}, \"%name (x, y)\", 0, TextAlignment.Center)}")
+      .arg(points.join(", "));
+}
+
+} // namespace OMCReplies
+
+#endif // OMCREPLIES_H
@@ -0,0 +1,199 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+/*
+ * @author Adeel Asghar <adeel.asghar@liu.se>
+ */
+
+#include <QtTest/QtTest>
+
+#include "Util/StringHandler.h"
+#include "Component/Component.h"
+#include "oldstringhandler.h"
+#include "omcreplies.h"
+
+/*!
+ * \class TestStringHandler
+ * \brief Tests that the StringHandler splitters return the same lists as the old splitters in OldStringHandler.
+ */
+class TestStringHandler: public QObject
+{
+  Q_OBJECT
+private slots:
+  void getStrings_data();
+  void getStrings();
+  void getStringsInCurlBrackets_data();
+  void getStringsInCurlBrackets();
+  void unparseStrings_data();
+  void unparseStrings();
+  void unparseStringsValues();
+  void unparseArrays_data();
+  void unparseArrays();
+  void parseComponentInfo_data();
+  void parseComponentInfo();
+};
+
+void TestStringHandler::getStrings_data()
+{
+  QTest::addColumn<QString>("value");
+  QTest::addColumn<char>("start");
+  QTest::addColumn<char>("end");
+
+  QTest::newRow("empty") << "" << '{' << '}';
+  QTest::newRow("values") << "a, b ,c" << '{' << '}';
+  QTest::newRow("arrays") << " {1, 2}, {3, {4, 5}} , x " << '{' << '}';
+  QTest::newRow("strings") << "\"a, b\", 'c, d', \"e\\\"f, g\", \"h\\\\\", i" << '{' << '}';
+  QTest::newRow("unbalanced") << "}, a, {b, c" << '{' << '}';
+  QTest::newRow("parentheses") << "Line(points = {{1, 2}, {3, 4}}), Text(textString = \"x, (y)\")" << '(' << ')';
+  QString annotations = OMCReplies::annotations(500);
+  QTest::newRow("annotations") << annotations.mid(1, annotations.length() - 2) << '{' << '}';
+}
+
+void TestStringHandler::getStrings()
+{
+  QFETCH(QString, value);
+  QFETCH(char, start);
+  QFETCH(char, end);
+
+  QCOMPARE(StringHandler::getStrings(value, start, end), OldStringHandler::getStrings(value, start, end));
+}
+
+void TestStringHandler::getStringsInCurlBrackets_data()
+{
+  QTest::addColumn<QString>("value");
+  QTest::addColumn<char>("start");
+  QTest::addColumn<char>("end");
+
+  QTest::newRow("empty") << "" << '{' << '}';
+  QTest::newRow("empty array") << "{}" << '{' << '}';
+  QTest::newRow("bracket") << "{" << '{' << '}';
+  QTest::newRow("spaces") << "  {a, {b, c}}  \n" << '{' << '}';
+  QTest::newRow("no brackets") << "a, b" << '{' << '}';
+  QTest::newRow("two arrays") << "{a}, {b}" << '{' << '}';
+  QTest::newRow("annotations") << OMCReplies::annotations(500) << '{' << '}';
+  QTest::newRow("shapes") << OMCReplies::shapes(500) << '(' << ')';
+}
+
+void TestStringHandler::getStringsInCurlBrackets()
+{
+  QFETCH(QString, value);
+  QFETCH(char, start);
+  QFETCH(char, end);
+
+  QCOMPARE(StringHandler::getStringsInCurlBrackets(value, start, end),
+           OldStringHandler::getStrings(OldStringHandler::removeFirstLastCurlBrackets(value), start, end));
+}
+
+void TestStringHandler::unparseStrings_data()
+{
+  QTest::addColumn<QString>("value");
+
+  QTest::newRow("not an array") << " x";
+  QTest::newRow("empty array") << "{}";
+  QTest::newRow("strings") << "{\"a\", \"b\",\"c\"}";
+  QTest::newRow("escapes") << "{\"a\\\"b\", \"c\\\\d\", \"e\\nf\\tg\", \"\\'h\\?\"}";
+  QTest::newRow("unexpected quotes") << "{\"say \"hi\" now\", \"x\"}";
+  QTest::newRow("non ascii") << QString::fromUtf8("{\"\xCE\xA9mega\", \"caf\xC3\xA9\"}");
+  QTest::newRow("trailing array") << "{\"Real\", \"x\", \"\", \"public\", \"false\", \"false\", \"false\", \"false\", \"parameter\", \"none\", \"unspecified\", {\"3\"}}";
+  QTest::newRow("spaces") << "  {\"a\",   \"b\"}  ";
+}
+
+void TestStringHandler::unparseStrings()
+{
+  QFETCH(QString, value);
+
+  QCOMPARE(StringHandler::unparseStrings(value), OldStringHandler::unparseStrings(value));
+  // the same strings inside a larger reply.
+  QString reply = QString("{%1, %1}").arg(value);
+  QCOMPARE(StringHandler::unparseStrings(reply, 1, value.length()), OldStringHandler::unparseStrings(value));
+}
+
+void TestStringHandler::unparseStringsValues()
+{
+  QStringList list = StringHandler::unparseStrings("{\"a\\\"b\", \"c, {d}\", \"\"}");
+  QCOMPARE(list.size(), 3);
+  QCOMPARE(list.at(0), QString("a\"b"));
+  QCOMPARE(list.at(1), QString("c, {d}"));
+  QCOMPARE(list.at(2), QString(""));
+}
+
+void TestStringHandler::unparseArrays_data()
+{
+  QTest::addColumn<QString>("value");
+
+  QTest::newRow("empty") << "";
+  QTest::newRow("empty array") << "{}";
+  QTest::newRow("arrays") << "{{\"a\",\"b\"},{\"c\",{\"d\"}}}";
+  QTest::newRow("quoted brackets") << "{{\"x\\\"}\", \"y\"}, {\"z{\"}}";
+  QTest::newRow("components") << OMCReplies::components(1000);
+}
+
+void TestStringHandler::unparseArrays()
+{
+  QFETCH(QString, value);
+
+  QStringList list = OldStringHandler::unparseArrays(value);
+  QCOMPARE(StringHandler::unparseArrays(value), list);
+  QList<QPair<int, int> > ranges = StringHandler::unparseArraysRanges(value);
+  QCOMPARE(ranges.size(), list.size());
+  for (int i = 0 ; i < ranges.size() ; i++) {
+    QCOMPARE(value.mid(ranges.at(i).first, ranges.at(i).second), list.at(i));
+  }
+}
+
+void TestStringHandler::parseComponentInfo_data()
+{
+  QTest::addColumn<QString>("value");
+
+  QTest::newRow("component") << "{{\"Real\", \"x\", \"the \\\"x\\\"\", \"public\", \"false\", \"false\", \"false\", \"false\", \"parameter\", \"none\", \"unspecified\", {}}}";
+  QTest::newRow("components") << OMCReplies::components(1000);
+}
+
+void TestStringHandler::parseComponentInfo()
+{
+  QFETCH(QString, value);
+
+  QStringList list = OldStringHandler::unparseArrays(value);
+  QList<QPair<int, int> > ranges = StringHandler::unparseArraysRanges(value);
+  QCOMPARE(ranges.size(), list.size());
+  for (int i = 0 ; i < ranges.size() ; i++) {
+    ComponentInfo oldComponentInfo;
+    oldComponentInfo.parseComponentInfo(OldStringHandler::unparseStrings(list.at(i)));
+    ComponentInfo componentInfo;
+    componentInfo.parseComponentInfo(StringHandler::unparseStrings(value, ranges.at(i).first, ranges.at(i).second));
+    QCOMPARE(componentInfo.getName(), oldComponentInfo.getName());
+    QCOMPARE(componentInfo.getComment(), oldComponentInfo.getComment());
+    QVERIFY(componentInfo == oldComponentInfo);
+  }
+}
+
+QTEST_MAIN(TestStringHandler)
+
+#include "teststringhandler.moc"